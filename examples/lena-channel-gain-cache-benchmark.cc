@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Runtime and accuracy of the channel gain cache (LteHelper
+ * UseChannelGainCache) and of the culling of the weak interferers
+ * (LteSpectrumPhy InterferenceCullingThreshold).
+ *
+ * The eNBs are on a square grid, each with the given number of UEs
+ * dropped around it, all of them static and in full buffer downlink.
+ * The same scenario is simulated with the full computation, then with
+ * the cache and the culling. The wall clock times are reported, with
+ * the error of the average wideband SINR of each UE of the second run
+ * with respect to the first one.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaChannelGainCacheBenchmark");
+
+/// Sum of the SINR samples of a UE
+struct SinrSum
+{
+  double sum; ///< sum of the linear SINR samples
+  uint64_t count; ///< number of samples
+};
+
+/**
+ * Trace sink of the ReportCurrentCellRsrpSinr trace source of a UE
+ *
+ * \param sinrSum the sum of the UE
+ * \param cellId the serving cell ID
+ * \param rnti the RNTI
+ * \param rsrp the RSRP
+ * \param sinr the average linear SINR
+ */
+static void
+ReportSinr (SinrSum* sinrSum, uint16_t cellId, uint16_t rnti, double rsrp, double sinr)
+{
+  sinrSum->sum += sinr;
+  ++sinrSum->count;
+}
+
+/**
+ * Simulate the scenario once
+ *
+ * \param nEnbsPerSide the number of eNBs on each side of the grid
+ * \param nUesPerEnb the number of UEs of each eNB
+ * \param distance the distance between the eNBs in meters
+ * \param simTime the simulated time
+ * \param useCache whether the channel gain cache is used
+ * \param cullingThreshold the interference culling threshold in dB
+ * \param sinrDb the average SINR of each UE, in dB
+ * \return the wall clock time of the simulation, in ms
+ */
+static int64_t
+RunScenario (uint32_t nEnbsPerSide, uint32_t nUesPerEnb, double distance, Time simTime,
+             bool useCache, double cullingThreshold, std::vector<double>& sinrDb)
+{
+  // same drop and same random variables in every run
+  RngSeedManager::SetRun (1);
+  Config::SetDefault ("ns3::LteSpectrumPhy::InterferenceCullingThreshold", DoubleValue (cullingThreshold));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseChannelGainCache", BooleanValue (useCache));
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::LogDistancePropagationLossModel"));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnbsPerSide * nEnbsPerSide);
+  NodeContainer ueNodes;
+  ueNodes.Create (enbNodes.GetN () * nUesPerEnb);
+
+  Ptr<ListPositionAllocator> enbPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      enbPositions->Add (Vector ((i % nEnbsPerSide) * distance, (i / nEnbsPerSide) * distance, 30.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (enbPositions);
+  mobility.Install (enbNodes);
+
+  Ptr<UniformRandomVariable> offset = CreateObject<UniformRandomVariable> ();
+  offset->SetAttribute ("Min", DoubleValue (-distance / 2));
+  offset->SetAttribute ("Max", DoubleValue (distance / 2));
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      uint32_t enb = i / nUesPerEnb;
+      uePositions->Add (Vector ((enb % nEnbsPerSide) * distance + offset->GetValue (),
+                                (enb / nEnbsPerSide) * distance + offset->GetValue (),
+                                1.5));
+    }
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  std::vector<SinrSum> sinrSums (ueDevs.GetN ());
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      sinrSums[i].sum = 0.0;
+      sinrSums[i].count = 0;
+      Ptr<LteUePhy> phy = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetPhy ();
+      phy->TraceConnectWithoutContext ("ReportCurrentCellRsrpSinr",
+                                       MakeBoundCallback (&ReportSinr, &sinrSums[i]));
+    }
+
+  Simulator::Stop (simTime);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsedMs = clock.End ();
+
+  sinrDb.clear ();
+  for (uint32_t i = 0; i < sinrSums.size (); ++i)
+    {
+      double sinr = sinrSums[i].count > 0 ? sinrSums[i].sum / sinrSums[i].count : 0.0;
+      sinrDb.push_back (10 * std::log10 (sinr));
+    }
+
+  Simulator::Destroy ();
+  return elapsedMs;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nEnbsPerSide = 4;
+  uint32_t nUesPerEnb = 10;
+  double distance = 500.0;
+  double simTime = 1.0;
+  double cullingThreshold = 10.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nEnbsPerSide", "Number of eNBs on each side of the grid", nEnbsPerSide);
+  cmd.AddValue ("nUesPerEnb", "Number of UEs of each eNB", nUesPerEnb);
+  cmd.AddValue ("distance", "Distance between the eNBs [m]", distance);
+  cmd.AddValue ("simTime", "Simulated time [s]", simTime);
+  cmd.AddValue ("cullingThreshold", "Interference culling threshold [dB under the noise floor]", cullingThreshold);
+  cmd.Parse (argc, argv);
+
+  std::vector<double> fullSinrDb;
+  int64_t fullMs = RunScenario (nEnbsPerSide, nUesPerEnb, distance, Seconds (simTime),
+                                false, -1.0, fullSinrDb);
+  std::vector<double> fastSinrDb;
+  int64_t fastMs = RunScenario (nEnbsPerSide, nUesPerEnb, distance, Seconds (simTime),
+                                true, cullingThreshold, fastSinrDb);
+
+  double sumError = 0.0;
+  double maxError = 0.0;
+  for (uint32_t i = 0; i < fullSinrDb.size (); ++i)
+    {
+      double error = std::fabs (fastSinrDb[i] - fullSinrDb[i]);
+      sumError += error;
+      maxError = std::max (maxError, error);
+    }
+
+  std::cout << "eNBs\tUEs\tfull[ms]\tcached+culled[ms]\tspeedup\tmean SINR error[dB]\tmax SINR error[dB]" << std::endl;
+  std::cout << nEnbsPerSide * nEnbsPerSide << "\t" << fullSinrDb.size () << "\t"
+            << fullMs << "\t" << fastMs << "\t"
+            << (double) fullMs / std::max (fastMs, (int64_t) 1) << "\t"
+            << sumError / std::max (fullSinrDb.size (), (size_t) 1) << "\t"
+            << maxError << std::endl;
+
+  return 0;
+}
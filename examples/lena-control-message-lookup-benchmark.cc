@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+
+#include <iomanip>
+#include <list>
+
+using namespace ns3;
+
+/**
+ * Scaling of the DCI lookup of the UEs of a cell with the number of
+ * scheduled UEs.
+ *
+ * Every TTI, the eNB sends a DL DCI and an UL DCI to each UE, with the
+ * MIB. Each UE then looks for its own DCIs and for the broadcast
+ * messages: first as done before LteControlMessageList, copying the
+ * list of the frame and decoding every DCI to compare its RNTI, which
+ * costs O(UEs^2) per TTI for the cell, and then with the RNTI index
+ * of LteControlMessageList, built once per TTI by the eNB. Both must
+ * find the same messages.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaControlMessageLookupBenchmark");
+
+/**
+ * \param msgList the control messages of the frame, copied as done
+ *        for each receiver
+ * \param rnti the RNTI of the UE
+ * \return the number of messages for the UE, broadcast ones included
+ */
+static uint32_t
+ScanList (std::list<Ptr<LteControlMessage> > msgList, uint16_t rnti)
+{
+  uint32_t nFound = 0;
+  for (std::list<Ptr<LteControlMessage> >::iterator it = msgList.begin (); it != msgList.end (); ++it)
+    {
+      if ((*it)->GetMessageType () == LteControlMessage::DL_DCI)
+        {
+          if (DynamicCast<DlDciLteControlMessage> (*it)->GetDci ().m_rnti == rnti)
+            {
+              ++nFound;
+            }
+        }
+      else if ((*it)->GetMessageType () == LteControlMessage::UL_DCI)
+        {
+          if (DynamicCast<UlDciLteControlMessage> (*it)->GetDci ().m_rnti == rnti)
+            {
+              ++nFound;
+            }
+        }
+      else
+        {
+          ++nFound;
+        }
+    }
+  return nFound;
+}
+
+/**
+ * \param msgList the control messages of the frame
+ * \param rnti the RNTI of the UE
+ * \return the number of messages for the UE, broadcast ones included
+ */
+static uint32_t
+LookUpList (Ptr<const LteControlMessageList> msgList, uint16_t rnti)
+{
+  std::pair<LteControlMessageList::Iterator, LteControlMessageList::Iterator> own = msgList->Find (rnti);
+  std::pair<LteControlMessageList::Iterator, LteControlMessageList::Iterator> common = msgList->Find (0);
+  return (own.second - own.first) + (common.second - common.first);
+}
+
+/**
+ * Run the benchmark for one number of UEs
+ *
+ * \param nUes the number of scheduled UEs of the cell
+ * \param nTtis the number of simulated TTIs
+ */
+static void
+RunBenchmark (uint32_t nUes, uint32_t nTtis)
+{
+  std::list<Ptr<LteControlMessage> > msgList;
+  LteRrcSap::MasterInformationBlock mibContent;
+  mibContent.dlBandwidth = 100;
+  mibContent.systemFrameNumber = 0;
+  Ptr<MibLteControlMessage> mib = Create<MibLteControlMessage> ();
+  mib->SetMib (mibContent);
+  msgList.push_back (mib);
+  for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+    {
+      DlDciListElement_s dlDci;
+      dlDci.m_rnti = rnti;
+      dlDci.m_rbBitmap = 1;
+      dlDci.m_resAlloc = 0;
+      dlDci.m_tbsSize.push_back (100);
+      dlDci.m_mcs.push_back (10);
+      dlDci.m_ndi.push_back (1);
+      dlDci.m_rv.push_back (0);
+      dlDci.m_harqProcess = 0;
+      Ptr<DlDciLteControlMessage> dlMsg = Create<DlDciLteControlMessage> ();
+      dlMsg->SetDci (dlDci);
+      msgList.push_back (dlMsg);
+
+      UlDciListElement_s ulDci;
+      ulDci.m_rnti = rnti;
+      ulDci.m_rbStart = 0;
+      ulDci.m_rbLen = 1;
+      ulDci.m_tbSize = 100;
+      ulDci.m_mcs = 10;
+      ulDci.m_ndi = 1;
+      Ptr<UlDciLteControlMessage> ulMsg = Create<UlDciLteControlMessage> ();
+      ulMsg->SetDci (ulDci);
+      msgList.push_back (ulMsg);
+    }
+
+  uint64_t nScanFound = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t t = 0; t < nTtis; ++t)
+    {
+      for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+        {
+          nScanFound += ScanList (msgList, rnti);
+        }
+    }
+  int64_t scanMs = clock.End ();
+
+  uint64_t nLookUpFound = 0;
+  clock.Start ();
+  for (uint32_t t = 0; t < nTtis; ++t)
+    {
+      Ptr<const LteControlMessageList> shared = Create<LteControlMessageList> (msgList);
+      for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+        {
+          nLookUpFound += LookUpList (shared, rnti);
+        }
+    }
+  int64_t lookUpMs = clock.End ();
+
+  NS_ABORT_MSG_IF (nScanFound != nLookUpFound, "the implementations disagree");
+
+  std::cout << nUes << "\t" << msgList.size () << "\t" << scanMs << "\t" << lookUpMs << "\t"
+            << std::fixed << std::setprecision (2)
+            << scanMs * 1000.0 / nTtis << "\t" << lookUpMs * 1000.0 / nTtis << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nTtis = 1000;
+  uint32_t maxUes = 800;
+
+  CommandLine cmd;
+  cmd.AddValue ("ttis", "Number of simulated TTIs", nTtis);
+  cmd.AddValue ("maxUes", "Largest number of scheduled UEs", maxUes);
+  cmd.Parse (argc, argv);
+
+  std::cout << "UEs\tmessages\tscan[ms]\tlookup[ms]\tscan[us/TTI]\tlookup[us/TTI]" << std::endl;
+  for (uint32_t nUes = 25; nUes <= maxUes; nUes *= 2)
+    {
+      RunBenchmark (nUes, nTtis);
+    }
+
+  return 0;
+}
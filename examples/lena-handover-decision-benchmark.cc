@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Benchmark of the handover decisions of A2A4RsrqHandoverAlgorithm, as
+ * done for the UEs of one eNB.
+ *
+ * Every TTI, the UEs whose report interval elapses send an Event A4
+ * report with the RSRQ of a random subset of the neighbour cells, and
+ * some of them also an Event A2 report with the RSRQ of the serving
+ * cell, which triggers the evaluation of the handover. The reports are
+ * handled with LteHandoverMeasurementStore, evaluating the pending UEs
+ * once per TTI, and with the previous implementation keeping the
+ * measurements in nested std::map and scanning them for each A2 report.
+ * The two must trigger the same handovers.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaHandoverDecisionBenchmark");
+
+/// A measurement report of a UE
+struct Report
+{
+  uint16_t rnti; ///< RNTI of the UE
+  std::vector<std::pair<uint16_t, uint8_t> > neighbours; ///< A4 report, cell ID and RSRQ
+  uint8_t servingRsrq; ///< A2 report, 0 if none
+};
+
+/// A handover decision
+typedef std::pair<uint16_t, uint16_t> Decision;
+
+/// Reference implementation: nested maps, scanned for each A2 report
+class MapHandoverDecision
+{
+public:
+  /**
+   * \param report the measurement report
+   * \param offset the neighbour cell offset
+   * \param decisions the handover decisions
+   */
+  void Receive (const Report& report, uint8_t offset, std::vector<Decision>& decisions)
+  {
+    for (std::vector<std::pair<uint16_t, uint8_t> >::const_iterator it = report.neighbours.begin ();
+         it != report.neighbours.end (); ++it)
+      {
+        m_table[report.rnti][it->first] = it->second;
+      }
+    if (report.servingRsrq > 0)
+      {
+        std::map<uint16_t, std::map<uint16_t, uint8_t> >::const_iterator it1 = m_table.find (report.rnti);
+        if (it1 == m_table.end ())
+          {
+            return;
+          }
+        uint16_t bestCellId = 0;
+        uint8_t bestRsrq = 0;
+        for (std::map<uint16_t, uint8_t>::const_iterator it2 = it1->second.begin ();
+             it2 != it1->second.end (); ++it2)
+          {
+            if (it2->second > bestRsrq)
+              {
+                bestCellId = it2->first;
+                bestRsrq = it2->second;
+              }
+          }
+        if (bestCellId > 0 && bestRsrq - report.servingRsrq >= offset)
+          {
+            decisions.push_back (Decision (report.rnti, bestCellId));
+          }
+      }
+  }
+
+private:
+  /// RSRQ of each neighbour cell of each UE
+  std::map<uint16_t, std::map<uint16_t, uint8_t> > m_table;
+};
+
+/**
+ * \param store the measurement store
+ * \param report the measurement report
+ */
+static void
+Receive (LteHandoverMeasurementStore& store, const Report& report)
+{
+  for (std::vector<std::pair<uint16_t, uint8_t> >::const_iterator it = report.neighbours.begin ();
+       it != report.neighbours.end (); ++it)
+    {
+      store.Update (report.rnti, it->first, it->second);
+    }
+  if (report.servingRsrq > 0)
+    {
+      store.AddPending (report.rnti, report.servingRsrq);
+    }
+}
+
+/**
+ * Evaluate the pending handovers at the end of a TTI
+ *
+ * \param store the measurement store
+ * \param pending the pending evaluations, reused across TTIs
+ * \param offset the neighbour cell offset
+ * \param decisions the handover decisions
+ */
+static void
+Evaluate (LteHandoverMeasurementStore& store,
+          std::vector<LteHandoverMeasurementStore::Pending>& pending,
+          uint8_t offset, std::vector<Decision>& decisions)
+{
+  store.TakePending (pending);
+  for (std::vector<LteHandoverMeasurementStore::Pending>::const_iterator it = pending.begin ();
+       it != pending.end (); ++it)
+    {
+      uint8_t bestRsrq = 0;
+      uint16_t bestCellId = store.GetBestNeighbour (it->rnti, bestRsrq);
+      if (bestCellId > 0 && bestRsrq - it->servingValue >= offset)
+        {
+          decisions.push_back (Decision (it->rnti, bestCellId));
+        }
+    }
+}
+
+/**
+ * Run the benchmark for one deployment
+ *
+ * \param nUes the number of UEs of the eNB
+ * \param nNeighbours the number of neighbour cells
+ * \param reportIntervalMs the report interval of each UE, in TTIs
+ * \param nTtis the number of simulated TTIs
+ */
+static void
+RunBenchmark (uint32_t nUes, uint32_t nNeighbours, uint32_t reportIntervalMs, uint32_t nTtis)
+{
+  const uint8_t offset = 1; // NeighbourCellOffset
+  const uint32_t nReported = std::min (nNeighbours, (uint32_t) 8); // maxReportCells
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+
+  // pre-generate a cycle of reports, so that both implementations are
+  // timed on the same input and without the random number generation
+  const uint32_t nSampleTtis = std::min (nTtis, reportIntervalMs * 4);
+  std::vector<std::vector<Report> > samples (nSampleTtis);
+  for (uint32_t t = 0; t < nSampleTtis; ++t)
+    {
+      for (uint32_t u = t % reportIntervalMs; u < nUes; u += reportIntervalMs)
+        {
+          Report report;
+          report.rnti = u + 1;
+          uint32_t first = uniform->GetInteger (0, nNeighbours - 1);
+          for (uint32_t c = 0; c < nReported; ++c)
+            {
+              uint16_t cellId = (first + c) % nNeighbours + 2; // the serving cell is 1
+              report.neighbours.push_back (std::make_pair (cellId, (uint8_t) uniform->GetInteger (1, 34)));
+            }
+          report.servingRsrq = uniform->GetValue () < 0.5 ? (uint8_t) uniform->GetInteger (1, 34) : 0;
+          samples[t].push_back (report);
+        }
+    }
+
+  MapHandoverDecision map;
+  std::vector<Decision> mapDecisions;
+  uint64_t nReports = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t t = 0; t < nTtis; ++t)
+    {
+      const std::vector<Report>& reports = samples[t % nSampleTtis];
+      for (std::vector<Report>::const_iterator it = reports.begin (); it != reports.end (); ++it)
+        {
+          map.Receive (*it, offset, mapDecisions);
+        }
+      nReports += reports.size ();
+    }
+  int64_t mapMs = clock.End ();
+
+  LteHandoverMeasurementStore store;
+  std::vector<LteHandoverMeasurementStore::Pending> pending;
+  std::vector<Decision> storeDecisions;
+  clock.Start ();
+  for (uint32_t t = 0; t < nTtis; ++t)
+    {
+      const std::vector<Report>& reports = samples[t % nSampleTtis];
+      for (std::vector<Report>::const_iterator it = reports.begin (); it != reports.end (); ++it)
+        {
+          Receive (store, *it);
+        }
+      Evaluate (store, pending, offset, storeDecisions);
+    }
+  int64_t storeMs = clock.End ();
+
+  // a UE reports at most once per TTI, so both see the same decisions
+  // in the same order
+  NS_ABORT_MSG_IF (mapDecisions != storeDecisions, "the implementations disagree");
+
+  std::cout << nUes << "\t" << nNeighbours << "\t" << reportIntervalMs << "\t"
+            << mapMs << "\t" << storeMs << "\t"
+            << std::fixed << std::setprecision (0)
+            << nReports * 1000.0 / std::max (mapMs, (int64_t) 1) << "\t"
+            << nReports * 1000.0 / std::max (storeMs, (int64_t) 1) << "\t"
+            << storeDecisions.size () << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nUes = 2000;
+  uint32_t nTtis = 10000;
+  uint32_t maxNeighbours = 64;
+
+  CommandLine cmd;
+  cmd.AddValue ("nUes", "Number of UEs of the eNB", nUes);
+  cmd.AddValue ("ttis", "Number of simulated TTIs", nTtis);
+  cmd.AddValue ("maxNeighbours", "Largest number of neighbour cells", maxNeighbours);
+  cmd.Parse (argc, argv);
+
+  // report intervals of high mobility (40 ms) down to the default (240 ms)
+  const uint32_t reportIntervalsMs[] = { 40, 120, 240 };
+
+  std::cout << "UEs\tneighbours\tinterval[ms]\tmap[ms]\tstore[ms]\tmap[report/s]\tstore[report/s]\thandovers" << std::endl;
+  for (uint32_t nNeighbours = 8; nNeighbours <= maxNeighbours; nNeighbours *= 2)
+    {
+      for (uint32_t i = 0; i < sizeof (reportIntervalsMs) / sizeof (reportIntervalsMs[0]); ++i)
+        {
+          RunBenchmark (nUes, nNeighbours, reportIntervalsMs[i], nTtis);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * Startup time of a mass attach with the ideal RRC protocol.
+ *
+ * All the UEs are attached to the closest eNB at the start of the
+ * simulation, which runs until every UE has established its RRC
+ * connection. The wall clock times of the installation of the devices
+ * and of the connection establishment are reported, so that the cost
+ * of the RRC message delivery shows up separately from the cost of the
+ * scenario construction.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaIdealRrcAttachBenchmark");
+
+/// Progress of the connection establishment
+struct AttachProgress
+{
+  uint32_t nUes; ///< number of UEs
+  uint32_t nConnected; ///< number of UEs that established their connection
+  Time lastConnection; ///< time of the last connection establishment
+};
+
+/**
+ * Trace sink of the ConnectionEstablished trace source of the UE RRC,
+ * stopping the simulation when all the UEs are connected
+ *
+ * \param progress the progress of the connection establishment
+ * \param imsi the IMSI
+ * \param cellId the cell ID
+ * \param rnti the RNTI
+ */
+static void
+ConnectionEstablished (AttachProgress* progress, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  ++progress->nConnected;
+  progress->lastConnection = Simulator::Now ();
+  if (progress->nConnected == progress->nUes)
+    {
+      Simulator::Stop ();
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nUes = 5000;
+  uint32_t nEnbsPerSide = 5;
+  double distance = 500.0;
+  double maxSimTime = 10.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nUes", "Number of UEs", nUes);
+  cmd.AddValue ("nEnbsPerSide", "Number of eNBs on each side of the grid", nEnbsPerSide);
+  cmd.AddValue ("distance", "Distance between the eNBs [m]", distance);
+  cmd.AddValue ("maxSimTime", "Simulated time after which the attach is given up [s]", maxSimTime);
+  cmd.Parse (argc, argv);
+
+  // an SRS periodicity allowing up to 320 UEs per cell
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue (320));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseIdealRrc", BooleanValue (true));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnbsPerSide * nEnbsPerSide);
+  NodeContainer ueNodes;
+  ueNodes.Create (nUes);
+
+  Ptr<ListPositionAllocator> enbPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      enbPositions->Add (Vector ((i % nEnbsPerSide) * distance, (i / nEnbsPerSide) * distance, 30.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (enbPositions);
+  mobility.Install (enbNodes);
+
+  Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable> ();
+  position->SetAttribute ("Min", DoubleValue (-distance / 2));
+  position->SetAttribute ("Max", DoubleValue ((nEnbsPerSide - 0.5) * distance));
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nUes; ++i)
+    {
+      uePositions->Add (Vector (position->GetValue (), position->GetValue (), 1.5));
+    }
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+
+  AttachProgress progress;
+  progress.nUes = nUes;
+  progress.nConnected = 0;
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<LteUeRrc> rrc = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ();
+      rrc->TraceConnectWithoutContext ("ConnectionEstablished",
+                                       MakeBoundCallback (&ConnectionEstablished, &progress));
+    }
+  int64_t installMs = clock.End ();
+
+  Simulator::Stop (Seconds (maxSimTime));
+  clock.Start ();
+  Simulator::Run ();
+  int64_t attachMs = clock.End ();
+  Simulator::Destroy ();
+
+  std::cout << "eNBs\tUEs\tconnected\tinstall[ms]\tattach[ms]\tlast connection[s]" << std::endl;
+  std::cout << enbNodes.GetN () << "\t" << nUes << "\t" << progress.nConnected << "\t"
+            << installMs << "\t" << attachMs << "\t"
+            << progress.lastConnection.GetSeconds () << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,130 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * Scenario construction time of LteHelper with one and with several
+ * component carriers.
+ *
+ * The eNB and UE devices are installed with InstallEnbDevice and
+ * InstallUeDevice, the UEs either in a single container, as a batch, or
+ * one node at a time, and the wall clock times of the installations are
+ * reported. The gap between the two UE installation modes is the cost
+ * paid once per call to InstallUeDevice rather than once per UE.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaInstallBenchmark");
+
+/**
+ * Install the devices once
+ *
+ * \param nEnbs the number of eNBs
+ * \param nUes the number of UEs
+ * \param nCcs the number of component carriers
+ * \param batched whether the UEs are installed in a single container
+ * \param enbMs the wall clock time of the eNB installation, in ms
+ * \param ueMs the wall clock time of the UE installation, in ms
+ */
+static void
+RunInstall (uint32_t nEnbs, uint32_t nUes, uint16_t nCcs, bool batched,
+            int64_t& enbMs, int64_t& ueMs)
+{
+  RngSeedManager::SetRun (1);
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseCa", BooleanValue (nCcs > 1));
+  lteHelper->SetAttribute ("NumberOfComponentCarriers", UintegerValue (nCcs));
+  if (nCcs > 1)
+    {
+      lteHelper->SetAttribute ("EnbComponentCarrierManager", StringValue ("ns3::RrComponentCarrierManager"));
+    }
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (nUes);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (500.0),
+                                 "DeltaY", DoubleValue (500.0),
+                                 "GridWidth", UintegerValue (10));
+  mobility.Install (enbNodes);
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (10.0),
+                                 "DeltaY", DoubleValue (10.0),
+                                 "GridWidth", UintegerValue (100));
+  mobility.Install (ueNodes);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  lteHelper->InstallEnbDevice (enbNodes);
+  enbMs = clock.End ();
+
+  clock.Start ();
+  if (batched)
+    {
+      lteHelper->InstallUeDevice (ueNodes);
+    }
+  else
+    {
+      for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+        {
+          lteHelper->InstallUeDevice (NodeContainer (ueNodes.Get (i)));
+        }
+    }
+  ueMs = clock.End ();
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nEnbs = 50;
+  uint32_t maxUes = 5000;
+  uint16_t maxCcs = 5;
+
+  CommandLine cmd;
+  cmd.AddValue ("nEnbs", "Number of eNBs", nEnbs);
+  cmd.AddValue ("maxUes", "Largest number of UEs", maxUes);
+  cmd.AddValue ("maxCcs", "Largest number of component carriers", maxCcs);
+  cmd.Parse (argc, argv);
+
+  std::cout << "CCs\tUEs\tinstall\teNBs[ms]\tUEs[ms]\tUE[us/UE]" << std::endl;
+  // a single carrier, then the largest number of carriers
+  for (uint16_t nCcs = 1; nCcs <= maxCcs; nCcs = (nCcs < maxCcs ? maxCcs : maxCcs + 1))
+    {
+      for (uint32_t nUes = 1000; nUes <= maxUes; nUes *= 5)
+        {
+          for (uint32_t batched = 0; batched <= 1; ++batched)
+            {
+              int64_t enbMs;
+              int64_t ueMs;
+              RunInstall (nEnbs, nUes, nCcs, batched, enbMs, ueMs);
+              std::cout << nCcs << "\t" << nUes << "\t" << (batched ? "batch" : "single") << "\t"
+                        << enbMs << "\t" << ueMs << "\t" << ueMs * 1000.0 / nUes << std::endl;
+            }
+        }
+    }
+
+  return 0;
+}
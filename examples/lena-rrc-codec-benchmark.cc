@@ -0,0 +1,308 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/lte-rrc-header.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Encode/decode throughput benchmark of the ASN.1 PER codec of the RRC
+ * messages used with the real RRC protocol (UseIdealRrc=false).
+ *
+ * Every message of lte-rrc-header.h is filled with a representative
+ * content, then encoded into a packet (SetMessage and AddHeader) and
+ * decoded from it (RemoveHeader and GetMessage) the given number of
+ * times. Before the measurement, the decoded message is encoded again
+ * and checked to give the same octets.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaRrcCodecBenchmark");
+
+static LteRrcSap::RadioResourceConfigDedicated
+CreateRadioResourceConfigDedicated (void)
+{
+  LteRrcSap::RadioResourceConfigDedicated rrcd;
+
+  LteRrcSap::LogicalChannelConfig logicalChannelConfig;
+  logicalChannelConfig.priority = 1;
+  logicalChannelConfig.prioritizedBitRateKbps = 16;
+  logicalChannelConfig.bucketSizeDurationMs = 100;
+  logicalChannelConfig.logicalChannelGroup = 1;
+
+  LteRrcSap::SrbToAddMod srbToAddMod;
+  srbToAddMod.srbIdentity = 1;
+  srbToAddMod.logicalChannelConfig = logicalChannelConfig;
+  rrcd.srbToAddModList.push_back (srbToAddMod);
+
+  for (uint8_t drbId = 1; drbId <= 2; ++drbId)
+    {
+      LteRrcSap::DrbToAddMod drbToAddMod;
+      drbToAddMod.epsBearerIdentity = drbId;
+      drbToAddMod.drbIdentity = drbId;
+      drbToAddMod.rlcConfig.choice = (drbId == 1) ? LteRrcSap::RlcConfig::AM : LteRrcSap::RlcConfig::UM_BI_DIRECTIONAL;
+      drbToAddMod.logicalChannelIdentity = drbId + 2;
+      drbToAddMod.logicalChannelConfig = logicalChannelConfig;
+      drbToAddMod.logicalChannelConfig.priority = drbId + 5;
+      rrcd.drbToAddModList.push_back (drbToAddMod);
+    }
+
+  rrcd.havePhysicalConfigDedicated = true;
+  rrcd.physicalConfigDedicated.haveSoundingRsUlConfigDedicated = true;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.type = LteRrcSap::SoundingRsUlConfigDedicated::SETUP;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsBandwidth = 0;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsConfigIndex = 12;
+  rrcd.physicalConfigDedicated.haveAntennaInfoDedicated = true;
+  rrcd.physicalConfigDedicated.antennaInfo.transmissionMode = 2;
+  rrcd.physicalConfigDedicated.havePdschConfigDedicated = true;
+  rrcd.physicalConfigDedicated.pdschConfigDedicated.pa = LteRrcSap::PdschConfigDedicated::dB0;
+  return rrcd;
+}
+
+static LteRrcSap::MeasConfig
+CreateMeasConfig (void)
+{
+  LteRrcSap::MeasConfig measConfig;
+
+  LteRrcSap::MeasObjectToAddMod measObject;
+  measObject.measObjectId = 1;
+  measObject.measObjectEutra.carrierFreq = 100;
+  measObject.measObjectEutra.allowedMeasBandwidth = 50;
+  measObject.measObjectEutra.presenceAntennaPort1 = false;
+  measObject.measObjectEutra.neighCellConfig = 0;
+  measObject.measObjectEutra.offsetFreq = 0;
+  measObject.measObjectEutra.haveCellForWhichToReportCGI = false;
+  measConfig.measObjectToAddModList.push_back (measObject);
+
+  for (uint8_t id = 1; id <= 2; ++id)
+    {
+      LteRrcSap::ReportConfigToAddMod reportConfig;
+      reportConfig.reportConfigId = id;
+      reportConfig.reportConfigEutra.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+      reportConfig.reportConfigEutra.eventId = (id == 1) ? LteRrcSap::ReportConfigEutra::EVENT_A3 : LteRrcSap::ReportConfigEutra::EVENT_A2;
+      reportConfig.reportConfigEutra.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ;
+      reportConfig.reportConfigEutra.threshold1.range = 30;
+      reportConfig.reportConfigEutra.a3Offset = 3;
+      reportConfig.reportConfigEutra.hysteresis = 2;
+      reportConfig.reportConfigEutra.timeToTrigger = 256;
+      reportConfig.reportConfigEutra.reportInterval = LteRrcSap::ReportConfigEutra::MS480;
+      measConfig.reportConfigToAddModList.push_back (reportConfig);
+
+      LteRrcSap::MeasIdToAddMod measId;
+      measId.measId = id;
+      measId.measObjectId = 1;
+      measId.reportConfigId = id;
+      measConfig.measIdToAddModList.push_back (measId);
+    }
+
+  measConfig.haveQuantityConfig = true;
+  measConfig.quantityConfig.filterCoefficientRSRP = 4;
+  measConfig.quantityConfig.filterCoefficientRSRQ = 4;
+  measConfig.haveMeasGapConfig = false;
+  measConfig.haveSmeasure = false;
+  measConfig.haveSpeedStatePars = false;
+  return measConfig;
+}
+
+/**
+ * Check the round trip of a message, then measure its encoding and
+ * decoding times
+ */
+template <class H, class M>
+static void
+RunBenchmark (std::string name, M msg, uint32_t iterations, int64_t& totalEncodeMs, int64_t& totalDecodeMs)
+{
+  H header;
+  header.SetMessage (msg);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (header);
+  uint32_t size = packet->GetSize ();
+
+  H decoded;
+  packet->PeekHeader (decoded);
+  H reencoded;
+  reencoded.SetMessage (decoded.GetMessage ());
+  Ptr<Packet> reencodedPacket = Create<Packet> ();
+  reencodedPacket->AddHeader (reencoded);
+  std::vector<uint8_t> octets (size);
+  std::vector<uint8_t> reencodedOctets (size);
+  NS_ABORT_MSG_IF (reencodedPacket->GetSize () != size, name << ": round trip changed the size");
+  packet->CopyData (&octets[0], size);
+  reencodedPacket->CopyData (&reencodedOctets[0], size);
+  NS_ABORT_MSG_IF (octets != reencodedOctets, name << ": round trip changed the encoding");
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      H h;
+      h.SetMessage (msg);
+      Ptr<Packet> p = Create<Packet> ();
+      p->AddHeader (h);
+    }
+  int64_t encodeMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      H h;
+      Ptr<Packet> p = packet->Copy ();
+      p->RemoveHeader (h);
+      M m = h.GetMessage ();
+    }
+  int64_t decodeMs = clock.End ();
+
+  totalEncodeMs += encodeMs;
+  totalDecodeMs += decodeMs;
+  std::cout << std::left << std::setw (40) << name << std::right << "\t" << size << "\t"
+            << encodeMs << "\t" << decodeMs << "\t"
+            << std::fixed << std::setprecision (0)
+            << iterations * 1000.0 / std::max (encodeMs, (int64_t) 1) << "\t"
+            << iterations * 1000.0 / std::max (decodeMs, (int64_t) 1) << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t iterations = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue ("iterations", "Number of times each message is encoded and decoded", iterations);
+  cmd.Parse (argc, argv);
+
+  int64_t totalEncodeMs = 0;
+  int64_t totalDecodeMs = 0;
+  std::cout << std::left << std::setw (40) << "message" << std::right
+            << "\tsize\tencode[ms]\tdecode[ms]\tencode[msg/s]\tdecode[msg/s]" << std::endl;
+
+  LteRrcSap::RrcConnectionRequest rrcConnectionRequest;
+  rrcConnectionRequest.ueIdentity = 0x123456789aULL;
+  RunBenchmark<RrcConnectionRequestHeader> ("RrcConnectionRequest", rrcConnectionRequest, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionSetup rrcConnectionSetup;
+  rrcConnectionSetup.rrcTransactionIdentifier = 1;
+  rrcConnectionSetup.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  RunBenchmark<RrcConnectionSetupHeader> ("RrcConnectionSetup", rrcConnectionSetup, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionSetupCompleted rrcConnectionSetupCompleted;
+  rrcConnectionSetupCompleted.rrcTransactionIdentifier = 1;
+  RunBenchmark<RrcConnectionSetupCompleteHeader> ("RrcConnectionSetupComplete", rrcConnectionSetupCompleted, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReconfiguration rrcConnectionReconfiguration;
+  rrcConnectionReconfiguration.rrcTransactionIdentifier = 2;
+  rrcConnectionReconfiguration.haveMeasConfig = true;
+  rrcConnectionReconfiguration.measConfig = CreateMeasConfig ();
+  rrcConnectionReconfiguration.haveMobilityControlInfo = true;
+  rrcConnectionReconfiguration.mobilityControlInfo.targetPhysCellId = 4;
+  rrcConnectionReconfiguration.mobilityControlInfo.haveCarrierFreq = true;
+  rrcConnectionReconfiguration.mobilityControlInfo.carrierFreq.dlCarrierFreq = 100;
+  rrcConnectionReconfiguration.mobilityControlInfo.carrierFreq.ulCarrierFreq = 18100;
+  rrcConnectionReconfiguration.mobilityControlInfo.haveCarrierBandwidth = true;
+  rrcConnectionReconfiguration.mobilityControlInfo.carrierBandwidth.dlBandwidth = 50;
+  rrcConnectionReconfiguration.mobilityControlInfo.carrierBandwidth.ulBandwidth = 50;
+  rrcConnectionReconfiguration.mobilityControlInfo.newUeIdentity = 11;
+  rrcConnectionReconfiguration.mobilityControlInfo.haveRachConfigDedicated = true;
+  rrcConnectionReconfiguration.mobilityControlInfo.rachConfigDedicated.raPreambleIndex = 2;
+  rrcConnectionReconfiguration.mobilityControlInfo.rachConfigDedicated.raPrachMaskIndex = 2;
+  rrcConnectionReconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  rrcConnectionReconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  rrcConnectionReconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  rrcConnectionReconfiguration.haveRadioResourceConfigDedicated = true;
+  rrcConnectionReconfiguration.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  rrcConnectionReconfiguration.haveNonCriticalExtension = false;
+  RunBenchmark<RrcConnectionReconfigurationHeader> ("RrcConnectionReconfiguration", rrcConnectionReconfiguration, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReconfigurationCompleted rrcConnectionReconfigurationCompleted;
+  rrcConnectionReconfigurationCompleted.rrcTransactionIdentifier = 2;
+  RunBenchmark<RrcConnectionReconfigurationCompleteHeader> ("RrcConnectionReconfigurationComplete", rrcConnectionReconfigurationCompleted, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::HandoverPreparationInfo handoverPreparationInfo;
+  handoverPreparationInfo.asConfig.sourceMeasConfig = CreateMeasConfig ();
+  handoverPreparationInfo.asConfig.sourceRadioResourceConfig = CreateRadioResourceConfigDedicated ();
+  handoverPreparationInfo.asConfig.sourceUeIdentity = 11;
+  handoverPreparationInfo.asConfig.sourceMasterInformationBlock.dlBandwidth = 50;
+  handoverPreparationInfo.asConfig.sourceMasterInformationBlock.systemFrameNumber = 1;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity = 123;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity = 5;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIndication = false;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIdentity = 0;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellSelectionInfo.qRxLevMin = -35;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellSelectionInfo.qQualMin = -20;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.pdschConfigCommon.referenceSignalPower = 30;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.pdschConfigCommon.pb = 0;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq = 18100;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.freqInfo.ulBandwidth = 50;
+  handoverPreparationInfo.asConfig.sourceDlCarrierFreq = 100;
+  RunBenchmark<HandoverPreparationInfoHeader> ("HandoverPreparationInfo", handoverPreparationInfo, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReestablishmentRequest rrcConnectionReestablishmentRequest;
+  rrcConnectionReestablishmentRequest.ueIdentity.cRnti = 7;
+  rrcConnectionReestablishmentRequest.ueIdentity.physCellId = 2;
+  rrcConnectionReestablishmentRequest.reestablishmentCause = LteRrcSap::HANDOVER_FAILURE;
+  RunBenchmark<RrcConnectionReestablishmentRequestHeader> ("RrcConnectionReestablishmentRequest", rrcConnectionReestablishmentRequest, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReestablishment rrcConnectionReestablishment;
+  rrcConnectionReestablishment.rrcTransactionIdentifier = 3;
+  rrcConnectionReestablishment.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  RunBenchmark<RrcConnectionReestablishmentHeader> ("RrcConnectionReestablishment", rrcConnectionReestablishment, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReestablishmentComplete rrcConnectionReestablishmentComplete;
+  rrcConnectionReestablishmentComplete.rrcTransactionIdentifier = 3;
+  RunBenchmark<RrcConnectionReestablishmentCompleteHeader> ("RrcConnectionReestablishmentComplete", rrcConnectionReestablishmentComplete, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReestablishmentReject rrcConnectionReestablishmentReject;
+  RunBenchmark<RrcConnectionReestablishmentRejectHeader> ("RrcConnectionReestablishmentReject", rrcConnectionReestablishmentReject, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionRelease rrcConnectionRelease;
+  rrcConnectionRelease.rrcTransactionIdentifier = 1;
+  RunBenchmark<RrcConnectionReleaseHeader> ("RrcConnectionRelease", rrcConnectionRelease, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::RrcConnectionReject rrcConnectionReject;
+  rrcConnectionReject.waitTime = 2;
+  RunBenchmark<RrcConnectionRejectHeader> ("RrcConnectionReject", rrcConnectionReject, iterations, totalEncodeMs, totalDecodeMs);
+
+  LteRrcSap::MeasurementReport measurementReport;
+  measurementReport.measResults.measId = 1;
+  measurementReport.measResults.rsrpResult = 60;
+  measurementReport.measResults.rsrqResult = 20;
+  measurementReport.measResults.haveMeasResultNeighCells = true;
+  for (uint16_t physCellId = 2; physCellId <= 5; ++physCellId)
+    {
+      LteRrcSap::MeasResultEutra measResultEutra;
+      measResultEutra.physCellId = physCellId;
+      measResultEutra.haveCgiInfo = false;
+      measResultEutra.haveRsrpResult = true;
+      measResultEutra.rsrpResult = 50 - physCellId;
+      measResultEutra.haveRsrqResult = true;
+      measResultEutra.rsrqResult = 18 - physCellId;
+      measurementReport.measResults.measResultListEutra.push_back (measResultEutra);
+    }
+  RunBenchmark<MeasurementReportHeader> ("MeasurementReport", measurementReport, iterations, totalEncodeMs, totalDecodeMs);
+
+  std::cout << std::left << std::setw (40) << "total" << std::right << "\t-\t"
+            << totalEncodeMs << "\t" << totalDecodeMs << std::endl;
+
+  return 0;
+}
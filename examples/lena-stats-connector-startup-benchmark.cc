@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+/**
+ * Startup time of a mass attach with the RLC and PDCP statistics enabled.
+ *
+ * The UEs are attached to the closest eNB at the start of the
+ * simulation, with a data radio bearer each, and the simulation runs
+ * until every UE has established its RRC connection. For every
+ * connection setup and reconfiguration, the RadioBearerStatsConnector
+ * hooks the statistics calculators to the RLC and PDCP entities of the
+ * UE and of its UE manager at the eNB. The run is repeated for 1000,
+ * 5000 and 10000 UEs, and with the statistics disabled as a reference;
+ * the wall clock times of the installation and of the attach are
+ * reported.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaStatsConnectorStartupBenchmark");
+
+/// Progress of the connection establishment
+struct AttachProgress
+{
+  uint32_t nUes; ///< number of UEs
+  uint32_t nConnected; ///< number of UEs that established their connection
+};
+
+/**
+ * Trace sink of the ConnectionEstablished trace source of the UE RRC,
+ * stopping the simulation when all the UEs are connected
+ *
+ * \param progress the progress of the connection establishment
+ * \param imsi the IMSI
+ * \param cellId the cell ID
+ * \param rnti the RNTI
+ */
+static void
+ConnectionEstablished (AttachProgress* progress, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  if (++progress->nConnected == progress->nUes)
+    {
+      Simulator::Stop ();
+    }
+}
+
+/**
+ * Simulate the attach once
+ *
+ * \param nUes the number of UEs
+ * \param nEnbsPerSide the number of eNBs on each side of the grid
+ * \param distance the distance between the eNBs
+ * \param maxSimTime the simulated time after which the attach is given up
+ * \param stats whether the RLC and PDCP statistics are enabled
+ * \param installMs the wall clock time of the installation, in ms
+ * \param attachMs the wall clock time of the attach, in ms
+ * \return the number of connected UEs
+ */
+static uint32_t
+RunAttach (uint32_t nUes, uint32_t nEnbsPerSide, double distance, Time maxSimTime, bool stats,
+           int64_t& installMs, int64_t& attachMs)
+{
+  RngSeedManager::SetRun (1);
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("UseIdealRrc", BooleanValue (true));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (nEnbsPerSide * nEnbsPerSide);
+  NodeContainer ueNodes;
+  ueNodes.Create (nUes);
+
+  Ptr<ListPositionAllocator> enbPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      enbPositions->Add (Vector ((i % nEnbsPerSide) * distance, (i / nEnbsPerSide) * distance, 30.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (enbPositions);
+  mobility.Install (enbNodes);
+
+  Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable> ();
+  position->SetAttribute ("Min", DoubleValue (-distance / 2));
+  position->SetAttribute ("Max", DoubleValue ((nEnbsPerSide - 0.5) * distance));
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nUes; ++i)
+    {
+      uePositions->Add (Vector (position->GetValue (), position->GetValue (), 1.5));
+    }
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+  if (stats)
+    {
+      lteHelper->EnableRlcTraces ();
+      lteHelper->EnablePdcpTraces ();
+    }
+
+  AttachProgress progress;
+  progress.nUes = nUes;
+  progress.nConnected = 0;
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<LteUeRrc> rrc = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ();
+      rrc->TraceConnectWithoutContext ("ConnectionEstablished",
+                                       MakeBoundCallback (&ConnectionEstablished, &progress));
+    }
+  installMs = clock.End ();
+
+  Simulator::Stop (maxSimTime);
+  clock.Start ();
+  Simulator::Run ();
+  attachMs = clock.End ();
+  Simulator::Destroy ();
+  return progress.nConnected;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nEnbsPerSide = 6;
+  double distance = 500.0;
+  double maxSimTime = 10.0;
+  uint32_t maxUes = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue ("nEnbsPerSide", "Number of eNBs on each side of the grid", nEnbsPerSide);
+  cmd.AddValue ("distance", "Distance between the eNBs [m]", distance);
+  cmd.AddValue ("maxSimTime", "Simulated time after which the attach is given up [s]", maxSimTime);
+  cmd.AddValue ("maxUes", "Largest number of UEs", maxUes);
+  cmd.Parse (argc, argv);
+
+  // an SRS periodicity allowing up to 320 UEs per cell
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue (320));
+
+  const uint32_t ueCounts[] = { 1000, 5000, 10000 };
+  std::cout << "UEs\tstats\tconnected\tinstall[ms]\tattach[ms]" << std::endl;
+  for (uint32_t c = 0; c < sizeof (ueCounts) / sizeof (ueCounts[0]) && ueCounts[c] <= maxUes; ++c)
+    {
+      for (uint32_t stats = 0; stats <= 1; ++stats)
+        {
+          int64_t installMs;
+          int64_t attachMs;
+          uint32_t nConnected = RunAttach (ueCounts[c], nEnbsPerSide, distance, Seconds (maxSimTime),
+                                           stats, installMs, attachMs);
+          std::cout << ueCounts[c] << "\t" << (stats ? "on" : "off") << "\t" << nConnected << "\t"
+                    << installMs << "\t" << attachMs << std::endl;
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Benchmark of EpcTftClassifier::Classify with 1 to 16 bearers per UE.
+ *
+ * Every bearer but the default one has a TFT made of a remote port
+ * range and a local port; the packets are spread uniformly over all
+ * the bearers. The compiled classifier is compared against the
+ * reference classification (packet copy, header removal and
+ * EpcTft::Matches over all the TFTs), and the results of the two are
+ * checked to be the same.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaTftClassifierBenchmark");
+
+static uint32_t
+ClassifyReference (const std::map<uint32_t, Ptr<EpcTft> >& tftMap, Ptr<Packet> p, EpcTft::Direction direction)
+{
+  Ptr<Packet> pCopy = p->Copy ();
+  Ipv4Header ipv4Header;
+  pCopy->RemoveHeader (ipv4Header);
+  UdpHeader udpHeader;
+  pCopy->RemoveHeader (udpHeader);
+  NS_ASSERT (direction == EpcTft::DOWNLINK);
+  for (std::map<uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = tftMap.rbegin ();
+       it != tftMap.rend ();
+       ++it)
+    {
+      if (it->second->Matches (direction, ipv4Header.GetSource (), ipv4Header.GetDestination (),
+                               udpHeader.GetSourcePort (), udpHeader.GetDestinationPort (),
+                               ipv4Header.GetTos ()))
+        {
+          return it->first;
+        }
+    }
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numPackets = 1000000;
+  uint32_t maxBearers = 16;
+
+  CommandLine cmd;
+  cmd.AddValue ("numPackets", "Number of packets classified for each number of bearers", numPackets);
+  cmd.AddValue ("maxBearers", "Max number of bearers per UE (up to 16)", maxBearers);
+  cmd.Parse (argc, argv);
+  NS_ABORT_MSG_IF (maxBearers < 1 || maxBearers > 16, "maxBearers must be between 1 and 16");
+
+  Ipv4Address ueAddress ("7.0.0.2");
+  Ipv4Address remoteAddress ("1.0.0.2");
+
+  std::cout << "bearers\treference[ms]\tcompiled[ms]\tspeedup" << std::endl;
+  for (uint32_t numBearers = 1; numBearers <= maxBearers; ++numBearers)
+    {
+      EpcTftClassifier classifier;
+      std::map<uint32_t, Ptr<EpcTft> > tftMap;
+      Ptr<EpcTft> defaultTft = EpcTft::Default ();
+      classifier.Add (defaultTft, 1);
+      tftMap[1] = defaultTft;
+      for (uint32_t b = 2; b <= numBearers; ++b)
+        {
+          Ptr<EpcTft> tft = Create<EpcTft> ();
+          EpcTft::PacketFilter pf;
+          pf.remoteAddress = remoteAddress;
+          pf.remoteMask = Ipv4Mask ("255.255.255.255");
+          pf.remotePortStart = 1000 * b;
+          pf.remotePortEnd = 1000 * b + 499;
+          pf.localPortStart = 2000 + b;
+          pf.localPortEnd = 2000 + b;
+          tft->Add (pf);
+          classifier.Add (tft, b);
+          tftMap[b] = tft;
+        }
+
+      // one packet template per bearer
+      std::vector<Ptr<Packet> > packets;
+      for (uint32_t b = 1; b <= numBearers; ++b)
+        {
+          Ptr<Packet> p = Create<Packet> (1000);
+          UdpHeader udpHeader;
+          udpHeader.SetSourcePort (1000 * b + b);
+          udpHeader.SetDestinationPort (2000 + b);
+          p->AddHeader (udpHeader);
+          Ipv4Header ipv4Header;
+          ipv4Header.SetSource (remoteAddress);
+          ipv4Header.SetDestination (ueAddress);
+          ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+          ipv4Header.SetPayloadSize (p->GetSize ());
+          p->AddHeader (ipv4Header);
+          packets.push_back (p);
+        }
+
+      for (uint32_t i = 0; i < packets.size (); ++i)
+        {
+          uint32_t reference = ClassifyReference (tftMap, packets[i], EpcTft::DOWNLINK);
+          uint32_t compiled = classifier.Classify (packets[i], EpcTft::DOWNLINK);
+          NS_ABORT_MSG_IF (reference != compiled, "mismatch: reference=" << reference << " compiled=" << compiled);
+        }
+
+      uint64_t check = 0;
+      SystemWallClockMs clock;
+      clock.Start ();
+      for (uint32_t i = 0; i < numPackets; ++i)
+        {
+          check += ClassifyReference (tftMap, packets[i % numBearers], EpcTft::DOWNLINK);
+        }
+      int64_t referenceMs = clock.End ();
+
+      clock.Start ();
+      for (uint32_t i = 0; i < numPackets; ++i)
+        {
+          check -= classifier.Classify (packets[i % numBearers], EpcTft::DOWNLINK);
+        }
+      int64_t compiledMs = clock.End ();
+      NS_ABORT_MSG_IF (check != 0, "reference and compiled classification differ");
+
+      std::cout << numBearers << "\t" << referenceMs << "\t" << compiledMs << "\t"
+                << std::fixed << std::setprecision (2)
+                << (double) referenceMs / std::max (compiledMs, (int64_t) 1) << std::endl;
+    }
+
+  return 0;
+}
@@ -0,0 +1,249 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/lte-ue-meas-table.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Benchmark of the storage and layer 3 filtering of the UE measurements
+ * and of the evaluation of the entering condition of event A3, as done
+ * by LteUeRrc every 200 ms for each UE.
+ *
+ * Each UE measures the serving cell and the given number of neighbour
+ * cells, whose RSRP is a random mean plus a normal fading. Every
+ * period, the batch of measurements of each UE is saved and the
+ * neighbours fulfilling Mn - Hys > Mp + Off are looked up, both with
+ * LteUeMeasTable and with a reference implementation keeping the cells
+ * in a std::map and scanning all of them. The two must find the same cells.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaUeMeasurementBenchmark");
+
+/// Reference implementation: filtered values in a map, full scan
+class MapMeasurements
+{
+public:
+  /// Filtered values of a cell
+  struct MeasValues
+  {
+    double rsrp; ///< filtered RSRP in dBm
+    double rsrq; ///< filtered RSRQ in dB
+  };
+
+  /**
+   * \param measurements the batch of measurements
+   * \param a the filter coefficient
+   */
+  void Update (const std::vector<LteUeCphySapUser::UeMeasurementsElement>& measurements, double a)
+  {
+    for (std::vector<LteUeCphySapUser::UeMeasurementsElement>::const_iterator it = measurements.begin ();
+         it != measurements.end (); ++it)
+      {
+        std::map<uint16_t, MeasValues>::iterator storedIt = m_stored.find (it->m_cellId);
+        if (storedIt == m_stored.end ())
+          {
+            MeasValues v;
+            v.rsrp = it->m_rsrp;
+            v.rsrq = it->m_rsrq;
+            m_stored[it->m_cellId] = v;
+          }
+        else
+          {
+            storedIt->second.rsrp = (1 - a) * storedIt->second.rsrp + a * it->m_rsrp;
+            storedIt->second.rsrq = (1 - a) * storedIt->second.rsrq + a * it->m_rsrq;
+          }
+      }
+  }
+
+  /**
+   * \param servingCellId the serving cell
+   * \param thresh the threshold above the serving cell RSRP
+   * \param cells the neighbour cells fulfilling the condition
+   */
+  void FindEntering (uint16_t servingCellId, double thresh, std::vector<uint16_t>& cells)
+  {
+    double mp = m_stored[servingCellId].rsrp;
+    for (std::map<uint16_t, MeasValues>::const_iterator it = m_stored.begin ();
+         it != m_stored.end (); ++it)
+      {
+        if (it->first != servingCellId && it->second.rsrp > mp + thresh)
+          {
+            cells.push_back (it->first);
+          }
+      }
+  }
+
+private:
+  std::map<uint16_t, MeasValues> m_stored; ///< filtered values per cell
+};
+
+/**
+ * \param table the measurement table
+ * \param servingCellId the serving cell
+ * \param thresh the threshold above the serving cell RSRP
+ * \param cells the neighbour cells fulfilling the condition
+ */
+static void
+FindEntering (LteUeMeasTable& table, uint16_t servingCellId, double thresh, std::vector<uint16_t>& cells)
+{
+  double mp = table.GetValue (table.FindRow (servingCellId), LteUeMeasTable::RSRP);
+  const std::vector<uint32_t>& sortedRows = table.GetSortedRows (LteUeMeasTable::RSRP);
+  uint32_t n = table.CountAbove (LteUeMeasTable::RSRP, mp + thresh);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      uint16_t cellId = table.GetCellId (sortedRows[i]);
+      if (cellId != servingCellId)
+        {
+          cells.push_back (cellId);
+        }
+    }
+}
+
+/**
+ * Run the benchmark for one deployment
+ *
+ * \param nUes the number of UEs
+ * \param nNeighbours the number of neighbour cells measured by each UE
+ * \param nPeriods the number of measurement periods
+ */
+static void
+RunBenchmark (uint32_t nUes, uint32_t nNeighbours, uint32_t nPeriods)
+{
+  const double a = 0.5; // filterCoefficient fc4
+  const double thresh = 3.0; // a3Offset + hysteresis in dB
+  const uint16_t nCells = 512;
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  Ptr<NormalRandomVariable> fading = CreateObject<NormalRandomVariable> ();
+  fading->SetAttribute ("Variance", DoubleValue (4.0));
+
+  // cells measured by each UE, the first one is the serving cell
+  std::vector<std::vector<LteUeCphySapUser::UeMeasurementsElement> > batches (nUes);
+  for (uint32_t u = 0; u < nUes; ++u)
+    {
+      uint16_t firstCell = uniform->GetInteger (1, nCells);
+      for (uint32_t c = 0; c <= nNeighbours; ++c)
+        {
+          LteUeCphySapUser::UeMeasurementsElement e;
+          e.m_cellId = (firstCell + c) % nCells + 1;
+          e.m_rsrp = (c == 0) ? -80.0 : uniform->GetValue (-120.0, -75.0);
+          e.m_rsrq = -10.0;
+          batches[u].push_back (e);
+        }
+    }
+  // pre-generate a cycle of samples, so that both implementations are
+  // timed on the same input and without the random number generation
+  const uint32_t nSamplePeriods = std::min (nPeriods, (uint32_t) 16);
+  std::vector<std::vector<std::vector<LteUeCphySapUser::UeMeasurementsElement> > > samples (nSamplePeriods, batches);
+  for (uint32_t p = 0; p < nSamplePeriods; ++p)
+    {
+      for (uint32_t u = 0; u < nUes; ++u)
+        {
+          for (uint32_t c = 0; c <= nNeighbours; ++c)
+            {
+              LteUeCphySapUser::UeMeasurementsElement& e = samples[p][u][c];
+              e.m_rsrp += fading->GetValue ();
+              e.m_rsrq += fading->GetValue () / 4;
+            }
+        }
+    }
+
+  std::vector<MapMeasurements> maps (nUes);
+  std::vector<LteUeMeasTable> tables (nUes);
+  std::vector<uint16_t> cells;
+  uint64_t mapEntering = 0;
+  uint64_t tableEntering = 0;
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t p = 0; p < nPeriods; ++p)
+    {
+      for (uint32_t u = 0; u < nUes; ++u)
+        {
+          maps[u].Update (samples[p % nSamplePeriods][u], a);
+          cells.clear ();
+          maps[u].FindEntering (samples[p % nSamplePeriods][u][0].m_cellId, thresh, cells);
+          mapEntering += cells.size ();
+        }
+    }
+  int64_t mapMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t p = 0; p < nPeriods; ++p)
+    {
+      for (uint32_t u = 0; u < nUes; ++u)
+        {
+          tables[u].Update (samples[p % nSamplePeriods][u], true, a, a);
+          cells.clear ();
+          FindEntering (tables[u], samples[p % nSamplePeriods][u][0].m_cellId, thresh, cells);
+          tableEntering += cells.size ();
+        }
+    }
+  int64_t tableMs = clock.End ();
+
+  // check that both end up with the same cells
+  for (uint32_t u = 0; u < nUes; ++u)
+    {
+      std::vector<uint16_t> mapCells;
+      std::vector<uint16_t> tableCells;
+      maps[u].FindEntering (samples[0][u][0].m_cellId, thresh, mapCells);
+      FindEntering (tables[u], samples[0][u][0].m_cellId, thresh, tableCells);
+      std::sort (tableCells.begin (), tableCells.end ());
+      NS_ABORT_MSG_IF (mapCells != tableCells, "UE " << u << ": the implementations disagree");
+    }
+  NS_ABORT_MSG_IF (mapEntering != tableEntering, "the implementations disagree");
+
+  double evaluations = (double) nUes * nPeriods;
+  std::cout << nUes << "\t" << nNeighbours << "\t"
+            << mapMs << "\t" << tableMs << "\t"
+            << std::fixed << std::setprecision (0)
+            << evaluations * 1000.0 / std::max (mapMs, (int64_t) 1) << "\t"
+            << evaluations * 1000.0 / std::max (tableMs, (int64_t) 1) << "\t"
+            << std::setprecision (2) << (double) tableEntering / evaluations << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nPeriods = 100;
+  uint32_t maxUes = 1000;
+  uint32_t maxNeighbours = 128;
+
+  CommandLine cmd;
+  cmd.AddValue ("periods", "Number of measurement periods (200 ms each)", nPeriods);
+  cmd.AddValue ("maxUes", "Largest number of UEs", maxUes);
+  cmd.AddValue ("maxNeighbours", "Largest number of neighbour cells per UE", maxNeighbours);
+  cmd.Parse (argc, argv);
+
+  std::cout << "UEs\tneighbours\tmap[ms]\ttable[ms]\tmap[eval/s]\ttable[eval/s]\tentering/eval" << std::endl;
+  for (uint32_t nUes = 100; nUes <= maxUes; nUes *= 10)
+    {
+      for (uint32_t nNeighbours = 8; nNeighbours <= maxNeighbours; nNeighbours *= 2)
+        {
+          RunBenchmark (nUes, nNeighbours, nPeriods);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Runtime of a multi-cell scenario with full buffer uplink traffic,
+ * where the eNBs receive the PUSCH and SRS signals of all the UEs of
+ * all the cells.
+ *
+ * The sectors of a hexagonal grid of three-sector sites each serve the
+ * given number of static UEs with closed loop uplink power control.
+ * The scenario is run twice: first with the contributions of the UEs to
+ * the UL interference of the eNBs not cached
+ * (ns3::LteInterference::CacheContributions = false), which is the
+ * reference, then with them cached. Every SRS SINR and PUSCH
+ * interference sample of the second run is checked against the one of
+ * the reference, and the program aborts if any of them differs by more
+ * than the given relative tolerance. The wall clock time of both runs
+ * is reported.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaUlInterferenceBenchmark");
+
+/// UL measurements of the eNBs, in the order in which they are reported
+struct UlSamples
+{
+  std::vector<int64_t> sinrTimes; ///< the time of each SRS SINR sample [ns]
+  std::vector<uint16_t> sinrRntis; ///< the RNTI of each SRS SINR sample
+  std::vector<double> sinrs; ///< the linear SRS SINR samples
+  std::vector<int64_t> interferenceTimes; ///< the time of each PUSCH interference sample [ns]
+  std::vector<double> interferences; ///< the average PUSCH interference samples [W/Hz]
+};
+
+/**
+ * Trace sink of the ReportUeSinr trace source of an eNB PHY
+ *
+ * \param samples the UL measurements
+ * \param cellId the cell ID
+ * \param rnti the RNTI of the UE
+ * \param sinrLinear the average linear SINR of the SRS
+ */
+static void
+ReportUeSinr (UlSamples* samples, uint16_t cellId, uint16_t rnti, double sinrLinear)
+{
+  samples->sinrTimes.push_back (Simulator::Now ().GetNanoSeconds ());
+  samples->sinrRntis.push_back (rnti);
+  samples->sinrs.push_back (sinrLinear);
+}
+
+/**
+ * Trace sink of the ReportInterference trace source of an eNB PHY
+ *
+ * \param samples the UL measurements
+ * \param cellId the cell ID
+ * \param interference the interference PSD of the PUSCH
+ */
+static void
+ReportInterference (UlSamples* samples, uint16_t cellId, Ptr<SpectrumValue> interference)
+{
+  samples->interferenceTimes.push_back (Simulator::Now ().GetNanoSeconds ());
+  samples->interferences.push_back (Sum (*interference) / interference->GetSpectrumModel ()->GetNumBands ());
+}
+
+/**
+ * Run the scenario once
+ *
+ * \param cacheContributions the value of ns3::LteInterference::CacheContributions
+ * \param nSites the number of three-sector sites
+ * \param nUesPerCell the number of UEs of each sector
+ * \param interSiteDistance the distance between the sites [m]
+ * \param simTime the simulated time [s]
+ * \param samples the UL measurements of the run
+ * \return the wall clock time of the simulation [ms]
+ */
+static int64_t
+RunScenario (bool cacheContributions, uint32_t nSites, uint32_t nUesPerCell,
+             double interSiteDistance, double simTime, UlSamples* samples)
+{
+  Config::SetDefault ("ns3::LteInterference::CacheContributions", BooleanValue (cacheContributions));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::LogDistancePropagationLossModel"));
+  lteHelper->SetEnbAntennaModelType ("ns3::ParabolicAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (70));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (3 * nSites);
+  NodeContainer ueNodes;
+  ueNodes.Create (enbNodes.GetN () * nUesPerCell);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  Ptr<LteHexGridEnbTopologyHelper> topologyHelper = CreateObject<LteHexGridEnbTopologyHelper> ();
+  topologyHelper->SetLteHelper (lteHelper);
+  topologyHelper->SetAttribute ("InterSiteDistance", DoubleValue (interSiteDistance));
+  topologyHelper->SetAttribute ("MinX", DoubleValue (interSiteDistance / 2));
+  topologyHelper->SetAttribute ("GridWidth", UintegerValue (3));
+  NetDeviceContainer enbDevs = topologyHelper->SetPositionAndInstallEnbDevice (enbNodes);
+
+  // the UEs in the box enclosing the sites, at the same positions in
+  // both runs
+  Vector minPosition = enbNodes.Get (0)->GetObject<MobilityModel> ()->GetPosition ();
+  Vector maxPosition = minPosition;
+  for (uint32_t i = 1; i < enbNodes.GetN (); ++i)
+    {
+      Vector position = enbNodes.Get (i)->GetObject<MobilityModel> ()->GetPosition ();
+      minPosition.x = std::min (minPosition.x, position.x);
+      minPosition.y = std::min (minPosition.y, position.y);
+      maxPosition.x = std::max (maxPosition.x, position.x);
+      maxPosition.y = std::max (maxPosition.y, position.y);
+    }
+  Ptr<UniformRandomVariable> xVariable = CreateObject<UniformRandomVariable> ();
+  xVariable->SetAttribute ("Min", DoubleValue (minPosition.x));
+  xVariable->SetAttribute ("Max", DoubleValue (maxPosition.x));
+  xVariable->SetStream (0);
+  Ptr<UniformRandomVariable> yVariable = CreateObject<UniformRandomVariable> ();
+  yVariable->SetAttribute ("Min", DoubleValue (minPosition.y));
+  yVariable->SetAttribute ("Max", DoubleValue (maxPosition.y));
+  yVariable->SetStream (1);
+  Ptr<ConstantRandomVariable> zVariable = CreateObject<ConstantRandomVariable> ();
+  zVariable->SetAttribute ("Constant", DoubleValue (1.5));
+  Ptr<RandomBoxPositionAllocator> uePositions = CreateObject<RandomBoxPositionAllocator> ();
+  uePositions->SetAttribute ("X", PointerValue (xVariable));
+  uePositions->SetAttribute ("Y", PointerValue (yVariable));
+  uePositions->SetAttribute ("Z", PointerValue (zVariable));
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  int64_t stream = 2;
+  stream += lteHelper->AssignStreams (enbDevs, stream);
+  lteHelper->AssignStreams (ueDevs, stream);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  for (uint32_t i = 0; i < enbDevs.GetN (); ++i)
+    {
+      Ptr<LteEnbPhy> phy = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ()->GetPhy ();
+      phy->TraceConnectWithoutContext ("ReportUeSinr", MakeBoundCallback (&ReportUeSinr, samples));
+      phy->TraceConnectWithoutContext ("ReportInterference", MakeBoundCallback (&ReportInterference, samples));
+    }
+
+  Simulator::Stop (Seconds (simTime));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsedMs = clock.End ();
+  Simulator::Destroy ();
+  return elapsedMs;
+}
+
+/**
+ * Abort if two samples differ by more than a relative tolerance
+ *
+ * \param name the name of the samples
+ * \param index the index of the samples
+ * \param reference the sample of the reference run
+ * \param value the sample of the run under test
+ * \param tolerance the relative tolerance
+ */
+static void
+CheckSample (const std::string& name, std::size_t index, double reference, double value, double tolerance)
+{
+  double error = std::fabs (value - reference);
+  NS_ABORT_MSG_IF (error > tolerance * std::max (std::fabs (reference), std::fabs (value)),
+                   name << " sample " << index << " is " << std::setprecision (17) << value
+                        << " instead of " << reference);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nSites = 19;
+  uint32_t nUesPerCell = 20;
+  double interSiteDistance = 500.0;
+  double simTime = 1.0;
+  double tolerance = 1e-6;
+
+  CommandLine cmd;
+  cmd.AddValue ("nSites", "Number of three-sector sites", nSites);
+  cmd.AddValue ("nUesPerCell", "Number of UEs of each sector", nUesPerCell);
+  cmd.AddValue ("interSiteDistance", "Distance between the sites [m]", interSiteDistance);
+  cmd.AddValue ("simTime", "Simulated time [s]", simTime);
+  cmd.AddValue ("tolerance", "Relative tolerance of the check of the samples against the reference", tolerance);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::LteUePhy::EnableUplinkPowerControl", BooleanValue (true));
+  Config::SetDefault ("ns3::LteUePowerControl::ClosedLoop", BooleanValue (true));
+  Config::SetDefault ("ns3::LteEnbPhy::UeSinrSamplePeriod", UintegerValue (1));
+  Config::SetDefault ("ns3::LteEnbPhy::InterferenceSamplePeriod", UintegerValue (1));
+
+  UlSamples reference;
+  int64_t referenceMs = RunScenario (false, nSites, nUesPerCell, interSiteDistance, simTime, &reference);
+  UlSamples cached;
+  int64_t cachedMs = RunScenario (true, nSites, nUesPerCell, interSiteDistance, simTime, &cached);
+
+  // the interference model changes only how the total is computed, so
+  // the samples must be the same, up to the rounding errors of the sums
+  NS_ABORT_MSG_IF (cached.sinrs.size () != reference.sinrs.size (),
+                   cached.sinrs.size () << " SRS SINR samples instead of " << reference.sinrs.size ());
+  NS_ABORT_MSG_IF (cached.interferences.size () != reference.interferences.size (),
+                   cached.interferences.size () << " PUSCH interference samples instead of "
+                                                << reference.interferences.size ());
+  for (std::size_t i = 0; i < reference.sinrs.size (); ++i)
+    {
+      NS_ABORT_MSG_IF (cached.sinrTimes[i] != reference.sinrTimes[i] || cached.sinrRntis[i] != reference.sinrRntis[i],
+                       "SRS SINR sample " << i << " is of RNTI " << cached.sinrRntis[i] << " at " << cached.sinrTimes[i]
+                                          << " ns instead of RNTI " << reference.sinrRntis[i] << " at " << reference.sinrTimes[i] << " ns");
+      CheckSample ("SRS SINR", i, reference.sinrs[i], cached.sinrs[i], tolerance);
+    }
+  for (std::size_t i = 0; i < reference.interferences.size (); ++i)
+    {
+      NS_ABORT_MSG_IF (cached.interferenceTimes[i] != reference.interferenceTimes[i],
+                       "PUSCH interference sample " << i << " is at " << cached.interferenceTimes[i]
+                                                    << " ns instead of " << reference.interferenceTimes[i] << " ns");
+      CheckSample ("PUSCH interference", i, reference.interferences[i], cached.interferences[i], tolerance);
+    }
+
+  std::cout << "cells\tUEs\tSRS SINR samples\tPUSCH interference samples\treference[ms]\tcached[ms]" << std::endl;
+  std::cout << 3 * nSites << "\t" << 3 * nSites * nUesPerCell << "\t"
+            << reference.sinrs.size () << "\t" << reference.interferences.size () << "\t"
+            << referenceMs << "\t" << cachedMs << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+
+#include <iomanip>
+
+using namespace ns3;
+
+/**
+ * Cost per subframe of the uplink power control of many UEs.
+ *
+ * Every subframe, each UE receives a TPC command and computes the power
+ * of its PUSCH transmission, as done by LteUePhy for a UE with an UL
+ * grant; every 40 subframes it gets a new RSRP measurement and every 80
+ * subframes it computes the power of its SRS over the whole bandwidth.
+ * The time per subframe is reported for a doubling number of UEs, with
+ * the mean computed power as a check that the results did not change.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaUlPowerControlBenchmark");
+
+/**
+ * Run the benchmark for one number of UEs
+ *
+ * \param nUes the number of UEs transmitting every subframe
+ * \param nSubframes the number of simulated subframes
+ * \param ulBandwidth the UL bandwidth in RBs
+ */
+static void
+RunBenchmark (uint32_t nUes, uint32_t nSubframes, uint16_t ulBandwidth)
+{
+  std::vector<Ptr<LteUePowerControl> > powerControls;
+  for (uint32_t i = 0; i < nUes; ++i)
+    {
+      Ptr<LteUePowerControl> powerControl = CreateObject<LteUePowerControl> ();
+      powerControl->ConfigureReferenceSignalPower (30);
+      powerControl->SetCellId (1);
+      powerControl->SetRnti (i + 1);
+      powerControls.push_back (powerControl);
+    }
+
+  // the RBs of a PUSCH grant, and the whole bandwidth for the SRS
+  std::vector<int> puschRbs;
+  for (int i = 0; i < 6; ++i)
+    {
+      puschRbs.push_back (i);
+    }
+  std::vector<int> srsRbs;
+  for (int i = 0; i < ulBandwidth; ++i)
+    {
+      srsRbs.push_back (i);
+    }
+
+  double totalPower = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t sf = 0; sf < nSubframes; ++sf)
+    {
+      for (uint32_t i = 0; i < nUes; ++i)
+        {
+          Ptr<LteUePowerControl> powerControl = powerControls[i];
+          if ((sf + i) % 40 == 0)
+            {
+              powerControl->SetRsrp (-70.0 - (i % 50));
+            }
+          powerControl->ReportTpc ((sf + 3 * i) % 4);
+          totalPower += powerControl->GetPuschTxPower (puschRbs);
+          if ((sf + i) % 80 == 0)
+            {
+              totalPower += powerControl->GetSrsTxPower (srsRbs);
+            }
+        }
+    }
+  int64_t elapsedMs = clock.End ();
+
+  std::cout << nUes << "\t" << elapsedMs << "\t" << std::fixed << std::setprecision (2)
+            << elapsedMs * 1000.0 / nSubframes << "\t" << totalPower / nSubframes / nUes << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nSubframes = 1000;
+  uint32_t maxUes = 8000;
+  uint16_t ulBandwidth = 100;
+
+  CommandLine cmd;
+  cmd.AddValue ("subframes", "Number of simulated subframes", nSubframes);
+  cmd.AddValue ("maxUes", "Largest number of UEs", maxUes);
+  cmd.AddValue ("ulBandwidth", "UL bandwidth in RBs", ulBandwidth);
+  cmd.Parse (argc, argv);
+
+  std::cout << "UEs\ttotal[ms]\tsubframe[us]\tmeanPower[dBm]" << std::endl;
+  for (uint32_t nUes = 125; nUes <= maxUes; nUes *= 2)
+    {
+      RunBenchmark (nUes, nSubframes, ulBandwidth);
+    }
+
+  return 0;
+}
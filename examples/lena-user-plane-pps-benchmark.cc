@@ -0,0 +1,205 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <list>
+
+using namespace ns3;
+
+/**
+ * Packets-per-second benchmark of the PDCP/RLC user plane.
+ *
+ * A transmitting PDCP/RLC pair is connected to a receiving RLC/PDCP
+ * pair through a MAC that just queues the RLC PDUs and hands them to
+ * the peer at the end of each TTI. Every TTI a burst of SDUs is given
+ * to the transmitting PDCP, and each side gets transmission
+ * opportunities until it reports an empty buffer, so STATUS PDUs flow
+ * back when RLC AM is used. The wall clock time needed to deliver all
+ * the SDUs is reported for RLC UM and RLC AM.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaUserPlanePpsBenchmark");
+
+/**
+ * MAC queuing the PDUs of one RLC entity, and keeping its last buffer
+ * status report
+ */
+class BenchmarkMac : public LteMacSapProvider
+{
+public:
+  BenchmarkMac ()
+    : m_numTxPdus (0),
+      m_pendingBytes (0)
+  {
+  }
+
+  virtual void TransmitPdu (TransmitPduParameters params)
+  {
+    m_pdus.push_back (params.pdu);
+    ++m_numTxPdus;
+  }
+
+  virtual void ReportBufferStatus (ReportBufferStatusParameters params)
+  {
+    m_pendingBytes = params.txQueueSize + params.retxQueueSize + params.statusPduSize;
+  }
+
+  std::list<Ptr<Packet> > m_pdus;
+  uint64_t m_numTxPdus;
+  uint32_t m_pendingBytes;
+};
+
+/// PDCP SAP user counting the received SDUs
+class BenchmarkPdcpSapUser : public LtePdcpSapUser
+{
+public:
+  BenchmarkPdcpSapUser ()
+    : m_rxSdus (0)
+  {
+  }
+
+  virtual void ReceivePdcpSdu (ReceivePdcpSduParameters params)
+  {
+    ++m_rxSdus;
+  }
+
+  uint64_t m_rxSdus;
+};
+
+/// one end of the radio bearer
+struct BenchmarkEntity
+{
+  Ptr<LtePdcp> pdcp;
+  Ptr<LteRlc> rlc;
+  BenchmarkMac mac;
+  BenchmarkPdcpSapUser pdcpSapUser;
+};
+
+static void
+SetupEntity (BenchmarkEntity& e, Ptr<LteRlc> rlc)
+{
+  e.rlc = rlc;
+  e.rlc->SetRnti (1);
+  e.rlc->SetLcId (3);
+  e.rlc->SetLteMacSapProvider (&e.mac);
+  e.pdcp = CreateObject<LtePdcp> ();
+  e.pdcp->SetRnti (1);
+  e.pdcp->SetLcId (3);
+  e.pdcp->SetLtePdcpSapUser (&e.pdcpSapUser);
+  e.pdcp->SetLteRlcSapProvider (e.rlc->GetLteRlcSapProvider ());
+  e.rlc->SetLteRlcSapUser (e.pdcp->GetLteRlcSapUser ());
+}
+
+/**
+ * Give transmission opportunities to an entity until it has nothing
+ * left to send, and deliver its PDUs to the peer
+ */
+static void
+Serve (BenchmarkEntity& from, BenchmarkEntity& to, uint32_t txOpportunity)
+{
+  for (uint32_t n = 0; from.mac.m_pendingBytes > 0 && n < 64; ++n)
+    {
+      uint64_t numTxPdus = from.mac.m_numTxPdus;
+      from.rlc->GetLteMacSapUser ()->NotifyTxOpportunity (txOpportunity, 0, 0, 0, 1, 3);
+      if (from.mac.m_numTxPdus == numTxPdus)
+        {
+          // not every RLC entity reports its buffer status after a
+          // transmission, so stop as soon as nothing is sent
+          break;
+        }
+    }
+  while (!from.mac.m_pdus.empty ())
+    {
+      to.rlc->GetLteMacSapUser ()->ReceivePdu (from.mac.m_pdus.front (), 1, 3);
+      from.mac.m_pdus.pop_front ();
+    }
+}
+
+static void
+Tti (BenchmarkEntity* tx, BenchmarkEntity* rx, uint32_t sdusPerTti, uint32_t sduSize, uint32_t txOpportunity)
+{
+  for (uint32_t i = 0; i < sdusPerTti; ++i)
+    {
+      LtePdcpSapProvider::TransmitPdcpSduParameters params;
+      params.pdcpSdu = Create<Packet> (sduSize);
+      params.rnti = 1;
+      params.lcid = 3;
+      tx->pdcp->GetLtePdcpSapProvider ()->TransmitPdcpSdu (params);
+    }
+  Serve (*tx, *rx, txOpportunity);
+  Serve (*rx, *tx, txOpportunity);
+}
+
+static void
+RunBenchmark (std::string mode, TypeId rlcTypeId, uint32_t numTtis, uint32_t sdusPerTti,
+              uint32_t sduSize, uint32_t txOpportunity)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (rlcTypeId);
+  BenchmarkEntity tx;
+  BenchmarkEntity rx;
+  SetupEntity (tx, factory.Create<LteRlc> ());
+  SetupEntity (rx, factory.Create<LteRlc> ());
+
+  for (uint32_t t = 0; t < numTtis; ++t)
+    {
+      Simulator::Schedule (MilliSeconds (t), &Tti, &tx, &rx, sdusPerTti, sduSize, txOpportunity);
+    }
+  Simulator::Stop (MilliSeconds (numTtis));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsedMs = clock.End ();
+
+  uint64_t txSdus = (uint64_t) numTtis * sdusPerTti;
+  std::cout << mode << "\t" << txSdus << "\t" << rx.pdcpSapUser.m_rxSdus << "\t" << elapsedMs << "\t"
+            << std::fixed << std::setprecision (0)
+            << rx.pdcpSapUser.m_rxSdus * 1000.0 / std::max (elapsedMs, (int64_t) 1) << std::endl;
+
+  Simulator::Destroy ();
+  tx.pdcp->Dispose ();
+  tx.rlc->Dispose ();
+  rx.pdcp->Dispose ();
+  rx.rlc->Dispose ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numTtis = 100000;
+  uint32_t sdusPerTti = 4;
+  uint32_t sduSize = 1000;
+  uint32_t txOpportunity = 1500;
+
+  CommandLine cmd;
+  cmd.AddValue ("numTtis", "Number of TTIs simulated for each RLC mode", numTtis);
+  cmd.AddValue ("sdusPerTti", "Number of PDCP SDUs sent in each TTI", sdusPerTti);
+  cmd.AddValue ("sduSize", "Size of the PDCP SDUs in bytes", sduSize);
+  cmd.AddValue ("txOpportunity", "Size of the transmission opportunities in bytes", txOpportunity);
+  cmd.Parse (argc, argv);
+
+  std::cout << "mode\ttxSdus\trxSdus\ttime[ms]\tpps" << std::endl;
+  RunBenchmark ("UM", LteRlcUm::GetTypeId (), numTtis, sdusPerTti, sduSize, txOpportunity);
+  RunBenchmark ("AM", LteRlcAm::GetTypeId (), numTtis, sdusPerTti, sduSize, txOpportunity);
+
+  return 0;
+}
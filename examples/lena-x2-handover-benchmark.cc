@@ -0,0 +1,253 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace ns3;
+
+/**
+ * Interruption time and cost of the X2 handovers, with the legacy X2-U
+ * forwarding and with the batched one.
+ *
+ * The UEs are halfway between two eNBs, each receiving a downlink UDP
+ * flow from a remote host, and are handed over back and forth between
+ * the eNBs at a fixed interval. The scenario is simulated without any
+ * handover, then with the legacy forwarding, where each packet is sent
+ * in its own datagram and the RLC backlog of the UE is lost, and then
+ * with the backlog forwarded to the target eNB (LteEnbRrc
+ * ForwardTxBacklog) in bursts of GTP-U PDUs (EpcX2 X2uMaxBurstSize).
+ * The average interruption time seen by the UEs (from the reception of
+ * the handover command to the completion of the handover), the wall
+ * clock time spent per handover, over the run without handover, and the
+ * number of received packets are reported.
+ */
+
+NS_LOG_COMPONENT_DEFINE ("LenaX2HandoverBenchmark");
+
+/// Handover statistics of a run
+struct HandoverStats
+{
+  std::map<uint64_t, Time> started; ///< start time of the ongoing handover of each IMSI
+  uint32_t nHandovers; ///< number of completed handovers
+  Time interruption; ///< sum of the interruption times
+};
+
+/**
+ * Trace sink of the HandoverStart trace source of the UE RRC
+ *
+ * \param stats the handover statistics
+ * \param imsi the IMSI
+ * \param cellId the source cell ID
+ * \param rnti the RNTI
+ * \param targetCellId the target cell ID
+ */
+static void
+HandoverStart (HandoverStats* stats, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
+{
+  stats->started[imsi] = Simulator::Now ();
+}
+
+/**
+ * Trace sink of the HandoverEndOk trace source of the UE RRC
+ *
+ * \param stats the handover statistics
+ * \param imsi the IMSI
+ * \param cellId the target cell ID
+ * \param rnti the new RNTI
+ */
+static void
+HandoverEndOk (HandoverStats* stats, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  std::map<uint64_t, Time>::iterator it = stats->started.find (imsi);
+  if (it != stats->started.end ())
+    {
+      stats->interruption += Simulator::Now () - it->second;
+      ++stats->nHandovers;
+      stats->started.erase (it);
+    }
+}
+
+/**
+ * Simulate the scenario once
+ *
+ * \param nUes the number of UEs
+ * \param nHandovers the number of handovers of each UE
+ * \param hoInterval the interval between the handovers of a UE
+ * \param packetInterval the interval between the downlink packets of a UE
+ * \param batched whether the RLC backlog is forwarded in X2-U bursts
+ * \param stats the handover statistics
+ * \param rxPackets the number of packets received by the UEs
+ * \return the wall clock time of the simulation, in ms
+ */
+static int64_t
+RunScenario (uint32_t nUes, uint32_t nHandovers, Time hoInterval, Time packetInterval,
+             bool batched, HandoverStats& stats, uint64_t& rxPackets)
+{
+  const uint32_t packetSize = 1000;
+  RngSeedManager::SetRun (1);
+  Config::SetDefault ("ns3::LteEnbRrc::ForwardTxBacklog", BooleanValue (batched));
+  Config::SetDefault ("ns3::EpcX2::X2uMaxBurstSize", UintegerValue (batched ? 8000 : 0));
+  // room for a burst and its GTP-U/UDP/IP headers
+  Config::SetDefault ("ns3::PointToPointEpcHelper::X2LinkMtu", UintegerValue (batched ? 9000 : 3000));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetHandoverAlgorithmType ("ns3::NoOpHandoverAlgorithm");
+
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (1500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (10)));
+  NetDeviceContainer internetDevices = p2ph.Install (epcHelper->GetPgwNode (), remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  ipv4h.Assign (internetDevices);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (nUes);
+
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 30.0));
+  positions->Add (Vector (200.0, 0.0, 30.0));
+  for (uint32_t i = 0; i < nUes; ++i)
+    {
+      positions->Add (Vector (100.0, 10.0 * i, 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+
+  internet.Install (ueNodes);
+  Ipv4InterfaceContainer ueIpIfaces = epcHelper->AssignUeIpv4Address (ueDevs);
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (i)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  lteHelper->AddX2Interface (enbNodes);
+
+  const uint16_t dlPort = 10000;
+  ApplicationContainer clientApps;
+  ApplicationContainer sinkApps;
+  PacketSinkHelper sinkHelper ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), dlPort));
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      UdpClientHelper client (ueIpIfaces.GetAddress (i), dlPort);
+      client.SetAttribute ("Interval", TimeValue (packetInterval));
+      client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      client.SetAttribute ("MaxPackets", UintegerValue (1000000000));
+      clientApps.Add (client.Install (remoteHost));
+      sinkApps.Add (sinkHelper.Install (ueNodes.Get (i)));
+    }
+  const Time startTime = MilliSeconds (500);
+  clientApps.Start (startTime);
+  sinkApps.Start (startTime);
+
+  // ping-pong between the eNBs, the UEs being spread over the interval
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Time offset = startTime + MilliSeconds (100) + hoInterval * i / ueDevs.GetN ();
+      for (uint32_t h = 0; h < nHandovers; ++h)
+        {
+          lteHelper->HandoverRequest (offset + hoInterval * h, ueDevs.Get (i),
+                                      enbDevs.Get (h % 2), enbDevs.Get ((h + 1) % 2));
+        }
+      Ptr<LteUeRrc> rrc = ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetRrc ();
+      rrc->TraceConnectWithoutContext ("HandoverStart", MakeBoundCallback (&HandoverStart, &stats));
+      rrc->TraceConnectWithoutContext ("HandoverEndOk", MakeBoundCallback (&HandoverEndOk, &stats));
+    }
+
+  Simulator::Stop (startTime + MilliSeconds (100) + hoInterval * (nHandovers + 1));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsedMs = clock.End ();
+
+  rxPackets = 0;
+  for (uint32_t i = 0; i < sinkApps.GetN (); ++i)
+    {
+      rxPackets += DynamicCast<PacketSink> (sinkApps.Get (i))->GetTotalRx () / packetSize;
+    }
+
+  Simulator::Destroy ();
+  return elapsedMs;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nUes = 20;
+  uint32_t nHandovers = 10;
+  double hoInterval = 0.5;
+  double packetInterval = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nUes", "Number of UEs", nUes);
+  cmd.AddValue ("nHandovers", "Number of handovers of each UE", nHandovers);
+  cmd.AddValue ("hoInterval", "Interval between the handovers of a UE [s]", hoInterval);
+  cmd.AddValue ("packetInterval", "Interval between the downlink packets of a UE [ms]", packetInterval);
+  cmd.Parse (argc, argv);
+
+  HandoverStats noStats;
+  noStats.nHandovers = 0;
+  uint64_t noRx;
+  int64_t noMs = RunScenario (nUes, 0, Seconds (hoInterval), MilliSeconds (packetInterval),
+                              false, noStats, noRx);
+
+  std::cout << "forwarding\thandovers\tinterruption[ms]\twall[ms]\tcost[ms/handover]\trx packets" << std::endl;
+  std::cout << "none\t0\t0\t" << noMs << "\t0\t" << noRx << std::endl;
+  for (uint32_t batched = 0; batched <= 1; ++batched)
+    {
+      HandoverStats stats;
+      stats.nHandovers = 0;
+      uint64_t rx;
+      int64_t ms = RunScenario (nUes, nHandovers, Seconds (hoInterval), MilliSeconds (packetInterval),
+                                batched, stats, rx);
+      uint32_t n = std::max (stats.nHandovers, (uint32_t) 1);
+      std::cout << (batched ? "batched" : "legacy") << "\t" << stats.nHandovers << "\t"
+                << stats.interruption.GetSeconds () * 1000.0 / n << "\t"
+                << ms << "\t" << (double) (ms - noMs) / n << "\t" << rx << std::endl;
+    }
+
+  return 0;
+}
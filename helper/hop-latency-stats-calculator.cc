@@ -0,0 +1,284 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "hop-latency-stats-calculator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+#include <ns3/lte-pdcp-tag.h>
+#include <ns3/lte-rlc-tag.h>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("HopLatencyStatsCalculator");
+
+NS_OBJECT_ENSURE_REGISTERED (HopLatencyStatsCalculator);
+
+HopLatencyStatsCalculator::HopLatencyStatsCalculator ()
+  : m_pendingOutput (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+HopLatencyStatsCalculator::~HopLatencyStatsCalculator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+HopLatencyStatsCalculator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::HopLatencyStatsCalculator")
+    .SetParent<LteStatsCalculator> ()
+    .SetGroupName("Lte")
+    .AddConstructor<HopLatencyStatsCalculator> ()
+    .AddAttribute ("DlOutputFilename",
+                   "Name of the file where the downlink results will be saved.",
+                   StringValue ("DlHopLatencyStats.txt"),
+                   MakeStringAccessor (&LteStatsCalculator::SetDlOutputFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("UlOutputFilename",
+                   "Name of the file where the uplink results will be saved.",
+                   StringValue ("UlHopLatencyStats.txt"),
+                   MakeStringAccessor (&LteStatsCalculator::SetUlOutputFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("PduTableSize",
+                   "Number of entries of the direct mapped table keeping the PHY "
+                   "timestamps of the RLC PDUs in flight. It should exceed the "
+                   "number of RLC PDUs transmitted during the largest delay to be measured.",
+                   UintegerValue (8192),
+                   MakeUintegerAccessor (&HopLatencyStatsCalculator::SetPduTableSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+void
+HopLatencyStatsCalculator::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_pendingOutput)
+    {
+      WriteResults ();
+    }
+  m_pduTable.clear ();
+  LteStatsCalculator::DoDispose ();
+}
+
+void
+HopLatencyStatsCalculator::SetPduTableSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  PduTimestamps empty;
+  empty.uid = 0;
+  empty.received = false;
+  m_pduTable.assign (size, empty);
+}
+
+void
+HopLatencyStatsCalculator::PhyTxStart (Ptr<const PacketBurst> pb)
+{
+  NS_LOG_FUNCTION (this << pb);
+  for (std::list<Ptr<Packet> >::const_iterator it = pb->Begin (); it != pb->End (); ++it)
+    {
+      uint64_t uid = (*it)->GetUid ();
+      PduTimestamps& entry = m_pduTable[uid % m_pduTable.size ()];
+      if (entry.uid != uid)
+        {
+          // first transmission: HARQ and RLC AM retransmissions send
+          // copies of the same PDU, which keep its uid
+          entry.uid = uid;
+          entry.firstTx = Simulator::Now ();
+          entry.received = false;
+        }
+    }
+}
+
+void
+HopLatencyStatsCalculator::PhyRxEndOk (Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+  uint64_t uid = p->GetUid ();
+  PduTimestamps& entry = m_pduTable[uid % m_pduTable.size ()];
+  if (entry.uid == uid && !entry.received)
+    {
+      entry.rx = Simulator::Now ();
+      entry.received = true;
+    }
+}
+
+void
+HopLatencyStatsCalculator::DlRxPdcpPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << p->GetSize ());
+  RecordRxPdcpPdu (m_dlHistograms[ImsiLcidPair_t (imsi, lcid)], p);
+}
+
+void
+HopLatencyStatsCalculator::UlRxPdcpPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << p->GetSize ());
+  RecordRxPdcpPdu (m_ulHistograms[ImsiLcidPair_t (imsi, lcid)], p);
+}
+
+void
+HopLatencyStatsCalculator::RecordRxPdcpPdu (BearerHistograms& histograms, Ptr<const Packet> p)
+{
+  PdcpTag pdcpTag;
+  RlcTag rlcTag;
+  if (!p->FindFirstMatchingByteTag (pdcpTag) || !p->FindFirstMatchingByteTag (rlcTag))
+    {
+      NS_LOG_WARN ("PDCP PDU without timestamps");
+      return;
+    }
+  m_pendingOutput = true;
+  Time now = Simulator::Now ();
+  Time pdcpTx = pdcpTag.GetSenderTimestamp ();
+  Time rlcTx = rlcTag.GetSenderTimestamp ();
+  histograms.hop[RLC_QUEUE].Record (rlcTx - pdcpTx);
+  histograms.hop[TOTAL].Record (now - pdcpTx);
+
+  // the PDCP PDU is a fragment of the (first) RLC PDU carrying it, so
+  // it has the same uid
+  uint64_t uid = p->GetUid ();
+  const PduTimestamps& entry = m_pduTable[uid % m_pduTable.size ()];
+  if (entry.uid == uid && entry.received)
+    {
+      histograms.hop[MAC_TO_PHY].Record (entry.firstTx - rlcTx);
+      histograms.hop[PHY_HARQ].Record (entry.rx - entry.firstTx);
+      histograms.hop[RLC_RX].Record (now - entry.rx);
+    }
+}
+
+LteLatencyHistogram
+HopLatencyStatsCalculator::GetDlHistogram (uint64_t imsi, uint8_t lcid, Hop hop) const
+{
+  NS_ASSERT (hop < NUM_HOPS);
+  HistogramMap::const_iterator it = m_dlHistograms.find (ImsiLcidPair_t (imsi, lcid));
+  return it != m_dlHistograms.end () ? it->second.hop[hop] : LteLatencyHistogram ();
+}
+
+LteLatencyHistogram
+HopLatencyStatsCalculator::GetUlHistogram (uint64_t imsi, uint8_t lcid, Hop hop) const
+{
+  NS_ASSERT (hop < NUM_HOPS);
+  HistogramMap::const_iterator it = m_ulHistograms.find (ImsiLcidPair_t (imsi, lcid));
+  return it != m_ulHistograms.end () ? it->second.hop[hop] : LteLatencyHistogram ();
+}
+
+std::string
+HopLatencyStatsCalculator::GetHopName (Hop hop)
+{
+  switch (hop)
+    {
+    case RLC_QUEUE:
+      return "RLC_QUEUE";
+    case MAC_TO_PHY:
+      return "MAC_TO_PHY";
+    case PHY_HARQ:
+      return "PHY_HARQ";
+    case RLC_RX:
+      return "RLC_RX";
+    case TOTAL:
+      return "TOTAL";
+    default:
+      NS_FATAL_ERROR ("unknown hop " << hop);
+      return "";
+    }
+}
+
+void
+HopLatencyStatsCalculator::WriteResults ()
+{
+  NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
+  NS_LOG_INFO ("Write hop latency stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
+
+  std::ofstream ulOutFile;
+  ulOutFile.open (GetUlOutputFilename ().c_str ());
+  if (!ulOutFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
+      return;
+    }
+  std::ofstream dlOutFile;
+  dlOutFile.open (GetDlOutputFilename ().c_str ());
+  if (!dlOutFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
+      return;
+    }
+  WriteHistograms (ulOutFile, m_ulHistograms);
+  WriteHistograms (dlOutFile, m_dlHistograms);
+  m_pendingOutput = false;
+}
+
+void
+HopLatencyStatsCalculator::WriteHistograms (std::ofstream& outFile, const HistogramMap& histograms)
+{
+  NS_LOG_FUNCTION (this);
+
+  // all the latencies are in microseconds
+  outFile << "% IMSI\tLCID\thop\tcount\tmean\tmin\tp50\tp90\tp99\tp99.9\tmax" << std::endl;
+  for (HistogramMap::const_iterator it = histograms.begin (); it != histograms.end (); ++it)
+    {
+      for (uint32_t h = 0; h < NUM_HOPS; ++h)
+        {
+          const LteLatencyHistogram& histogram = it->second.hop[h];
+          outFile << it->first.m_imsi << "\t" << (uint32_t) it->first.m_lcId << "\t"
+                  << GetHopName ((Hop) h) << "\t"
+                  << histogram.GetCount () << "\t"
+                  << histogram.GetMean () << "\t"
+                  << histogram.GetMin () << "\t"
+                  << histogram.GetPercentile (50) << "\t"
+                  << histogram.GetPercentile (90) << "\t"
+                  << histogram.GetPercentile (99) << "\t"
+                  << histogram.GetPercentile (99.9) << "\t"
+                  << histogram.GetMax () << std::endl;
+        }
+    }
+
+  outFile << "% IMSI\tLCID\thop\tlow\thigh\tcount" << std::endl;
+  for (HistogramMap::const_iterator it = histograms.begin (); it != histograms.end (); ++it)
+    {
+      for (uint32_t h = 0; h < NUM_HOPS; ++h)
+        {
+          std::ostringstream prefix;
+          prefix << it->first.m_imsi << "\t" << (uint32_t) it->first.m_lcId << "\t"
+                 << GetHopName ((Hop) h) << "\t";
+          it->second.hop[h].PrintBuckets (outFile, prefix.str ());
+        }
+    }
+}
+
+void
+HopLatencyStatsCalculator::PhyTxStartCallback (Ptr<HopLatencyStatsCalculator> stats,
+                                               std::string path, Ptr<const PacketBurst> pb)
+{
+  NS_LOG_FUNCTION (stats << path);
+  stats->PhyTxStart (pb);
+}
+
+void
+HopLatencyStatsCalculator::PhyRxEndOkCallback (Ptr<HopLatencyStatsCalculator> stats,
+                                               std::string path, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (stats << path);
+  stats->PhyRxEndOk (p);
+}
+
+} // namespace ns3
@@ -0,0 +1,232 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HOP_LATENCY_STATS_CALCULATOR_H_
+#define HOP_LATENCY_STATS_CALCULATOR_H_
+
+#include "ns3/lte-stats-calculator.h"
+#include "ns3/lte-latency-histogram.h"
+#include "ns3/lte-common.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/packet-burst.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Trace sink breaking down the PDCP to PDCP delay of the data radio
+ * bearers into the delay of each hop of the user plane. The hops are
+ * delimited by these timestamps:
+ *
+ *   - PDCP transmission, carried by the PdcpTag of the PDU
+ *   - RLC dequeue, carried by the RlcTag of the RLC PDU; the RLC PDUs
+ *     are dequeued within the scheduling of the MAC (DL scheduling
+ *     configuration at the eNB, UL grant at the UE), so this is also
+ *     the scheduling time
+ *   - first transmission of the RLC PDU by LteSpectrumPhy (TxStart)
+ *   - successful decoding of the RLC PDU by LteSpectrumPhy (RxEndOk)
+ *   - PDCP reception, i.e., the end of the RLC reassembly
+ *
+ * and the breakdown is:
+ *
+ *   - RLC_QUEUE: time waiting in the RLC buffer for a scheduling grant
+ *   - MAC_TO_PHY: time from the scheduling to the transmission
+ *   - PHY_HARQ: time on air, including the HARQ retransmissions
+ *   - RLC_RX: time spent in RLC reordering and reassembly
+ *   - TOTAL: PDCP to PDCP delay
+ *
+ * The PHY timestamps are kept in a direct mapped table indexed by the
+ * uid of the RLC PDU, which is the uid of the PDCP PDU at the receiver
+ * too; PDUs whose entry was evicted by a later PDU only contribute to
+ * RLC_QUEUE and TOTAL. The latencies are counted in fixed memory
+ * LteLatencyHistogram instances, one per hop and radio bearer, which
+ * are written to file when the calculator is disposed or when
+ * WriteResults is called.
+ */
+class HopLatencyStatsCalculator : public LteStatsCalculator
+{
+public:
+  /// Hops of the user plane
+  enum Hop
+  {
+    RLC_QUEUE = 0,
+    MAC_TO_PHY,
+    PHY_HARQ,
+    RLC_RX,
+    TOTAL,
+    NUM_HOPS
+  };
+
+  /**
+   * Class constructor
+   */
+  HopLatencyStatsCalculator ();
+
+  /**
+   * Class destructor
+   */
+  virtual ~HopLatencyStatsCalculator ();
+
+  // Inherited from ns3::Object
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+  void DoDispose ();
+
+  /**
+   * Set the number of entries of the table of PHY timestamps
+   *
+   * \param size the number of entries
+   */
+  void SetPduTableSize (uint32_t size);
+
+  /**
+   * Notifies the stats calculator that a PHY transmission has started.
+   * @param pb the burst of RLC PDUs being transmitted
+   */
+  void PhyTxStart (Ptr<const PacketBurst> pb);
+
+  /**
+   * Notifies the stats calculator that a RLC PDU has been successfully
+   * received by the PHY.
+   * @param p the RLC PDU
+   */
+  void PhyRxEndOk (Ptr<const Packet> p);
+
+  /**
+   * Notifies the stats calculator that a downlink PDCP PDU has been
+   * received.
+   * @param cellId CellId of the attached Enb
+   * @param imsi IMSI of the UE who received the PDU
+   * @param rnti C-RNTI of the UE who received the PDU
+   * @param lcid LCID through which the PDU has been received
+   * @param p the PDCP PDU
+   */
+  void DlRxPdcpPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, Ptr<const Packet> p);
+
+  /**
+   * Notifies the stats calculator that an uplink PDCP PDU has been
+   * received.
+   * @param cellId CellId of the attached Enb
+   * @param imsi IMSI of the UE who transmitted the PDU
+   * @param rnti C-RNTI of the UE who transmitted the PDU
+   * @param lcid LCID through which the PDU has been received
+   * @param p the PDCP PDU
+   */
+  void UlRxPdcpPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, Ptr<const Packet> p);
+
+  /**
+   * \param imsi the IMSI of the UE
+   * \param lcid the LCID of the radio bearer
+   * \param hop the hop
+   * \return the downlink latency histogram of the hop; an empty
+   * histogram if the bearer did not receive anything
+   */
+  LteLatencyHistogram GetDlHistogram (uint64_t imsi, uint8_t lcid, Hop hop) const;
+
+  /**
+   * \param imsi the IMSI of the UE
+   * \param lcid the LCID of the radio bearer
+   * \param hop the hop
+   * \return the uplink latency histogram of the hop; an empty
+   * histogram if the bearer did not receive anything
+   */
+  LteLatencyHistogram GetUlHistogram (uint64_t imsi, uint8_t lcid, Hop hop) const;
+
+  /**
+   * Write the summary and the buckets of all the histograms to the
+   * downlink and uplink output files
+   */
+  void WriteResults ();
+
+  /**
+   * \param hop the hop
+   * \return the name of the hop
+   */
+  static std::string GetHopName (Hop hop);
+
+  /**
+   * trace sink
+   *
+   * \param stats the calculator
+   * \param path the trace path
+   * \param pb the burst being transmitted
+   */
+  static void PhyTxStartCallback (Ptr<HopLatencyStatsCalculator> stats,
+                                  std::string path, Ptr<const PacketBurst> pb);
+
+  /**
+   * trace sink
+   *
+   * \param stats the calculator
+   * \param path the trace path
+   * \param p the PDU successfully received
+   */
+  static void PhyRxEndOkCallback (Ptr<HopLatencyStatsCalculator> stats,
+                                  std::string path, Ptr<const Packet> p);
+
+private:
+  /// PHY timestamps of a RLC PDU
+  struct PduTimestamps
+  {
+    uint64_t uid; ///< uid of the RLC PDU
+    Time firstTx; ///< first transmission by the PHY
+    Time rx; ///< first successful reception by the PHY
+    bool received; ///< whether rx is valid
+  };
+
+  /// Latency histograms of a radio bearer, one per hop
+  struct BearerHistograms
+  {
+    LteLatencyHistogram hop[NUM_HOPS]; ///< the histograms
+  };
+
+  /// Container: (IMSI, LCID) pair, histograms
+  typedef std::map<ImsiLcidPair_t, BearerHistograms> HistogramMap;
+
+  /**
+   * Record the hops of a received PDCP PDU
+   *
+   * \param histograms the histograms of the radio bearer
+   * \param p the PDCP PDU
+   */
+  void RecordRxPdcpPdu (BearerHistograms& histograms, Ptr<const Packet> p);
+
+  /**
+   * Write the histograms of one direction
+   *
+   * \param outFile the output file
+   * \param histograms the histograms
+   */
+  void WriteHistograms (std::ofstream& outFile, const HistogramMap& histograms);
+
+  std::vector<PduTimestamps> m_pduTable; ///< PHY timestamps, indexed by uid
+  HistogramMap m_dlHistograms; ///< downlink histograms
+  HistogramMap m_ulHistograms; ///< uplink histograms
+  bool m_pendingOutput; ///< whether some samples were not written yet
+};
+
+} // namespace ns3
+
+#endif /* HOP_LATENCY_STATS_CALCULATOR_H_ */
@@ -41,6 +41,7 @@
 #include <ns3/multi-model-spectrum-channel.h>
 #include <ns3/friis-spectrum-propagation-loss.h>
 #include <ns3/trace-fading-loss-model.h>
+#include <ns3/lte-channel-gain-cache.h>
 #include <ns3/isotropic-antenna-model.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-ue-net-device.h>
@@ -62,10 +63,12 @@
 #include <ns3/phy-rx-stats-calculator.h>
 #include <ns3/epc-helper.h>
 #include <iostream>
+#include <algorithm>
 #include <ns3/buildings-propagation-loss-model.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/epc-x2.h>
 #include <ns3/cc-helper.h>
+#include <ns3/lte-spatial-index.h>
 
 #include <ns3/pointer.h>
 #include <ns3/object-map.h>
@@ -153,6 +156,14 @@ TypeId LteHelper::GetTypeId (void)
                    StringValue (""),
                    MakeStringAccessor (&LteHelper::SetFadingModel),
                    MakeStringChecker ())
+    .AddAttribute ("UseChannelGainCache",
+                   "If true, the losses of the pathloss model are cached by a "
+                   "LteChannelGainCache, shared by all the devices on the channel. "
+                   "Only applies to the pathloss models inheriting from "
+                   "ns3::PropagationLossModel.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_useChannelGainCache),
+                   MakeBooleanChecker ())
     .AddAttribute ("UseIdealRrc",
                    "If true, LteRrcProtocolIdeal will be used for RRC signaling. "
                    "If false, LteRrcProtocolReal will be used.",
@@ -241,6 +252,12 @@ LteHelper::ChannelModelInitialized (void)
           NS_LOG_LOGIC (this << " using a PropagationLossModel in DL");
           Ptr<PropagationLossModel> dlPlm = m_downlinkPathlossModelElem->GetObject<PropagationLossModel> ();
           NS_ASSERT_MSG (dlPlm != 0, " " << m_downlinkPathlossModelElem << " is neither PropagationLossModel nor SpectrumPropagationLossModel");
+          if (m_useChannelGainCache)
+            {
+              Ptr<LteChannelGainCache> cache = CreateObject<LteChannelGainCache> ();
+              cache->SetPropagationLossModel (dlPlm);
+              dlPlm = cache;
+            }
           m_downlinkChannelElem->AddPropagationLossModel (dlPlm);
         }
 
@@ -256,6 +273,12 @@ LteHelper::ChannelModelInitialized (void)
           NS_LOG_LOGIC (this << " using a PropagationLossModel in UL");
           Ptr<PropagationLossModel> ulPlm = m_uplinkPathlossModelElem->GetObject<PropagationLossModel> ();
           NS_ASSERT_MSG (ulPlm != 0, " " << m_uplinkPathlossModelElem << " is neither PropagationLossModel nor SpectrumPropagationLossModel");
+          if (m_useChannelGainCache)
+            {
+              Ptr<LteChannelGainCache> cache = CreateObject<LteChannelGainCache> ();
+              cache->SetPropagationLossModel (ulPlm);
+              ulPlm = cache;
+            }
           m_uplinkChannelElem->AddPropagationLossModel (ulPlm);
         }
       if (!m_fadingModelType.empty ())
@@ -506,10 +529,17 @@ LteHelper::InstallUeDevice (NodeContainer c)
 {
   NS_LOG_FUNCTION (this);
   NetDeviceContainer devices;
+  if (c.GetN () == 0)
+    {
+      return devices;
+    }
+  // the carriers are the same for all the UEs of the container
+  std::vector<UeCcParameters> ccs;
+  GetUeCcParameters (ccs);
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
       Ptr<Node> node = *i;
-      Ptr<NetDevice> device = InstallSingleUeDevice (node);
+      Ptr<NetDevice> device = InstallSingleUeDevice (node, ccs);
       //NS_LOG_UNCOND("InstallSingleUeDevice left");
       devices.Add (device);
     }
@@ -552,6 +582,8 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
       NS_ABORT_MSG_IF (m_enbComponentCarrierMap.empty () == true, "You have to either define a valid Carrier Component MAP or disable Ca");
     }
   
+  Ptr<MobilityModel> mm = n->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (mm, "MobilityModel needs to be set on node before calling LteHelper::InstallEnbDevice ()");
   uint16_t counter = 0;
   for (it = m_enbComponentCarrierMap.begin (); it != m_enbComponentCarrierMap.end (); ++it)
     {
@@ -583,8 +615,6 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
       ulPhy->SetChannel (m_uplinkChannel.at (counter));
       counter++;
 
-      Ptr<MobilityModel> mm = n->GetObject<MobilityModel> ();
-      NS_ASSERT_MSG (mm, "MobilityModel needs to be set on node before calling LteHelper::InstallUeDevice ()");
       dlPhy->SetMobility (mm);
       ulPhy->SetMobility (mm);
 
@@ -797,31 +827,58 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
   return dev;
 }
 
+void
+LteHelper::GetUeCcParameters (std::vector<UeCcParameters>& ccs) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_enbComponentCarrierMap.empty () == true, "If CA is not enabled, before call this method you have to install Enbs --> InstallEnbDevice()");
+  ccs.clear ();
+  ccs.reserve (m_enbComponentCarrierMap.size ());
+  uint16_t counter = 0;
+  for (std::map<uint8_t, Ptr<ComponentCarrierEnb> >::const_iterator itCcMap = m_enbComponentCarrierMap.begin ();
+       itCcMap != m_enbComponentCarrierMap.end (); ++itCcMap)
+    {
+      UeCcParameters cc;
+      cc.componentCarrierId = itCcMap->first;
+      cc.ulBandwidth = itCcMap->second->GetUlBandwidth ();
+      cc.dlBandwidth = itCcMap->second->GetDlBandwidth ();
+      cc.ulEarfcn = itCcMap->second->m_ulEarfcn;
+      cc.dlEarfcn = itCcMap->second->m_dlEarfcn;
+      cc.isPrimary = itCcMap->second->IsPrimary ();
+      cc.dlChannel = m_downlinkChannel.at (counter);
+      cc.ulChannel = m_uplinkChannel.at (counter);
+      ccs.push_back (cc);
+      counter++;
+    }
+}
+
 Ptr<NetDevice>
-LteHelper::InstallSingleUeDevice (Ptr<Node> n)
+LteHelper::InstallSingleUeDevice (Ptr<Node> n, const std::vector<UeCcParameters>& ccs)
 {
   NS_LOG_FUNCTION (this);
 
   Ptr<LteUeNetDevice> dev = m_ueNetDeviceFactory.Create<LteUeNetDevice> ();
   std::map<uint8_t, Ptr<ComponentCarrierUe> > m_ueComponentCarrierMap;
-  std::map<uint8_t, Ptr<ComponentCarrierEnb> >::iterator itCcMap;
-  NS_ABORT_MSG_IF (m_enbComponentCarrierMap.empty () == true, "If CA is not enabled, before call this method you have to install Enbs --> InstallEnbDevice()");
-  for (itCcMap = m_enbComponentCarrierMap.begin (); itCcMap != m_enbComponentCarrierMap.end (); ++itCcMap)
+  Ptr<MobilityModel> mm = n->GetObject<MobilityModel> ();
+  NS_ASSERT_MSG (mm, "MobilityModel needs to be set on node before calling LteHelper::InstallUeDevice ()");
+  for (std::vector<UeCcParameters>::const_iterator itCc = ccs.begin (); itCc != ccs.end (); ++itCc)
     {
       Ptr <ComponentCarrierUe> cc =  CreateObject<ComponentCarrierUe> ();
-      cc->SetUlBandwidth ( itCcMap->second->GetUlBandwidth ());
-      cc->SetDlBandwidth ( itCcMap->second->GetDlBandwidth ());
-      cc->m_dlEarfcn = itCcMap->second->m_dlEarfcn;
-      cc->m_ulEarfcn = itCcMap->second->m_ulEarfcn;
-      cc->SetAsPrimary (itCcMap->second->IsPrimary ());
+      cc->SetUlBandwidth (itCc->ulBandwidth);
+      cc->SetDlBandwidth (itCc->dlBandwidth);
+      cc->m_dlEarfcn = itCc->dlEarfcn;
+      cc->m_ulEarfcn = itCc->ulEarfcn;
+      cc->SetAsPrimary (itCc->isPrimary);
       Ptr<LteUeMac> mac = CreateObject<LteUeMac> ();
       cc->SetMac (mac);
       // cc->GetPhy ()->Initialize (); // it is initialized within the LteUeNetDevice::DoInitialize ()
-      m_ueComponentCarrierMap.insert (std::pair<uint8_t, Ptr<ComponentCarrierUe> > (itCcMap->first, cc));
+      m_ueComponentCarrierMap.insert (std::pair<uint8_t, Ptr<ComponentCarrierUe> > (itCc->componentCarrierId, cc));
     }
+  // the PHYs are created after all the MACs, keeping the order in which
+  // the random variables get their streams
   std::map<uint8_t, Ptr<ComponentCarrierUe> >::iterator it;
-  uint16_t counter = 0;
-  for (it = m_ueComponentCarrierMap.begin (); it != m_ueComponentCarrierMap.end (); ++it)
+  std::vector<UeCcParameters>::const_iterator itCc = ccs.begin ();
+  for (it = m_ueComponentCarrierMap.begin (); it != m_ueComponentCarrierMap.end (); ++it, ++itCc)
     {
       Ptr<LteSpectrumPhy> dlPhy = CreateObject<LteSpectrumPhy> ();
       Ptr<LteSpectrumPhy> ulPhy = CreateObject<LteSpectrumPhy> ();
@@ -863,14 +920,9 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
           pCtrl->AddCallback (MakeCallback (&LteUePhy::GenerateCtrlCqiReport, phy));
         }
 
+      dlPhy->SetChannel (itCc->dlChannel);
+      ulPhy->SetChannel (itCc->ulChannel);
 
-
-      dlPhy->SetChannel (m_downlinkChannel.at (counter));
-      ulPhy->SetChannel (m_uplinkChannel.at (counter));
-      counter++;
-
-      Ptr<MobilityModel> mm = n->GetObject<MobilityModel> ();
-      NS_ASSERT_MSG (mm, "MobilityModel needs to be set on node before calling LteHelper::InstallUeDevice ()");
       dlPhy->SetMobility (mm);
       ulPhy->SetMobility (mm);
 
@@ -949,7 +1001,6 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
   dev->SetAttribute ("LteUeRrc", PointerValue (rrc));
   dev->SetAttribute ("LteUeComponentCarrierManager", PointerValue (ccm));
   dev->SetAttribute ("EpcUeNas", PointerValue (nas));
-  counter = 0;
   for (it = m_ueComponentCarrierMap.begin (); it != m_ueComponentCarrierMap.end (); ++it)
     {
       Ptr<LteUePhy> tmpPhy;
@@ -1088,9 +1139,12 @@ void
 LteHelper::AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices)
 {
   NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (enbDevices.GetN () > 0, "empty enb device container");
+  LteSpatialIndex enbIndex (enbDevices);
   for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); ++i)
     {
-      AttachToClosestEnb (*i, enbDevices);
+      Vector uepos = (*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+      Attach (*i, enbDevices.Get (enbIndex.FindNearest (uepos)));
     }
 }
 
@@ -1166,12 +1220,11 @@ public:
    * Fired upon successful RRC connection establishment.
    *
    * \param a DrbActivator object
-   * \param context
    * \param imsi
    * \param cellId
    * \param rnti
    */
-  static void ActivateCallback (Ptr<DrbActivator> a, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  static void ActivateCallback (Ptr<DrbActivator> a, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Procedure firstly checks if bearer was not activated, if IMSI
@@ -1214,9 +1267,9 @@ DrbActivator::DrbActivator (Ptr<NetDevice> ueDevice, EpsBearer bearer)
 }
 
 void
-DrbActivator::ActivateCallback (Ptr<DrbActivator> a, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+DrbActivator::ActivateCallback (Ptr<DrbActivator> a, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (a << context << imsi << cellId << rnti);
+  NS_LOG_FUNCTION (a << imsi << cellId << rnti);
   a->ActivateDrb (imsi, cellId, rnti);
 }
 
@@ -1260,12 +1313,9 @@ LteHelper::ActivateDataRadioBearer (Ptr<NetDevice> ueDevice, EpsBearer bearer)
 
   Ptr<LteEnbNetDevice> enbLteDevice = ueDevice->GetObject<LteUeNetDevice> ()->GetTargetEnb ();
 
-  std::ostringstream path;
-  path << "/NodeList/" << enbLteDevice->GetNode ()->GetId ()
-       << "/DeviceList/" << enbLteDevice->GetIfIndex ()
-       << "/LteEnbRrc/ConnectionEstablished";
   Ptr<DrbActivator> arg = Create<DrbActivator> (ueDevice, bearer);
-  Config::Connect (path.str (), MakeBoundCallback (&DrbActivator::ActivateCallback, arg));
+  enbLteDevice->GetRrc ()->TraceConnectWithoutContext ("ConnectionEstablished",
+                                                       MakeBoundCallback (&DrbActivator::ActivateCallback, arg));
 
 }
 
@@ -1285,6 +1335,25 @@ LteHelper::AddX2Interface (NodeContainer enbNodes)
     }
 }
 
+void
+LteHelper::AddX2Interface (NodeContainer enbNodes, double maxDistance)
+{
+  NS_LOG_FUNCTION (this << maxDistance);
+
+  NS_ASSERT_MSG (m_epcHelper != 0, "X2 interfaces cannot be set up when the EPC is not used");
+
+  LteSpatialIndex enbIndex (enbNodes);
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      std::vector<uint32_t> neighbours = enbIndex.FindWithinRadius (enbIndex.GetPosition (i), maxDistance);
+      for (std::vector<uint32_t>::const_iterator j = std::upper_bound (neighbours.begin (), neighbours.end (), i);
+           j != neighbours.end (); ++j)
+        {
+          AddX2Interface (enbNodes.Get (i), enbNodes.Get (*j));
+        }
+    }
+}
+
 void
 LteHelper::AddX2Interface (Ptr<Node> enbNode1, Ptr<Node> enbNode2)
 {
@@ -1586,4 +1655,27 @@ LteHelper::GetPdcpStats (void)
   return m_pdcpStats;
 }
 
+void
+LteHelper::EnableHopLatencyTraces (void)
+{
+  NS_ASSERT_MSG (m_hopLatencyStats == 0, "please make sure that LteHelper::EnableHopLatencyTraces is called at most once");
+  m_hopLatencyStats = CreateObject<HopLatencyStatsCalculator> ();
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/DlSpectrumPhy/TxStart",
+                   MakeBoundCallback (&HopLatencyStatsCalculator::PhyTxStartCallback, m_hopLatencyStats));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/UlSpectrumPhy/TxStart",
+                   MakeBoundCallback (&HopLatencyStatsCalculator::PhyTxStartCallback, m_hopLatencyStats));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/DlSpectrumPhy/RxEndOk",
+                   MakeBoundCallback (&HopLatencyStatsCalculator::PhyRxEndOkCallback, m_hopLatencyStats));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/UlSpectrumPhy/RxEndOk",
+                   MakeBoundCallback (&HopLatencyStatsCalculator::PhyRxEndOkCallback, m_hopLatencyStats));
+  m_radioBearerStatsConnector.EnableHopLatencyStats (m_hopLatencyStats);
+  Simulator::ScheduleDestroy (&HopLatencyStatsCalculator::WriteResults, m_hopLatencyStats);
+}
+
+Ptr<HopLatencyStatsCalculator>
+LteHelper::GetHopLatencyStats (void)
+{
+  return m_hopLatencyStats;
+}
+
 } // namespace ns3
@@ -37,6 +37,7 @@
 #include <ns3/mac-stats-calculator.h>
 #include <ns3/radio-bearer-stats-calculator.h>
 #include <ns3/radio-bearer-stats-connector.h>
+#include <ns3/hop-latency-stats-calculator.h>
 #include <ns3/epc-tft.h>
 #include <ns3/mobility-model.h>
 #include <ns3/component-carrier-enb.h>
@@ -436,7 +437,8 @@ public:
    * \param enbDevices the set of eNodeB devices to be considered
    *
    * This function finds among the eNodeB set the closest eNodeB for each UE,
-   * and then invokes manual attachment between the pair.
+   * and then invokes manual attachment between the pair. The eNodeBs are
+   * indexed once for all the UEs with a LteSpatialIndex.
    *
    * Users are encouraged to use automatic attachment (Idle mode cell selection)
    * instead of this function.
@@ -496,6 +498,17 @@ public:
    */
   void AddX2Interface (NodeContainer enbNodes);
 
+  /**
+   * Create an X2 interface between the eNBs of a given set that are
+   * within a given distance of each other. The pairs are found with a
+   * LteSpatialIndex rather than by testing all of them.
+   *
+   * \param enbNodes the set of eNB nodes
+   * \param maxDistance the largest distance between the eNBs of an X2
+   *        interface, in meters
+   */
+  void AddX2Interface (NodeContainer enbNodes, double maxDistance);
+
   /**
    * Create an X2 interface between two eNBs.
    *
@@ -640,6 +653,20 @@ public:
    */
   Ptr<RadioBearerStatsCalculator> GetPdcpStats (void);
 
+  /**
+   * Enable trace sinks breaking down the delay of the data radio
+   * bearers into the delay of each user plane hop (RLC queue, MAC to
+   * PHY, PHY with HARQ, RLC reassembly). The histograms are written to
+   * file by Simulator::Destroy ().
+   */
+  void EnableHopLatencyTraces (void);
+
+  /**
+   *
+   * \return the hop latency stats calculator object
+   */
+  Ptr<HopLatencyStatsCalculator> GetHopLatencyStats (void);
+
   /**
    * Assign a fixed random variable stream number to the random variables used.
    *
@@ -670,12 +697,32 @@ private:
    */
   Ptr<NetDevice> InstallSingleEnbDevice (Ptr<Node> n);
 
+  /// Parameters of a component carrier of the UEs, the same for all the UEs
+  struct UeCcParameters
+  {
+    uint8_t componentCarrierId; ///< component carrier ID
+    uint8_t ulBandwidth; ///< UL bandwidth in RBs
+    uint8_t dlBandwidth; ///< DL bandwidth in RBs
+    uint16_t ulEarfcn; ///< UL EARFCN
+    uint16_t dlEarfcn; ///< DL EARFCN
+    bool isPrimary; ///< whether the carrier is the primary one
+    Ptr<SpectrumChannel> dlChannel; ///< DL channel of the carrier
+    Ptr<SpectrumChannel> ulChannel; ///< UL channel of the carrier
+  };
+
+  /**
+   * Read the component carriers of the UEs from those of the eNBs
+   * \param ccs the parameters of the carriers, by component carrier ID
+   */
+  void GetUeCcParameters (std::vector<UeCcParameters>& ccs) const;
+
   /**
    * Create a UE device (LteUeNetDevice) on the given node
    * \param n the node where the device is to be installed
+   * \param ccs the component carriers, as returned by GetUeCcParameters
    * \return pointer to the created device
    */
-  Ptr<NetDevice> InstallSingleUeDevice (Ptr<Node> n);
+  Ptr<NetDevice> InstallSingleUeDevice (Ptr<Node> n, const std::vector<UeCcParameters>& ccs);
 
   /**
    * The actual function to trigger a manual handover.
@@ -770,6 +817,8 @@ private:
   Ptr<RadioBearerStatsCalculator> m_rlcStats;
   /// Container of PDCP layer statistics.
   Ptr<RadioBearerStatsCalculator> m_pdcpStats;
+  /// Container of per hop latency statistics.
+  Ptr<HopLatencyStatsCalculator> m_hopLatencyStats;
   /// Connects RLC and PDCP statistics containers to appropriate trace sources
   RadioBearerStatsConnector m_radioBearerStatsConnector;
 
@@ -793,6 +842,11 @@ private:
    */
   uint16_t m_cellIdCounter;
 
+  /**
+   * The `UseChannelGainCache` attribute. If true, the losses of the pathloss
+   * model are cached by a LteChannelGainCache.
+   */
+  bool m_useChannelGainCache;
   /**
    * The `UseIdealRrc` attribute. If true, LteRrcProtocolIdeal will be used for
    * RRC signaling. If false, LteRrcProtocolReal will be used.
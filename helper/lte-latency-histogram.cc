@@ -0,0 +1,201 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-latency-histogram.h"
+#include <ns3/assert.h>
+#include <cstring>
+
+namespace ns3 {
+
+/// number of buckets below the first power of two split in sub buckets
+static const uint32_t LINEAR_BUCKETS = 1 << LteLatencyHistogram::SUB_BUCKET_BITS;
+/// number of sub buckets in each power of two above LINEAR_BUCKETS
+static const uint32_t SUB_BUCKETS = 1 << (LteLatencyHistogram::SUB_BUCKET_BITS - 1);
+
+LteLatencyHistogram::LteLatencyHistogram ()
+{
+  Reset ();
+}
+
+uint32_t
+LteLatencyHistogram::GetBucketIndex (uint64_t value)
+{
+  if (value < LINEAR_BUCKETS)
+    {
+      return value;
+    }
+  if (value >> 32)
+    {
+      return NUM_BUCKETS - 1;
+    }
+  uint32_t msb = 0;
+  for (uint64_t v = value; v > 1; v >>= 1)
+    {
+      ++msb;
+    }
+  // keep SUB_BUCKET_BITS significant bits, the first of which is set
+  uint32_t shift = msb - (SUB_BUCKET_BITS - 1);
+  uint32_t sub = (value >> shift) - SUB_BUCKETS;
+  return LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t
+LteLatencyHistogram::GetBucketLowerBound (uint32_t index)
+{
+  NS_ASSERT (index < NUM_BUCKETS);
+  if (index < LINEAR_BUCKETS)
+    {
+      return index;
+    }
+  uint32_t shift = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+  uint64_t sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+  return sub << shift;
+}
+
+uint64_t
+LteLatencyHistogram::GetBucketUpperBound (uint32_t index)
+{
+  NS_ASSERT (index < NUM_BUCKETS);
+  if (index < LINEAR_BUCKETS)
+    {
+      return index;
+    }
+  uint32_t shift = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+  return GetBucketLowerBound (index) + (((uint64_t) 1) << shift) - 1;
+}
+
+void
+LteLatencyHistogram::Record (Time latency)
+{
+  int64_t us = latency.GetMicroSeconds ();
+  uint64_t value = us > 0 ? us : 0;
+  ++m_buckets[GetBucketIndex (value)];
+  if (m_count == 0 || value < m_min)
+    {
+      m_min = value;
+    }
+  if (value > m_max)
+    {
+      m_max = value;
+    }
+  ++m_count;
+  m_sum += value;
+}
+
+void
+LteLatencyHistogram::Merge (const LteLatencyHistogram& other)
+{
+  if (other.m_count == 0)
+    {
+      return;
+    }
+  for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      m_buckets[i] += other.m_buckets[i];
+    }
+  if (m_count == 0 || other.m_min < m_min)
+    {
+      m_min = other.m_min;
+    }
+  if (other.m_max > m_max)
+    {
+      m_max = other.m_max;
+    }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+LteLatencyHistogram::Reset ()
+{
+  memset (m_buckets, 0, sizeof (m_buckets));
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint64_t
+LteLatencyHistogram::GetCount () const
+{
+  return m_count;
+}
+
+uint64_t
+LteLatencyHistogram::GetMin () const
+{
+  return m_min;
+}
+
+uint64_t
+LteLatencyHistogram::GetMax () const
+{
+  return m_max;
+}
+
+double
+LteLatencyHistogram::GetMean () const
+{
+  return m_count > 0 ? (double) m_sum / m_count : 0.0;
+}
+
+uint64_t
+LteLatencyHistogram::GetPercentile (double percentile) const
+{
+  if (m_count == 0)
+    {
+      return 0;
+    }
+  // rank of the sample, counting from 1
+  uint64_t rank = (uint64_t) (percentile / 100.0 * m_count + 0.5);
+  if (rank < 1)
+    {
+      rank = 1;
+    }
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      seen += m_buckets[i];
+      if (seen >= rank)
+        {
+          uint64_t upper = GetBucketUpperBound (i);
+          return upper < m_max ? upper : m_max;
+        }
+    }
+  return m_max;
+}
+
+uint32_t
+LteLatencyHistogram::GetBucketCount (uint32_t index) const
+{
+  NS_ASSERT (index < NUM_BUCKETS);
+  return m_buckets[index];
+}
+
+void
+LteLatencyHistogram::PrintBuckets (std::ostream& os, std::string prefix) const
+{
+  for (uint32_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      if (m_buckets[i] > 0)
+        {
+          os << prefix << GetBucketLowerBound (i) << "\t" << GetBucketUpperBound (i)
+             << "\t" << m_buckets[i] << std::endl;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_LATENCY_HISTOGRAM_H
+#define LTE_LATENCY_HISTOGRAM_H
+
+#include <ns3/nstime.h>
+#include <stdint.h>
+#include <ostream>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Fixed memory latency histogram, with log-linear buckets in the style
+ * of HdrHistogram. Values are recorded in microseconds; values below
+ * 2^SUB_BUCKET_BITS us get a bucket each, larger values are counted in
+ * buckets whose width doubles at each power of two, so that the
+ * relative error of any reported value is bounded by
+ * 2^-(SUB_BUCKET_BITS-1) (12.5%). Values of 2^32 us (about 71 minutes)
+ * and above are counted in the last bucket.
+ */
+class LteLatencyHistogram
+{
+public:
+  /// number of bits of the value resolved exactly within each power of two
+  static const uint32_t SUB_BUCKET_BITS = 4;
+  /// number of buckets
+  static const uint32_t NUM_BUCKETS = (1 << SUB_BUCKET_BITS) + (32 - SUB_BUCKET_BITS) * (1 << (SUB_BUCKET_BITS - 1));
+
+  LteLatencyHistogram ();
+
+  /**
+   * Record a latency sample
+   *
+   * \param latency the sample; negative values are recorded as zero
+   */
+  void Record (Time latency);
+
+  /**
+   * Add all the samples of another histogram to this one
+   *
+   * \param other the histogram to be merged
+   */
+  void Merge (const LteLatencyHistogram& other);
+
+  /// remove all the samples
+  void Reset ();
+
+  /// \return the number of samples
+  uint64_t GetCount () const;
+  /// \return the smallest sample in microseconds
+  uint64_t GetMin () const;
+  /// \return the largest sample in microseconds
+  uint64_t GetMax () const;
+  /// \return the average of the samples in microseconds
+  double GetMean () const;
+
+  /**
+   * \param percentile the percentile, in [0, 100]
+   * \return the upper bound of the bucket holding the given percentile,
+   * in microseconds and clamped to the largest sample
+   */
+  uint64_t GetPercentile (double percentile) const;
+
+  /**
+   * \param value a value in microseconds
+   * \return the index of the bucket counting the value
+   */
+  static uint32_t GetBucketIndex (uint64_t value);
+
+  /**
+   * \param index the index of a bucket
+   * \return the smallest value in microseconds counted by the bucket
+   */
+  static uint64_t GetBucketLowerBound (uint32_t index);
+
+  /**
+   * \param index the index of a bucket
+   * \return the largest value in microseconds counted by the bucket
+   */
+  static uint64_t GetBucketUpperBound (uint32_t index);
+
+  /**
+   * \param index the index of a bucket
+   * \return the number of samples counted by the bucket
+   */
+  uint32_t GetBucketCount (uint32_t index) const;
+
+  /**
+   * Print the non empty buckets, one per line, as "low high count"
+   *
+   * \param os the output stream
+   * \param prefix text printed at the beginning of each line
+   */
+  void PrintBuckets (std::ostream& os, std::string prefix) const;
+
+private:
+  uint32_t m_buckets[NUM_BUCKETS]; ///< sample count of each bucket
+  uint64_t m_count; ///< number of samples
+  uint64_t m_min; ///< smallest sample in us
+  uint64_t m_max; ///< largest sample in us
+  uint64_t m_sum; ///< sum of the samples in us
+};
+
+} // namespace ns3
+
+#endif // LTE_LATENCY_HISTOGRAM_H
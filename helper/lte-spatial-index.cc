@@ -0,0 +1,282 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-spatial-index.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <ns3/node.h>
+#include <ns3/mobility-model.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteSpatialIndex");
+
+LteSpatialIndex::LteSpatialIndex (const std::vector<Vector>& positions)
+  : m_positions (positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+  Build ();
+}
+
+LteSpatialIndex::LteSpatialIndex (NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION (this << devices.GetN ());
+  m_positions.reserve (devices.GetN ());
+  for (NetDeviceContainer::Iterator it = devices.Begin (); it != devices.End (); ++it)
+    {
+      Ptr<MobilityModel> mm = (*it)->GetNode ()->GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (mm != 0, "the node of the device has no MobilityModel");
+      m_positions.push_back (mm->GetPosition ());
+    }
+  Build ();
+}
+
+LteSpatialIndex::LteSpatialIndex (NodeContainer nodes)
+{
+  NS_LOG_FUNCTION (this << nodes.GetN ());
+  m_positions.reserve (nodes.GetN ());
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<MobilityModel> mm = (*it)->GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (mm != 0, "the node has no MobilityModel");
+      m_positions.push_back (mm->GetPosition ());
+    }
+  Build ();
+}
+
+void
+LteSpatialIndex::Build ()
+{
+  NS_LOG_FUNCTION (this);
+  m_xMin = 0;
+  m_yMin = 0;
+  m_cellSize = 1;
+  m_nColumns = 0;
+  m_nRows = 0;
+  if (m_positions.empty ())
+    {
+      return;
+    }
+
+  double xMax = m_positions[0].x;
+  double yMax = m_positions[0].y;
+  m_xMin = xMax;
+  m_yMin = yMax;
+  for (std::vector<Vector>::const_iterator it = m_positions.begin (); it != m_positions.end (); ++it)
+    {
+      m_xMin = std::min (m_xMin, it->x);
+      m_yMin = std::min (m_yMin, it->y);
+      xMax = std::max (xMax, it->x);
+      yMax = std::max (yMax, it->y);
+    }
+
+  // about two positions per cell, also when the positions are aligned
+  double width = xMax - m_xMin;
+  double height = yMax - m_yMin;
+  double n = m_positions.size ();
+  m_cellSize = std::max (std::sqrt (2 * width * height / n), 2 * std::max (width, height) / n);
+  if (m_cellSize <= 0)
+    {
+      m_cellSize = 1;
+    }
+  m_nColumns = (int32_t) std::floor (width / m_cellSize) + 1;
+  m_nRows = (int32_t) std::floor (height / m_cellSize) + 1;
+  NS_LOG_LOGIC ("cell size " << m_cellSize << " columns " << m_nColumns << " rows " << m_nRows);
+
+  // counting sort of the positions by cell, keeping the indexes sorted
+  // within each cell
+  std::vector<uint32_t> cells (m_positions.size ());
+  m_cellStart.assign (m_nColumns * m_nRows + 1, 0);
+  for (uint32_t i = 0; i < m_positions.size (); ++i)
+    {
+      cells[i] = GetRow (m_positions[i].y) * m_nColumns + GetColumn (m_positions[i].x);
+      ++m_cellStart[cells[i] + 1];
+    }
+  for (uint32_t c = 1; c < m_cellStart.size (); ++c)
+    {
+      m_cellStart[c] += m_cellStart[c - 1];
+    }
+  m_cellPositions.resize (m_positions.size ());
+  std::vector<uint32_t> next (m_cellStart.begin (), m_cellStart.end () - 1);
+  for (uint32_t i = 0; i < m_positions.size (); ++i)
+    {
+      m_cellPositions[next[cells[i]]++] = i;
+    }
+}
+
+uint32_t
+LteSpatialIndex::GetN () const
+{
+  return m_positions.size ();
+}
+
+Vector
+LteSpatialIndex::GetPosition (uint32_t i) const
+{
+  NS_ASSERT (i < m_positions.size ());
+  return m_positions[i];
+}
+
+int32_t
+LteSpatialIndex::GetColumn (double x) const
+{
+  double c = std::floor ((x - m_xMin) / m_cellSize);
+  return (int32_t) std::max (0.0, std::min (c, m_nColumns - 1.0));
+}
+
+int32_t
+LteSpatialIndex::GetRow (double y) const
+{
+  double r = std::floor ((y - m_yMin) / m_cellSize);
+  return (int32_t) std::max (0.0, std::min (r, m_nRows - 1.0));
+}
+
+void
+LteSpatialIndex::Search (const Vector& position, uint32_t k,
+                         std::vector<std::pair<double, uint32_t> >& closest) const
+{
+  closest.clear ();
+  if (k == 0 || m_positions.empty ())
+    {
+      return;
+    }
+  int32_t cx = GetColumn (position.x);
+  int32_t cy = GetRow (position.y);
+  for (int32_t r = 0; ; ++r)
+    {
+      for (int32_t row = std::max (cy - r, 0); row <= std::min (cy + r, m_nRows - 1); ++row)
+        {
+          // the first and last rows of the ring are full, the others
+          // only have their two ends
+          bool fullRow = (row == cy - r || row == cy + r);
+          int32_t step = fullRow ? 1 : 2 * r;
+          for (int32_t column = cx - r; column <= cx + r; column += std::max (step, 1))
+            {
+              if (column < 0 || column >= m_nColumns)
+                {
+                  continue;
+                }
+              uint32_t cell = row * m_nColumns + column;
+              for (uint32_t j = m_cellStart[cell]; j < m_cellStart[cell + 1]; ++j)
+                {
+                  uint32_t i = m_cellPositions[j];
+                  std::pair<double, uint32_t> candidate (CalculateDistance (position, m_positions[i]), i);
+                  if (closest.size () < k || candidate < closest.back ())
+                    {
+                      closest.insert (std::upper_bound (closest.begin (), closest.end (), candidate),
+                                      candidate);
+                      if (closest.size () > k)
+                        {
+                          closest.pop_back ();
+                        }
+                    }
+                }
+            }
+        }
+
+      // horizontal distance to the nearest side of the visited square
+      // beyond which there are cells left
+      double bound = std::numeric_limits<double>::infinity ();
+      if (cx - r > 0)
+        {
+          bound = std::min (bound, position.x - (m_xMin + (cx - r) * m_cellSize));
+        }
+      if (cx + r < m_nColumns - 1)
+        {
+          bound = std::min (bound, m_xMin + (cx + r + 1) * m_cellSize - position.x);
+        }
+      if (cy - r > 0)
+        {
+          bound = std::min (bound, position.y - (m_yMin + (cy - r) * m_cellSize));
+        }
+      if (cy + r < m_nRows - 1)
+        {
+          bound = std::min (bound, m_yMin + (cy + r + 1) * m_cellSize - position.y);
+        }
+      if (bound == std::numeric_limits<double>::infinity ())
+        {
+          // all the cells were visited
+          return;
+        }
+      // the positions left are strictly farther, ties included
+      if (closest.size () == k && closest.back ().first < bound)
+        {
+          return;
+        }
+    }
+}
+
+uint32_t
+LteSpatialIndex::FindNearest (const Vector& position) const
+{
+  NS_LOG_FUNCTION (this << position);
+  NS_ASSERT_MSG (!m_positions.empty (), "empty spatial index");
+  std::vector<std::pair<double, uint32_t> > closest;
+  Search (position, 1, closest);
+  return closest.front ().second;
+}
+
+std::vector<uint32_t>
+LteSpatialIndex::FindKNearest (const Vector& position, uint32_t k) const
+{
+  NS_LOG_FUNCTION (this << position << k);
+  std::vector<std::pair<double, uint32_t> > closest;
+  Search (position, k, closest);
+  std::vector<uint32_t> indexes;
+  indexes.reserve (closest.size ());
+  for (std::vector<std::pair<double, uint32_t> >::const_iterator it = closest.begin ();
+       it != closest.end (); ++it)
+    {
+      indexes.push_back (it->second);
+    }
+  return indexes;
+}
+
+std::vector<uint32_t>
+LteSpatialIndex::FindWithinRadius (const Vector& position, double radius) const
+{
+  NS_LOG_FUNCTION (this << position << radius);
+  std::vector<uint32_t> indexes;
+  if (m_positions.empty () || radius < 0)
+    {
+      return indexes;
+    }
+  int32_t row1 = GetRow (position.y + radius);
+  int32_t column0 = GetColumn (position.x - radius);
+  int32_t column1 = GetColumn (position.x + radius);
+  for (int32_t row = GetRow (position.y - radius); row <= row1; ++row)
+    {
+      for (int32_t column = column0; column <= column1; ++column)
+        {
+          uint32_t cell = row * m_nColumns + column;
+          for (uint32_t j = m_cellStart[cell]; j < m_cellStart[cell + 1]; ++j)
+            {
+              uint32_t i = m_cellPositions[j];
+              if (CalculateDistance (position, m_positions[i]) <= radius)
+                {
+                  indexes.push_back (i);
+                }
+            }
+        }
+    }
+  std::sort (indexes.begin (), indexes.end ());
+  return indexes;
+}
+
+} // namespace ns3
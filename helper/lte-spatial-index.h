@@ -0,0 +1,137 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_SPATIAL_INDEX_H
+#define LTE_SPATIAL_INDEX_H
+
+#include <ns3/vector.h>
+#include <ns3/net-device-container.h>
+#include <ns3/node-container.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Uniform grid index over a fixed set of positions, typically those of
+ * the eNBs of a scenario, answering nearest, k-nearest and radius
+ * queries without scanning all the positions.
+ *
+ * The positions are binned on the horizontal plane in square cells
+ * sized so that there are about two positions per cell; the distances
+ * are the 3D ones, as returned by CalculateDistance. Queries visit the
+ * cells in rings of increasing distance around the cell of the query
+ * and stop as soon as the unvisited rings cannot hold a closer
+ * position. Ties are broken by the lowest index, so that the results
+ * match a linear scan of the positions in container order.
+ *
+ * The index is a snapshot: it must be rebuilt if the indexed nodes move.
+ */
+class LteSpatialIndex
+{
+public:
+  /**
+   * \param positions the positions to index; queries return indexes
+   *        into this vector
+   */
+  LteSpatialIndex (const std::vector<Vector>& positions);
+
+  /**
+   * \param devices the devices to index, whose nodes must have a
+   *        MobilityModel; queries return indexes into the container
+   */
+  LteSpatialIndex (NetDeviceContainer devices);
+
+  /**
+   * \param nodes the nodes to index, which must have a MobilityModel;
+   *        queries return indexes into the container
+   */
+  LteSpatialIndex (NodeContainer nodes);
+
+  /// \return the number of indexed positions
+  uint32_t GetN () const;
+
+  /**
+   * \param i the index of a position
+   * \return the position
+   */
+  Vector GetPosition (uint32_t i) const;
+
+  /**
+   * \param position a position
+   * \return the index of the closest indexed position
+   */
+  uint32_t FindNearest (const Vector& position) const;
+
+  /**
+   * \param position a position
+   * \param k the number of positions to return
+   * \return the indexes of the k closest indexed positions, or of all of
+   *         them if there are fewer, from the closest to the farthest
+   */
+  std::vector<uint32_t> FindKNearest (const Vector& position, uint32_t k) const;
+
+  /**
+   * \param position a position
+   * \param radius the largest distance
+   * \return the indexes of the indexed positions within the given
+   *         distance, in increasing order
+   */
+  std::vector<uint32_t> FindWithinRadius (const Vector& position, double radius) const;
+
+private:
+  /// Bin the positions in the cells of the grid
+  void Build ();
+
+  /**
+   * \param x a coordinate
+   * \return the column of the cell holding the coordinate, clamped to the grid
+   */
+  int32_t GetColumn (double x) const;
+
+  /**
+   * \param y a coordinate
+   * \return the row of the cell holding the coordinate, clamped to the grid
+   */
+  int32_t GetRow (double y) const;
+
+  /**
+   * Visit the rings of cells around a position in increasing order, until
+   * the k closest positions are known
+   *
+   * \param position the position
+   * \param k the number of positions
+   * \param closest the (distance, index) of the closest positions,
+   *        sorted
+   */
+  void Search (const Vector& position, uint32_t k,
+               std::vector<std::pair<double, uint32_t> >& closest) const;
+
+  std::vector<Vector> m_positions; ///< the indexed positions
+  double m_xMin; ///< smallest x of the positions
+  double m_yMin; ///< smallest y of the positions
+  double m_cellSize; ///< side of the cells
+  int32_t m_nColumns; ///< number of columns of cells
+  int32_t m_nRows; ///< number of rows of cells
+  std::vector<uint32_t> m_cellStart; ///< offset in m_cellPositions of the first position of each cell, row by row
+  std::vector<uint32_t> m_cellPositions; ///< the indexes of the positions, cell by cell
+};
+
+} // namespace ns3
+
+#endif // LTE_SPATIAL_INDEX_H
@@ -25,6 +25,7 @@
 #include <ns3/log.h>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -33,7 +34,8 @@ namespace ns3 {
   NS_OBJECT_ENSURE_REGISTERED ( RadioBearerStatsCalculator);
 
   RadioBearerStatsCalculator::RadioBearerStatsCalculator ()
-    : m_firstWrite (true),
+    : m_sortedSlotsValid (true),
+      m_firstWrite (true),
       m_pendingOutput (false), 
       m_protocolType ("RLC")
   {
@@ -41,7 +43,8 @@ namespace ns3 {
   }
 
   RadioBearerStatsCalculator::RadioBearerStatsCalculator (std::string protocolType)
-    : m_firstWrite (true),
+    : m_sortedSlotsValid (true),
+      m_firstWrite (true),
       m_pendingOutput (false)
   {
     NS_LOG_FUNCTION (this);
@@ -130,17 +133,132 @@ namespace ns3 {
     return m_epochDuration;  
   }
 
+  uint32_t
+  RadioBearerStatsCalculator::GetBucket (uint64_t imsi, uint8_t lcid) const
+  {
+    // Fibonacci hashing, the number of buckets being a power of 2
+    uint64_t h = ((imsi << 8) | lcid) * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t) (h >> 32) & (m_buckets.size () - 1);
+  }
+
+  uint32_t
+  RadioBearerStatsCalculator::Find (uint64_t imsi, uint8_t lcid) const
+  {
+    if (m_buckets.empty ())
+      {
+        return m_bearers.size ();
+      }
+    uint32_t mask = m_buckets.size () - 1;
+    for (uint32_t b = GetBucket (imsi, lcid); m_buckets[b] != 0; b = (b + 1) & mask)
+      {
+        const ImsiLcidPair_t& key = m_bearers[m_buckets[b] - 1].key;
+        if (key.m_imsi == imsi && key.m_lcId == lcid)
+          {
+            return m_buckets[b] - 1;
+          }
+      }
+    return m_bearers.size ();
+  }
+
+  uint32_t
+  RadioBearerStatsCalculator::FindOrInsert (uint64_t imsi, uint8_t lcid)
+  {
+    uint32_t slot = Find (imsi, lcid);
+    if (slot < m_bearers.size ())
+      {
+        return slot;
+      }
+
+    // keep the load factor of the table below 1/2
+    if (2 * (m_bearers.size () + 1) > m_buckets.size ())
+      {
+        Grow ();
+      }
+    NS_LOG_DEBUG (this << " Creating stats for IMSI " << imsi << " and LCID " << (uint32_t) lcid);
+    BearerInfo info;
+    info.key = ImsiLcidPair_t (imsi, lcid);
+    info.ulCellId = 0;
+    info.dlCellId = 0;
+    m_bearers.push_back (info);
+    m_bearerStats.push_back (BearerStats ());
+    m_sortedSlotsValid = false;
+
+    uint32_t mask = m_buckets.size () - 1;
+    uint32_t b = GetBucket (imsi, lcid);
+    while (m_buckets[b] != 0)
+      {
+        b = (b + 1) & mask;
+      }
+    m_buckets[b] = slot + 1;
+    return slot;
+  }
+
+  void
+  RadioBearerStatsCalculator::Grow ()
+  {
+    NS_LOG_FUNCTION (this << m_buckets.size ());
+    m_buckets.assign (std::max<std::size_t> (16, 2 * m_buckets.size ()), 0);
+    uint32_t mask = m_buckets.size () - 1;
+    for (uint32_t slot = 0; slot < m_bearers.size (); ++slot)
+      {
+        uint32_t b = GetBucket (m_bearers[slot].key.m_imsi, m_bearers[slot].key.m_lcId);
+        while (m_buckets[b] != 0)
+          {
+            b = (b + 1) & mask;
+          }
+        m_buckets[b] = slot + 1;
+      }
+  }
+
+  void
+  RadioBearerStatsCalculator::UpdateStats (ValueStats& stats, uint64_t value)
+  {
+    // same recurrence as MinMaxAvgTotalCalculator, see Knuth, The Art of
+    // Computer Programming, Vol. 2, eq. (15) and (16) on p. 216
+    ++stats.count;
+    if (stats.count == 1)
+      {
+        stats.mean = value;
+        stats.s = 0;
+        stats.min = value;
+        stats.max = value;
+      }
+    else
+      {
+        double meanPrev = stats.mean;
+        stats.mean = meanPrev + (value - meanPrev) / stats.count;
+        stats.s += (value - meanPrev) * (value - stats.mean);
+        stats.min = std::min (stats.min, value);
+        stats.max = std::max (stats.max, value);
+      }
+  }
+
+  std::vector<double>
+  RadioBearerStatsCalculator::GetStatsVector (const ValueStats& stats)
+  {
+    std::vector<double> v (4, 0.0);
+    if (stats.count > 0)
+      {
+        v[0] = stats.mean;
+        v[1] = stats.count > 1 ? std::sqrt (stats.s / (stats.count - 1)) : 0.0;
+        v[2] = stats.min;
+        v[3] = stats.max;
+      }
+    return v;
+  }
+
   void
   RadioBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
   {
     NS_LOG_FUNCTION (this << "UlTxPDU" << cellId << imsi << rnti << (uint32_t) lcid << packetSize);
-    ImsiLcidPair_t p (imsi, lcid);
     if (Simulator::Now () >= m_startTime)
       {
-        m_ulCellId[p] = cellId;
-        m_flowId[p] = LteFlowId_t (rnti, lcid);
-        m_ulTxPackets[p]++;
-        m_ulTxData[p] += packetSize;
+        uint32_t slot = FindOrInsert (imsi, lcid);
+        m_bearers[slot].ulCellId = cellId;
+        m_bearers[slot].flowId = LteFlowId_t (rnti, lcid);
+        DirectionStats& ul = m_bearerStats[slot].ul;
+        ul.txPackets++;
+        ul.txData += packetSize;
       }
     m_pendingOutput = true;
   }
@@ -149,13 +267,14 @@ namespace ns3 {
   RadioBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
   {
     NS_LOG_FUNCTION (this << "DlTxPDU" << cellId << imsi << rnti << (uint32_t) lcid << packetSize);
-    ImsiLcidPair_t p (imsi, lcid);
     if (Simulator::Now () >= m_startTime)
       {
-        m_dlCellId[p] = cellId;
-        m_flowId[p] = LteFlowId_t (rnti, lcid);
-        m_dlTxPackets[p]++;
-        m_dlTxData[p] += packetSize;
+        uint32_t slot = FindOrInsert (imsi, lcid);
+        m_bearers[slot].dlCellId = cellId;
+        m_bearers[slot].flowId = LteFlowId_t (rnti, lcid);
+        DirectionStats& dl = m_bearerStats[slot].dl;
+        dl.txPackets++;
+        dl.txData += packetSize;
       }
     m_pendingOutput = true;
   }
@@ -165,22 +284,15 @@ namespace ns3 {
                                        uint64_t delay)
   {
     NS_LOG_FUNCTION (this << "UlRxPDU" << cellId << imsi << rnti << (uint32_t) lcid << packetSize << delay);
-    ImsiLcidPair_t p (imsi, lcid);
     if (Simulator::Now () >= m_startTime)
       {
-        m_ulCellId[p] = cellId;
-        m_ulRxPackets[p]++;
-        m_ulRxData[p] += packetSize;
-
-        Uint64StatsMap::iterator it = m_ulDelay.find (p);
-        if (it == m_ulDelay.end ())
-          {
-            NS_LOG_DEBUG (this << " Creating UL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-            m_ulDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-            m_ulPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
-          }
-        m_ulDelay[p]->Update (delay);
-        m_ulPduSize[p]->Update (packetSize);
+        uint32_t slot = FindOrInsert (imsi, lcid);
+        m_bearers[slot].ulCellId = cellId;
+        DirectionStats& ul = m_bearerStats[slot].ul;
+        ul.rxPackets++;
+        ul.rxData += packetSize;
+        UpdateStats (ul.delay, delay);
+        UpdateStats (ul.pduSize, packetSize);
       }
     m_pendingOutput = true;
   }
@@ -189,22 +301,15 @@ namespace ns3 {
   RadioBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
   {
     NS_LOG_FUNCTION (this << "DlRxPDU" << cellId << imsi << rnti << (uint32_t) lcid << packetSize << delay);
-    ImsiLcidPair_t p (imsi, lcid);
     if (Simulator::Now () >= m_startTime)
       {
-        m_dlCellId[p] = cellId;
-        m_dlRxPackets[p]++;
-        m_dlRxData[p] += packetSize;
-
-        Uint64StatsMap::iterator it = m_dlDelay.find (p);
-        if (it == m_dlDelay.end ())
-          {
-            NS_LOG_DEBUG (this << " Creating DL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-            m_dlDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-            m_dlPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
-          }
-        m_dlDelay[p]->Update (delay);
-        m_dlPduSize[p]->Update (packetSize);
+        uint32_t slot = FindOrInsert (imsi, lcid);
+        m_bearers[slot].dlCellId = cellId;
+        DirectionStats& dl = m_bearerStats[slot].dl;
+        dl.rxPackets++;
+        dl.rxData += packetSize;
+        UpdateStats (dl.delay, delay);
+        UpdateStats (dl.pduSize, packetSize);
       }
     m_pendingOutput = true;
   }
@@ -238,11 +343,11 @@ namespace ns3 {
         ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
         ulOutFile << "delay\tstdDev\tmin\tmax\t";
         ulOutFile << "PduSize\tstdDev\tmin\tmax";
-        ulOutFile << std::endl;
+        ulOutFile << "\n";
         dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
         dlOutFile << "delay\tstdDev\tmin\tmax\t";
         dlOutFile << "PduSize\tstdDev\tmin\tmax";
-        dlOutFile << std::endl;
+        dlOutFile << "\n";
       }
     else
       {
@@ -261,98 +366,91 @@ namespace ns3 {
           }
       }
 
-    WriteUlResults (ulOutFile);
-    WriteDlResults (dlOutFile);
+    WriteResults (ulOutFile, true);
+    WriteResults (dlOutFile, false);
     m_pendingOutput = false;
 
   }
 
-  void
-  RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
-  {
-    NS_LOG_FUNCTION (this);
-
-    // Get the unique IMSI / LCID list
-
-    std::vector < ImsiLcidPair_t > pairVector;
-    for (Uint32Map::iterator it = m_ulTxPackets.begin (); it != m_ulTxPackets.end (); ++it)
-      {
-        if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
-          {
-            pairVector.push_back ((*it).first);
-          }
-      }
+namespace {
 
-    Time endTime = m_startTime + m_epochDuration;
-    for (std::vector<ImsiLcidPair_t>::iterator it = pairVector.begin (); it != pairVector.end (); ++it)
-      {
-        ImsiLcidPair_t p = *it;
-        outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-        outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-        outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
-        outFile << p.m_imsi << "\t";
-        outFile << m_flowId[p].m_rnti << "\t";
-        outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-        outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetUlRxData (p.m_imsi, p.m_lcId) << "\t";
-        std::vector<double> stats = GetUlDelayStats (p.m_imsi, p.m_lcId);
-        for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-          {
-            outFile << (*it) * 1e-9 << "\t";
-          }
-        stats = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
-        for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-          {
-            outFile << (*it) << "\t";
-          }
-        outFile << std::endl;
-      }
+  /// Orders the slots of the radio bearers by (IMSI, LCID)
+  struct SlotKeyLess
+  {
+    /**
+     * \param keys the (IMSI, LCID) pairs, by slot
+     */
+    SlotKeyLess (const std::vector<ImsiLcidPair_t>& keys)
+      : m_keys (keys)
+    {
+    }
+    /**
+     * \param a a slot
+     * \param b a slot
+     * \return whether the radio bearer of a comes first
+     */
+    bool operator () (uint32_t a, uint32_t b) const
+    {
+      return m_keys[a] < m_keys[b];
+    }
+    const std::vector<ImsiLcidPair_t>& m_keys; ///< the (IMSI, LCID) pairs, by slot
+  };
 
-    outFile.close ();
-  }
+} // unnamed namespace
 
   void
-  RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
+  RadioBearerStatsCalculator::WriteResults (std::ofstream& outFile, bool uplink)
   {
-    NS_LOG_FUNCTION (this);
+    NS_LOG_FUNCTION (this << uplink);
 
-    // Get the unique IMSI list
-    std::vector < ImsiLcidPair_t > pairVector;
-    for (Uint32Map::iterator it = m_dlTxPackets.begin (); it != m_dlTxPackets.end (); ++it)
+    if (!m_sortedSlotsValid)
       {
-        if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+        std::vector<ImsiLcidPair_t> keys;
+        keys.reserve (m_bearers.size ());
+        m_sortedSlots.clear ();
+        for (uint32_t slot = 0; slot < m_bearers.size (); ++slot)
           {
-            pairVector.push_back ((*it).first);
+            keys.push_back (m_bearers[slot].key);
+            m_sortedSlots.push_back (slot);
           }
+        std::sort (m_sortedSlots.begin (), m_sortedSlots.end (), SlotKeyLess (keys));
+        m_sortedSlotsValid = true;
       }
 
-    Time endTime = m_startTime + m_epochDuration;
-    for (std::vector<ImsiLcidPair_t>::iterator pair = pairVector.begin (); pair != pairVector.end (); ++pair)
-      {
-        ImsiLcidPair_t p = *pair;
-        outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-        outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-        outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
-        outFile << p.m_imsi << "\t";
-        outFile << m_flowId[p].m_rnti << "\t";
-        outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-        outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-        outFile << GetDlRxData (p.m_imsi, p.m_lcId) << "\t";
-        std::vector<double> stats = GetDlDelayStats (p.m_imsi, p.m_lcId);
+    // the lines end with '\n' rather than std::endl, so that the stream
+    // is flushed once, when it is closed
+    double start = m_startTime.GetNanoSeconds () / 1.0e9;
+    double end = (m_startTime + m_epochDuration).GetNanoSeconds () / 1.0e9;
+    for (std::vector<uint32_t>::const_iterator it = m_sortedSlots.begin (); it != m_sortedSlots.end (); ++it)
+      {
+        const BearerInfo& info = m_bearers[*it];
+        const DirectionStats& dir = uplink ? m_bearerStats[*it].ul : m_bearerStats[*it].dl;
+        if (dir.txPackets == 0)
+          {
+            // only the radio bearers which transmitted during the epoch are reported
+            continue;
+          }
+        outFile << start << "\t";
+        outFile << end << "\t";
+        outFile << (uplink ? info.ulCellId : info.dlCellId) << "\t";
+        outFile << info.key.m_imsi << "\t";
+        outFile << info.flowId.m_rnti << "\t";
+        outFile << (uint32_t) info.flowId.m_lcId << "\t";
+        outFile << dir.txPackets << "\t";
+        outFile << dir.txData << "\t";
+        outFile << dir.rxPackets << "\t";
+        outFile << dir.rxData << "\t";
+        std::vector<double> stats = GetStatsVector (dir.delay);
         for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
           {
             outFile << (*it) * 1e-9 << "\t";
           }
-        stats = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
+        stats = GetStatsVector (dir.pduSize);
         for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
           {
             outFile << (*it) << "\t";
           }
-        outFile << std::endl;
+        outFile << "\n";
       }
 
     outFile.close ();
@@ -363,19 +461,9 @@ namespace ns3 {
   {
     NS_LOG_FUNCTION (this);
 
-    m_ulTxPackets.erase (m_ulTxPackets.begin (), m_ulTxPackets.end ());
-    m_ulRxPackets.erase (m_ulRxPackets.begin (), m_ulRxPackets.end ());
-    m_ulRxData.erase (m_ulRxData.begin (), m_ulRxData.end ());
-    m_ulTxData.erase (m_ulTxData.begin (), m_ulTxData.end ());
-    m_ulDelay.erase (m_ulDelay.begin (), m_ulDelay.end ());
-    m_ulPduSize.erase (m_ulPduSize.begin (), m_ulPduSize.end ());
-
-    m_dlTxPackets.erase (m_dlTxPackets.begin (), m_dlTxPackets.end ());
-    m_dlRxPackets.erase (m_dlRxPackets.begin (), m_dlRxPackets.end ());
-    m_dlRxData.erase (m_dlRxData.begin (), m_dlRxData.end ());
-    m_dlTxData.erase (m_dlTxData.begin (), m_dlTxData.end ());
-    m_dlDelay.erase (m_dlDelay.begin (), m_dlDelay.end ());
-    m_dlPduSize.erase (m_dlPduSize.begin (), m_dlPduSize.end ());
+    // the radio bearers and their slots are kept, only the counters are
+    // cleared, without any memory being released or allocated
+    std::fill (m_bearerStats.begin (), m_bearerStats.end (), BearerStats ());
   }
 
   void
@@ -401,201 +489,194 @@ namespace ns3 {
   RadioBearerStatsCalculator::GetUlTxPackets (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_ulTxPackets[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].ul.txPackets;
   }
 
   uint32_t
   RadioBearerStatsCalculator::GetUlRxPackets (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_ulRxPackets[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].ul.rxPackets;
   }
 
   uint64_t
   RadioBearerStatsCalculator::GetUlTxData (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_ulTxData[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].ul.txData;
   }
 
   uint64_t
   RadioBearerStatsCalculator::GetUlRxData (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_ulRxData[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].ul.rxData;
+  }
+
+  uint32_t
+  RadioBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
+  {
+    NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearers[slot].ulCellId;
   }
 
   double
   RadioBearerStatsCalculator::GetUlDelay (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    Uint64StatsMap::iterator it = m_ulDelay.find (p);
-    if (it == m_ulDelay.end ())
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size () || m_bearerStats[slot].ul.delay.count == 0)
       {
         NS_LOG_ERROR ("UL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
         return 0;
-
       }
-    return m_ulDelay[p]->getMean ();
+    return m_bearerStats[slot].ul.delay.mean;
   }
 
   std::vector<double>
   RadioBearerStatsCalculator::GetUlDelayStats (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    std::vector<double> stats;
-    Uint64StatsMap::iterator it = m_ulDelay.find (p);
-    if (it == m_ulDelay.end ())
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
       {
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        return stats;
-
+        return std::vector<double> (4, 0.0);
       }
-    stats.push_back (m_ulDelay[p]->getMean ());
-    stats.push_back (m_ulDelay[p]->getStddev ());
-    stats.push_back (m_ulDelay[p]->getMin ());
-    stats.push_back (m_ulDelay[p]->getMax ());
-    return stats;
+    return GetStatsVector (m_bearerStats[slot].ul.delay);
   }
 
   std::vector<double>
   RadioBearerStatsCalculator::GetUlPduSizeStats (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    std::vector<double> stats;
-    Uint32StatsMap::iterator it = m_ulPduSize.find (p);
-    if (it == m_ulPduSize.end ())
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
       {
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        return stats;
-
+        return std::vector<double> (4, 0.0);
       }
-    stats.push_back (m_ulPduSize[p]->getMean ());
-    stats.push_back (m_ulPduSize[p]->getStddev ());
-    stats.push_back (m_ulPduSize[p]->getMin ());
-    stats.push_back (m_ulPduSize[p]->getMax ());
-    return stats;
+    return GetStatsVector (m_bearerStats[slot].ul.pduSize);
   }
 
   uint32_t
   RadioBearerStatsCalculator::GetDlTxPackets (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_dlTxPackets[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].dl.txPackets;
   }
 
   uint32_t
   RadioBearerStatsCalculator::GetDlRxPackets (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_dlRxPackets[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].dl.rxPackets;
   }
 
   uint64_t
   RadioBearerStatsCalculator::GetDlTxData (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_dlTxData[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].dl.txData;
   }
 
   uint64_t
   RadioBearerStatsCalculator::GetDlRxData (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_dlRxData[p];
-  }
-
-  uint32_t
-  RadioBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
-  {
-    NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_ulCellId[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearerStats[slot].dl.rxData;
   }
 
   uint32_t
   RadioBearerStatsCalculator::GetDlCellId (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    return m_dlCellId[p];
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return 0;
+      }
+    return m_bearers[slot].dlCellId;
   }
 
   double
   RadioBearerStatsCalculator::GetDlDelay (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    Uint64StatsMap::iterator it = m_dlDelay.find (p);
-    if (it == m_dlDelay.end ())
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size () || m_bearerStats[slot].dl.delay.count == 0)
       {
-        NS_LOG_ERROR ("DL delay for " << imsi << " not found");
+        NS_LOG_ERROR ("DL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
         return 0;
       }
-    return m_dlDelay[p]->getMean ();
+    return m_bearerStats[slot].dl.delay.mean;
   }
 
   std::vector<double>
   RadioBearerStatsCalculator::GetDlDelayStats (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    std::vector<double> stats;
-    Uint64StatsMap::iterator it = m_dlDelay.find (p);
-    if (it == m_dlDelay.end ())
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
       {
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        return stats;
-
+        return std::vector<double> (4, 0.0);
       }
-    stats.push_back (m_dlDelay[p]->getMean ());
-    stats.push_back (m_dlDelay[p]->getStddev ());
-    stats.push_back (m_dlDelay[p]->getMin ());
-    stats.push_back (m_dlDelay[p]->getMax ());
-    return stats;
+    return GetStatsVector (m_bearerStats[slot].dl.delay);
   }
 
   std::vector<double>
   RadioBearerStatsCalculator::GetDlPduSizeStats (uint64_t imsi, uint8_t lcid)
   {
     NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-    ImsiLcidPair_t p (imsi, lcid);
-    std::vector<double> stats;
-    Uint32StatsMap::iterator it = m_dlPduSize.find (p);
-    if (it == m_dlPduSize.end ())
-      {
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        stats.push_back (0.0);
-        return stats;
-
-      }
-    stats.push_back (m_dlPduSize[p]->getMean ());
-    stats.push_back (m_dlPduSize[p]->getStddev ());
-    stats.push_back (m_dlPduSize[p]->getMin ());
-    stats.push_back (m_dlPduSize[p]->getMax ());
-    return stats;
+    uint32_t slot = Find (imsi, lcid);
+    if (slot == m_bearers.size ())
+      {
+        return std::vector<double> (4, 0.0);
+      }
+    return GetStatsVector (m_bearerStats[slot].dl.pduSize);
   }
 
   std::string
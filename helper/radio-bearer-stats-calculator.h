@@ -26,27 +26,12 @@
 #include "ns3/lte-common.h"
 #include "ns3/uinteger.h"
 #include "ns3/object.h"
-#include "ns3/basic-data-calculators.h"
-#include "ns3/lte-common.h"
 #include <string>
-#include <map>
+#include <vector>
 #include <fstream>
 
 namespace ns3
 {
-/// Container: (IMSI, LCID) pair, uint32_t
-typedef std::map<ImsiLcidPair_t, uint32_t> Uint32Map;
-/// Container: (IMSI, LCID) pair, uint64_t
-typedef std::map<ImsiLcidPair_t, uint64_t> Uint64Map;
-/// Container: (IMSI, LCID) pair, uint32_t calculator
-typedef std::map<ImsiLcidPair_t, Ptr<MinMaxAvgTotalCalculator<uint32_t> > > Uint32StatsMap;
-/// Container: (IMSI, LCID) pair, uint64_t calculator
-typedef std::map<ImsiLcidPair_t, Ptr<MinMaxAvgTotalCalculator<uint64_t> > > Uint64StatsMap;
-/// Container: (IMSI, LCID) pair, double
-typedef std::map<ImsiLcidPair_t, double> DoubleMap;
-/// Container: (IMSI, LCID) pair, LteFlowId_t
-typedef std::map<ImsiLcidPair_t, LteFlowId_t> FlowIdMap;
-
 /**
  * \ingroup lte
  *
@@ -358,20 +343,13 @@ private:
   ShowResults (void);
 
   /**
-   * Writes collected statistics to UL output file and
-   * closes UL output file.
-   * @param outFile ofstream for UL statistics
+   * Writes the statistics of one direction collected during the epoch
+   * and closes the output file.
+   * @param outFile ofstream for the statistics
+   * @param uplink true for the UL statistics, false for the DL ones
    */
   void
-  WriteUlResults (std::ofstream& outFile);
-
-  /**
-   * Writes collected statistics to DL output file and
-   * closes DL output file.
-   * @param outFile ofstream for DL statistics
-   */
-  void
-  WriteDlResults (std::ofstream& outFile);
+  WriteResults (std::ofstream& outFile, bool uplink);
 
   /**
    * Erases collected statistics
@@ -394,23 +372,88 @@ private:
 
   EventId m_endEpochEvent; //!< Event id for next end epoch event
 
-  FlowIdMap m_flowId; //!< List of FlowIds, ie. (RNTI, LCID) by (IMSI, LCID) pair
-
-  Uint32Map m_dlCellId; //!< List of DL CellIds by (IMSI, LCID) pair
-  Uint32Map m_dlTxPackets; //!< Number of DL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_dlRxPackets; //!< Number of DL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_dlTxData; //!< Amount of DL TX Data by (IMSI, LCID) pair
-  Uint64Map m_dlRxData; //!< Amount of DL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_dlDelay; //!< DL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_dlPduSize; //!< DL PDU Size by (IMSI, LCID) pair
-
-  Uint32Map m_ulCellId; //!< List of UL CellIds by (IMSI, LCID) pair
-  Uint32Map m_ulTxPackets; //!< Number of UL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_ulRxPackets; //!< Number of UL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_ulTxData; //!< Amount of UL TX Data by (IMSI, LCID) pair
-  Uint64Map m_ulRxData; //!< Amount of UL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_ulDelay; //!< UL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_ulPduSize; //!< UL PDU Size by (IMSI, LCID) pair
+  /// Running statistics of a value, computed as MinMaxAvgTotalCalculator does
+  struct ValueStats
+  {
+    uint32_t count; ///< number of values
+    double mean; ///< mean of the values
+    double s; ///< sum of the squared deviations from the mean
+    uint64_t min; ///< smallest value
+    uint64_t max; ///< largest value
+  };
+
+  /// Counters of one direction of a radio bearer during an epoch
+  struct DirectionStats
+  {
+    uint32_t txPackets; ///< number of TX PDUs
+    uint32_t rxPackets; ///< number of RX PDUs
+    uint64_t txData; ///< amount of TX data
+    uint64_t rxData; ///< amount of RX data
+    ValueStats delay; ///< delay of the RX PDUs
+    ValueStats pduSize; ///< size of the RX PDUs
+  };
+
+  /// Counters of a radio bearer during an epoch, reset at each epoch
+  struct BearerStats
+  {
+    DirectionStats ul; ///< UL counters
+    DirectionStats dl; ///< DL counters
+  };
+
+  /// Identity of a radio bearer, kept across the epochs
+  struct BearerInfo
+  {
+    ImsiLcidPair_t key; ///< (IMSI, LCID) pair
+    LteFlowId_t flowId; ///< (RNTI, LCID) of the last TX PDU
+    uint32_t ulCellId; ///< cell ID of the last UL PDU
+    uint32_t dlCellId; ///< cell ID of the last DL PDU
+  };
+
+  /**
+   * \param imsi the IMSI
+   * \param lcid the LCID
+   * \return the slot of the radio bearer, added if not known yet
+   */
+  uint32_t FindOrInsert (uint64_t imsi, uint8_t lcid);
+
+  /**
+   * \param imsi the IMSI
+   * \param lcid the LCID
+   * \return the slot of the radio bearer, or the number of radio
+   *         bearers if not known
+   */
+  uint32_t Find (uint64_t imsi, uint8_t lcid) const;
+
+  /**
+   * \param imsi the IMSI
+   * \param lcid the LCID
+   * \return the first bucket to probe for the radio bearer
+   */
+  uint32_t GetBucket (uint64_t imsi, uint8_t lcid) const;
+
+  /**
+   * Rebuild the hash table with twice as many buckets
+   */
+  void Grow ();
+
+  /**
+   * \param stats the running statistics
+   * \param value the new value
+   */
+  static void UpdateStats (ValueStats& stats, uint64_t value);
+
+  /**
+   * \param stats the running statistics
+   * \return average, standard deviation, min and max, all 0 if no
+   *         value was recorded
+   */
+  static std::vector<double> GetStatsVector (const ValueStats& stats);
+
+  std::vector<BearerInfo> m_bearers; //!< Radio bearers, by slot
+  std::vector<BearerStats> m_bearerStats; //!< Counters of the on going epoch, by slot
+  std::vector<uint32_t> m_buckets; //!< Open addressing table of the slots plus one, 0 for the empty buckets
+  std::vector<uint32_t> m_sortedSlots; //!< Slots sorted by (IMSI, LCID), giving the output order
+  bool m_sortedSlotsValid; //!< whether m_sortedSlots covers all the radio bearers
 
   /**
    * Start time of the on going epoch
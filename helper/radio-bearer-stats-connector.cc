@@ -24,24 +24,23 @@
 
 #include "radio-bearer-stats-connector.h"
 #include "radio-bearer-stats-calculator.h"
+#include "hop-latency-stats-calculator.h"
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-radio-bearer-info.h>
+#include <ns3/lte-rlc.h>
+#include <ns3/lte-pdcp.h>
+#include <ns3/node-list.h>
+#include <ns3/node.h>
+#include <ns3/object-map.h>
+#include <ns3/pointer.h>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("RadioBearerStatsConnector");
 
-/**
-  * Less than operator for CellIdRnti, because it is used as key in map
-  */
-bool
-operator < (const RadioBearerStatsConnector::CellIdRnti& a, const RadioBearerStatsConnector::CellIdRnti& b)
-{
-  return ( (a.cellId < b.cellId) || ( (a.cellId == b.cellId) && (a.rnti < b.rnti) ) );
-}
-
 /**
  * This structure is used as interface between trace
  * sources and RadioBearerStatsCalculator. It stores
@@ -59,49 +58,46 @@ public:
 /**
  * Callback function for DL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
-DlTxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+DlTxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_LOGIC (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << packetSize);
   arg->stats->DlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
 
 /**
  * Callback function for DL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  * /param delay
  */
 void
-DlRxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+DlRxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_LOGIC (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << packetSize << delay);
   arg->stats->DlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
 /**
  * Callback function for UL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
-UlTxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+UlTxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_LOGIC (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << packetSize);
  
   arg->stats->UlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
@@ -109,21 +105,113 @@ UlTxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
 /**
  * Callback function for UL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  * /param delay
  */
 void
-UlRxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+UlRxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_LOGIC (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << packetSize << delay);
  
   arg->stats->UlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
+/**
+ * This structure is used as interface between trace
+ * sources and HopLatencyStatsCalculator, like
+ * BoundCallbackArgument.
+ */
+struct HopLatencyBoundCallbackArgument : public SimpleRefCount<HopLatencyBoundCallbackArgument>
+{
+public:
+  Ptr<HopLatencyStatsCalculator> stats;  //!< statistics calculator
+  uint64_t imsi; //!< imsi
+  uint16_t cellId; //!< cellId
+};
+
+/**
+ * Callback function for DL hop latency statistics
+ * /param arg
+ * /param rnti
+ * /param lcid
+ * /param p
+ */
+void
+DlRxPduPacketCallback (Ptr<HopLatencyBoundCallbackArgument> arg,
+                       uint16_t rnti, uint8_t lcid, Ptr<const Packet> p)
+{
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << p->GetSize ());
+  arg->stats->DlRxPdcpPdu (arg->cellId, arg->imsi, rnti, lcid, p);
+}
+
+/**
+ * Callback function for UL hop latency statistics
+ * /param arg
+ * /param rnti
+ * /param lcid
+ * /param p
+ */
+void
+UlRxPduPacketCallback (Ptr<HopLatencyBoundCallbackArgument> arg,
+                       uint16_t rnti, uint8_t lcid, Ptr<const Packet> p)
+{
+  NS_LOG_LOGIC (rnti << (uint16_t)lcid << p->GetSize ());
+  arg->stats->UlRxPdcpPdu (arg->cellId, arg->imsi, rnti, lcid, p);
+}
+
+
+
+/**
+ * Connect the PDU trace sources of the RLC or of the PDCP of a radio
+ * bearer, if any, to the given sinks
+ *
+ * \param layer the RLC or PDCP entity, possibly null
+ * \param txSink the sink of the TxPDU trace source
+ * \param rxSink the sink of the RxPDU trace source
+ */
+static void
+ConnectPduTraces (Ptr<Object> layer,
+                  Callback<void, uint16_t, uint8_t, uint32_t> txSink,
+                  Callback<void, uint16_t, uint8_t, uint32_t, uint64_t> rxSink)
+{
+  if (layer)
+    {
+      layer->TraceConnectWithoutContext ("TxPDU", txSink);
+      layer->TraceConnectWithoutContext ("RxPDU", rxSink);
+    }
+}
+
+/**
+ * \param owner the UE RRC or the UE manager at the eNB
+ * \param name the name of the attribute of the bearer, Srb0 or Srb1
+ * \return the signaling radio bearer, possibly null
+ */
+static Ptr<LteSignalingRadioBearerInfo>
+GetSignalingRadioBearer (Ptr<Object> owner, std::string name)
+{
+  PointerValue srb;
+  owner->GetAttribute (name, srb);
+  return srb.Get<LteSignalingRadioBearerInfo> ();
+}
+
+/**
+ * \param owner the UE RRC or the UE manager at the eNB
+ * \param drbs the data radio bearers
+ */
+static void
+GetDataRadioBearers (Ptr<Object> owner, std::vector<Ptr<LteDataRadioBearerInfo> >& drbs)
+{
+  ObjectMapValue drbMap;
+  owner->GetAttribute ("DataRadioBearerMap", drbMap);
+  for (ObjectMapValue::Iterator it = drbMap.Begin (); it != drbMap.End (); ++it)
+    {
+      drbs.push_back (DynamicCast<LteDataRadioBearerInfo> (it->second));
+    }
+}
+
 
 
 RadioBearerStatsConnector::RadioBearerStatsConnector ()
@@ -145,111 +233,118 @@ RadioBearerStatsConnector::EnablePdcpStats (Ptr<RadioBearerStatsCalculator> pdcp
   EnsureConnected ();
 }
 
+void 
+RadioBearerStatsConnector::EnableHopLatencyStats (Ptr<HopLatencyStatsCalculator> hopLatencyStats)
+{
+  m_hopLatencyStats = hopLatencyStats;
+  EnsureConnected ();
+}
+
 void 
 RadioBearerStatsConnector::EnsureConnected ()
 {
   NS_LOG_FUNCTION (this);
   if (!m_connected)
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverStart",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, this));
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
-		       MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, this));
+      for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+        {
+          for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+            {
+              Ptr<NetDevice> device = (*nodeIt)->GetDevice (i);
+              Ptr<LteEnbNetDevice> enbDevice = DynamicCast<LteEnbNetDevice> (device);
+              if (enbDevice)
+                {
+                  Ptr<EnbRrcArgument> arg = Create<EnbRrcArgument> ();
+                  arg->connector = this;
+                  arg->rrc = enbDevice->GetRrc ();
+                  m_enbRrcByCellId[enbDevice->GetCellId ()] = arg->rrc;
+                  arg->rrc->TraceConnectWithoutContext ("ConnectionReconfiguration",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb, arg));
+                  arg->rrc->TraceConnectWithoutContext ("HandoverStart",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartEnb, arg));
+                  arg->rrc->TraceConnectWithoutContext ("HandoverEndOk",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkEnb, arg));
+                }
+              Ptr<LteUeNetDevice> ueDevice = DynamicCast<LteUeNetDevice> (device);
+              if (ueDevice)
+                {
+                  Ptr<UeRrcArgument> arg = Create<UeRrcArgument> ();
+                  arg->connector = this;
+                  arg->rrc = ueDevice->GetRrc ();
+                  arg->rrc->TraceConnectWithoutContext ("RandomAccessSuccessful",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, arg));
+                  arg->rrc->TraceConnectWithoutContext ("ConnectionReconfiguration",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyConnectionReconfigurationUe, arg));
+                  arg->rrc->TraceConnectWithoutContext ("HandoverStart",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverStartUe, arg));
+                  arg->rrc->TraceConnectWithoutContext ("HandoverEndOk",
+                                                        MakeBoundCallback (&RadioBearerStatsConnector::NotifyHandoverEndOkUe, arg));
+                }
+            }
+        }
       m_connected = true;
     }
 }
 
 void 
-RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->ConnectSrb0Traces (context, imsi, cellId, rnti);
+  arg->connector->ConnectSrb0Traces (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyConnectionSetupUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyConnectionSetupUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->ConnectSrb1TracesUe (context, imsi, cellId, rnti);
+  arg->connector->ConnectSrb1TracesUe (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyConnectionReconfigurationUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyConnectionReconfigurationUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->ConnectTracesUeIfFirstTime (context, imsi, cellId, rnti);
+  arg->connector->ConnectTracesUeIfFirstTime (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyHandoverStartUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
+RadioBearerStatsConnector::NotifyHandoverStartUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
 {
-  c->DisconnectTracesUe (context, imsi, cellId, rnti);
+  arg->connector->DisconnectTracesUe (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyHandoverEndOkUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyHandoverEndOkUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->ConnectTracesUe (context, imsi, cellId, rnti);
+  arg->connector->ConnectTracesUe (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyNewUeContextEnb (RadioBearerStatsConnector* c, std::string context, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->StoreUeManagerPath (context, cellId, rnti);
+  arg->connector->ConnectTracesEnbIfFirstTime (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyConnectionReconfigurationEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyHandoverStartEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
 {
-  c->ConnectTracesEnbIfFirstTime (context, imsi, cellId, rnti);
+  arg->connector->DisconnectTracesEnb (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyHandoverStartEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
+RadioBearerStatsConnector::NotifyHandoverEndOkEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  c->DisconnectTracesEnb (context, imsi, cellId, rnti);
+  arg->connector->ConnectTracesEnb (arg->rrc, imsi, cellId, rnti);
 }
 
 void 
-RadioBearerStatsConnector::NotifyHandoverEndOkEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
-{
-  c->ConnectTracesEnb (context, imsi, cellId, rnti);
-}
-
-void 
-RadioBearerStatsConnector::StoreUeManagerPath (std::string context, uint16_t cellId, uint16_t rnti)
-{
-  NS_LOG_FUNCTION (this << context << cellId << rnti);
-  std::ostringstream ueManagerPath;
-  ueManagerPath <<  context.substr (0, context.rfind ("/")) << "/UeMap/" << (uint32_t) rnti;
-  CellIdRnti key;
-  key.cellId = cellId;
-  key.rnti = rnti;
-  m_ueManagerPathByCellIdRnti[key] = ueManagerPath.str ();
-}
-
-void 
-RadioBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectSrb0Traces (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << imsi << cellId << rnti);
-  std::string ueRrcPath =  context.substr (0, context.rfind ("/"));
-  CellIdRnti key;
-  key.cellId = cellId;
-  key.rnti = rnti;
-  std::map<CellIdRnti, std::string>::iterator it = m_ueManagerPathByCellIdRnti.find (key);
-  NS_ASSERT (it != m_ueManagerPathByCellIdRnti.end ());
-  std::string ueManagerPath = it->second;  
-  NS_LOG_LOGIC (this << " ueManagerPath: " << ueManagerPath);
-  m_ueManagerPathByCellIdRnti.erase (it);
+  std::map<uint16_t, Ptr<LteEnbRrc> >::iterator it = m_enbRrcByCellId.find (cellId);
+  if (it == m_enbRrcByCellId.end () || !it->second->HasUeManager (rnti))
+    {
+      NS_LOG_LOGIC (this << " no UE context for RNTI " << rnti << " in cell " << cellId);
+      return;
+    }
+  Ptr<UeManager> ueManager = it->second->GetUeManager (rnti);
 
   if (m_rlcStats)
     {
@@ -258,31 +353,22 @@ RadioBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
 
-      // diconnect eventually previously connected SRB0 both at UE and eNB
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&UlRxPduCallback, arg));
-
       // connect SRB0 both at UE and eNB
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ConnectPduTraces (GetSignalingRadioBearer (ueRrc, "Srb0")->m_rlc,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (GetSignalingRadioBearer (ueManager, "Srb0")->m_rlc,
+                        MakeBoundCallback (&DlTxPduCallback, arg),
+                        MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      Ptr<LteSignalingRadioBearerInfo> srb1 = GetSignalingRadioBearer (ueManager, "Srb1");
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_rlc,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
     }
   if (m_pdcpStats)
     {
@@ -292,27 +378,34 @@ RadioBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi
       arg->stats = m_pdcpStats;
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
+      Ptr<LteSignalingRadioBearerInfo> srb1 = GetSignalingRadioBearer (ueManager, "Srb1");
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_pdcp,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
     }
 }
 
 void 
-RadioBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectSrb1TracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << imsi << cellId << rnti);
-   if (m_rlcStats)
+  Ptr<LteSignalingRadioBearerInfo> srb1 = GetSignalingRadioBearer (ueRrc, "Srb1");
+  if (!srb1)
+    {
+      return;
+    }
+  if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (srb1->m_rlc,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -320,56 +413,59 @@ RadioBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
+      ConnectPduTraces (srb1->m_pdcp,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
     }
 }
   
 void 
-RadioBearerStatsConnector::ConnectTracesUeIfFirstTime (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesUeIfFirstTime (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context);
+  NS_LOG_FUNCTION (this << imsi);
   if (m_imsiSeenUe.find (imsi) == m_imsiSeenUe.end ())
     {
       m_imsiSeenUe.insert (imsi);
-      ConnectTracesUe (context, imsi, cellId, rnti);
+      ConnectTracesUe (ueRrc, imsi, cellId, rnti);
     }
 }
  
 void 
-RadioBearerStatsConnector::ConnectTracesEnbIfFirstTime (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesEnbIfFirstTime (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context);
+  NS_LOG_FUNCTION (this << imsi);
    if (m_imsiSeenEnb.find (imsi) == m_imsiSeenEnb.end ())
     {
       m_imsiSeenEnb.insert (imsi);
-      ConnectTracesEnb (context, imsi, cellId, rnti);
+      ConnectTracesEnb (enbRrc, imsi, cellId, rnti);
     }
 }
 
 void 
-RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context);
-  NS_LOG_LOGIC (this << "expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-  std::string basePath = context.substr (0, context.rfind ("/"));
+  NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+  std::vector<Ptr<LteDataRadioBearerInfo> > drbs;
+  GetDataRadioBearers (ueRrc, drbs);
+  Ptr<LteSignalingRadioBearerInfo> srb1 = GetSignalingRadioBearer (ueRrc, "Srb1");
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          ConnectPduTraces ((*it)->m_rlc,
+                            MakeBoundCallback (&UlTxPduCallback, arg),
+                            MakeBoundCallback (&DlRxPduCallback, arg));
+        }
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_rlc,
+                            MakeBoundCallback (&UlTxPduCallback, arg),
+                            MakeBoundCallback (&DlRxPduCallback, arg));
+        }
     }
   if (m_pdcpStats)
     {
@@ -377,42 +473,69 @@ RadioBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&UlTxPduCallback, arg));
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          ConnectPduTraces ((*it)->m_pdcp,
+                            MakeBoundCallback (&UlTxPduCallback, arg),
+                            MakeBoundCallback (&DlRxPduCallback, arg));
+        }
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_pdcp,
+                            MakeBoundCallback (&UlTxPduCallback, arg),
+                            MakeBoundCallback (&DlRxPduCallback, arg));
+        }
+    }
+  if (m_hopLatencyStats)
+    {
+      Ptr<HopLatencyBoundCallbackArgument> arg = Create<HopLatencyBoundCallbackArgument> ();
+      arg->imsi = imsi;
+      arg->cellId = cellId; 
+      arg->stats = m_hopLatencyStats;
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          if ((*it)->m_pdcp)
+            {
+              (*it)->m_pdcp->TraceConnectWithoutContext ("RxPDUPacket",
+                                                         MakeBoundCallback (&DlRxPduPacketCallback, arg));
+            }
+        }
     }
 }
 
 void 
-RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesEnb (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context);
-  NS_LOG_LOGIC (this << "expected context  should match /NodeList/*/DeviceList/*/LteEnbRrc/");
-  std::ostringstream basePath;
-  basePath <<  context.substr (0, context.rfind ("/")) << "/UeMap/" << (uint32_t) rnti;
+  NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+  Ptr<UeManager> ueManager = enbRrc->GetUeManager (rnti);
+  std::vector<Ptr<LteDataRadioBearerInfo> > drbs;
+  GetDataRadioBearers (ueManager, drbs);
+  Ptr<LteSignalingRadioBearerInfo> srb0 = GetSignalingRadioBearer (ueManager, "Srb0");
+  Ptr<LteSignalingRadioBearerInfo> srb1 = GetSignalingRadioBearer (ueManager, "Srb1");
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_rlcStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          ConnectPduTraces ((*it)->m_rlc,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
+      if (srb0)
+        {
+          ConnectPduTraces (srb0->m_rlc,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_rlc,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
     }
   if (m_pdcpStats)
     {
@@ -420,26 +543,45 @@ RadioBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi,
       arg->imsi = imsi;
       arg->cellId = cellId; 
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/TxPDU",
-		       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/RxPDU",
-		       MakeBoundCallback (&UlRxPduCallback, arg));
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          ConnectPduTraces ((*it)->m_pdcp,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
+      if (srb1)
+        {
+          ConnectPduTraces (srb1->m_pdcp,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
+    }
+  if (m_hopLatencyStats)
+    {
+      Ptr<HopLatencyBoundCallbackArgument> arg = Create<HopLatencyBoundCallbackArgument> ();
+      arg->imsi = imsi;
+      arg->cellId = cellId; 
+      arg->stats = m_hopLatencyStats;
+      for (std::vector<Ptr<LteDataRadioBearerInfo> >::const_iterator it = drbs.begin (); it != drbs.end (); ++it)
+        {
+          if ((*it)->m_pdcp)
+            {
+              (*it)->m_pdcp->TraceConnectWithoutContext ("RxPDUPacket",
+                                                         MakeBoundCallback (&UlRxPduPacketCallback, arg));
+            }
+        }
     }
 }
 
 void 
-RadioBearerStatsConnector::DisconnectTracesUe (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::DisconnectTracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
   NS_LOG_FUNCTION (this);
 }
 
 
 void 
-RadioBearerStatsConnector::DisconnectTracesEnb (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::DisconnectTracesEnb (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
   NS_LOG_FUNCTION (this);
 }
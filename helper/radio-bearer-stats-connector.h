@@ -35,6 +35,10 @@
 namespace ns3 {
 
 class RadioBearerStatsCalculator;
+class HopLatencyStatsCalculator;
+class LteEnbRrc;
+class LteUeRrc;
+class UeManager;
 
 /**
  * \ingroup lte
@@ -68,223 +72,205 @@ public:
   void EnablePdcpStats (Ptr<RadioBearerStatsCalculator> pdcpStats);
 
   /**
-   * Connects trace sinks to appropriate trace sources
+   * Enables trace sinks for the latency breakdown of the data radio
+   * bearers. Usually, this function is called by
+   * LteHelper::EnableHopLatencyTraces().
+   * \param hopLatencyStats hop latency statistics calculator
+   */
+  void EnableHopLatencyStats (Ptr<HopLatencyStatsCalculator> hopLatencyStats);
+
+  /**
+   * Connects trace sinks to the RRC trace sources of all the existing
+   * eNB and UE devices. The RLC and PDCP trace sources of each radio
+   * bearer are then connected directly, without any configuration path
+   * matching, as the RRC announces the setup of the bearers.
    */
   void EnsureConnected ();
 
+  /// The RRC of an eNB, bound to its trace sinks
+  struct EnbRrcArgument : public SimpleRefCount<EnbRrcArgument>
+  {
+    RadioBearerStatsConnector* connector; //!< the connector
+    Ptr<LteEnbRrc> rrc; //!< the eNB RRC
+  };
+
+  /// The RRC of a UE, bound to its trace sinks
+  struct UeRrcArgument : public SimpleRefCount<UeRrcArgument>
+  {
+    RadioBearerStatsConnector* connector; //!< the connector
+    Ptr<LteUeRrc> rrc; //!< the UE RRC
+  };
+
   // trace sinks, to be used with MakeBoundCallback
 
   /**
    * Function hooked to RandomAccessSuccessful trace source at UE RRC,
    * which is fired upon successful completion of the random access procedure
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyRandomAccessSuccessfulUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Sink connected source of UE Connection Setup trace. Not used.
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyConnectionSetupUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyConnectionSetupUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to ConnectionReconfiguration trace source at UE RRC,
    * which is fired upon RRC connection reconfiguration
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyConnectionReconfigurationUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyConnectionReconfigurationUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to HandoverStart trace source at UE RRC,
    * which is fired upon start of a handover procedure
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    * \param targetCellId
    */
-  static void NotifyHandoverStartUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint16_t targetCellId);
+  static void NotifyHandoverStartUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint16_t targetCellId);
 
   /**
    * Function hooked to HandoverStart trace source at UE RRC,
    * which is fired upon successful termination of a handover procedure
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyHandoverEndOkUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
-
-  /**
-   * Function hooked to NewUeContext trace source at eNB RRC,
-   * which is fired upon creation of a new UE context
-   * \param c
-   * \param context
-   * \param cellid
-   * \param rnti
-   */
-  static void NotifyNewUeContextEnb (RadioBearerStatsConnector* c, std::string context, uint16_t cellid, uint16_t rnti);
+  static void NotifyHandoverEndOkUe (Ptr<UeRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to ConnectionReconfiguration trace source at eNB RRC,
    * which is fired upon RRC connection reconfiguration
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyConnectionReconfigurationEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyConnectionReconfigurationEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to HandoverStart trace source at eNB RRC,
    * which is fired upon start of a handover procedure
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    * \param targetCellId
    */
-  static void NotifyHandoverStartEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint16_t targetCellId);
+  static void NotifyHandoverStartEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint16_t targetCellId);
 
   /**
    * Function hooked to HandoverEndOk trace source at eNB RRC,
    * which is fired upon successful termination of a handover procedure
-   * \param c
-   * \param context
+   * \param arg the RRC and the connector
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyHandoverEndOkEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyHandoverEndOkEnb (Ptr<EnbRrcArgument> arg, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
 private:
-  /**
-   * Creates UE Manager path and stores it in m_ueManagerPathByCellIdRnti
-   * \param ueManagerPath
-   * \param cellId
-   * \param rnti
-   */
-  void StoreUeManagerPath (std::string ueManagerPath, uint16_t cellId, uint16_t rnti);
-
   /**
    * Connects Srb0 trace sources at UE and eNB to RLC and PDCP calculators,
    * and Srb1 trace sources at eNB to RLC and PDCP calculators,
-   * \param ueRrcPath
+   * \param ueRrc
    * \param imsi
    * \param cellId
    * \param rnti
    */
-  void ConnectSrb0Traces (std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  void ConnectSrb0Traces (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Connects Srb1 trace sources at UE to RLC and PDCP calculators
-   * \param ueRrcPath
+   * \param ueRrc
    * \param imsi
    * \param cellId
    * \param rnti
    */
-  void ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  void ConnectSrb1TracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Connects all trace sources at UE to RLC and PDCP calculators.
    * This function can connect traces only once for UE.
-   * \param context
+   * \param ueRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void ConnectTracesUeIfFirstTime (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void ConnectTracesUeIfFirstTime (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Connects all trace sources at eNB to RLC and PDCP calculators.
    * This function can connect traces only once for eNB.
-   * \param context
+   * \param enbRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void ConnectTracesEnbIfFirstTime (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void ConnectTracesEnbIfFirstTime (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Connects all trace sources at UE to RLC and PDCP calculators.
-   * \param context
+   * \param ueRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void ConnectTracesUe (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void ConnectTracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Disconnects all trace sources at UE to RLC and PDCP calculators.
    * Function is not implemented.
-   * \param context
+   * \param ueRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void DisconnectTracesUe (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void DisconnectTracesUe (Ptr<LteUeRrc> ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Connects all trace sources at eNB to RLC and PDCP calculators
-   * \param context
+   * \param enbRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void ConnectTracesEnb (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void ConnectTracesEnb (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Disconnects all trace sources at eNB to RLC and PDCP calculators.
    * Function is not implemented.
-   * \param context
+   * \param enbRrc
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  void DisconnectTracesEnb (std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  void DisconnectTracesEnb (Ptr<LteEnbRrc> enbRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
 
   Ptr<RadioBearerStatsCalculator> m_rlcStats; //!< Calculator for RLC Statistics
   Ptr<RadioBearerStatsCalculator> m_pdcpStats; //!< Calculator for PDCP Statistics
+  Ptr<HopLatencyStatsCalculator> m_hopLatencyStats; //!< Calculator for hop latency Statistics
 
   bool m_connected; //!< true if traces are connected to sinks, initially set to false
   std::set<uint64_t> m_imsiSeenUe; //!< stores all UEs for which RLC and PDCP traces were connected
   std::set<uint64_t> m_imsiSeenEnb; //!< stores all eNBs for which RLC and PDCP traces were connected
-  
-  /**
-   * Struct used as key in m_ueManagerPathByCellIdRnti map
-   */
-  struct CellIdRnti
-  {
-    uint16_t cellId; //!< cellId
-    uint16_t rnti; //!< rnti
-  };
-
-  /**
-   * Less than operator for CellIdRnti, because it is used as key in map
-   */
-  friend bool operator < (const CellIdRnti &a, const CellIdRnti &b);
-
-  /**
-   * List UE Manager Paths by CellIdRnti
-   */
-  std::map<CellIdRnti, std::string> m_ueManagerPathByCellIdRnti;
+  std::map<uint16_t, Ptr<LteEnbRrc> > m_enbRrcByCellId; //!< the RRC of the eNBs, by cell ID
 
 };
 
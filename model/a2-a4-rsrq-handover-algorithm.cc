@@ -28,6 +28,7 @@
 #include "a2-a4-rsrq-handover-algorithm.h"
 #include <ns3/log.h>
 #include <ns3/uinteger.h>
+#include <ns3/simulator.h>
 
 namespace ns3 {
 
@@ -135,6 +136,7 @@ void
 A2A4RsrqHandoverAlgorithm::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_evaluateHandoversEvent.Cancel ();
   delete m_handoverManagementSapProvider;
 }
 
@@ -149,7 +151,12 @@ A2A4RsrqHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
     {
       NS_ASSERT_MSG (measResults.rsrqResult <= m_servingCellThreshold,
                      "Invalid UE measurement report");
-      EvaluateHandover (rnti, measResults.rsrqResult);
+      // evaluated once all the reports of the TTI are received
+      if (m_neighbourCellMeasures.AddPending (rnti, measResults.rsrqResult))
+        {
+          m_evaluateHandoversEvent = Simulator::ScheduleNow (&A2A4RsrqHandoverAlgorithm::EvaluatePendingHandovers,
+                                                             this);
+        }
     }
   else if (measResults.measId == m_a4MeasId)
     {
@@ -162,7 +169,7 @@ A2A4RsrqHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
             {
               NS_ASSERT_MSG (it->haveRsrqResult == true,
                              "RSRQ measurement is missing from cellId " << it->physCellId);
-              UpdateNeighbourMeasurements (rnti, it->physCellId, it->rsrqResult);
+              m_neighbourCellMeasures.Update (rnti, it->physCellId, it->rsrqResult);
             }
         }
       else
@@ -178,54 +185,66 @@ A2A4RsrqHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
 } // end of DoReportUeMeas
 
 
+void
+A2A4RsrqHandoverAlgorithm::EvaluatePendingHandovers ()
+{
+  NS_LOG_FUNCTION (this);
+  m_neighbourCellMeasures.TakePending (m_pendingHandovers);
+  for (std::vector<LteHandoverMeasurementStore::Pending>::const_iterator it = m_pendingHandovers.begin ();
+       it != m_pendingHandovers.end (); ++it)
+    {
+      // the UE may have been released or may have started another
+      // procedure since its report was received
+      if (!m_handoverManagementSapUser->IsUeConnectedNormally (it->rnti))
+        {
+          NS_LOG_LOGIC ("Skipping handover evaluation for RNTI " << it->rnti << " which is no longer connected normally");
+          continue;
+        }
+      EvaluateHandover (it->rnti, it->servingValue);
+    }
+}
+
+
 void
 A2A4RsrqHandoverAlgorithm::EvaluateHandover (uint16_t rnti,
                                              uint8_t servingCellRsrq)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t) servingCellRsrq);
 
-  MeasurementTable_t::iterator it1;
-  it1 = m_neighbourCellMeasures.find (rnti);
+  // Find the best neighbour cell (eNB)
+  uint8_t bestNeighbourRsrq = 0;
+  uint16_t bestNeighbourCellId = m_neighbourCellMeasures.GetBestNeighbour (rnti, bestNeighbourRsrq);
 
-  if (it1 == m_neighbourCellMeasures.end ())
+  if (bestNeighbourCellId == 0)
     {
       NS_LOG_WARN ("Skipping handover evaluation for RNTI " << rnti << " because neighbour cells information is not found");
+      return;
     }
-  else
+
+  if (!IsValidNeighbour (bestNeighbourCellId))
     {
-      // Find the best neighbour cell (eNB)
-      NS_LOG_LOGIC ("Number of neighbour cells = " << it1->second.size ());
-      uint16_t bestNeighbourCellId = 0;
-      uint8_t bestNeighbourRsrq = 0;
-      MeasurementRow_t::iterator it2;
-      for (it2 = it1->second.begin (); it2 != it1->second.end (); ++it2)
-        {
-          if ((it2->second->m_rsrq > bestNeighbourRsrq)
-              && IsValidNeighbour (it2->first))
-            {
-              bestNeighbourCellId = it2->first;
-              bestNeighbourRsrq = it2->second->m_rsrq;
-            }
-        }
+      // fall back to the best of the valid neighbours
+      bestNeighbourCellId = m_neighbourCellMeasures.GetBestNeighbour (rnti,
+                                                                      MakeCallback (&A2A4RsrqHandoverAlgorithm::IsValidNeighbour, this),
+                                                                      bestNeighbourRsrq);
+    }
 
-      // Trigger Handover, if needed
-      if (bestNeighbourCellId > 0)
-        {
-          NS_LOG_LOGIC ("Best neighbour cellId " << bestNeighbourCellId);
+  // Trigger Handover, if needed
+  if (bestNeighbourCellId > 0)
+    {
+      NS_LOG_LOGIC ("Best neighbour cellId " << bestNeighbourCellId);
 
-          if ((bestNeighbourRsrq - servingCellRsrq) >= m_neighbourCellOffset)
-            {
-              NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);
-              NS_LOG_LOGIC ("target cell RSRQ " << (uint16_t) bestNeighbourRsrq);
-              NS_LOG_LOGIC ("serving cell RSRQ " << (uint16_t) servingCellRsrq);
+      if ((bestNeighbourRsrq - servingCellRsrq) >= m_neighbourCellOffset)
+        {
+          NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);
+          NS_LOG_LOGIC ("target cell RSRQ " << (uint16_t) bestNeighbourRsrq);
+          NS_LOG_LOGIC ("serving cell RSRQ " << (uint16_t) servingCellRsrq);
 
-              // Inform eNodeB RRC about handover
-              m_handoverManagementSapUser->TriggerHandover (rnti,
-                                                            bestNeighbourCellId);
-            }
+          // Inform eNodeB RRC about handover
+          m_handoverManagementSapUser->TriggerHandover (rnti,
+                                                        bestNeighbourCellId);
         }
-
-    } // end of else of if (it1 == m_neighbourCellMeasures.end ())
+    }
 
 } // end of EvaluateMeasurementReport
 
@@ -245,48 +264,4 @@ A2A4RsrqHandoverAlgorithm::IsValidNeighbour (uint16_t cellId)
 }
 
 
-void
-A2A4RsrqHandoverAlgorithm::UpdateNeighbourMeasurements (uint16_t rnti,
-                                                        uint16_t cellId,
-                                                        uint8_t rsrq)
-{
-  NS_LOG_FUNCTION (this << rnti << cellId << (uint16_t) rsrq);
-  MeasurementTable_t::iterator it1;
-  it1 = m_neighbourCellMeasures.find (rnti);
-
-  if (it1 == m_neighbourCellMeasures.end ())
-    {
-      // insert a new UE entry
-      MeasurementRow_t row;
-      std::pair<MeasurementTable_t::iterator, bool> ret;
-      ret = m_neighbourCellMeasures.insert (std::pair<uint16_t, MeasurementRow_t> (rnti, row));
-      NS_ASSERT (ret.second);
-      it1 = ret.first;
-    }
-
-  NS_ASSERT (it1 != m_neighbourCellMeasures.end ());
-  Ptr<UeMeasure> neighbourCellMeasures;
-  std::map<uint16_t, Ptr<UeMeasure> >::iterator it2;
-  it2 = it1->second.find (cellId);
-
-  if (it2 != it1->second.end ())
-    {
-      neighbourCellMeasures = it2->second;
-      neighbourCellMeasures->m_cellId = cellId;
-      neighbourCellMeasures->m_rsrp = 0;
-      neighbourCellMeasures->m_rsrq = rsrq;
-    }
-  else
-    {
-      // insert a new cell entry
-      neighbourCellMeasures = Create<UeMeasure> ();
-      neighbourCellMeasures->m_cellId = cellId;
-      neighbourCellMeasures->m_rsrp = 0;
-      neighbourCellMeasures->m_rsrq = rsrq;
-      it1->second[cellId] = neighbourCellMeasures;
-    }
-
-} // end of UpdateNeighbourMeasurements
-
-
 } // end of namespace ns3
@@ -31,9 +31,8 @@
 #include <ns3/lte-handover-algorithm.h>
 #include <ns3/lte-handover-management-sap.h>
 #include <ns3/lte-rrc-sap.h>
-#include <ns3/simple-ref-count.h>
-#include <ns3/ptr.h>
-#include <map>
+#include <ns3/lte-handover-measurement-store.h>
+#include <ns3/event-id.h>
 
 namespace ns3 {
 
@@ -112,6 +111,12 @@ private:
    */
   void EvaluateHandover (uint16_t rnti, uint8_t servingCellRsrq);
 
+  /**
+   * Evaluate the handover of all the UEs which reported Event A2 since
+   * the last call, after all the reports of the TTI were received.
+   */
+  void EvaluatePendingHandovers ();
+
   /**
    * Determines if a neighbour cell is a valid destination for handover.
    * Currently always return true.
@@ -121,50 +126,17 @@ private:
    */
   bool IsValidNeighbour (uint16_t cellId);
 
-  /**
-   * Called when Event A4 is reported, then update the measurements table.
-   * If the RNTI and/or cell ID is not found in the table, a corresponding
-   * entry will be created. Only the latest measurements are stored in the
-   * table.
-   *
-   * \param rnti The RNTI of the UE who reported the event.
-   * \param cellId The cell ID of the measured cell.
-   * \param rsrq The RSRQ of the cell as measured by the UE.
-   */
-  void UpdateNeighbourMeasurements (uint16_t rnti, uint16_t cellId,
-                                    uint8_t rsrq);
-
   /// The expected measurement identity for A2 measurements.
   uint8_t m_a2MeasId;
   /// The expected measurement identity for A4 measurements.
   uint8_t m_a4MeasId;
 
-  /**
-   * Measurements reported by a UE for a cell ID. The values are quantized
-   * according 3GPP TS 36.133 section 9.1.4 and 9.1.7.
-   */
-  class UeMeasure : public SimpleRefCount<UeMeasure>
-  {
-  public:
-    uint16_t m_cellId;  ///< Cell ID.
-    uint8_t m_rsrp;     ///< RSRP in quantized format. \todo Can be removed?
-    uint8_t m_rsrq;     ///< RSRQ in quantized format.
-  };
-
-  /**
-   * Measurements reported by a UE for several cells. The structure is a map
-   * indexed by the cell ID.
-   */
-  typedef std::map<uint16_t, Ptr<UeMeasure> > MeasurementRow_t;
-
-  /**
-   * Measurements reported by several UEs. The structure is a map indexed by
-   * the RNTI of the UE.
-   */
-  typedef std::map<uint16_t, MeasurementRow_t> MeasurementTable_t;
-
-  /// Table of measurement reports from all UEs.
-  MeasurementTable_t m_neighbourCellMeasures;
+  /// Latest Event A4 RSRQ reported by each UE for each neighbour cell.
+  LteHandoverMeasurementStore m_neighbourCellMeasures;
+  /// Event evaluating the pending handovers.
+  EventId m_evaluateHandoversEvent;
+  /// Pending handovers being evaluated, reused across evaluations.
+  std::vector<LteHandoverMeasurementStore::Pending> m_pendingHandovers;
 
   /**
    * The `ServingCellThreshold` attribute. If the RSRQ of the serving cell is
@@ -23,6 +23,7 @@
 #include <ns3/log.h>
 #include <ns3/double.h>
 #include <ns3/lte-common.h>
+#include <ns3/simulator.h>
 #include <list>
 
 namespace ns3 {
@@ -115,6 +116,7 @@ void
 A3RsrpHandoverAlgorithm::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_evaluateHandoversEvent.Cancel ();
   delete m_handoverManagementSapProvider;
 }
 
@@ -134,21 +136,15 @@ A3RsrpHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
       if (measResults.haveMeasResultNeighCells
           && !measResults.measResultListEutra.empty ())
         {
-          uint16_t bestNeighbourCellId = 0;
-          uint8_t bestNeighbourRsrp = 0;
-
+          // only the cells of the last report are candidates
+          m_neighbourCellMeasures.ClearUe (rnti);
           for (std::list <LteRrcSap::MeasResultEutra>::iterator it = measResults.measResultListEutra.begin ();
                it != measResults.measResultListEutra.end ();
                ++it)
             {
               if (it->haveRsrpResult)
                 {
-                  if ((bestNeighbourRsrp < it->rsrpResult)
-                      && IsValidNeighbour (it->physCellId))
-                    {
-                      bestNeighbourCellId = it->physCellId;
-                      bestNeighbourRsrp = it->rsrpResult;
-                    }
+                  m_neighbourCellMeasures.Update (rnti, it->physCellId, it->rsrpResult);
                 }
               else
                 {
@@ -156,15 +152,11 @@ A3RsrpHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
                 }
             }
 
-          if (bestNeighbourCellId > 0)
+          // evaluated once all the reports of the TTI are received
+          if (m_neighbourCellMeasures.AddPending (rnti, measResults.rsrpResult))
             {
-              NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);
-              NS_LOG_LOGIC ("target cell RSRP " << (uint16_t) bestNeighbourRsrp);
-              NS_LOG_LOGIC ("serving cell RSRP " << (uint16_t) measResults.rsrpResult);
-
-              // Inform eNodeB RRC about handover
-              m_handoverManagementSapUser->TriggerHandover (rnti,
-                                                            bestNeighbourCellId);
+              m_evaluateHandoversEvent = Simulator::ScheduleNow (&A3RsrpHandoverAlgorithm::EvaluatePendingHandovers,
+                                                                 this);
             }
         }
       else
@@ -176,6 +168,45 @@ A3RsrpHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
 } // end of DoReportUeMeas
 
 
+void
+A3RsrpHandoverAlgorithm::EvaluatePendingHandovers ()
+{
+  NS_LOG_FUNCTION (this);
+  m_neighbourCellMeasures.TakePending (m_pendingHandovers);
+  for (std::vector<LteHandoverMeasurementStore::Pending>::const_iterator it = m_pendingHandovers.begin ();
+       it != m_pendingHandovers.end (); ++it)
+    {
+      // the UE may have been released or may have started another
+      // procedure since its report was received
+      if (!m_handoverManagementSapUser->IsUeConnectedNormally (it->rnti))
+        {
+          NS_LOG_LOGIC ("Skipping handover evaluation for RNTI " << it->rnti << " which is no longer connected normally");
+          continue;
+        }
+
+      uint8_t bestNeighbourRsrp = 0;
+      uint16_t bestNeighbourCellId = m_neighbourCellMeasures.GetBestNeighbour (it->rnti, bestNeighbourRsrp);
+      if (bestNeighbourCellId > 0 && !IsValidNeighbour (bestNeighbourCellId))
+        {
+          bestNeighbourCellId = m_neighbourCellMeasures.GetBestNeighbour (it->rnti,
+                                                                          MakeCallback (&A3RsrpHandoverAlgorithm::IsValidNeighbour, this),
+                                                                          bestNeighbourRsrp);
+        }
+
+      if (bestNeighbourCellId > 0)
+        {
+          NS_LOG_LOGIC ("Trigger Handover to cellId " << bestNeighbourCellId);
+          NS_LOG_LOGIC ("target cell RSRP " << (uint16_t) bestNeighbourRsrp);
+          NS_LOG_LOGIC ("serving cell RSRP " << (uint16_t) it->servingValue);
+
+          // Inform eNodeB RRC about handover
+          m_handoverManagementSapUser->TriggerHandover (it->rnti,
+                                                        bestNeighbourCellId);
+        }
+    }
+}
+
+
 bool
 A3RsrpHandoverAlgorithm::IsValidNeighbour (uint16_t cellId)
 {
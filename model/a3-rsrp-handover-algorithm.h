@@ -25,6 +25,8 @@
 #include <ns3/lte-handover-algorithm.h>
 #include <ns3/lte-handover-management-sap.h>
 #include <ns3/lte-rrc-sap.h>
+#include <ns3/lte-handover-measurement-store.h>
+#include <ns3/event-id.h>
 #include <ns3/nstime.h>
 
 namespace ns3 {
@@ -98,9 +100,22 @@ private:
    */
   bool IsValidNeighbour (uint16_t cellId);
 
+  /**
+   * Trigger the handover of all the UEs which reported Event A3 since the
+   * last call, after all the reports of the TTI were received.
+   */
+  void EvaluatePendingHandovers ();
+
   /// The expected measurement identity for A3 measurements.
   uint8_t m_measId;
 
+  /// Neighbour cell RSRP of the last Event A3 report of each UE.
+  LteHandoverMeasurementStore m_neighbourCellMeasures;
+  /// Event evaluating the pending handovers.
+  EventId m_evaluateHandoversEvent;
+  /// Pending handovers being evaluated, reused across evaluations.
+  std::vector<LteHandoverMeasurementStore::Pending> m_pendingHandovers;
+
   /**
    * The `Hysteresis` attribute. Handover margin (hysteresis) in dB (rounded to
    * the nearest multiple of 0.5 dB).
@@ -26,6 +26,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/uinteger.h"
+#include "ns3/pointer.h"
 
 #include "epc-gtpu-header.h"
 #include "eps-bearer-tag.h"
@@ -63,7 +64,14 @@ EpcEnbApplication::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::EpcEnbApplication")
     .SetParent<Object> ()
-    .SetGroupName("Lte");
+    .SetGroupName("Lte")
+    .AddAttribute ("S1uBurstAggregator",
+                   "The aggregator of the GTP-U PDUs sent to the SGW over S1-U.",
+                   TypeId::ATTR_GET,
+                   PointerValue (),
+                   MakePointerAccessor (&EpcEnbApplication::m_s1uBurstAggregator),
+                   MakePointerChecker<EpcGtpuBurstAggregator> ())
+    ;
   return tid;
 }
 
@@ -73,6 +81,8 @@ EpcEnbApplication::DoDispose (void)
   NS_LOG_FUNCTION (this);
   m_lteSocket = 0;
   m_s1uSocket = 0;
+  m_s1uBurstAggregator->Dispose ();
+  m_s1uBurstAggregator = 0;
   delete m_s1SapProvider;
   delete m_s1apSapEnb;
 }
@@ -91,6 +101,8 @@ EpcEnbApplication::EpcEnbApplication (Ptr<Socket> lteSocket, Ptr<Socket> s1uSock
   NS_LOG_FUNCTION (this << lteSocket << s1uSocket << sgwS1uAddress);
   m_s1uSocket->SetRecvCallback (MakeCallback (&EpcEnbApplication::RecvFromS1uSocket, this));
   m_lteSocket->SetRecvCallback (MakeCallback (&EpcEnbApplication::RecvFromLteSocket, this));
+  m_s1uBurstAggregator = CreateObject<EpcGtpuBurstAggregator> ();
+  m_s1uBurstAggregator->SetSocket (m_s1uSocket, m_gtpuUdpPort);
   m_s1SapProvider = new MemberEpcEnbS1SapProvider<EpcEnbApplication> (this);
   m_s1apSapEnb = new MemberEpcS1apSapEnb<EpcEnbApplication> (this);
 }
@@ -273,19 +285,26 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
 {
   NS_LOG_FUNCTION (this << socket);  
   NS_ASSERT (socket == m_s1uSocket);
-  Ptr<Packet> packet = socket->Recv ();
-  GtpuHeader gtpu;
-  packet->RemoveHeader (gtpu);
-  uint32_t teid = gtpu.GetTeid ();
-  std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
-  NS_ASSERT (it != m_teidRbidMap.end ());
-
-  /// \internal
-  /// Workaround for \bugid{231}
-  SocketAddressTag tag;
-  packet->RemovePacketTag (tag);
-  
-  SendToLteSocket (packet, it->second.m_rnti, it->second.m_bid);
+  std::list<Ptr<Packet> > packets;
+  EpcGtpuBurstAggregator::Split (socket->Recv (), packets);
+  for (std::list<Ptr<Packet> >::iterator pit = packets.begin ();
+       pit != packets.end ();
+       ++pit)
+    {
+      Ptr<Packet> packet = *pit;
+      GtpuHeader gtpu;
+      packet->RemoveHeader (gtpu);
+      uint32_t teid = gtpu.GetTeid ();
+      std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
+      NS_ASSERT (it != m_teidRbidMap.end ());
+
+      /// \internal
+      /// Workaround for \bugid{231}
+      SocketAddressTag tag;
+      packet->RemovePacketTag (tag);
+
+      SendToLteSocket (packet, it->second.m_rnti, it->second.m_bid);
+    }
 }
 
 void 
@@ -309,8 +328,7 @@ EpcEnbApplication::SendToS1uSocket (Ptr<Packet> packet, uint32_t teid)
   // Length of the payload + the non obligatory GTP-U header
   gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);  
   packet->AddHeader (gtpu);
-  uint32_t flags = 0;
-  m_s1uSocket->SendTo (packet, flags, InetSocketAddress (m_sgwS1uAddress, m_gtpuUdpPort));
+  m_s1uBurstAggregator->Send (packet, m_sgwS1uAddress);
 }
 
 void
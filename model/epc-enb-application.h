@@ -34,6 +34,7 @@
 #include <ns3/eps-bearer.h>
 #include <ns3/epc-enb-s1-sap.h>
 #include <ns3/epc-s1ap-sap.h>
+#include <ns3/epc-gtpu-burst-aggregator.h>
 #include <map>
 
 namespace ns3 {
@@ -223,6 +224,11 @@ private:
    */
   uint16_t m_gtpuUdpPort;
 
+  /**
+   * Aggregator of the GTP-U PDUs sent to the SGW
+   */
+  Ptr<EpcGtpuBurstAggregator> m_s1uBurstAggregator;
+
   /**
    * Provider for the S1 SAP 
    */
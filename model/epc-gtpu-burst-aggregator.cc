@@ -0,0 +1,222 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "epc-gtpu-burst-aggregator.h"
+#include "epc-gtpu-header.h"
+
+#include <ns3/log.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/abort.h>
+#include <ns3/ipv4.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/ipv4-route.h>
+#include <ns3/ipv4-routing-protocol.h>
+#include <ns3/udp-header.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EpcGtpuBurstAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED (EpcGtpuBurstAggregator);
+
+EpcGtpuBurstAggregator::EpcGtpuBurstAggregator ()
+  : m_port (2152) // fixed by the standard
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EpcGtpuBurstAggregator::~EpcGtpuBurstAggregator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+EpcGtpuBurstAggregator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EpcGtpuBurstAggregator")
+    .SetParent<Object> ()
+    .SetGroupName("Lte")
+    .AddConstructor<EpcGtpuBurstAggregator> ()
+    .AddAttribute ("Window",
+                   "Time during which the GTP-U PDUs addressed to the same peer "
+                   "are aggregated in a single burst. Zero disables the aggregation.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&EpcGtpuBurstAggregator::m_window),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxBurstSize",
+                   "Max size in bytes of a burst; a burst is sent before the end "
+                   "of the window if the next PDU would not fit. Zero means the "
+                   "MTU of the device towards the peer minus the IPv4 and UDP "
+                   "headers, which is also the largest value accepted.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&EpcGtpuBurstAggregator::m_maxBurstSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddTraceSource ("BurstTx",
+                     "A burst of GTP-U PDUs has been sent.",
+                     MakeTraceSourceAccessor (&EpcGtpuBurstAggregator::m_burstTxTrace),
+                     "ns3::EpcGtpuBurstAggregator::BurstTxTracedCallback")
+    ;
+  return tid;
+}
+
+void
+EpcGtpuBurstAggregator::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<Ipv4Address, PendingBurst>::iterator it = m_pendingBursts.begin ();
+       it != m_pendingBursts.end ();
+       ++it)
+    {
+      it->second.flushEvent.Cancel ();
+    }
+  m_pendingBursts.clear ();
+  m_mtuBurstSizes.clear ();
+  m_socket = 0;
+  Object::DoDispose ();
+}
+
+void
+EpcGtpuBurstAggregator::SetSocket (Ptr<Socket> socket, uint16_t port)
+{
+  NS_LOG_FUNCTION (this << socket << port);
+  m_socket = socket;
+  m_port = port;
+}
+
+void
+EpcGtpuBurstAggregator::Send (Ptr<Packet> pdu, Ipv4Address peerAddress)
+{
+  NS_LOG_FUNCTION (this << pdu << peerAddress);
+  uint32_t size = pdu->GetSize ();
+
+  if (m_window.IsZero ())
+    {
+      Flush (peerAddress);
+      m_socket->SendTo (pdu, 0, InetSocketAddress (peerAddress, m_port));
+      m_burstTxTrace (1, size);
+      return;
+    }
+
+  uint32_t maxBurstSize = GetMaxBurstSize (peerAddress);
+  if (size >= maxBurstSize)
+    {
+      Flush (peerAddress);
+      m_socket->SendTo (pdu, 0, InetSocketAddress (peerAddress, m_port));
+      m_burstTxTrace (1, size);
+      return;
+    }
+
+  std::map<Ipv4Address, PendingBurst>::iterator it = m_pendingBursts.find (peerAddress);
+  if (it != m_pendingBursts.end () && it->second.packet->GetSize () + size > maxBurstSize)
+    {
+      Flush (peerAddress);
+      it = m_pendingBursts.end ();
+    }
+  if (it == m_pendingBursts.end ())
+    {
+      PendingBurst burst;
+      burst.packet = Create<Packet> ();
+      burst.numPdus = 0;
+      burst.flushEvent = Simulator::Schedule (m_window, &EpcGtpuBurstAggregator::Flush, this, peerAddress);
+      it = m_pendingBursts.insert (std::make_pair (peerAddress, burst)).first;
+    }
+  it->second.packet->AddAtEnd (pdu);
+  ++it->second.numPdus;
+}
+
+uint32_t
+EpcGtpuBurstAggregator::GetMaxBurstSize (Ipv4Address peerAddress)
+{
+  std::map<Ipv4Address, uint32_t>::iterator it = m_mtuBurstSizes.find (peerAddress);
+  if (it == m_mtuBurstSizes.end ())
+    {
+      Ptr<Ipv4> ipv4 = m_socket->GetNode ()->GetObject<Ipv4> ();
+      NS_ASSERT_MSG (ipv4 != 0 && ipv4->GetRoutingProtocol () != 0, "no IPv4 routing on the node of the socket");
+      Ipv4Header header;
+      header.SetDestination (peerAddress);
+      Socket::SocketErrno errno_;
+      Ptr<Ipv4Route> route = ipv4->GetRoutingProtocol ()->RouteOutput (0, header, 0, errno_);
+      NS_ABORT_MSG_IF (route == 0, "no route to the GTP-U peer " << peerAddress);
+      uint32_t mtu = route->GetOutputDevice ()->GetMtu ();
+      uint32_t overhead = header.GetSerializedSize () + UdpHeader ().GetSerializedSize ();
+      NS_ABORT_MSG_IF (mtu <= overhead, "MTU " << mtu << " of the device towards " << peerAddress << " too small");
+      NS_LOG_LOGIC ("MTU towards " << peerAddress << " is " << mtu);
+      it = m_mtuBurstSizes.insert (std::make_pair (peerAddress, mtu - overhead)).first;
+    }
+  if (m_maxBurstSize == 0)
+    {
+      return it->second;
+    }
+  NS_ABORT_MSG_IF (m_maxBurstSize > it->second,
+                   "MaxBurstSize " << m_maxBurstSize << " exceeds the " << it->second
+                   << " bytes that fit in the MTU of the device towards " << peerAddress);
+  return m_maxBurstSize;
+}
+
+void
+EpcGtpuBurstAggregator::Flush (Ipv4Address peerAddress)
+{
+  NS_LOG_FUNCTION (this << peerAddress);
+  std::map<Ipv4Address, PendingBurst>::iterator it = m_pendingBursts.find (peerAddress);
+  if (it == m_pendingBursts.end ())
+    {
+      return;
+    }
+  it->second.flushEvent.Cancel ();
+  Ptr<Packet> packet = it->second.packet;
+  uint32_t numPdus = it->second.numPdus;
+  m_pendingBursts.erase (it);
+  NS_LOG_LOGIC ("sending burst of " << numPdus << " PDUs, " << packet->GetSize () << " bytes to " << peerAddress);
+  m_socket->SendTo (packet, 0, InetSocketAddress (peerAddress, m_port));
+  m_burstTxTrace (numPdus, packet->GetSize ());
+}
+
+void
+EpcGtpuBurstAggregator::FlushAll ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_pendingBursts.empty ())
+    {
+      Flush (m_pendingBursts.begin ()->first);
+    }
+}
+
+void
+EpcGtpuBurstAggregator::Split (Ptr<Packet> datagram, std::list<Ptr<Packet> >& pdus)
+{
+  NS_LOG_FUNCTION (datagram);
+  GtpuHeader gtpu;
+  while (datagram->GetSize () > 0)
+    {
+      datagram->PeekHeader (gtpu);
+      // From 3GPP TS 29.281 v10.0.0 Section 5.1, the Length field does
+      // not include the first 8 bytes of the GTP-U header
+      uint32_t pduSize = gtpu.GetLength () + 8;
+      NS_ASSERT_MSG (pduSize <= datagram->GetSize (), "truncated GTP-U PDU");
+      if (pduSize == datagram->GetSize ())
+        {
+          pdus.push_back (datagram);
+          return;
+        }
+      pdus.push_back (datagram->CreateFragment (0, pduSize));
+      datagram->RemoveAtStart (pduSize);
+    }
+}
+
+} // namespace ns3
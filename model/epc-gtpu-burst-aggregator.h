@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EPC_GTPU_BURST_AGGREGATOR_H
+#define EPC_GTPU_BURST_AGGREGATOR_H
+
+#include <ns3/object.h>
+#include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/socket.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/traced-callback.h>
+
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup lte
+ *
+ * Aggregates GTP-U PDUs addressed to the same GTP-U peer within a
+ * configurable time window, and sends them as one UDP datagram. The
+ * PDUs are simply concatenated, each one keeping its own GTP-U header:
+ * the receiver splits the datagram back into the original PDUs with
+ * Split (), using the Length field of each GTP-U header, so that the
+ * per-PDU GTP-U processing is unchanged.
+ *
+ * With a zero window (the default) every PDU is sent right away as in
+ * plain GTP-U.
+ *
+ * \note byte tags are preserved across a burst, while packet tags of
+ * the aggregated PDUs are not.
+ */
+class EpcGtpuBurstAggregator : public Object
+{
+public:
+  EpcGtpuBurstAggregator ();
+  virtual ~EpcGtpuBurstAggregator ();
+
+  // inherited from Object
+  static TypeId GetTypeId (void);
+  virtual void DoDispose (void);
+
+  /**
+   * Set the socket used to send the bursts
+   *
+   * \param socket the UDP socket
+   * \param port the UDP port of the GTP-U peers
+   */
+  void SetSocket (Ptr<Socket> socket, uint16_t port);
+
+  /**
+   * Send a GTP-U PDU, possibly delaying it by up to the aggregation
+   * window to send it together with other PDUs addressed to the same
+   * peer.
+   *
+   * \param pdu the GTP-U PDU, including its GtpuHeader
+   * \param peerAddress the address of the GTP-U peer
+   */
+  void Send (Ptr<Packet> pdu, Ipv4Address peerAddress);
+
+  /**
+   * Send right away all the pending bursts
+   */
+  void FlushAll ();
+
+  /**
+   * Split a received UDP datagram into the GTP-U PDUs it carries. A
+   * datagram carrying a single PDU is returned as is.
+   *
+   * \param datagram the received datagram, which is consumed
+   * \param pdus the list to which the PDUs are appended
+   */
+  static void Split (Ptr<Packet> datagram, std::list<Ptr<Packet> >& pdus);
+
+  /**
+   * TracedCallback signature for the transmission of a burst
+   *
+   * \param [in] numPdus the number of GTP-U PDUs in the burst
+   * \param [in] numBytes the size of the burst in bytes
+   */
+  typedef void (* BurstTxTracedCallback)
+    (uint32_t numPdus, uint32_t numBytes);
+
+private:
+
+  /**
+   * Send the pending burst for a given peer
+   *
+   * \param peerAddress the address of the GTP-U peer
+   */
+  void Flush (Ipv4Address peerAddress);
+
+  /**
+   * Get the max size of the bursts for a given peer, aborting if
+   * MaxBurstSize would not fit in the MTU of the device towards it
+   *
+   * \param peerAddress the address of the GTP-U peer
+   * \return the max size of a burst in bytes
+   */
+  uint32_t GetMaxBurstSize (Ipv4Address peerAddress);
+
+  /// a burst being aggregated
+  struct PendingBurst
+  {
+    Ptr<Packet> packet; ///< the PDUs aggregated so far
+    uint32_t numPdus;   ///< the number of PDUs in packet
+    EventId flushEvent; ///< the end of the aggregation window
+  };
+
+  std::map<Ipv4Address, PendingBurst> m_pendingBursts; ///< pending bursts by peer address
+
+  Ptr<Socket> m_socket; ///< socket used to send the bursts
+  uint16_t m_port;      ///< UDP port of the GTP-U peers
+
+  Time m_window;          ///< aggregation window
+  uint32_t m_maxBurstSize; ///< max size of a burst in bytes, 0 for the MTU
+  std::map<Ipv4Address, uint32_t> m_mtuBurstSizes; ///< largest burst that fits in the MTU, by peer address
+
+  /**
+   * Trace fired upon the transmission of a burst
+   */
+  TracedCallback<uint32_t, uint32_t> m_burstTxTrace;
+};
+
+} // namespace ns3
+
+#endif /* EPC_GTPU_BURST_AGGREGATOR_H */
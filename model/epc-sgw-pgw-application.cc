@@ -27,6 +27,7 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/epc-gtpu-header.h"
 #include "ns3/abort.h"
+#include "ns3/pointer.h"
 
 namespace ns3 {
 
@@ -101,7 +102,14 @@ EpcSgwPgwApplication::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::EpcSgwPgwApplication")
     .SetParent<Object> ()
-    .SetGroupName("Lte");
+    .SetGroupName("Lte")
+    .AddAttribute ("S1uBurstAggregator",
+                   "The aggregator of the GTP-U PDUs sent to the eNBs over S1-U.",
+                   TypeId::ATTR_GET,
+                   PointerValue (),
+                   MakePointerAccessor (&EpcSgwPgwApplication::m_s1uBurstAggregator),
+                   MakePointerChecker<EpcGtpuBurstAggregator> ())
+    ;
   return tid;
 }
 
@@ -111,6 +119,8 @@ EpcSgwPgwApplication::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_s1uSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s1uSocket = 0;
+  m_s1uBurstAggregator->Dispose ();
+  m_s1uBurstAggregator = 0;
   delete (m_s11SapSgw);
 }
 
@@ -125,6 +135,8 @@ EpcSgwPgwApplication::EpcSgwPgwApplication (const Ptr<VirtualNetDevice> tunDevic
 {
   NS_LOG_FUNCTION (this << tunDevice << s1uSocket);
   m_s1uSocket->SetRecvCallback (MakeCallback (&EpcSgwPgwApplication::RecvFromS1uSocket, this));
+  m_s1uBurstAggregator = CreateObject<EpcGtpuBurstAggregator> ();
+  m_s1uBurstAggregator->SetSocket (m_s1uSocket, m_gtpuUdpPort);
   m_s11SapSgw = new MemberEpcS11SapSgw<EpcSgwPgwApplication> (this);
 }
 
@@ -178,17 +190,24 @@ EpcSgwPgwApplication::RecvFromS1uSocket (Ptr<Socket> socket)
 {
   NS_LOG_FUNCTION (this << socket);  
   NS_ASSERT (socket == m_s1uSocket);
-  Ptr<Packet> packet = socket->Recv ();
-  GtpuHeader gtpu;
-  packet->RemoveHeader (gtpu);
-  uint32_t teid = gtpu.GetTeid ();
+  std::list<Ptr<Packet> > packets;
+  EpcGtpuBurstAggregator::Split (socket->Recv (), packets);
+  for (std::list<Ptr<Packet> >::iterator it = packets.begin ();
+       it != packets.end ();
+       ++it)
+    {
+      Ptr<Packet> packet = *it;
+      GtpuHeader gtpu;
+      packet->RemoveHeader (gtpu);
+      uint32_t teid = gtpu.GetTeid ();
 
-  /// \internal
-  /// Workaround for \bugid{231}
-  SocketAddressTag tag;
-  packet->RemovePacketTag (tag);
+      /// \internal
+      /// Workaround for \bugid{231}
+      SocketAddressTag tag;
+      packet->RemovePacketTag (tag);
 
-  SendToTunDevice (packet, teid);
+      SendToTunDevice (packet, teid);
+    }
 }
 
 void 
@@ -210,8 +229,7 @@ EpcSgwPgwApplication::SendToS1uSocket (Ptr<Packet> packet, Ipv4Address enbAddr,
   // Length of the payload + the non obligatory GTP-U header
   gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);  
   packet->AddHeader (gtpu);
-  uint32_t flags = 0;
-  m_s1uSocket->SendTo (packet, flags, InetSocketAddress (enbAddr, m_gtpuUdpPort));
+  m_s1uBurstAggregator->Send (packet, enbAddr);
 }
 
 
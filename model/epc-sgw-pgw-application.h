@@ -36,6 +36,7 @@
 #include <ns3/application.h>
 #include <ns3/epc-s1ap-sap.h>
 #include <ns3/epc-s11-sap.h>
+#include <ns3/epc-gtpu-burst-aggregator.h>
 #include <map>
 
 namespace ns3 {
@@ -252,6 +253,11 @@ public:
    */
   uint16_t m_gtpuUdpPort;
 
+  /**
+   * Aggregator of the GTP-U PDUs sent to the eNBs
+   */
+  Ptr<EpcGtpuBurstAggregator> m_s1uBurstAggregator;
+
   uint32_t m_teidCount;
 
   /**
@@ -29,20 +29,97 @@
 #include "epc-tft-classifier.h"
 #include "epc-tft.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
 
+#include <algorithm>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
+EpcTftClassifier::FieldIndex::FieldIndex ()
+  : m_numWords (0)
+{
+}
+
+void
+EpcTftClassifier::FieldIndex::Clear (uint32_t numWords)
+{
+  m_ranges.clear ();
+  m_boundaries.clear ();
+  m_bitmaps.clear ();
+  m_numWords = numWords;
+}
+
+void
+EpcTftClassifier::FieldIndex::AddRange (uint32_t start, uint32_t end, uint32_t filter)
+{
+  NS_ASSERT (start <= end);
+  Range r;
+  r.start = start;
+  r.end = end;
+  r.filter = filter;
+  m_ranges.push_back (r);
+}
+
+void
+EpcTftClassifier::FieldIndex::Build ()
+{
+  // the boundaries of the elementary intervals are the first value
+  // of each range and the value following its last one
+  m_boundaries.push_back (0);
+  for (std::vector<Range>::const_iterator it = m_ranges.begin ();
+       it != m_ranges.end ();
+       ++it)
+    {
+      m_boundaries.push_back (it->start);
+      if (it->end < 0xffffffff)
+        {
+          m_boundaries.push_back (it->end + 1);
+        }
+    }
+  std::sort (m_boundaries.begin (), m_boundaries.end ());
+  m_boundaries.erase (std::unique (m_boundaries.begin (), m_boundaries.end ()),
+                      m_boundaries.end ());
+
+  m_bitmaps.assign (m_boundaries.size () * m_numWords, 0);
+  for (uint32_t i = 0; i < m_boundaries.size (); ++i)
+    {
+      // an elementary interval is either fully covered by a range or
+      // not covered at all, hence checking its first value is enough
+      uint64_t* bitmap = &m_bitmaps[i * m_numWords];
+      for (std::vector<Range>::const_iterator it = m_ranges.begin ();
+           it != m_ranges.end ();
+           ++it)
+        {
+          if (it->start <= m_boundaries[i] && m_boundaries[i] <= it->end)
+            {
+              bitmap[it->filter / 64] |= (uint64_t) 1 << (it->filter % 64);
+            }
+        }
+    }
+}
+
+const uint64_t*
+EpcTftClassifier::FieldIndex::Lookup (uint32_t value) const
+{
+  NS_ASSERT (!m_boundaries.empty ());
+  // m_boundaries[0] == 0, hence upper_bound never returns begin ()
+  std::vector<uint32_t>::const_iterator it = std::upper_bound (m_boundaries.begin (),
+                                                               m_boundaries.end (),
+                                                               value);
+  return &m_bitmaps[(it - m_boundaries.begin () - 1) * m_numWords];
+}
+
+
 EpcTftClassifier::EpcTftClassifier ()
+  : m_numWords (0)
 {
   NS_LOG_FUNCTION (this);
+  Compile ();
 }
 
 void
@@ -53,7 +130,9 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
   m_tftMap[id] = tft;  
   
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
-  NS_ASSERT (m_tftMap.size () <= 16);
+  NS_ABORT_MSG_IF (m_tftMap.size () > 16, "more than 16 TFTs per UE");
+
+  Compile ();
 }
 
 void
@@ -61,6 +140,134 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  Compile ();
+}
+
+/**
+ * \param mask an IPv4 mask
+ * \return true if the bits set in the mask are contiguous, starting
+ * from the most significant one
+ */
+static bool
+IsContiguousMask (uint32_t mask)
+{
+  uint32_t inverse = ~mask;
+  return (inverse & (inverse + 1)) == 0;
+}
+
+void
+EpcTftClassifier::Compile ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_filters.clear ();
+  m_compiledNumFilters.clear ();
+
+  // we use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin ();
+       it != m_tftMap.rend ();
+       ++it)
+    {
+      m_compiledNumFilters.push_back (it->second->GetNumFilters ());
+      std::list<EpcTft::PacketFilter> filters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator fit = filters.begin ();
+           fit != filters.end ();
+           ++fit)
+        {
+          CompiledFilter f;
+          f.tftId = it->first;
+          f.direction = fit->direction;
+          f.remoteMask = fit->remoteMask.Get ();
+          f.remoteAddress = fit->remoteAddress.Get () & f.remoteMask;
+          f.localMask = fit->localMask.Get ();
+          f.localAddress = fit->localAddress.Get () & f.localMask;
+          f.remotePortStart = fit->remotePortStart;
+          f.remotePortEnd = fit->remotePortEnd;
+          f.localPortStart = fit->localPortStart;
+          f.localPortEnd = fit->localPortEnd;
+          f.typeOfServiceMask = fit->typeOfServiceMask;
+          f.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          f.verifyAddresses = !IsContiguousMask (f.remoteMask) || !IsContiguousMask (f.localMask);
+          m_filters.push_back (f);
+        }
+    }
+
+  m_numWords = (m_filters.size () + 63) / 64;
+  if (m_numWords == 0)
+    {
+      // keep the indexes valid even with no filter at all
+      m_numWords = 1;
+    }
+  m_directionBitmap[0].assign (m_numWords, 0);
+  m_directionBitmap[1].assign (m_numWords, 0);
+  m_remoteAddressIndex.Clear (m_numWords);
+  m_localAddressIndex.Clear (m_numWords);
+  m_remotePortIndex.Clear (m_numWords);
+  m_localPortIndex.Clear (m_numWords);
+
+  uint32_t filterIndex = 0;
+  for (std::vector<CompiledFilter>::const_iterator it = m_filters.begin ();
+       it != m_filters.end ();
+       ++it, ++filterIndex)
+    {
+      const uint64_t bit = (uint64_t) 1 << (filterIndex % 64);
+      if (it->direction & EpcTft::DOWNLINK)
+        {
+          m_directionBitmap[0][filterIndex / 64] |= bit;
+        }
+      if (it->direction & EpcTft::UPLINK)
+        {
+          m_directionBitmap[1][filterIndex / 64] |= bit;
+        }
+
+      // non contiguous masks do not map onto a single range: let any
+      // address through, the filter will be verified after the lookup
+      if (it->verifyAddresses)
+        {
+          m_remoteAddressIndex.AddRange (0, 0xffffffff, filterIndex);
+          m_localAddressIndex.AddRange (0, 0xffffffff, filterIndex);
+        }
+      else
+        {
+          m_remoteAddressIndex.AddRange (it->remoteAddress, it->remoteAddress | ~it->remoteMask, filterIndex);
+          m_localAddressIndex.AddRange (it->localAddress, it->localAddress | ~it->localMask, filterIndex);
+        }
+
+      // an empty port range never matches
+      if (it->remotePortStart <= it->remotePortEnd)
+        {
+          m_remotePortIndex.AddRange (it->remotePortStart, it->remotePortEnd, filterIndex);
+        }
+      if (it->localPortStart <= it->localPortEnd)
+        {
+          m_localPortIndex.AddRange (it->localPortStart, it->localPortEnd, filterIndex);
+        }
+    }
+
+  m_remoteAddressIndex.Build ();
+  m_localAddressIndex.Build ();
+  m_remotePortIndex.Build ();
+  m_localPortIndex.Build ();
+
+  NS_LOG_LOGIC ("compiled " << m_filters.size () << " filters from " << m_tftMap.size () << " TFTs");
+}
+
+bool
+EpcTftClassifier::IsOutdated () const
+{
+  // m_compiledNumFilters follows the reverse order of m_tftMap
+  std::vector<uint8_t>::const_reverse_iterator nit = m_compiledNumFilters.rbegin ();
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_iterator it = m_tftMap.begin ();
+       it != m_tftMap.end ();
+       ++it, ++nit)
+    {
+      if (it->second->GetNumFilters () != *nit)
+        {
+          return true;
+        }
+    }
+  return false;
 }
 
  
@@ -69,93 +276,112 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
+  if (IsOutdated ())
+    {
+      NS_LOG_LOGIC ("a TFT was modified, recompiling");
+      Compile ();
+    }
 
-  Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  // peek at the IPv4 header (up to 60 bytes with options) and at the
+  // first 4 bytes of the transport header (the ports), without copying
+  // nor modifying the packet
+  uint8_t buf[64];
+  uint32_t size = p->CopyData (buf, sizeof (buf));
+  if (size < 20)
+    {
+      NS_LOG_INFO ("packet too short for an IPv4 header: " << size);
+      return 0;  // no match
+    }
+  uint32_t headerLength = (buf[0] & 0x0f) * 4;
 
-  Ipv4Address localAddress;
-  Ipv4Address remoteAddress;
+  uint8_t tos = buf[1];
+  uint8_t protocol = buf[9];
+  uint32_t source = ((uint32_t) buf[12] << 24) | ((uint32_t) buf[13] << 16)
+    | ((uint32_t) buf[14] << 8) | buf[15];
+  uint32_t destination = ((uint32_t) buf[16] << 24) | ((uint32_t) buf[17] << 16)
+    | ((uint32_t) buf[18] << 8) | buf[19];
 
+  uint32_t localAddress;
+  uint32_t remoteAddress;
   
   if (direction ==  EpcTft::UPLINK)
     {
-      localAddress = ipv4Header.GetSource ();
-      remoteAddress = ipv4Header.GetDestination ();
+      localAddress = source;
+      remoteAddress = destination;
     }
   else
     { 
       NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-      remoteAddress = ipv4Header.GetSource ();
-      localAddress = ipv4Header.GetDestination ();      
+      remoteAddress = source;
+      localAddress = destination;
     }
-  
-  uint8_t protocol = ipv4Header.GetProtocol ();
 
-  uint8_t tos = ipv4Header.GetTos ();
-
-  uint16_t localPort = 0;
-  uint16_t remotePort = 0;
-
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
+  if (protocol != UdpL4Protocol::PROT_NUMBER && protocol != TcpL4Protocol::PROT_NUMBER)
     {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
-
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
+      NS_LOG_INFO ("Unknown protocol: " << protocol);
+      return 0;  // no match
     }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
+  if (headerLength < 20 || size < headerLength + 4)
     {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
-	}
+      NS_LOG_INFO ("packet too short for a transport header: " << size);
+      return 0;  // no match
+    }
+
+  // UDP and TCP both start with source port and destination port
+  uint16_t sourcePort = ((uint16_t) buf[headerLength] << 8) | buf[headerLength + 1];
+  uint16_t destinationPort = ((uint16_t) buf[headerLength + 2] << 8) | buf[headerLength + 3];
+  uint16_t localPort;
+  uint16_t remotePort;
+  if (direction ==  EpcTft::UPLINK)
+    {
+      localPort = sourcePort;
+      remotePort = destinationPort;
     }
   else
     {
-      NS_LOG_INFO ("Unknown protocol: " << protocol);
-      return 0;  // no match
+      remotePort = sourcePort;
+      localPort = destinationPort;
     }
 
   NS_LOG_INFO ("Classifing packet:"
-	       << " localAddr="  << localAddress 
-	       << " remoteAddr=" << remoteAddress 
+	       << " localAddr="  << Ipv4Address (localAddress)
+	       << " remoteAddr=" << Ipv4Address (remoteAddress)
 	       << " localPort="  << localPort 
 	       << " remotePort=" << remotePort 
 	       << " tos=0x" << (uint16_t) tos );
 
-  // now it is possible to classify the packet!
-  // we use a reverse iterator since filter priority is not implemented properly.
-  // This way, since the default bearer is expected to be added first, it will be evaluated last.
-  std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+  const uint64_t* directionBitmap = &m_directionBitmap[direction == EpcTft::UPLINK ? 1 : 0][0];
+  const uint64_t* remoteAddressBitmap = m_remoteAddressIndex.Lookup (remoteAddress);
+  const uint64_t* localAddressBitmap = m_localAddressIndex.Lookup (localAddress);
+  const uint64_t* remotePortBitmap = m_remotePortIndex.Lookup (remotePort);
+  const uint64_t* localPortBitmap = m_localPortIndex.Lookup (localPort);
 
-  for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+  for (uint32_t w = 0; w < m_numWords; ++w)
     {
-      NS_LOG_LOGIC ("TFT id: " << it->first );
-      NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-      Ptr<EpcTft> tft = it->second;         
-      if (tft->Matches (direction, remoteAddress, localAddress, remotePort, localPort, tos))
+      uint64_t candidates = directionBitmap[w] & remoteAddressBitmap[w] & localAddressBitmap[w]
+        & remotePortBitmap[w] & localPortBitmap[w];
+      while (candidates != 0)
         {
-	  NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-	  return it->first; // the id of the matching TFT
+          // lowest bit set first, i.e., filters in evaluation order
+          uint32_t bit = 0;
+          while (((candidates >> bit) & 1) == 0)
+            {
+              ++bit;
+            }
+          candidates &= candidates - 1;
+          const CompiledFilter& f = m_filters[w * 64 + bit];
+          if ((tos & f.typeOfServiceMask) != f.typeOfService)
+            {
+              continue;
+            }
+          if (f.verifyAddresses
+              && (((remoteAddress & f.remoteMask) != f.remoteAddress)
+                  || ((localAddress & f.localMask) != f.localAddress)))
+            {
+              continue;
+            }
+          NS_LOG_LOGIC ("matches with TFT ID = " << f.tftId);
+          return f.tftId; // the id of the matching TFT
         }
     }
   NS_LOG_LOGIC ("no match");
@@ -28,6 +28,7 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -37,7 +38,19 @@ class Packet;
 
 /**
  * \brief classifies IP packets accoding to Traffic Flow Templates (TFTs)
- * 
+ *
+ * The set of TFTs is compiled into a decision structure every time a
+ * TFT is added or deleted, and before classifying a packet if a packet
+ * filter has been added to one of the TFTs since then. Each packet filter is assigned one bit, in
+ * the order in which filters are to be evaluated. For every
+ * classification field (remote address, local address, remote port,
+ * local port) the value space is split into elementary intervals, each
+ * one holding the bitmap of the filters that cover it. Classifying a
+ * packet hence requires one binary search per field and the AND of the
+ * resulting bitmaps; the first bit set is the matching filter. Address
+ * masks that are not contiguous and the type of service are verified
+ * on the candidate filter only.
+ *
  * \note this implementation works with IPv4 only.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
@@ -72,8 +85,99 @@ public:
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction);
   
 protected:
-  
+
+  /**
+   * Rebuild the decision structure out of m_tftMap
+   */
+  void Compile ();
+
+  /**
+   * \return true if a filter was added to one of the TFTs after the
+   * last compilation
+   */
+  bool IsOutdated () const;
+
+  /**
+   * Flattened copy of an EpcTft::PacketFilter, together with the
+   * identifier of the TFT it belongs to
+   */
+  struct CompiledFilter
+  {
+    uint32_t tftId;            ///< identifier of the TFT owning the filter
+    uint8_t direction;         ///< EpcTft::Direction bitmask
+    uint32_t remoteAddress;    ///< remote address
+    uint32_t remoteMask;       ///< remote address mask
+    uint32_t localAddress;     ///< local address
+    uint32_t localMask;        ///< local address mask
+    uint16_t remotePortStart;  ///< start of the remote port range
+    uint16_t remotePortEnd;    ///< end of the remote port range
+    uint16_t localPortStart;   ///< start of the local port range
+    uint16_t localPortEnd;     ///< end of the local port range
+    uint8_t typeOfService;     ///< type of service
+    uint8_t typeOfServiceMask; ///< type of service mask
+    bool verifyAddresses;      ///< true if any of the masks is not contiguous
+  };
+
+  /**
+   * Elementary interval index over a single classification field
+   */
+  class FieldIndex
+  {
+  public:
+    FieldIndex ();
+
+    /**
+     * Remove all the ranges and set the bitmap size
+     *
+     * \param numWords number of 64 bit words of each bitmap
+     */
+    void Clear (uint32_t numWords);
+
+    /**
+     * Register the range covered by a filter
+     *
+     * \param start first value of the range
+     * \param end last value of the range (inclusive)
+     * \param filter the filter index (i.e., its bit)
+     */
+    void AddRange (uint32_t start, uint32_t end, uint32_t filter);
+
+    /**
+     * Split the value space into elementary intervals and compute
+     * their bitmaps. To be called after all the ranges have been added.
+     */
+    void Build ();
+
+    /**
+     * \param value the value of the field
+     * \return the bitmap of the filters covering the value
+     */
+    const uint64_t* Lookup (uint32_t value) const;
+
+  private:
+    /// a range registered by a filter
+    struct Range
+    {
+      uint32_t start;  ///< first value
+      uint32_t end;    ///< last value
+      uint32_t filter; ///< filter index
+    };
+    std::vector<Range> m_ranges;        ///< registered ranges
+    std::vector<uint32_t> m_boundaries; ///< first value of each elementary interval
+    std::vector<uint64_t> m_bitmaps;    ///< bitmaps of the elementary intervals
+    uint32_t m_numWords;                ///< words per bitmap
+  };
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap;
+  std::vector<uint8_t> m_compiledNumFilters; ///< number of filters of each TFT of m_tftMap when compiled
+
+  std::vector<CompiledFilter> m_filters; ///< filters, in evaluation order
+  uint32_t m_numWords;                   ///< words per bitmap
+  std::vector<uint64_t> m_directionBitmap[2]; ///< filters per direction: 0 downlink, 1 uplink
+  FieldIndex m_remoteAddressIndex;       ///< remote address index
+  FieldIndex m_localAddressIndex;        ///< local address index
+  FieldIndex m_remotePortIndex;          ///< remote port index
+  FieldIndex m_localPortIndex;           ///< local port index
   
 };
 
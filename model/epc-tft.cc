@@ -169,6 +169,12 @@ EpcTft::Add (PacketFilter f)
   ++m_numFilters;
   return (m_numFilters - 1);
 }
+
+uint8_t
+EpcTft::GetNumFilters () const
+{
+  return m_numFilters;
+}
     
 bool 
 EpcTft::Matches (Direction direction,
@@ -191,5 +197,12 @@ EpcTft::Matches (Direction direction,
   return false;
 }
 
+std::list<EpcTft::PacketFilter>
+EpcTft::GetPacketFilters () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_filters;
+}
+
 
 } // namespace ns3
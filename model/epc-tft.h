@@ -150,6 +150,18 @@ public:
 		  uint16_t localPort,
 		  uint8_t typeOfService);
 
+  /** 
+   * \return the packet filters of this TFT, in order of evaluation
+   * (i.e., sorted by increasing precedence value)
+   */
+  std::list<PacketFilter> GetPacketFilters () const;
+
+  /**
+   * \return the number of packet filters of this TFT. Since filters can
+   * only be added, it changes every time the TFT is modified.
+   */
+  uint8_t GetNumFilters () const;
+
 
 private:
 
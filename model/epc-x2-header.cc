@@ -278,6 +278,7 @@ EpcX2HandoverRequestHeader::Deserialize (Buffer::Iterator start)
   int sz = i.ReadNtohU32 ();
   m_headerLength += 27;
   m_numberOfIes++;
+  m_erabsToBeSetupList.reserve (sz);
 
   for (int j = 0; j < sz; j++)
     {
@@ -519,6 +520,7 @@ EpcX2HandoverRequestAckHeader::Deserialize (Buffer::Iterator start)
   int sz = i.ReadNtohU32 ();
   m_headerLength += 4;
   m_numberOfIes++;
+  m_erabsAdmittedList.reserve (sz);
 
   for (int j = 0; j < sz; j++)
     {
@@ -535,6 +537,7 @@ EpcX2HandoverRequestAckHeader::Deserialize (Buffer::Iterator start)
   sz = i.ReadNtohU32 ();
   m_headerLength += 4;
   m_numberOfIes++;
+  m_erabsNotAdmittedList.reserve (sz);
 
   for (int j = 0; j < sz; j++)
     {
@@ -875,6 +878,7 @@ EpcX2SnStatusTransferHeader::Deserialize (Buffer::Iterator start)
 
   m_numberOfIes = 3;
   m_headerLength = 6 + sz * (14 + (EpcX2Sap::m_maxPdcpSn / 64));
+  m_erabsSubjectToStatusTransferList.reserve (sz);
 
   for (int j = 0; j < sz; j++)
     {
@@ -1199,6 +1203,7 @@ EpcX2LoadInformationHeader::Deserialize (Buffer::Iterator start)
   int sz = i.ReadNtohU16 ();
   m_headerLength += 6;
   m_numberOfIes++;
+  m_cellInformationList.reserve (sz);
 
   for (int j = 0; j < sz; j++)
     {
@@ -1208,6 +1213,7 @@ EpcX2LoadInformationHeader::Deserialize (Buffer::Iterator start)
 
       int sz2 = i.ReadNtohU16 ();
       m_headerLength += 2;
+      cellInfoItem.ulInterferenceOverloadIndicationList.reserve (sz2);
       for (int k = 0; k < sz2; k++)
         {
           EpcX2Sap::UlInterferenceOverloadIndicationItem item = (EpcX2Sap::UlInterferenceOverloadIndicationItem) i.ReadU8 ();
@@ -1217,6 +1223,7 @@ EpcX2LoadInformationHeader::Deserialize (Buffer::Iterator start)
 
       int sz3 = i.ReadNtohU16 ();
       m_headerLength += 2;
+      cellInfoItem.ulHighInterferenceInformationList.reserve (sz3);
       for (int k = 0; k < sz3; k++)
         {
           EpcX2Sap::UlHighInterferenceInformationItem item;
@@ -1225,6 +1232,7 @@ EpcX2LoadInformationHeader::Deserialize (Buffer::Iterator start)
 
           int sz4 = i.ReadNtohU16 ();
           m_headerLength += 2;
+          item.ulHighInterferenceIndicationList.reserve (sz4);
           for (int m = 0; m < sz4; m++)
             {
               item.ulHighInterferenceIndicationList.push_back (i.ReadU8 ());
@@ -1236,6 +1244,7 @@ EpcX2LoadInformationHeader::Deserialize (Buffer::Iterator start)
 
       int sz5 = i.ReadNtohU16 ();
       m_headerLength += 2;
+      cellInfoItem.relativeNarrowbandTxBand.rntpPerPrbList.reserve (sz5);
       for (int k = 0; k < sz5; k++)
         {
           cellInfoItem.relativeNarrowbandTxBand.rntpPerPrbList.push_back (i.ReadU8 ());
@@ -1399,6 +1408,7 @@ EpcX2ResourceStatusUpdateHeader::Deserialize (Buffer::Iterator start)
   m_enb2MeasurementId = i.ReadNtohU16 ();
 
   int sz = i.ReadNtohU16 ();
+  m_cellMeasurementResultList.reserve (sz);
   for (int j = 0; j < sz; j++)
     {
       EpcX2Sap::CellMeasurementResultItem item;
@@ -22,6 +22,8 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 #include "ns3/epc-gtpu-header.h"
 
 #include "ns3/epc-x2-header.h"
@@ -83,7 +85,8 @@ NS_OBJECT_ENSURE_REGISTERED (EpcX2);
 
 EpcX2::EpcX2 ()
   : m_x2cUdpPort (4444),
-    m_x2uUdpPort (2152)
+    m_x2uUdpPort (2152),
+    m_x2uMaxBurstSize (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -102,6 +105,12 @@ EpcX2::DoDispose (void)
 
   m_x2InterfaceSockets.clear ();
   m_x2InterfaceCellIds.clear ();
+  for (std::map<uint16_t, X2uBurst>::iterator it = m_x2uBursts.begin ();
+       it != m_x2uBursts.end (); ++it)
+    {
+      it->second.event.Cancel ();
+    }
+  m_x2uBursts.clear ();
   delete m_x2SapProvider;
 }
 
@@ -110,7 +119,17 @@ EpcX2::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::EpcX2")
     .SetParent<Object> ()
-    .SetGroupName("Lte");
+    .SetGroupName("Lte")
+    .AddAttribute ("X2uMaxBurstSize",
+                   "Maximum size in bytes of the UDP payload carrying the UE data "
+                   "forwarded at the same time to a neighbour eNB, e.g., the "
+                   "transmission buffers of a UE leaving for that eNB. The GTP-U "
+                   "PDUs are concatenated up to this size and sent as a single "
+                   "datagram; the packet tags of the UE data are not kept. "
+                   "Zero sends each packet in its own datagram.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&EpcX2::m_x2uMaxBurstSize),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
 
@@ -380,18 +399,32 @@ EpcX2::RecvFromX2uSocket (Ptr<Socket> socket)
                  "Missing infos of local and remote CellId");
   Ptr<X2CellInfo> cellsInfo = m_x2InterfaceCellIds [socket];
 
-  GtpuHeader gtpu;
-  packet->RemoveHeader (gtpu);
+  // the datagram carries one GTP-U PDU, or several of them with X2-U bursts
+  bool last = false;
+  while (!last)
+    {
+      GtpuHeader gtpu;
+      packet->RemoveHeader (gtpu);
+
+      NS_LOG_LOGIC ("GTP-U header: " << gtpu);
 
-  NS_LOG_LOGIC ("GTP-U header: " << gtpu);
+      uint32_t ueDataSize = gtpu.GetLength () + 8 - gtpu.GetSerializedSize ();
+      last = ueDataSize >= packet->GetSize ();
+      Ptr<Packet> ueData = packet;
+      if (!last)
+        {
+          ueData = packet->CreateFragment (0, ueDataSize);
+          packet->RemoveAtStart (ueDataSize);
+        }
 
-  EpcX2SapUser::UeDataParams params;
-  params.sourceCellId = cellsInfo->m_remoteCellId;
-  params.targetCellId = cellsInfo->m_localCellId;
-  params.gtpTeid = gtpu.GetTeid ();
-  params.ueData = packet;
+      EpcX2SapUser::UeDataParams params;
+      params.sourceCellId = cellsInfo->m_remoteCellId;
+      params.targetCellId = cellsInfo->m_localCellId;
+      params.gtpTeid = gtpu.GetTeid ();
+      params.ueData = ueData;
 
-  m_x2SapUser->RecvUeData (params);
+      m_x2SapUser->RecvUeData (params);
+    }
 }
 
 
@@ -757,8 +790,45 @@ EpcX2::DoSendUeData (EpcX2SapProvider::UeDataParams params)
   Ptr<Packet> packet = params.ueData;
   packet->AddHeader (gtpu);
 
-  NS_LOG_INFO ("Forward UE DATA through X2 interface");
-  sourceSocket->SendTo (packet, 0, InetSocketAddress (targetIpAddr, m_x2uUdpPort));
+  if (m_x2uMaxBurstSize == 0)
+    {
+      NS_LOG_INFO ("Forward UE DATA through X2 interface");
+      sourceSocket->SendTo (packet, 0, InetSocketAddress (targetIpAddr, m_x2uUdpPort));
+      return;
+    }
+
+  // the UE data forwarded at this time goes in one burst
+  X2uBurst& burst = m_x2uBursts[params.targetCellId];
+  if (burst.packet != 0 && burst.packet->GetSize () + packet->GetSize () > m_x2uMaxBurstSize)
+    {
+      SendX2uBurst (params.targetCellId);
+    }
+  if (burst.packet == 0)
+    {
+      burst.packet = Create<Packet> ();
+      burst.event = Simulator::ScheduleNow (&EpcX2::SendX2uBurst, this, params.targetCellId);
+    }
+  NS_LOG_LOGIC ("adding " << packet->GetSize () << " bytes to the X2-U burst of " << burst.packet->GetSize () << " bytes");
+  burst.packet->AddAtEnd (packet);
+}
+
+void
+EpcX2::SendX2uBurst (uint16_t targetCellId)
+{
+  NS_LOG_FUNCTION (this << targetCellId);
+
+  std::map<uint16_t, X2uBurst>::iterator it = m_x2uBursts.find (targetCellId);
+  if (it == m_x2uBursts.end () || it->second.packet == 0)
+    {
+      return;
+    }
+  it->second.event.Cancel ();
+  Ptr<Packet> packet = it->second.packet;
+  it->second.packet = 0;
+
+  Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [targetCellId];
+  NS_LOG_INFO ("Forward a burst of " << packet->GetSize () << " bytes of UE DATA through X2 interface");
+  socketInfo->m_localUserPlaneSocket->SendTo (packet, 0, InetSocketAddress (socketInfo->m_remoteIpAddr, m_x2uUdpPort));
 }
 
 } // namespace ns3
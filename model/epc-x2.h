@@ -25,6 +25,8 @@
 #include "ns3/callback.h"
 #include "ns3/ptr.h"
 #include "ns3/object.h"
+#include "ns3/packet.h"
+#include "ns3/event-id.h"
 
 #include "ns3/epc-x2-sap.h"
 
@@ -124,6 +126,13 @@ public:
    */
   void RecvFromX2uSocket (Ptr<Socket> socket);
 
+  /**
+   * Send the X2-U burst being built for a neighbour eNB, if any
+   *
+   * \param targetCellId the cell ID of the neighbour eNB
+   */
+  void SendX2uBurst (uint16_t targetCellId);
+
 
 protected:
   // Interface provided by EpcX2SapProvider
@@ -160,6 +169,22 @@ private:
   uint16_t m_x2cUdpPort;
   uint16_t m_x2uUdpPort;
 
+  /**
+   * Maximum size of an X2-U burst, 0 if the UE data is sent one packet
+   * per datagram
+   */
+  uint32_t m_x2uMaxBurstSize;
+
+  /// GTP-U PDUs sent at the same time to a neighbour eNB, carried by a single datagram
+  struct X2uBurst
+  {
+    Ptr<Packet> packet; ///< the concatenated GTP-U PDUs, 0 if none
+    EventId event; ///< the event sending the burst
+  };
+
+  /// X2-U burst being built for each neighbour eNB, by cell ID
+  std::map<uint16_t, X2uBurst> m_x2uBursts;
+
 };
 
 } //namespace ns3
@@ -22,6 +22,8 @@
 #include "ff-mac-scheduler.h"
 #include <ns3/log.h>
 #include <ns3/enum.h>
+#include <ns3/lte-common.h>
+#include <ns3/lte-vendor-specific-parameters.h>
 
 
 namespace ns3 {
@@ -62,10 +64,55 @@ FfMacScheduler::GetTypeId (void)
                    MakeEnumChecker (FfMacScheduler::SRS_UL_CQI, "SRS_UL_CQI",
                                     FfMacScheduler::PUSCH_UL_CQI, "PUSCH_UL_CQI",
                                     FfMacScheduler::ALL_UL_CQI, "ALL_UL_CQI"))
+    .AddTraceSource ("UlSrsCqiChanged",
+                     "The SRS UL-CQIs of a UE changed.",
+                     MakeTraceSourceAccessor (&FfMacScheduler::m_ulSrsCqiChangedTrace),
+                     "ns3::FfMacScheduler::UlSrsCqiChangedTracedCallback")
     ;
   return tid;
 }
 
+void
+FfMacScheduler::UpdateSrsUlCqi (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params,
+                                uint8_t ulBandwidth,
+                                std::map <uint16_t, std::vector <double> >& ueCqi,
+                                std::map <uint16_t, uint32_t>& ueCqiTimers,
+                                uint32_t cqiTimersThreshold)
+{
+  NS_LOG_FUNCTION (this);
+  // get the RNTI from vendor specific parameters
+  uint16_t rnti = 0;
+  NS_ASSERT (params.m_vendorSpecificList.size () > 0);
+  for (uint16_t i = 0; i < params.m_vendorSpecificList.size (); i++)
+    {
+      if (params.m_vendorSpecificList.at (i).m_type == SRS_CQI_RNTI_VSP)
+        {
+          Ptr<SrsCqiRntiVsp> vsp = DynamicCast<SrsCqiRntiVsp> (params.m_vendorSpecificList.at (i).m_value);
+          rnti = vsp->GetRnti ();
+        }
+    }
+  // update the values in place, creating the entry of the UE at its
+  // first SRS
+  std::pair<std::map <uint16_t, std::vector <double> >::iterator, bool> ret;
+  ret = ueCqi.insert (std::pair <uint16_t, std::vector <double> > (rnti, std::vector <double> ()));
+  std::vector <double>& cqi = ret.first->second;
+  bool changed = ret.second || cqi.size () != ulBandwidth;
+  cqi.resize (ulBandwidth);
+  for (uint32_t j = 0; j < ulBandwidth; j++)
+    {
+      double sinr = LteFfConverter::fpS11dot3toDouble (params.m_ulCqi.m_sinr.at (j));
+      changed = changed || cqi[j] != sinr;
+      cqi[j] = sinr;
+      NS_LOG_INFO (this << " RNTI " << rnti << " SRS-CQI for RB  " << j << " value " << sinr);
+    }
+  // generate or update correspondent timer
+  ueCqiTimers[rnti] = cqiTimersThreshold;
+  if (changed)
+    {
+      m_ulSrsCqiChangedTrace (rnti);
+    }
+}
+
 
 } // namespace ns3
 
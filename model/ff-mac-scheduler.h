@@ -23,6 +23,11 @@
 #define FF_MAC_SCHEDULER_H
 
 #include <ns3/object.h>
+#include <ns3/traced-callback.h>
+#include <ns3/ff-mac-sched-sap.h>
+
+#include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -124,10 +129,40 @@ public:
    */
   virtual LteFfrSapUser* GetLteFfrSapUser () = 0;
   
+  /**
+   * TracedCallback signature for the change of the SRS UL-CQIs of a UE
+   *
+   * \param [in] rnti the RNTI of the UE
+   */
+  typedef void (* UlSrsCqiChangedTracedCallback) (uint16_t rnti);
+
 protected:
-    
+
+  /**
+   * Store the per-RB SINRs of an SRS UL-CQI report in the UL-CQIs of the
+   * scheduler, creating the entry of the UE at its first SRS, and restart
+   * the validity timer of the UE. The UlSrsCqiChanged trace is fired if
+   * the SINRs of the UE differ from those stored.
+   *
+   * \param params the UL-CQI report, of SRS type
+   * \param ulBandwidth the UL bandwidth in RBs
+   * \param ueCqi the per-RB SINRs of the UEs, by RNTI
+   * \param ueCqiTimers the validity timers of the UL-CQIs, by RNTI
+   * \param cqiTimersThreshold the validity of a UL-CQI in TTIs
+   */
+  void UpdateSrsUlCqi (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params,
+                       uint8_t ulBandwidth,
+                       std::map <uint16_t, std::vector <double> >& ueCqi,
+                       std::map <uint16_t, uint32_t>& ueCqiTimers,
+                       uint32_t cqiTimersThreshold);
+
   UlCqiFilter_t m_ulCqiFilter;
 
+  /**
+   * Trace fired when the SRS UL-CQIs of a UE change
+   */
+  TracedCallback<uint16_t> m_ulSrsCqiChangedTrace;
+
 };
 
 }  // namespace ns3
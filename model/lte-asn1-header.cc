@@ -23,9 +23,7 @@
 #include "ns3/log.h"
 #include "ns3/lte-asn1-header.h"
 
-#include <stdio.h>
 #include <sstream>
-#include <cmath>
 
 namespace ns3 {
 
@@ -33,6 +31,21 @@ NS_LOG_COMPONENT_DEFINE ("Asn1Header");
 
 NS_OBJECT_ENSURE_REGISTERED (Asn1Header);
 
+/**
+ * \param range number of values of a constrained whole number
+ * \return the number of bits needed to encode it, i.e., ceil (log2 (range))
+ */
+static uint32_t
+GetRequiredBits (int range)
+{
+  uint32_t requiredBits = 0;
+  while ((((int64_t) 1) << requiredBits) < range)
+    {
+      ++requiredBits;
+    }
+  return requiredBits;
+}
+
 TypeId
 Asn1Header::GetTypeId (void)
 {
@@ -51,9 +64,11 @@ Asn1Header::GetInstanceTypeId (void) const
 
 Asn1Header::Asn1Header ()
 {
-  m_serializationPendingBits = 0x00;
-  m_numSerializationPendingBits = 0;
+  m_serializationCache = 0;
+  m_numSerializationCacheBits = 0;
   m_isDataSerialized = false;
+  m_deserializationCache = 0;
+  m_numDeserializationCacheBits = 0;
 }
 
 Asn1Header::~Asn1Header ()
@@ -79,96 +94,95 @@ void Asn1Header::Serialize (Buffer::Iterator bIterator) const
   bIterator.Write (m_serializationResult.Begin (),m_serializationResult.End ());
 }
 
-void Asn1Header::WriteOctet (uint8_t octet) const
+void Asn1Header::StartSerialization (void) const
 {
-  m_serializationResult.AddAtEnd (1);
-  Buffer::Iterator bIterator = m_serializationResult.End ();
-  bIterator.Prev ();
-  bIterator.WriteU8 (octet);
+  m_serializationCache = 0;
+  m_numSerializationCacheBits = 0;
+  // clear () keeps the capacity, so that the buffer is allocated only
+  // the first time a message is serialized
+  m_serializationBytes.clear ();
+  m_serializationBytes.reserve (256);
+  m_serializationResult = Buffer ();
 }
 
-template <int N>
-void Asn1Header::SerializeBitset (std::bitset<N> data) const
+void Asn1Header::WriteBits (uint64_t value, uint32_t numBits) const
 {
+  NS_ASSERT (numBits <= 64);
+  if (numBits == 0)
+    {
+      return;
+    }
+  if (numBits < 64)
+    {
+      value &= (((uint64_t) 1) << numBits) - 1;
+    }
+
+  uint32_t freeBits = 64 - m_numSerializationCacheBits;
+  if (numBits < freeBits)
+    {
+      m_serializationCache = (m_serializationCache << numBits) | value;
+      m_numSerializationCacheBits += numBits;
+      return;
+    }
+
+  // Complete the cached word with the most significant bits of the
+  // value, and move it to the octet buffer
+  uint32_t remainingBits = numBits - freeBits;
+  uint64_t word = (freeBits == 64) ? value : ((m_serializationCache << freeBits) | (value >> remainingBits));
+  for (int shift = 56; shift >= 0; shift -= 8)
+    {
+      m_serializationBytes.push_back ((uint8_t) (word >> shift));
+    }
+  m_serializationCache = (remainingBits > 0) ? (value & ((((uint64_t) 1) << remainingBits) - 1)) : 0;
+  m_numSerializationCacheBits = remainingBits;
+}
 
-  size_t dataSize = data.size ();
-  uint8_t pendingBits = dataSize;
-  uint8_t mask = 1;
-  int j;
+uint64_t Asn1Header::ReadBits (uint32_t numBits, Buffer::Iterator &bIterator)
+{
+  NS_ASSERT (numBits <= 64);
+  if (numBits == 0)
+    {
+      return 0;
+    }
+  if (numBits > 56)
+    {
+      // the cache cannot hold the octets of the field on top of the
+      // cached bits, read it in two halves
+      uint64_t high = ReadBits (numBits - 32, bIterator);
+      return (high << 32) | ReadBits (32, bIterator);
+    }
 
+  // Less than 8 bits are cached: load all the missing octets at once
+  while (m_numDeserializationCacheBits < numBits)
+    {
+      m_deserializationCache |= ((uint64_t) bIterator.ReadU8 ()) << (56 - m_numDeserializationCacheBits);
+      m_numDeserializationCacheBits += 8;
+    }
+
+  uint64_t value = m_deserializationCache >> (64 - numBits);
+  m_deserializationCache <<= numBits;
+  m_numDeserializationCacheBits -= numBits;
+  return value;
+}
+
+template <int N>
+void Asn1Header::SerializeBitset (std::bitset<N> data) const
+{
   // No extension marker (Clause 16.7 ITU-T X.691),
   // as 3GPP TS 36.331 does not use it in its IE's.
 
   // Clause 16.8 ITU-T X.691
-  if (dataSize == 0)
+  if (N == 0)
     {
       return;
     }
 
   // Clause 16.9 ITU-T X.691
   // Clause 16.10 ITU-T X.691
-  if (dataSize <= 65536)
-    {
-      // If there are bits pending to be processed,
-      // append first bits in data to complete an octet.
-      if (m_numSerializationPendingBits > 0)
-        {
-          mask = 0x80 >> m_numSerializationPendingBits;
-          while (pendingBits > 0 && m_numSerializationPendingBits < 8)
-            {
-              m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-              pendingBits--;
-              m_numSerializationPendingBits++;
-              mask = (mask >> 1) & (~mask);
-            }
-
-          if (m_numSerializationPendingBits >= 8)
-            {
-              WriteOctet (m_serializationPendingBits);
-              m_numSerializationPendingBits = 0;
-              m_serializationPendingBits = 0;
-            }
-        }
-
-      while (pendingBits > 0)
-        {
-          mask = 1;
-          j = 8;
-
-          // If there are less than 8 remaining bits,
-          // store it to m_serializationPendingBits.
-          if (pendingBits < 8)
-            {
-              mask = 0x80;
-              m_numSerializationPendingBits = pendingBits;
-              while (pendingBits > 0)
-                {
-                  m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-                  mask = (mask >> 1) & (~mask);
-                  pendingBits--;
-                }
-            }
-
-          // Write the data to buffer
-          else
-            {
-              uint8_t octetToWrite = 0;
-              for (; j > 0; j--)
-                {
-                  octetToWrite |= (data[pendingBits - j]) ? mask : 0;
-                  mask = (mask << 1) & (~mask);
-                }
-              WriteOctet (octetToWrite);
-              pendingBits -= 8;
-            }
-        }
-    }
-
-  // Clause 16.11 ITU-T X.691
-  else
-    {
-      printf ("FRAGMENTATION NEEDED!\n");
-    }
+  // The bitsets used by 3GPP TS 36.331 IE's have at most 32 bits, so
+  // they fit in an unsigned long and are written in one operation.
+  NS_ASSERT (N <= 32);
+  WriteBits (data.to_ulong (), N);
 }
 
 template <int N>
@@ -343,76 +357,8 @@ void Asn1Header::SerializeInteger (int n, int nmin, int nmax) const
     }
 
   // Clause 11.5.6 ITU-T X.691
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  switch (requiredBits)
-    {
-    case 1:
-      SerializeBitset<1> (std::bitset<1> (n));
-      break;
-    case 2:
-      SerializeBitset<2> (std::bitset<2> (n));
-      break;
-    case 3:
-      SerializeBitset<3> (std::bitset<3> (n));
-      break;
-    case 4:
-      SerializeBitset<4> (std::bitset<4> (n));
-      break;
-    case 5:
-      SerializeBitset<5> (std::bitset<5> (n));
-      break;
-    case 6:
-      SerializeBitset<6> (std::bitset<6> (n));
-      break;
-    case 7:
-      SerializeBitset<7> (std::bitset<7> (n));
-      break;
-    case 8:
-      SerializeBitset<8> (std::bitset<8> (n));
-      break;
-    case 9:
-      SerializeBitset<9> (std::bitset<9> (n));
-      break;
-    case 10:
-      SerializeBitset<10> (std::bitset<10> (n));
-      break;
-    case 11:
-      SerializeBitset<11> (std::bitset<11> (n));
-      break;
-    case 12:
-      SerializeBitset<12> (std::bitset<12> (n));
-      break;
-    case 13:
-      SerializeBitset<13> (std::bitset<13> (n));
-      break;
-    case 14:
-      SerializeBitset<14> (std::bitset<14> (n));
-      break;
-    case 15:
-      SerializeBitset<15> (std::bitset<15> (n));
-      break;
-    case 16:
-      SerializeBitset<16> (std::bitset<16> (n));
-      break;
-    case 17:
-      SerializeBitset<17> (std::bitset<17> (n));
-      break;
-    case 18:
-      SerializeBitset<18> (std::bitset<18> (n));
-      break;
-    case 19:
-      SerializeBitset<19> (std::bitset<19> (n));
-      break;
-    case 20:
-      SerializeBitset<20> (std::bitset<20> (n));
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger " << requiredBits << " Out of range!!" << std::endl;
-        exit (1);
-      }
-    }
+  uint32_t requiredBits = GetRequiredBits (range);
+  WriteBits (n, requiredBits);
 }
 
 void Asn1Header::SerializeNull () const
@@ -423,10 +369,23 @@ void Asn1Header::SerializeNull () const
 
 void Asn1Header::FinalizeSerialization () const
 {
-  if (m_numSerializationPendingBits > 0)
+  // Move the cached bits to the octet buffer, padding the last octet
+  // with zeros
+  uint32_t paddingBits = (8 - m_numSerializationCacheBits % 8) % 8;
+  uint64_t word = m_serializationCache << paddingBits;
+  for (int shift = m_numSerializationCacheBits + paddingBits - 8; shift >= 0; shift -= 8)
     {
-      m_numSerializationPendingBits = 0;
-      SerializeBitset<8> (std::bitset<8> (m_serializationPendingBits));
+      m_serializationBytes.push_back ((uint8_t) (word >> shift));
+    }
+  m_serializationCache = 0;
+  m_numSerializationCacheBits = 0;
+
+  // Copy the octets to the result in one operation
+  m_serializationResult = Buffer ();
+  m_serializationResult.AddAtEnd (m_serializationBytes.size ());
+  if (!m_serializationBytes.empty ())
+    {
+      m_serializationResult.Begin ().Write (&m_serializationBytes[0], m_serializationBytes.size ());
     }
   m_isDataSerialized = true;
 }
@@ -434,53 +393,8 @@ void Asn1Header::FinalizeSerialization () const
 template <int N>
 Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
 {
-
-  int bitsToRead = N;
-  uint8_t mask;
-
-  // Read bits from pending bits
-  if (m_numSerializationPendingBits > 0)
-    {
-      while (bitsToRead > 0 && m_numSerializationPendingBits > 0)
-        {
-          data->set (bitsToRead - 1,(m_serializationPendingBits & 0x80) ? 1 : 0);
-          bitsToRead--;
-          m_numSerializationPendingBits--;
-          m_serializationPendingBits = m_serializationPendingBits << 1;
-        }
-    }
-
-  // Read bits from buffer
-  while (bitsToRead > 0)
-    {
-      uint8_t octet = bIterator.ReadU8 ();
-      // If 8 bits can be allocated to the bitset, set the bits
-      if (bitsToRead >= 8)
-        {
-          mask = 0x80;
-          for (int j = 0; j < 8; j++)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
-
-      // Otherwise, we'll have to save the remaining bits
-      else
-        {
-          mask = 0x80;
-          m_numSerializationPendingBits = 8 - bitsToRead;
-          m_serializationPendingBits = octet << bitsToRead;
-          while (bitsToRead > 0)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
-    }
-
+  NS_ASSERT (N <= 32);
+  *data = std::bitset<N> ((unsigned long) ReadBits (N, bIterator));
   return bIterator;
 }
 
@@ -555,117 +469,8 @@ Buffer::Iterator Asn1Header::DeserializeInteger (int *n, int nmin, int nmax, Buf
       return bIterator;
     }
 
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  std::bitset<1> bitsRead1;
-  std::bitset<2> bitsRead2;
-  std::bitset<3> bitsRead3;
-  std::bitset<4> bitsRead4;
-  std::bitset<5> bitsRead5;
-  std::bitset<6> bitsRead6;
-  std::bitset<7> bitsRead7;
-  std::bitset<8> bitsRead8;
-  std::bitset<9> bitsRead9;
-  std::bitset<10> bitsRead10;
-  std::bitset<11> bitsRead11;
-  std::bitset<12> bitsRead12;
-  std::bitset<13> bitsRead13;
-  std::bitset<14> bitsRead14;
-  std::bitset<15> bitsRead15;
-  std::bitset<16> bitsRead16;
-  std::bitset<17> bitsRead17;
-  std::bitset<18> bitsRead18;
-  std::bitset<19> bitsRead19;
-  std::bitset<20> bitsRead20;
-
-  switch (requiredBits)
-    {
-    case 1:
-      bIterator = DeserializeBitset<1> (&bitsRead1,bIterator);
-      *n = (int)bitsRead1.to_ulong ();
-      break;
-    case 2: 
-      bIterator = DeserializeBitset<2> (&bitsRead2,bIterator);
-      *n = (int)bitsRead2.to_ulong ();
-      break;
-    case 3: 
-      bIterator = DeserializeBitset<3> (&bitsRead3,bIterator);
-      *n = (int)bitsRead3.to_ulong ();
-      break;
-    case 4: 
-      bIterator = DeserializeBitset<4> (&bitsRead4,bIterator);
-      *n = (int)bitsRead4.to_ulong ();
-      break;
-    case 5:
-      bIterator = DeserializeBitset<5> (&bitsRead5,bIterator);
-      *n = (int)bitsRead5.to_ulong ();
-      break;
-    case 6:
-      bIterator = DeserializeBitset<6> (&bitsRead6,bIterator);
-      *n = (int)bitsRead6.to_ulong ();
-      break;
-    case 7:
-      bIterator = DeserializeBitset<7> (&bitsRead7,bIterator);
-      *n = (int)bitsRead7.to_ulong ();
-      break;
-    case 8:
-      bIterator = DeserializeBitset<8> (&bitsRead8,bIterator);
-      *n = (int)bitsRead8.to_ulong ();
-      break;
-    case 9:
-      bIterator = DeserializeBitset<9> (&bitsRead9,bIterator);
-      *n = (int)bitsRead9.to_ulong ();
-      break;
-    case 10:
-      bIterator = DeserializeBitset<10> (&bitsRead10,bIterator);
-      *n = (int)bitsRead10.to_ulong ();
-      break;
-    case 11:
-      bIterator = DeserializeBitset<11> (&bitsRead11,bIterator);
-      *n = (int)bitsRead11.to_ulong ();
-      break;
-    case 12:
-      bIterator = DeserializeBitset<12> (&bitsRead12,bIterator);
-      *n = (int)bitsRead12.to_ulong ();
-      break;
-    case 13:
-      bIterator = DeserializeBitset<13> (&bitsRead13,bIterator);
-      *n = (int)bitsRead13.to_ulong ();
-      break;
-    case 14:
-      bIterator = DeserializeBitset<14> (&bitsRead14,bIterator);
-      *n = (int)bitsRead14.to_ulong ();
-      break;
-    case 15:
-      bIterator = DeserializeBitset<15> (&bitsRead15,bIterator);
-      *n = (int)bitsRead15.to_ulong ();
-      break;
-    case 16:
-      bIterator = DeserializeBitset<16> (&bitsRead16,bIterator);
-      *n = (int)bitsRead16.to_ulong ();
-      break;
-    case 17:
-      bIterator = DeserializeBitset<17> (&bitsRead17,bIterator);
-      *n = (int)bitsRead17.to_ulong ();
-      break;
-    case 18:
-      bIterator = DeserializeBitset<18> (&bitsRead18,bIterator);
-      *n = (int)bitsRead18.to_ulong ();
-      break;
-    case 19:
-      bIterator = DeserializeBitset<19> (&bitsRead19,bIterator);
-      *n = (int)bitsRead19.to_ulong ();
-      break;
-    case 20:
-      bIterator = DeserializeBitset<20> (&bitsRead20,bIterator);
-      *n = (int)bitsRead20.to_ulong ();
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger Out of range!!" << std::endl;
-        exit (1);
-      }
-    }
+  uint32_t requiredBits = GetRequiredBits (range);
+  *n = (int) ReadBits (requiredBits, bIterator);
 
   *n += nmin;
 
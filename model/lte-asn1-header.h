@@ -27,6 +27,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -67,16 +68,38 @@ public:
   virtual void PreSerialize (void) const = 0;
 
 protected:
-  mutable uint8_t m_serializationPendingBits; //!< pending bits
-  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
+  mutable uint64_t m_serializationCache; //!< bits not yet moved to m_serializationBytes, right aligned
+  mutable uint8_t m_numSerializationCacheBits; //!< number of bits in m_serializationCache
+  mutable std::vector<uint8_t> m_serializationBytes; //!< octets serialized so far
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  uint64_t m_deserializationCache; //!< bits read but not yet deserialized, left aligned
+  uint8_t m_numDeserializationCacheBits; //!< number of bits in m_deserializationCache
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
-   * \param octet bits to write
+   * Start a new serialization, discarding the result of the previous
+   * one. To be called at the beginning of PreSerialize.
    */
-  void WriteOctet (uint8_t octet) const;
+  void StartSerialization (void) const;
+
+  /**
+   * Append a bit field to the serialization, most significant bit first.
+   * The bits are accumulated in a 64 bit word, which is moved to a
+   * contiguous octet buffer when full.
+   * \param value the bits to write, right aligned
+   * \param numBits number of bits to write, at most 64
+   */
+  void WriteBits (uint64_t value, uint32_t numBits) const;
+
+  /**
+   * Read a bit field, most significant bit first. Only the octets
+   * holding the missing bits are read from the buffer, so that at most
+   * 7 bits remain cached after the field is extracted.
+   * \param numBits number of bits to read, at most 64
+   * \param bIterator buffer iterator, advanced past the octets read
+   * \returns the bits read, right aligned
+   */
+  uint64_t ReadBits (uint32_t numBits, Buffer::Iterator &bIterator);
 
   // Serialization functions
 
@@ -0,0 +1,197 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-channel-gain-cache.h"
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/pointer.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteChannelGainCache");
+
+NS_OBJECT_ENSURE_REGISTERED (LteChannelGainCache);
+
+LteChannelGainCache::LteChannelGainCache ()
+  : m_nHits (0),
+    m_nMisses (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteChannelGainCache::~LteChannelGainCache ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+LteChannelGainCache::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteChannelGainCache")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName("Lte")
+    .AddConstructor<LteChannelGainCache> ()
+    .AddAttribute ("PropagationLossModel",
+                   "The propagation loss model whose losses are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&LteChannelGainCache::SetPropagationLossModel,
+                                        &LteChannelGainCache::GetPropagationLossModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("MaxAge",
+                   "Time after which a cached loss is computed again. "
+                   "Zero means that the losses are computed again only "
+                   "after a course change of one of the nodes.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&LteChannelGainCache::m_maxAge),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+void
+LteChannelGainCache::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_model = 0;
+  m_nodeIndex.clear ();
+  m_generation.clear ();
+  m_entries.clear ();
+  PropagationLossModel::DoDispose ();
+}
+
+void
+LteChannelGainCache::SetPropagationLossModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_model = model;
+  Flush ();
+}
+
+Ptr<PropagationLossModel>
+LteChannelGainCache::GetPropagationLossModel () const
+{
+  return m_model;
+}
+
+void
+LteChannelGainCache::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<std::vector<Entry> >::iterator it = m_entries.begin ();
+       it != m_entries.end (); ++it)
+    {
+      for (std::vector<Entry>::iterator entryIt = it->begin (); entryIt != it->end (); ++entryIt)
+        {
+          entryIt->valid = false;
+        }
+    }
+}
+
+uint64_t
+LteChannelGainCache::GetNHits () const
+{
+  return m_nHits;
+}
+
+uint64_t
+LteChannelGainCache::GetNMisses () const
+{
+  return m_nMisses;
+}
+
+uint32_t
+LteChannelGainCache::GetNodeIndex (Ptr<MobilityModel> mobility) const
+{
+  std::map<const MobilityModel*, uint32_t>::const_iterator it = m_nodeIndex.find (PeekPointer (mobility));
+  if (it != m_nodeIndex.end ())
+    {
+      return it->second;
+    }
+
+  uint32_t index = m_generation.size ();
+  NS_LOG_LOGIC (this << " node " << index << " has mobility model " << mobility);
+  m_nodeIndex[PeekPointer (mobility)] = index;
+  m_generation.push_back (0);
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&LteChannelGainCache::CourseChanged,
+                                                      const_cast<LteChannelGainCache*> (this)));
+  return index;
+}
+
+void
+LteChannelGainCache::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::map<const MobilityModel*, uint32_t>::const_iterator it = m_nodeIndex.find (PeekPointer (mobility));
+  if (it != m_nodeIndex.end ())
+    {
+      ++m_generation[it->second];
+    }
+}
+
+double
+LteChannelGainCache::DoCalcRxPower (double txPowerDbm,
+                                    Ptr<MobilityModel> a,
+                                    Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "no propagation loss model to cache");
+  uint32_t txIndex = GetNodeIndex (a);
+  uint32_t rxIndex = GetNodeIndex (b);
+  if (txIndex >= m_entries.size ())
+    {
+      m_entries.resize (txIndex + 1);
+    }
+  std::vector<Entry>& txEntries = m_entries[txIndex];
+  if (rxIndex >= txEntries.size ())
+    {
+      Entry invalid;
+      invalid.lossDb = 0.0;
+      invalid.txGeneration = 0;
+      invalid.rxGeneration = 0;
+      invalid.valid = false;
+      txEntries.resize (rxIndex + 1, invalid);
+    }
+
+  Entry& entry = txEntries[rxIndex];
+  Time now = Simulator::Now ();
+  if (entry.valid
+      && entry.txGeneration == m_generation[txIndex]
+      && entry.rxGeneration == m_generation[rxIndex]
+      && (m_maxAge.IsZero () || now - entry.computed < m_maxAge))
+    {
+      ++m_nHits;
+      return txPowerDbm - entry.lossDb;
+    }
+
+  ++m_nMisses;
+  double rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  entry.lossDb = txPowerDbm - rxPowerDbm;
+  entry.txGeneration = m_generation[txIndex];
+  entry.rxGeneration = m_generation[rxIndex];
+  entry.computed = now;
+  entry.valid = true;
+  NS_LOG_LOGIC (this << " loss " << entry.lossDb << " dB from node " << txIndex
+                     << " to node " << rxIndex);
+  return rxPowerDbm;
+}
+
+int64_t
+LteChannelGainCache::DoAssignStreams (int64_t stream)
+{
+  return m_model != 0 ? m_model->AssignStreams (stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_CHANNEL_GAIN_CACHE_H
+#define LTE_CHANNEL_GAIN_CACHE_H
+
+#include <ns3/propagation-loss-model.h>
+#include <ns3/mobility-model.h>
+#include <ns3/nstime.h>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Propagation loss model caching the loss computed by another
+ * propagation loss model for each (transmitter, receiver) pair.
+ *
+ * An LTE spectrum channel computes the loss between every eNB and every
+ * UE for every transmission, although it changes only when one of them
+ * moves. This model keeps the last loss of each pair, the pairs being
+ * identified by the mobility models of the two nodes. An entry is
+ * invalidated when one of the nodes reports a course change (which
+ * includes any SetPosition) and, if MaxAge is not zero, when it is
+ * older than MaxAge. Nodes moving without changing course, e.g., with
+ * ConstantVelocityMobilityModel, need a MaxAge matching the accepted
+ * position error.
+ *
+ * The wrapped model must give a loss that depends only on the positions
+ * of the nodes: random loss models would be frozen by the cache.
+ */
+class LteChannelGainCache : public PropagationLossModel
+{
+public:
+  LteChannelGainCache ();
+  virtual ~LteChannelGainCache ();
+
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \param model the propagation loss model whose losses are cached
+   */
+  void SetPropagationLossModel (Ptr<PropagationLossModel> model);
+
+  /// \return the propagation loss model whose losses are cached
+  Ptr<PropagationLossModel> GetPropagationLossModel () const;
+
+  /// Invalidate all the entries, e.g., after a change of the wrapped model
+  void Flush ();
+
+  /// \return the number of losses found in the cache
+  uint64_t GetNHits () const;
+
+  /// \return the number of losses computed by the wrapped model
+  uint64_t GetNMisses () const;
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  // inherited from PropagationLossModel
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /// Cached loss of a (transmitter, receiver) pair
+  struct Entry
+  {
+    double lossDb; ///< loss in dB
+    uint32_t txGeneration; ///< course changes of the transmitter at computation time
+    uint32_t rxGeneration; ///< course changes of the receiver at computation time
+    Time computed; ///< computation time
+    bool valid; ///< whether the entry holds a loss
+  };
+
+  /**
+   * \param mobility the mobility model of a node
+   * \return the index of the node, a new index being given to (and the
+   *         course changes of) a node seen for the first time
+   */
+  uint32_t GetNodeIndex (Ptr<MobilityModel> mobility) const;
+
+  /**
+   * Trace sink of the course changes of the nodes
+   *
+   * \param mobility the mobility model of the node
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  Ptr<PropagationLossModel> m_model; ///< the wrapped model
+  Time m_maxAge; ///< maximum age of an entry, 0 for no limit
+  /// index of each node, by mobility model
+  mutable std::map<const MobilityModel*, uint32_t> m_nodeIndex;
+  /// number of course changes of each node
+  mutable std::vector<uint32_t> m_generation;
+  /// entries, indexed by transmitter then receiver
+  mutable std::vector<std::vector<Entry> > m_entries;
+  mutable uint64_t m_nHits; ///< number of losses found in the cache
+  mutable uint64_t m_nMisses; ///< number of losses computed
+};
+
+} // namespace ns3
+
+#endif // LTE_CHANNEL_GAIN_CACHE_H
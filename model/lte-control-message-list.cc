@@ -0,0 +1,111 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-control-message-list.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteControlMessageList");
+
+LteControlMessageList::LteControlMessageList (const std::list<Ptr<LteControlMessage> >& msgList)
+{
+  NS_LOG_FUNCTION (this << msgList.size ());
+  m_records.reserve (msgList.size ());
+  std::vector<std::pair<uint16_t, uint32_t> > index;
+  index.reserve (msgList.size ());
+  for (std::list<Ptr<LteControlMessage> >::const_iterator it = msgList.begin ();
+       it != msgList.end (); ++it)
+    {
+      Record record;
+      record.msg = *it;
+      record.rnti = GetMessageRnti (*it);
+      record.type = (*it)->GetMessageType ();
+      index.push_back (std::make_pair (record.rnti, (uint32_t) m_records.size ()));
+      m_records.push_back (record);
+    }
+
+  // the positions break the ties, keeping the order of transmission
+  std::sort (index.begin (), index.end ());
+  m_indexRntis.reserve (index.size ());
+  m_index.reserve (index.size ());
+  for (std::vector<std::pair<uint16_t, uint32_t> >::const_iterator it = index.begin ();
+       it != index.end (); ++it)
+    {
+      m_indexRntis.push_back (it->first);
+      m_index.push_back (it->second);
+    }
+}
+
+uint16_t
+LteControlMessageList::GetMessageRnti (Ptr<LteControlMessage> msg)
+{
+  switch (msg->GetMessageType ())
+    {
+    case LteControlMessage::DL_DCI:
+      return DynamicCast<DlDciLteControlMessage> (msg)->GetDci ().m_rnti;
+    case LteControlMessage::UL_DCI:
+      return DynamicCast<UlDciLteControlMessage> (msg)->GetDci ().m_rnti;
+    case LteControlMessage::DL_CQI:
+      return DynamicCast<DlCqiLteControlMessage> (msg)->GetDlCqi ().m_rnti;
+    case LteControlMessage::BSR:
+      return DynamicCast<BsrLteControlMessage> (msg)->GetBsr ().m_rnti;
+    case LteControlMessage::DL_HARQ:
+      return DynamicCast<DlHarqFeedbackLteControlMessage> (msg)->GetDlHarqFeedback ().m_rnti;
+    default:
+      return 0;
+    }
+}
+
+uint32_t
+LteControlMessageList::GetN () const
+{
+  return m_records.size ();
+}
+
+Ptr<LteControlMessage>
+LteControlMessageList::Get (uint32_t i) const
+{
+  NS_ASSERT (i < m_records.size ());
+  return m_records[i].msg;
+}
+
+LteControlMessage::MessageType
+LteControlMessageList::GetType (uint32_t i) const
+{
+  NS_ASSERT (i < m_records.size ());
+  return m_records[i].type;
+}
+
+uint16_t
+LteControlMessageList::GetRnti (uint32_t i) const
+{
+  NS_ASSERT (i < m_records.size ());
+  return m_records[i].rnti;
+}
+
+std::pair<LteControlMessageList::Iterator, LteControlMessageList::Iterator>
+LteControlMessageList::Find (uint16_t rnti) const
+{
+  std::pair<std::vector<uint16_t>::const_iterator, std::vector<uint16_t>::const_iterator> range
+    = std::equal_range (m_indexRntis.begin (), m_indexRntis.end (), rnti);
+  return std::make_pair (m_index.begin () + (range.first - m_indexRntis.begin ()),
+                         m_index.begin () + (range.second - m_indexRntis.begin ()));
+}
+
+} // namespace ns3
@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_CONTROL_MESSAGE_LIST_H
+#define LTE_CONTROL_MESSAGE_LIST_H
+
+#include <ns3/ptr.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/lte-control-messages.h>
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * The control messages sent by a PHY in a frame, as seen by all the
+ * receivers of the frame.
+ *
+ * The list is built once by the transmitter and is then shared,
+ * read-only, by the signal parameters of every receiver. Each message
+ * is kept in a contiguous record with its type and with the RNTI it is
+ * addressed to, so that the receivers do not need to decode the
+ * messages of the other UEs. An index of the records by RNTI is built
+ * with the list.
+ */
+class LteControlMessageList : public SimpleRefCount<LteControlMessageList>
+{
+public:
+  /// Iterator over the positions of the messages of an RNTI
+  typedef std::vector<uint32_t>::const_iterator Iterator;
+
+  /**
+   * \param msgList the control messages, in order of transmission
+   */
+  LteControlMessageList (const std::list<Ptr<LteControlMessage> >& msgList);
+
+  /// \return the number of messages
+  uint32_t GetN () const;
+
+  /**
+   * \param i the position of a message
+   * \return the message
+   */
+  Ptr<LteControlMessage> Get (uint32_t i) const;
+
+  /**
+   * \param i the position of a message
+   * \return the type of the message
+   */
+  LteControlMessage::MessageType GetType (uint32_t i) const;
+
+  /**
+   * \param i the position of a message
+   * \return the RNTI the message is addressed to or comes from, 0 for
+   *         messages not bound to a single UE (MIB, SIB1, RAR, RACH
+   *         preamble)
+   */
+  uint16_t GetRnti (uint32_t i) const;
+
+  /**
+   * \param rnti an RNTI, 0 for the messages not bound to a single UE
+   * \return the range of the positions of the messages of the RNTI, in
+   *         order of transmission
+   */
+  std::pair<Iterator, Iterator> Find (uint16_t rnti) const;
+
+private:
+  /**
+   * \param msg a control message
+   * \return the RNTI of the message, as returned by GetRnti
+   */
+  static uint16_t GetMessageRnti (Ptr<LteControlMessage> msg);
+
+  /// A control message and its decoded addressing
+  struct Record
+  {
+    Ptr<LteControlMessage> msg; ///< the message
+    uint16_t rnti; ///< the RNTI of the message
+    LteControlMessage::MessageType type; ///< the type of the message
+  };
+
+  std::vector<Record> m_records; ///< the messages, in order of transmission
+  std::vector<uint16_t> m_indexRntis; ///< the RNTI of each entry of m_index, sorted
+  std::vector<uint32_t> m_index; ///< the positions of the messages, sorted by RNTI
+};
+
+} // namespace ns3
+
+#endif // LTE_CONTROL_MESSAGE_LIST_H
@@ -248,7 +248,7 @@ public:
   virtual void SubframeIndication (uint32_t frameNo, uint32_t subframeNo);
   virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg);
   virtual void ReceiveRachPreamble (uint32_t prachId);
-  virtual void UlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi);
+  virtual void UlCqiReport (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& ulcqi);
   virtual void UlInfoListElementHarqFeeback (UlInfoListElement_s params);
   virtual void DlInfoListElementHarqFeeback (DlInfoListElement_s params);
 
@@ -286,7 +286,7 @@ EnbMacMemberLteEnbPhySapUser::ReceiveRachPreamble (uint32_t prachId)
 }
 
 void
-EnbMacMemberLteEnbPhySapUser::UlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi)
+EnbMacMemberLteEnbPhySapUser::UlCqiReport (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& ulcqi)
 {
   m_mac->DoUlCqiReport (ulcqi);
 }
@@ -654,7 +654,7 @@ LteEnbMac::DoReceiveRachPreamble  (uint8_t rapId)
 }
 
 void
-LteEnbMac::DoUlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi)
+LteEnbMac::DoUlCqiReport (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& ulcqi)
 { 
   if (ulcqi.m_ulCqi.m_type == UlCqi_s::PUSCH)
     {
@@ -179,7 +179,7 @@ private:
   void ReceiveBsrMessage  (MacCeListElement_s bsr);
 
  
-  void DoUlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi);
+  void DoUlCqiReport (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& ulcqi);
 
 
 
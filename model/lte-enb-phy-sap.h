@@ -108,7 +108,7 @@ public:
    * \brief Returns to MAC level the UL-CQI evaluated
    * \param ulcqi the UL-CQI (see FF MAC API 4.3.29)
    */
-  virtual void UlCqiReport (FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi) = 0;
+  virtual void UlCqiReport (const FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& ulcqi) = 0;
 
   /**
    * Notify the HARQ on the UL tranmission status
@@ -240,6 +240,8 @@ LteEnbPhy::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_ueAttached.clear ();
   m_srsUeOffset.clear ();
+  m_mibMsg = 0;
+  m_sib1Msg = 0;
   delete m_enbPhySapProvider;
   delete m_enbCphySapProvider;
   LtePhy::DoDispose ();
@@ -520,52 +522,27 @@ LteEnbPhy::ReceiveLteControlMessage (Ptr<LteControlMessage> msg)
 }
 
 void
-LteEnbPhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgList)
+LteEnbPhy::ReceiveLteControlMessageList (Ptr<const LteControlMessageList> msgList)
 {
   NS_LOG_FUNCTION (this);
-  std::list<Ptr<LteControlMessage> >::iterator it;
-  for (it = msgList.begin (); it != msgList.end (); it++)
+  for (uint32_t i = 0; i < msgList->GetN (); ++i)
     {
-      switch ((*it)->GetMessageType ())
+      switch (msgList->GetType (i))
         {
         case LteControlMessage::RACH_PREAMBLE:
           {
-            Ptr<RachPreambleLteControlMessage> rachPreamble = DynamicCast<RachPreambleLteControlMessage> (*it);
+            Ptr<RachPreambleLteControlMessage> rachPreamble = DynamicCast<RachPreambleLteControlMessage> (msgList->Get (i));
             m_enbPhySapUser->ReceiveRachPreamble (rachPreamble->GetRapId ());
           }
           break;
         case LteControlMessage::DL_CQI:
-          {
-            Ptr<DlCqiLteControlMessage> dlcqiMsg = DynamicCast<DlCqiLteControlMessage> (*it);
-            CqiListElement_s dlcqi = dlcqiMsg->GetDlCqi ();
-            // check whether the UE is connected
-            if (m_ueAttached.find (dlcqi.m_rnti) != m_ueAttached.end ())
-              {
-                m_enbPhySapUser->ReceiveLteControlMessage (*it);
-              }
-          }
-          break;
         case LteControlMessage::BSR:
-          {
-            Ptr<BsrLteControlMessage> bsrMsg = DynamicCast<BsrLteControlMessage> (*it);
-            MacCeListElement_s bsr = bsrMsg->GetBsr ();
-            // check whether the UE is connected
-            if (m_ueAttached.find (bsr.m_rnti) != m_ueAttached.end ())
-              {
-                m_enbPhySapUser->ReceiveLteControlMessage (*it);
-              }
-          }
-          break;
         case LteControlMessage::DL_HARQ:
-          {
-            Ptr<DlHarqFeedbackLteControlMessage> dlharqMsg = DynamicCast<DlHarqFeedbackLteControlMessage> (*it);
-            DlInfoListElement_s dlharq = dlharqMsg->GetDlHarqFeedback ();
-            // check whether the UE is connected
-            if (m_ueAttached.find (dlharq.m_rnti) != m_ueAttached.end ())
-              {
-                m_enbPhySapUser->ReceiveLteControlMessage (*it);
-              }
-          }
+          // check whether the UE is connected
+          if (m_ueAttached.find (msgList->GetRnti (i)) != m_ueAttached.end ())
+            {
+              m_enbPhySapUser->ReceiveLteControlMessage (msgList->Get (i));
+            }
           break;
         default:
           NS_FATAL_ERROR ("Unexpected LteControlMessage type");
@@ -587,9 +564,12 @@ LteEnbPhy::StartFrame (void)
 
   // send MIB at beginning of every frame
   m_mib.systemFrameNumber = m_nrSubFrames;
-  Ptr<MibLteControlMessage> mibMsg = Create<MibLteControlMessage> ();
-  mibMsg->SetMib (m_mib);
-  m_controlMessagesQueue.at (0).push_back (mibMsg);
+  if (m_mibMsg == 0 || m_mibMsg->GetMib ().systemFrameNumber != m_mib.systemFrameNumber)
+    {
+      m_mibMsg = Create<MibLteControlMessage> ();
+      m_mibMsg->SetMib (m_mib);
+    }
+  m_controlMessagesQueue.at (0).push_back (m_mibMsg);
 
   StartSubFrame ();
 }
@@ -611,9 +591,12 @@ LteEnbPhy::StartSubFrame (void)
    */
   if ((m_nrSubFrames == 6) && ((m_nrFrames % 2) == 1))
     {
-      Ptr<Sib1LteControlMessage> msg = Create<Sib1LteControlMessage> ();
-      msg->SetSib1 (m_sib1);
-      m_controlMessagesQueue.at (0).push_back (msg);
+      if (m_sib1Msg == 0)
+        {
+          m_sib1Msg = Create<Sib1LteControlMessage> ();
+          m_sib1Msg->SetSib1 (m_sib1);
+        }
+      m_controlMessagesQueue.at (0).push_back (m_sib1Msg);
     }
 
   if (m_srsPeriodicity>0)
@@ -869,6 +852,7 @@ LteEnbPhy::CreatePuschCqiReport (const SpectrumValue& sinr)
   Values::const_iterator it;
   FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi;
   ulcqi.m_ulCqi.m_type = UlCqi_s::PUSCH;
+  ulcqi.m_ulCqi.m_sinr.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
   int i = 0;
   for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
     {
@@ -970,6 +954,7 @@ LteEnbPhy::CreateSrsCqiReport (const SpectrumValue& sinr)
   Values::const_iterator it;
   FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi;
   ulcqi.m_ulCqi.m_type = UlCqi_s::SRS;
+  ulcqi.m_ulCqi.m_sinr.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
   int i = 0;
   double srsSum = 0.0;
   for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
@@ -983,16 +968,15 @@ LteEnbPhy::CreateSrsCqiReport (const SpectrumValue& sinr)
       i++;
     }
   // Insert the user generated the srs as a vendor specific parameter
-  NS_LOG_DEBUG (this << " ENB RX UL-CQI of " << m_srsUeOffset.at (m_currentSrsOffset));
-  VendorSpecificListElement_s vsp;
+  uint16_t srsRnti = m_srsUeOffset.at (m_currentSrsOffset);
+  NS_LOG_DEBUG (this << " ENB RX UL-CQI of " << srsRnti);
+  ulcqi.m_vendorSpecificList.resize (1);
+  VendorSpecificListElement_s& vsp = ulcqi.m_vendorSpecificList.back ();
   vsp.m_type = SRS_CQI_RNTI_VSP;
   vsp.m_length = sizeof(SrsCqiRntiVsp);
-  Ptr<SrsCqiRntiVsp> rnti  = Create <SrsCqiRntiVsp> (m_srsUeOffset.at (m_currentSrsOffset));
-  vsp.m_value = rnti;
-  ulcqi.m_vendorSpecificList.push_back (vsp);
+  vsp.m_value = Create <SrsCqiRntiVsp> (srsRnti);
   // call SRS tracing method
-  CreateSrsReport (m_srsUeOffset.at (m_currentSrsOffset),
-                   (i > 0) ? (srsSum / i) : DBL_MAX);
+  CreateSrsReport (srsRnti, (i > 0) ? (srsSum / i) : DBL_MAX);
   return (ulcqi);
 
 }
@@ -1091,6 +1075,7 @@ LteEnbPhy::DoSetMasterInformationBlock (LteRrcSap::MasterInformationBlock mib)
 {
   NS_LOG_FUNCTION (this);
   m_mib = mib;
+  m_mibMsg = 0;
 }
 
 
@@ -1099,6 +1084,7 @@ LteEnbPhy::DoSetSystemInformationBlockType1 (LteRrcSap::SystemInformationBlockTy
 {
   NS_LOG_FUNCTION (this);
   m_sib1 = sib1;
+  m_sib1Msg = 0;
 }
 
 
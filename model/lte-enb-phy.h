@@ -24,6 +24,7 @@
 
 
 #include <ns3/lte-control-messages.h>
+#include <ns3/lte-control-message-list.h>
 #include <ns3/lte-enb-phy-sap.h>
 #include <ns3/lte-enb-cphy-sap.h>
 #include <ns3/lte-phy.h>
@@ -266,8 +267,10 @@ public:
 
   /**
   * \brief PhySpectrum received a new list of LteControlMessage
+  *
+  * \param msgList the control messages of a UE
   */
-  virtual void ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> >);
+  virtual void ReceiveLteControlMessageList (Ptr<const LteControlMessageList> msgList);
 
   // inherited from LtePhy
   virtual void GenerateCtrlCqiReport (const SpectrumValue& sinr);
@@ -398,6 +401,16 @@ private:
    * The message content is specified by the upper layer through the RRC SAP.
    */
   LteRrcSap::SystemInformationBlockType1 m_sib1;
+  /**
+   * The MIB control message built from m_mib, broadcasted as is until the
+   * upper layer changes the MIB.
+   */
+  Ptr<MibLteControlMessage> m_mibMsg;
+  /**
+   * The SIB1 control message built from m_sib1, broadcasted as is until
+   * the upper layer changes the SIB1.
+   */
+  Ptr<Sib1LteControlMessage> m_sib1Msg;
 
   Ptr<LteHarqPhy> m_harqPhyModule;
 
@@ -40,6 +40,7 @@
 #include <ns3/lte-rlc-um.h>
 #include <ns3/lte-rlc-am.h>
 #include <ns3/lte-pdcp.h>
+#include <ns3/lte-pdcp-header.h>
 
 
 
@@ -660,6 +661,38 @@ UeManager::RecvHandoverRequestAck (EpcX2SapUser::HandoverRequestAckParams params
         }
     }
   m_rrc->m_x2SapProvider->SendSnStatusTransfer (sst);
+
+  if (m_rrc->m_forwardTxBacklog)
+    {
+      ForwardTxBacklog ();
+    }
+}
+
+void
+UeManager::ForwardTxBacklog ()
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Ptr<Packet> > sdus;
+  for (std::map <uint8_t, Ptr<LteDataRadioBearerInfo> >::iterator drbIt = m_drbMap.begin ();
+       drbIt != m_drbMap.end ();
+       ++drbIt)
+    {
+      sdus.clear ();
+      drbIt->second->m_rlc->TakeUntransmittedSdus (sdus);
+      NS_LOG_LOGIC ("forwarding " << sdus.size () << " SDUs of DRB " << (uint16_t) drbIt->first);
+      for (std::vector<Ptr<Packet> >::iterator it = sdus.begin (); it != sdus.end (); ++it)
+        {
+          // the RLC SDUs are PDCP PDUs, the target eNB adds its own PDCP header
+          LtePdcpHeader pdcpHeader;
+          (*it)->RemoveHeader (pdcpHeader);
+          EpcX2Sap::UeDataParams params;
+          params.sourceCellId = m_rrc->m_cellId;
+          params.targetCellId = m_targetCellId;
+          params.gtpTeid = drbIt->second->m_gtpTeid;
+          params.ueData = *it;
+          m_rrc->m_x2SapProvider->SendUeData (params);
+        }
+    }
 }
 
 
@@ -1543,6 +1576,13 @@ LteEnbRrc::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteEnbRrc::m_admitRrcConnectionRequest),
                    MakeBooleanChecker ())
+    .AddAttribute ("ForwardTxBacklog",
+                   "Whether the SDUs still waiting in the RLC transmission "
+                   "buffers of a UE are forwarded over X2 to the target eNB "
+                   "when the UE leaves with a handover",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteEnbRrc::m_forwardTxBacklog),
+                   MakeBooleanChecker ())
 
     // UE measurements related attributes
     .AddAttribute ("RsrpFilterCoefficient",
@@ -2405,6 +2445,14 @@ LteEnbRrc::DoTriggerHandover (uint16_t rnti, uint16_t targetCellId)
     }
 }
 
+bool
+LteEnbRrc::DoIsUeConnectedNormally (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  return HasUeManager (rnti)
+         && GetUeManager (rnti)->GetState () == UeManager::CONNECTED_NORMALLY;
+}
+
 uint8_t
 LteEnbRrc::DoAddUeMeasReportConfigForAnr (LteRrcSap::ReportConfigEutra reportConfig)
 {
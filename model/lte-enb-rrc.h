@@ -423,6 +423,13 @@ private:
    */
   void SwitchToState (State s);
 
+  /**
+   * Forward to the target eNB, over X2-U, the SDUs not yet transmitted
+   * by the RLC entities of the data radio bearers, when leaving with an
+   * X2 handover
+   */
+  void ForwardTxBacklog ();
+
 
   uint8_t m_lastAllocatedDrbid;
 
@@ -950,6 +957,7 @@ private:
 
   uint8_t DoAddUeMeasReportConfigForHandover (LteRrcSap::ReportConfigEutra reportConfig);
   void DoTriggerHandover (uint16_t rnti, uint16_t targetCellId);
+  bool DoIsUeConnectedNormally (uint16_t rnti);
 
   // ANR SAP methods
 
@@ -1217,6 +1225,12 @@ private:
    * request from a UE.
    */
   bool m_admitRrcConnectionRequest;
+  /**
+   * The `ForwardTxBacklog` attribute. Whether the SDUs still waiting in
+   * the RLC transmission buffers of a UE are forwarded to the target eNB
+   * when the UE leaves with an X2 handover.
+   */
+  bool m_forwardTxBacklog;
   /**
    * The `RsrpFilterCoefficient` attribute. Determines the strength of
    * smoothing effect induced by layer 3 filtering of RSRP in all attached UE.
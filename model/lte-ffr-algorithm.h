@@ -186,7 +186,7 @@ protected:
    * \param ulCqiMap
    *
    */
-  virtual void DoReportUlCqiInfo ( std::map <uint16_t, std::vector <double> > ulCqiMap ) = 0;
+  virtual void DoReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap) = 0;
 
   /**
    * \brief DoGetTpc for UE
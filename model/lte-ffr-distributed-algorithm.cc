@@ -31,7 +31,9 @@ NS_OBJECT_ENSURE_REGISTERED (LteFfrDistributedAlgorithm);
 
 LteFfrDistributedAlgorithm::LteFfrDistributedAlgorithm ()
   : m_ffrSapUser (0),
-    m_ffrRrcSapUser (0)
+    m_ffrRrcSapUser (0),
+    m_edgeUeNum (0),
+    m_edgeRbgMapsOutdated (true)
 {
   NS_LOG_FUNCTION (this);
   m_ffrSapProvider = new MemberLteFfrSapProvider<LteFfrDistributedAlgorithm> (this);
@@ -192,6 +194,7 @@ LteFfrDistributedAlgorithm::Reconfigure ()
     }
   InitializeDownlinkRbgMaps ();
   InitializeUplinkRbgMaps ();
+  m_edgeRbgMapsOutdated = true;
   m_needReconfiguration = false;
 }
 
@@ -321,7 +324,7 @@ LteFfrDistributedAlgorithm::DoReportUlCqiInfo (const struct FfMacSchedSapProvide
 }
 
 void
-LteFfrDistributedAlgorithm::DoReportUlCqiInfo (std::map <uint16_t, std::vector <double> > ulCqiMap)
+LteFfrDistributedAlgorithm::DoReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap)
 {
   NS_LOG_FUNCTION (this);
   NS_LOG_WARN ("Method should not be called, because it is empty");
@@ -407,7 +410,7 @@ LteFfrDistributedAlgorithm::DoReportUeMeas (uint16_t rnti,
           if (it->second != CenterArea)
             {
               NS_LOG_INFO ("UE RNTI: " << rnti << " will be served in Center sub-band");
-              it->second = CenterArea;
+              SetUeArea (it, CenterArea);
 
               LteRrcSap::PdschConfigDedicated pdschConfigDedicated;
               pdschConfigDedicated.pa = m_centerPowerOffset;
@@ -419,7 +422,7 @@ LteFfrDistributedAlgorithm::DoReportUeMeas (uint16_t rnti,
           if (it->second != EdgeArea )
             {
               NS_LOG_INFO ("UE RNTI: " << rnti << " will be served in Edge sub-band");
-              it->second = EdgeArea;
+              SetUeArea (it, EdgeArea);
 
               LteRrcSap::PdschConfigDedicated pdschConfigDedicated;
               pdschConfigDedicated.pa = m_edgePowerOffset;
@@ -468,6 +471,8 @@ LteFfrDistributedAlgorithm::DoReportUeMeas (uint16_t rnti,
         {
           NS_LOG_WARN (this << " Event A4 received without measurement results from neighbouring cells");
         }
+
+      UpdateUeWeights (rnti);
     }
   else
     {
@@ -476,86 +481,139 @@ LteFfrDistributedAlgorithm::DoReportUeMeas (uint16_t rnti,
 }
 
 void
-LteFfrDistributedAlgorithm::Calculate ()
+LteFfrDistributedAlgorithm::SetUeArea (std::map< uint16_t, uint8_t >::iterator it, uint8_t area)
 {
-  NS_LOG_FUNCTION (this);
-  m_calculationEvent = Simulator::Schedule (m_calculationInterval, &LteFfrDistributedAlgorithm::Calculate, this);
-
-  int rbgSize = GetRbgSize (m_dlBandwidth);
-  uint16_t rbgNum = m_dlBandwidth / rbgSize;
-
-  m_cellWeightMap.clear ();
-  m_dlEdgeRbgMap.clear ();
-  m_dlEdgeRbgMap.resize (m_dlBandwidth / rbgSize, false);
-  m_ulEdgeRbgMap.clear ();
-  m_ulEdgeRbgMap.resize (m_ulBandwidth, false);
+  NS_LOG_FUNCTION (this << it->first << (uint16_t) area);
+  bool hadEdgeUes = (m_edgeUeNum > 0);
+  if (it->second == EdgeArea)
+    {
+      m_edgeUeNum--;
+    }
+  it->second = area;
+  if (area == EdgeArea)
+    {
+      m_edgeUeNum++;
+    }
+  if (hadEdgeUes != (m_edgeUeNum > 0))
+    {
+      // the edge sub-band is only used when there are edge UEs
+      m_edgeRbgMapsOutdated = true;
+    }
+  UpdateUeWeights (it->first);
+}
 
-  MeasurementTable_t::iterator it1;
-  MeasurementRow_t::iterator it2;
-  Ptr<UeMeasure> servingCellMeasures;
-  Ptr<UeMeasure> neighbourCellMeasures;
+void
+LteFfrDistributedAlgorithm::UpdateUeWeights (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
 
-  uint32_t edgeUeNum = 0;
-  std::map< uint16_t, uint8_t >::iterator areaIt;
-  for (areaIt = m_ues.begin (); areaIt != m_ues.end (); areaIt++)
+  // the neighbours whose RSRP is close to the serving one, for an edge UE
+  std::vector<uint16_t> weightedCells;
+  std::map< uint16_t, uint8_t >::const_iterator areaIt = m_ues.find (rnti);
+  MeasurementTable_t::const_iterator it1 = m_ueMeasures.find (rnti);
+  if (areaIt != m_ues.end () && areaIt->second == EdgeArea && it1 != m_ueMeasures.end ())
     {
-      if (areaIt->second == EdgeArea)
+      MeasurementRow_t::const_iterator servingIt = it1->second.find (m_cellId);
+      if (servingIt != it1->second.end ())
         {
-          edgeUeNum++;
+          Ptr<UeMeasure> servingCellMeasures = servingIt->second;
+          for (MeasurementRow_t::const_iterator it2 = it1->second.begin (); it2 != it1->second.end (); it2++)
+            {
+              if (it2->first == m_cellId)
+                {
+                  continue;
+                }
+              Ptr<UeMeasure> neighbourCellMeasures = it2->second;
+              int16_t rsrpDifference = servingCellMeasures->m_rsrp - neighbourCellMeasures->m_rsrp;
+              NS_LOG_INFO ("CellId: " << m_cellId << " UE RNTI: " << rnti
+                                      << " NeighborCellId: " << neighbourCellMeasures->m_cellId
+                                      << " RSRP Serving: " << (int)servingCellMeasures->m_rsrp
+                                      << " RSRP Neighbor: " << (int)neighbourCellMeasures->m_rsrp
+                                      << " RSRP Difference: " << (int)rsrpDifference);
+
+              if (rsrpDifference < m_rsrpDifferenceThreshold)
+                {
+                  weightedCells.push_back (neighbourCellMeasures->m_cellId);
+                }
+            }
         }
     }
 
-  if (edgeUeNum != 0)
+  // apply the difference with the neighbours weighted so far by the UE;
+  // both lists are sorted by cell ID
+  std::vector<uint16_t>& oldCells = m_ueWeightedCells[rnti];
+  std::vector<uint16_t>::const_iterator oldIt = oldCells.begin ();
+  std::vector<uint16_t>::const_iterator newIt = weightedCells.begin ();
+  while (oldIt != oldCells.end () || newIt != weightedCells.end ())
     {
-      for (it1 = m_ueMeasures.begin (); it1 != m_ueMeasures.end (); it1++)
+      uint16_t changedCellId;
+      if (newIt == weightedCells.end () || (oldIt != oldCells.end () && *oldIt < *newIt))
         {
-          std::map< uint16_t, uint8_t >::iterator areaIt = m_ues.find (it1->first);
-          if (areaIt->second != EdgeArea)
+          changedCellId = *oldIt++;
+          std::map<uint16_t, uint32_t>::iterator cellIt = m_cellWeightMap.find (changedCellId);
+          NS_ASSERT (cellIt != m_cellWeightMap.end ());
+          if (--cellIt->second == 0)
             {
-              continue;
+              m_cellWeightMap.erase (cellIt);
             }
+        }
+      else if (oldIt == oldCells.end () || *newIt < *oldIt)
+        {
+          changedCellId = *newIt++;
+          m_cellWeightMap[changedCellId]++;
+        }
+      else
+        {
+          ++oldIt;
+          ++newIt;
+          continue;
+        }
 
-          servingCellMeasures = 0;
-          neighbourCellMeasures = 0;
+      // the weight only matters once the neighbour has sent its RNTP
+      if (m_rntp.find (changedCellId) != m_rntp.end ())
+        {
+          m_edgeRbgMapsOutdated = true;
+        }
+    }
+  oldCells.swap (weightedCells);
+}
 
-          it2 = it1->second.find (m_cellId);
-          if (it2 != it1->second.end ())
-            {
-              servingCellMeasures = it2->second;
-            }
-          else
-            {
-              continue;
-            }
+void
+LteFfrDistributedAlgorithm::Calculate ()
+{
+  NS_LOG_FUNCTION (this);
+  m_calculationEvent = Simulator::Schedule (m_calculationInterval, &LteFfrDistributedAlgorithm::Calculate, this);
 
-          for (it2 = it1->second.begin (); it2 != it1->second.end (); it2++)
-            {
-              if (it2->first != m_cellId)
-                {
-                  neighbourCellMeasures = it2->second;
-                }
-              else
-                {
-                  continue;
-                }
+  if (m_edgeRbgMapsOutdated)
+    {
+      UpdateEdgeRbgMaps ();
+      m_edgeRbgMapsOutdated = false;
+    }
 
-              if (servingCellMeasures && neighbourCellMeasures)
-                {
-                  int16_t rsrpDifference = servingCellMeasures->m_rsrp - neighbourCellMeasures->m_rsrp;
-                  NS_LOG_INFO ("CellId: " << m_cellId << " UE RNTI: " << it1->first
-                                          << " NeighborCellId: " << neighbourCellMeasures->m_cellId
-                                          << " RSRP Serving: " << (int)servingCellMeasures->m_rsrp
-                                          << " RSRP Neighbor: " << (int)neighbourCellMeasures->m_rsrp
-                                          << " RSRP Difference: " << (int)rsrpDifference);
-
-                  if (rsrpDifference < m_rsrpDifferenceThreshold)
-                    {
-                      m_cellWeightMap[neighbourCellMeasures->m_cellId]++;
-                    }
-                }
-            }
+  // the neighbours keep the last RNTP they received, hence it is only
+  // sent to the neighbours which do not have the current one yet
+  for (std::vector<uint16_t>::iterator ncIt = m_neigborCell.begin (); ncIt != m_neigborCell.end (); ncIt++)
+    {
+      if (m_loadInformationSent.insert (*ncIt).second)
+        {
+          SendLoadInformation ((*ncIt));
         }
+    }
+}
+
+void
+LteFfrDistributedAlgorithm::UpdateEdgeRbgMaps ()
+{
+  NS_LOG_FUNCTION (this);
+
+  int rbgSize = GetRbgSize (m_dlBandwidth);
+  uint16_t rbgNum = m_dlBandwidth / rbgSize;
+
+  std::vector <bool> dlEdgeRbgMap (rbgNum, false);
+  std::vector <bool> ulEdgeRbgMap (m_ulBandwidth, false);
 
+  if (m_edgeUeNum != 0)
+    {
       std::map< uint16_t, uint64_t > metricA;
       for (uint16_t i = 0; i < rbgNum; i++)
         {
@@ -594,7 +652,7 @@ LteFfrDistributedAlgorithm::Calculate ()
 
       for (int i = 0; i < m_edgeRbNum / rbgSize; i++)
         {
-          m_dlEdgeRbgMap[ sortedRbgByMetric[i] ] = true;
+          dlEdgeRbgMap[ sortedRbgByMetric[i] ] = true;
         }
 
       for (int i = 0; i < m_edgeRbNum / rbgSize; i++)
@@ -603,15 +661,18 @@ LteFfrDistributedAlgorithm::Calculate ()
           for (int k = 0; k < rbgSize; k++)
             {
               uint32_t rbIndex = rbgSize * rbgIndex + k;
-              m_ulEdgeRbgMap[ rbIndex ] = true;
+              ulEdgeRbgMap[ rbIndex ] = true;
             }
         }
     }
 
-  for (std::vector<uint16_t>::iterator ncIt = m_neigborCell.begin (); ncIt != m_neigborCell.end (); ncIt++)
+  if (dlEdgeRbgMap != m_dlEdgeRbgMap)
     {
-      SendLoadInformation ((*ncIt));
+      // the neighbours have an outdated RNTP
+      m_loadInformationSent.clear ();
     }
+  m_dlEdgeRbgMap.swap (dlEdgeRbgMap);
+  m_ulEdgeRbgMap.swap (ulEdgeRbgMap);
 }
 
 void
@@ -653,14 +714,25 @@ LteFfrDistributedAlgorithm::DoRecvLoadInformation (EpcX2Sap::LoadInformationPara
     }
 
   uint16_t neighborCellId = params.cellInformationList[0].sourceCellId;
+  const std::vector <bool>& rntp = params.cellInformationList[0].relativeNarrowbandTxBand.rntpPerPrbList;
   std::map<uint16_t, std::vector <bool> >::iterator it = m_rntp.find (neighborCellId);
   if (it != m_rntp.end ())
     {
-      it->second = params.cellInformationList[0].relativeNarrowbandTxBand.rntpPerPrbList;
+      if (it->second == rntp)
+        {
+          return;
+        }
+      it->second = rntp;
     }
   else
     {
-      m_rntp.insert (std::pair<uint16_t, std::vector <bool> > (neighborCellId, params.cellInformationList[0].relativeNarrowbandTxBand.rntpPerPrbList));
+      m_rntp.insert (std::pair<uint16_t, std::vector <bool> > (neighborCellId, rntp));
+    }
+
+  // the RNTP only matters if some edge UEs are close to the neighbour
+  if (m_cellWeightMap.find (neighborCellId) != m_cellWeightMap.end ())
+    {
+      m_edgeRbgMapsOutdated = true;
     }
 }
 
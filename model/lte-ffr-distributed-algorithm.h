@@ -26,6 +26,7 @@
 #include <ns3/lte-ffr-sap.h>
 #include <ns3/lte-ffr-rrc-sap.h>
 #include <ns3/lte-rrc-sap.h>
+#include <set>
 
 namespace ns3 {
 
@@ -66,7 +67,7 @@ protected:
   virtual bool DoIsUlRbgAvailableForUe (int i, uint16_t rnti);
   virtual void DoReportDlCqiInfo (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
   virtual void DoReportUlCqiInfo (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
-  virtual void DoReportUlCqiInfo ( std::map <uint16_t, std::vector <double> > ulCqiMap );
+  virtual void DoReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap);
   virtual uint8_t DoGetTpc (uint16_t rnti);
   virtual uint8_t DoGetMinContinuousUlBandwidth ();
 
@@ -82,7 +83,25 @@ private:
 
   void UpdateNeighbourMeasurements (uint16_t rnti, uint16_t cellId, uint8_t rsrp, uint8_t rsrq);
 
+  /**
+   * Update the weights of the neighbour cells after the area or the
+   * measurements of a UE changed
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void UpdateUeWeights (uint16_t rnti);
+
+  /**
+   * Set the area of a UE, keeping the number of edge UEs and the weights
+   * of the neighbour cells up to date
+   *
+   * \param it the entry of the UE in m_ues
+   * \param area the new UePosition of the UE
+   */
+  void SetUeArea (std::map< uint16_t, uint8_t >::iterator it, uint8_t area);
+
   void Calculate ();
+  void UpdateEdgeRbgMaps ();
   void SendLoadInformation (uint16_t targetCellId);
 
   // FFR SAP
@@ -147,8 +166,20 @@ public:
 
   uint8_t m_rsrpDifferenceThreshold;
 
+  /// number of edge UEs weighting each neighbour cell, without the cells of weight zero
   std::map<uint16_t, uint32_t> m_cellWeightMap;
 
+  //               rnti            cellIds of the neighbours weighted by the UE, sorted
+  std::map<uint16_t, std::vector<uint16_t> > m_ueWeightedCells;
+
+  uint32_t m_edgeUeNum; ///< number of UEs in the edge area
+
+  /// whether the edge UEs, the weights or the RNTPs changed since the last calculation
+  bool m_edgeRbgMapsOutdated;
+
+  /// neighbours to which the current m_dlEdgeRbgMap has been sent
+  std::set<uint16_t> m_loadInformationSent;
+
   std::map<uint16_t, std::vector <bool> > m_rntp;
 
 }; // end of class LteFfrDistributedAlgorithm
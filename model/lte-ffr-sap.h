@@ -108,7 +108,7 @@ public:
   /**
    * \brief ReportUlCqiInfo
    */
-  virtual void ReportUlCqiInfo ( std::map <uint16_t, std::vector <double> > ulCqiMap ) = 0;
+  virtual void ReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap) = 0;
 
   /**
    * \brief GetTpc
@@ -155,7 +155,7 @@ public:
   virtual bool IsUlRbgAvailableForUe (int i, uint16_t rnti);
   virtual void ReportDlCqiInfo (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params);
   virtual void ReportUlCqiInfo (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params);
-  virtual void ReportUlCqiInfo ( std::map <uint16_t, std::vector <double> > ulCqiMap );
+  virtual void ReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap);
   virtual uint8_t GetTpc (uint16_t rnti);
   virtual uint8_t GetMinContinuousUlBandwidth ();
 private:
@@ -216,7 +216,7 @@ MemberLteFfrSapProvider<C>::ReportUlCqiInfo (const struct FfMacSchedSapProvider:
 
 template <class C>
 void
-MemberLteFfrSapProvider<C>::ReportUlCqiInfo ( std::map <uint16_t, std::vector <double> > ulCqiMap )
+MemberLteFfrSapProvider<C>::ReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap)
 {
   m_owner->DoReportUlCqiInfo (ulCqiMap);
 }
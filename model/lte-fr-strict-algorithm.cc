@@ -452,7 +452,7 @@ LteFrStrictAlgorithm::DoReportUlCqiInfo (const struct FfMacSchedSapProvider::Sch
 }
 
 void
-LteFrStrictAlgorithm::DoReportUlCqiInfo (std::map <uint16_t, std::vector <double> > ulCqiMap)
+LteFrStrictAlgorithm::DoReportUlCqiInfo (const std::map <uint16_t, std::vector <double> >& ulCqiMap)
 {
   NS_LOG_FUNCTION (this);
   NS_LOG_WARN ("Method should not be called, because it is empty");
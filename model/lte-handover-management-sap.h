@@ -102,6 +102,19 @@ public:
    */
   virtual void TriggerHandover (uint16_t rnti, uint16_t targetCellId) = 0;
 
+  /**
+   * \brief Check whether a UE may currently be handed over.
+   * \param rnti Radio Network Temporary Identity, an integer identifying the UE
+   * \return true if the eNodeB RRC entity has a context for the UE and the UE
+   *         is in the CONNECTED_NORMALLY state
+   *
+   * A handover algorithm which defers its decisions after the reception of
+   * the measurement reports shall call this function before
+   * TriggerHandover, since in the meantime the UE may have been released or
+   * may have started another procedure.
+   */
+  virtual bool IsUeConnectedNormally (uint16_t rnti) = 0;
+
 }; // end of class LteHandoverManagementSapUser
 
 
@@ -157,6 +170,7 @@ public:
   // inherited from LteHandoverManagementSapUser
   virtual uint8_t AddUeMeasReportConfigForHandover (LteRrcSap::ReportConfigEutra reportConfig);
   virtual void TriggerHandover (uint16_t rnti, uint16_t targetCellId);
+  virtual bool IsUeConnectedNormally (uint16_t rnti);
 
 private:
   MemberLteHandoverManagementSapUser ();
@@ -188,6 +202,14 @@ MemberLteHandoverManagementSapUser<C>::TriggerHandover (uint16_t rnti, uint16_t
 }
 
 
+template <class C>
+bool
+MemberLteHandoverManagementSapUser<C>::IsUeConnectedNormally (uint16_t rnti)
+{
+  return m_owner->DoIsUeConnectedNormally (rnti);
+}
+
+
 } // end of namespace ns3
 
 
@@ -0,0 +1,258 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-handover-measurement-store.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteHandoverMeasurementStore");
+
+LteHandoverMeasurementStore::LteHandoverMeasurementStore ()
+  : m_stride (4)
+{
+}
+
+bool
+LteHandoverMeasurementStore::HasUe (uint16_t rnti) const
+{
+  return rnti < m_ueIndex.size () && m_ueIndex[rnti] >= 0;
+}
+
+uint32_t
+LteHandoverMeasurementStore::GetUeIndex (uint16_t rnti)
+{
+  if (rnti >= m_ueIndex.size ())
+    {
+      m_ueIndex.resize (rnti + 1, -1);
+    }
+  if (m_ueIndex[rnti] < 0)
+    {
+      NS_LOG_LOGIC ("new UE " << rnti << " at index " << m_ues.size ());
+      UeInfo ue;
+      ue.rnti = rnti;
+      ue.bestCell = -1;
+      ue.bestDirty = false;
+      ue.pending = false;
+      ue.servingValue = 0;
+      m_ueIndex[rnti] = m_ues.size ();
+      m_ues.push_back (ue);
+      m_values.resize (m_values.size () + m_stride, 0);
+    }
+  return m_ueIndex[rnti];
+}
+
+uint32_t
+LteHandoverMeasurementStore::GetCellIndex (uint16_t cellId)
+{
+  if (cellId >= m_cellIndex.size ())
+    {
+      m_cellIndex.resize (cellId + 1, -1);
+    }
+  if (m_cellIndex[cellId] < 0)
+    {
+      uint32_t cell = m_cellIds.size ();
+      NS_LOG_LOGIC ("new cell " << cellId << " at index " << cell);
+      if (cell == m_stride)
+        {
+          // twice more columns
+          std::vector<uint8_t> values (m_ues.size () * 2 * m_stride, 0);
+          for (uint32_t ue = 0; ue < m_ues.size (); ++ue)
+            {
+              std::copy (m_values.begin () + ue * m_stride,
+                         m_values.begin () + (ue + 1) * m_stride,
+                         values.begin () + ue * 2 * m_stride);
+            }
+          m_values.swap (values);
+          m_stride *= 2;
+        }
+      m_cellIndex[cellId] = cell;
+      m_cellIds.push_back (cellId);
+    }
+  return m_cellIndex[cellId];
+}
+
+bool
+LteHandoverMeasurementStore::IsBetter (uint8_t value, uint32_t cell,
+                                       uint8_t bestValue, uint32_t bestCell) const
+{
+  return value > bestValue || (value == bestValue && m_cellIds[cell] < m_cellIds[bestCell]);
+}
+
+void
+LteHandoverMeasurementStore::Update (uint16_t rnti, uint16_t cellId, uint8_t value)
+{
+  NS_LOG_FUNCTION (this << rnti << cellId << (uint16_t) value);
+  uint32_t cell = GetCellIndex (cellId);
+  uint32_t ueIndex = GetUeIndex (rnti);
+  UeInfo& ue = m_ues[ueIndex];
+  uint8_t* row = &m_values[ueIndex * m_stride];
+  uint8_t oldValue = row[cell];
+  row[cell] = value;
+
+  if (ue.bestDirty)
+    {
+      return;
+    }
+  if (ue.bestCell < 0)
+    {
+      ue.bestCell = cell;
+    }
+  else if ((uint32_t) ue.bestCell == cell)
+    {
+      // a decrease may let another cell become the best one
+      ue.bestDirty = value < oldValue;
+    }
+  else if (IsBetter (value, cell, row[ue.bestCell], ue.bestCell))
+    {
+      ue.bestCell = cell;
+    }
+}
+
+void
+LteHandoverMeasurementStore::ClearUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  if (HasUe (rnti))
+    {
+      uint32_t ueIndex = m_ueIndex[rnti];
+      std::fill (m_values.begin () + ueIndex * m_stride,
+                 m_values.begin () + (ueIndex + 1) * m_stride, 0);
+      m_ues[ueIndex].bestCell = -1;
+      m_ues[ueIndex].bestDirty = false;
+    }
+}
+
+uint16_t
+LteHandoverMeasurementStore::GetBestNeighbour (uint16_t rnti, uint8_t& value)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  value = 0;
+  if (!HasUe (rnti))
+    {
+      return 0;
+    }
+  uint32_t ueIndex = m_ueIndex[rnti];
+  UeInfo& ue = m_ues[ueIndex];
+  const uint8_t* row = &m_values[ueIndex * m_stride];
+  if (ue.bestDirty)
+    {
+      ue.bestCell = -1;
+      for (uint32_t cell = 0; cell < m_cellIds.size (); ++cell)
+        {
+          if (ue.bestCell < 0 || IsBetter (row[cell], cell, row[ue.bestCell], ue.bestCell))
+            {
+              ue.bestCell = cell;
+            }
+        }
+      ue.bestDirty = false;
+    }
+  if (ue.bestCell < 0 || row[ue.bestCell] == 0)
+    {
+      return 0;
+    }
+  value = row[ue.bestCell];
+  return m_cellIds[ue.bestCell];
+}
+
+uint16_t
+LteHandoverMeasurementStore::GetBestNeighbour (uint16_t rnti, Callback<bool, uint16_t> isValid,
+                                               uint8_t& value) const
+{
+  NS_LOG_FUNCTION (this << rnti);
+  value = 0;
+  if (!HasUe (rnti))
+    {
+      return 0;
+    }
+  const uint8_t* row = &m_values[m_ueIndex[rnti] * m_stride];
+  int32_t bestCell = -1;
+  for (uint32_t cell = 0; cell < m_cellIds.size (); ++cell)
+    {
+      if (row[cell] > 0
+          && (bestCell < 0 || IsBetter (row[cell], cell, row[bestCell], bestCell))
+          && isValid (m_cellIds[cell]))
+        {
+          bestCell = cell;
+        }
+    }
+  if (bestCell < 0)
+    {
+      return 0;
+    }
+  value = row[bestCell];
+  return m_cellIds[bestCell];
+}
+
+uint8_t
+LteHandoverMeasurementStore::GetValue (uint16_t rnti, uint16_t cellId) const
+{
+  if (!HasUe (rnti) || cellId >= m_cellIndex.size () || m_cellIndex[cellId] < 0)
+    {
+      return 0;
+    }
+  return m_values[m_ueIndex[rnti] * m_stride + m_cellIndex[cellId]];
+}
+
+uint32_t
+LteHandoverMeasurementStore::GetNCells () const
+{
+  return m_cellIds.size ();
+}
+
+uint16_t
+LteHandoverMeasurementStore::GetCellId (uint32_t cellIndex) const
+{
+  NS_ASSERT (cellIndex < m_cellIds.size ());
+  return m_cellIds[cellIndex];
+}
+
+bool
+LteHandoverMeasurementStore::AddPending (uint16_t rnti, uint8_t servingValue)
+{
+  NS_LOG_FUNCTION (this << rnti << (uint16_t) servingValue);
+  bool wasEmpty = m_pending.empty ();
+  uint32_t ueIndex = GetUeIndex (rnti);
+  UeInfo& ue = m_ues[ueIndex];
+  ue.servingValue = servingValue;
+  if (!ue.pending)
+    {
+      ue.pending = true;
+      m_pending.push_back (ueIndex);
+    }
+  return wasEmpty;
+}
+
+void
+LteHandoverMeasurementStore::TakePending (std::vector<Pending>& pending)
+{
+  NS_LOG_FUNCTION (this << m_pending.size ());
+  pending.clear ();
+  for (std::vector<uint32_t>::const_iterator it = m_pending.begin (); it != m_pending.end (); ++it)
+    {
+      UeInfo& ue = m_ues[*it];
+      Pending p;
+      p.rnti = ue.rnti;
+      p.servingValue = ue.servingValue;
+      pending.push_back (p);
+      ue.pending = false;
+    }
+  m_pending.clear ();
+}
+
+} // namespace ns3
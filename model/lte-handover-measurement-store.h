@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_HANDOVER_MEASUREMENT_STORE_H
+#define LTE_HANDOVER_MEASUREMENT_STORE_H
+
+#include <ns3/callback.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Latest neighbour cell measurements reported by the UEs of an eNB, as
+ * used by the handover algorithms.
+ *
+ * The UEs (by RNTI) and the neighbour cells (by cell ID) are given dense
+ * indices the first time they are seen, and the quantized measurements
+ * (RSRP or RSRQ range, as in the measurement reports) are kept in a
+ * single UE-major matrix. A zero value stands for a missing measurement,
+ * so a cell is a handover candidate only with a positive value.
+ *
+ * The best neighbour of each UE, i.e., the cell with the highest value,
+ * the lowest cell ID winning a tie, is tracked as the measurements are
+ * updated; the row of a UE is only scanned again when the value of its
+ * best neighbour decreases.
+ *
+ * The store also keeps the set of UEs whose handover is pending
+ * evaluation, so that the reports received in a TTI can be evaluated
+ * in a single batch.
+ */
+class LteHandoverMeasurementStore
+{
+public:
+  LteHandoverMeasurementStore ();
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \return whether the UE reported some measurements
+   */
+  bool HasUe (uint16_t rnti) const;
+
+  /**
+   * Save the latest measurement of a neighbour cell reported by a UE
+   *
+   * \param rnti the RNTI of the UE
+   * \param cellId the cell ID of the neighbour cell
+   * \param value the quantized measurement
+   */
+  void Update (uint16_t rnti, uint16_t cellId, uint8_t value);
+
+  /**
+   * Forget the measurements reported by a UE, keeping its index
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void ClearUe (uint16_t rnti);
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \param value the value of the best neighbour, if any
+   * \return the cell ID of the best neighbour, or 0 if no cell has a
+   *         positive value
+   */
+  uint16_t GetBestNeighbour (uint16_t rnti, uint8_t& value);
+
+  /**
+   * Scan the measurements of a UE for the best neighbour accepted by a
+   * filter, e.g., when the best neighbour is not a valid handover target
+   *
+   * \param rnti the RNTI of the UE
+   * \param isValid the filter of the neighbour cells, given the cell ID
+   * \param value the value of the best neighbour, if any
+   * \return the cell ID of the best valid neighbour, or 0 if no valid
+   *         cell has a positive value
+   */
+  uint16_t GetBestNeighbour (uint16_t rnti, Callback<bool, uint16_t> isValid, uint8_t& value) const;
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \param cellId the cell ID of a neighbour cell
+   * \return the latest measurement of the cell, 0 if none
+   */
+  uint8_t GetValue (uint16_t rnti, uint16_t cellId) const;
+
+  /// \return the number of neighbour cells ever reported
+  uint32_t GetNCells () const;
+
+  /**
+   * \param cellIndex the index of a neighbour cell
+   * \return the cell ID of the neighbour cell
+   */
+  uint16_t GetCellId (uint32_t cellIndex) const;
+
+  /**
+   * Add a UE to the batch of pending handover evaluations. A UE added
+   * twice is evaluated once, with the last serving cell measurement.
+   *
+   * \param rnti the RNTI of the UE
+   * \param servingValue the quantized measurement of the serving cell
+   * \return whether the batch was empty
+   */
+  bool AddPending (uint16_t rnti, uint8_t servingValue);
+
+  /// A pending handover evaluation
+  struct Pending
+  {
+    uint16_t rnti; ///< RNTI of the UE
+    uint8_t servingValue; ///< quantized measurement of the serving cell
+  };
+
+  /**
+   * Move the pending handover evaluations to a vector and empty the batch
+   *
+   * \param pending the pending evaluations, in order of arrival
+   */
+  void TakePending (std::vector<Pending>& pending);
+
+private:
+  /// Measurement state of a UE
+  struct UeInfo
+  {
+    uint16_t rnti; ///< RNTI of the UE
+    int32_t bestCell; ///< index of the best neighbour cell, -1 if none
+    bool bestDirty; ///< whether bestCell needs a scan of the row
+    bool pending; ///< whether the UE is in the batch of evaluations
+    uint8_t servingValue; ///< serving cell measurement of the pending evaluation
+  };
+
+  /**
+   * \param rnti the RNTI of the UE
+   * \return the index of the UE, a new index being given to a new UE
+   */
+  uint32_t GetUeIndex (uint16_t rnti);
+
+  /**
+   * \param cellId the cell ID
+   * \return the index of the cell, a new column being added for a new cell
+   */
+  uint32_t GetCellIndex (uint16_t cellId);
+
+  /**
+   * \param value a value
+   * \param cell the index of the cell of the value
+   * \param bestValue the value of the current best cell
+   * \param bestCell the index of the current best cell
+   * \return whether the cell is better than the current best cell
+   */
+  bool IsBetter (uint8_t value, uint32_t cell, uint8_t bestValue, uint32_t bestCell) const;
+
+  std::vector<int32_t> m_ueIndex; ///< index of each RNTI, -1 for unknown UEs
+  std::vector<UeInfo> m_ues; ///< UEs, by index
+  std::vector<int32_t> m_cellIndex; ///< index of each cell ID, -1 for unknown cells
+  std::vector<uint16_t> m_cellIds; ///< cell IDs, by index
+  uint32_t m_stride; ///< number of columns of the matrix
+  std::vector<uint8_t> m_values; ///< measurements, UE-major
+  std::vector<uint32_t> m_pending; ///< UE indices of the pending evaluations
+};
+
+} // namespace ns3
+
+#endif // LTE_HANDOVER_MEASUREMENT_STORE_H
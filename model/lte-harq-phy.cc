@@ -32,21 +32,35 @@ NS_LOG_COMPONENT_DEFINE ("LteHarqPhy");
 
 
 LteHarqPhy::LteHarqPhy ()
+  : m_ulHarqHead (0)
 {
-  // Create DL Decodification HARQ buffers
-  std::vector <HarqProcessInfoList_t> dlHarqLayer0;
-  dlHarqLayer0.resize (8);
-  std::vector <HarqProcessInfoList_t> dlHarqLayer1;
-  dlHarqLayer1.resize (8);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer0);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer1);
 }
 
 
 LteHarqPhy::~LteHarqPhy ()
 {
-  m_miDlHarqProcessesInfoMap.clear ();
-  m_miUlHarqProcessesInfoMap.clear ();
+}
+
+
+LteHarqPhy::UlHarqProcesses&
+LteHarqPhy::GetUlHarqProcesses (uint16_t rnti)
+{
+  std::map <uint16_t, uint32_t>::iterator it = m_ulHarqIndexByRnti.find (rnti);
+  if (it == m_ulHarqIndexByRnti.end ())
+    {
+      // new entry
+      it = m_ulHarqIndexByRnti.insert (std::pair <uint16_t, uint32_t> (rnti, m_miUlHarqProcessesInfo.size ())).first;
+      m_miUlHarqProcessesInfo.push_back (UlHarqProcesses ());
+    }
+  return m_miUlHarqProcessesInfo[it->second];
+}
+
+
+uint8_t
+LteHarqPhy::GetUlHarqSlot (uint8_t id) const
+{
+  NS_ASSERT (id < HARQ_PROC_NUM);
+  return (m_ulHarqHead + id) % HARQ_PROC_NUM;
 }
 
 
@@ -55,15 +69,13 @@ LteHarqPhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
 {
   NS_LOG_FUNCTION (this);
 
-  // left shift UL HARQ buffers
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >:: iterator it;
-  for (it = m_miUlHarqProcessesInfoMap.begin (); it != m_miUlHarqProcessesInfoMap.end (); it++)
+  // left shift UL HARQ buffers: the oldest process is dropped and
+  // becomes the newest, empty one
+  for (std::vector <UlHarqProcesses>::iterator it = m_miUlHarqProcessesInfo.begin (); it != m_miUlHarqProcessesInfo.end (); it++)
     {
-      (*it).second.erase ((*it).second.begin ());
-      HarqProcessInfoList_t h;
-      (*it).second.push_back (h);      
+      it->m_processes[m_ulHarqHead].clear ();
     }
-
+  m_ulHarqHead = (m_ulHarqHead + 1) % HARQ_PROC_NUM;
 }
 
 
@@ -71,7 +83,7 @@ double
 LteHarqPhy::GetAccumulatedMiDl (uint8_t harqProcId, uint8_t layer)
 {
   NS_LOG_FUNCTION (this << (uint32_t)harqProcId << (uint16_t)layer);
-  HarqProcessInfoList_t list = m_miDlHarqProcessesInfoMap.at (layer).at (harqProcId);
+  const HarqProcessInfoList_t& list = GetHarqProcessInfoDl (harqProcId, layer);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -80,11 +92,12 @@ LteHarqPhy::GetAccumulatedMiDl (uint8_t harqProcId, uint8_t layer)
   return (mi);
 }
 
-HarqProcessInfoList_t
+const HarqProcessInfoList_t&
 LteHarqPhy::GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer)
 {
   NS_LOG_FUNCTION (this << (uint32_t)harqProcId << (uint16_t)layer);
-  return (m_miDlHarqProcessesInfoMap.at (layer).at (harqProcId));   
+  NS_ASSERT (layer < HARQ_DL_LAYER_NUM && harqProcId < HARQ_PROC_NUM);
+  return (m_miDlHarqProcessesInfo[layer][harqProcId]);
 }
 
 
@@ -93,10 +106,10 @@ LteHarqPhy::GetAccumulatedMiUl (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  NS_ASSERT_MSG (it!=m_miUlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  HarqProcessInfoList_t list = (*it).second.at (0);
+  std::map <uint16_t, uint32_t>::iterator it;
+  it = m_ulHarqIndexByRnti.find (rnti);
+  NS_ASSERT_MSG (it!=m_ulHarqIndexByRnti.end (), " Does not find MI for RNTI");
+  const HarqProcessInfoList_t& list = m_miUlHarqProcessesInfo[it->second].m_processes[GetUlHarqSlot (0)];
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -105,24 +118,11 @@ LteHarqPhy::GetAccumulatedMiUl (uint16_t rnti)
   return (mi);
 }
 
-HarqProcessInfoList_t
+const HarqProcessInfoList_t&
 LteHarqPhy::GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)harqProcId);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-      return (harqList.at (harqProcId));
-    }
-  else
-    {
-      return ((*it).second.at (harqProcId));
-    }
+  return GetUlHarqProcesses (rnti).m_processes[GetUlHarqSlot (harqProcId)];
 }
 
 
@@ -131,7 +131,9 @@ void
 LteHarqPhy::UpdateDlHarqProcessStatus (uint8_t id, uint8_t layer, double mi, uint16_t infoBytes, uint16_t codeBytes)
 {
   NS_LOG_FUNCTION (this << (uint16_t) id << mi);
-  if (m_miDlHarqProcessesInfoMap.at (layer).at (id).size () == 3)  // MAX HARQ RETX
+  NS_ASSERT (layer < HARQ_DL_LAYER_NUM && id < HARQ_PROC_NUM);
+  HarqProcessInfoList_t& list = m_miDlHarqProcessesInfo[layer][id];
+  if (list.size () == HarqProcessInfoList_t::MAX_SIZE)  // MAX HARQ RETX
     {
       // HARQ should be disabled -> discard info
       return;
@@ -140,7 +142,7 @@ LteHarqPhy::UpdateDlHarqProcessStatus (uint8_t id, uint8_t layer, double mi, uin
   el.m_mi = mi;
   el.m_infoBits = infoBytes * 8;
   el.m_codeBits = codeBytes * 8;
-  m_miDlHarqProcessesInfoMap.at (layer).at (id).push_back (el);
+  list.push_back (el);
 }
 
 
@@ -148,9 +150,10 @@ void
 LteHarqPhy::ResetDlHarqProcessStatus (uint8_t id)
 {
   NS_LOG_FUNCTION (this << (uint16_t) id);
-  for (uint8_t i = 0; i < m_miDlHarqProcessesInfoMap.size (); i++)
+  NS_ASSERT (id < HARQ_PROC_NUM);
+  for (uint8_t i = 0; i < HARQ_DL_LAYER_NUM; i++)
     {
-      m_miDlHarqProcessesInfoMap.at (i).at (id).clear ();
+      m_miDlHarqProcessesInfo[i][id].clear ();
     }
   
 }
@@ -160,52 +163,24 @@ void
 LteHarqPhy::UpdateUlHarqProcessStatus (uint16_t rnti, double mi, uint16_t infoBytes, uint16_t codeBytes)
 {
   NS_LOG_FUNCTION (this << rnti << mi);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      HarqProcessInfoElement_t el;
-      el.m_mi = mi;
-      el.m_infoBits = infoBytes * 8;
-      el.m_codeBits = codeBytes * 8;
-      harqList.at (7).push_back (el);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-    }
-  else
+  HarqProcessInfoList_t& list = GetUlHarqProcesses (rnti).m_processes[GetUlHarqSlot (HARQ_PROC_NUM - 1)];
+  if (list.size () == HarqProcessInfoList_t::MAX_SIZE) // MAX HARQ RETX
     {
-      if ((*it).second.at (7).size () == 3) // MAX HARQ RETX
-        {
-          // HARQ should be disabled -> discard info
-          return;
-        }
-      HarqProcessInfoElement_t el;
-      el.m_mi = mi;
-      el.m_infoBits = infoBytes * 8;
-      el.m_codeBits = codeBytes * 8;
-      (*it).second.at (7).push_back (el);
+      // HARQ should be disabled -> discard info
+      return;
     }
+  HarqProcessInfoElement_t el;
+  el.m_mi = mi;
+  el.m_infoBits = infoBytes * 8;
+  el.m_codeBits = codeBytes * 8;
+  list.push_back (el);
 }
 
 void
 LteHarqPhy::ResetUlHarqProcessStatus (uint16_t rnti, uint8_t id)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)id);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-    }
-  else
-    {
-      (*it).second.at (id).clear ();
-    }
+  GetUlHarqProcesses (rnti).m_processes[GetUlHarqSlot (id)].clear ();
 }
 
 
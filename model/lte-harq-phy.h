@@ -44,7 +44,78 @@ struct HarqProcessInfoElement_t
    uint16_t m_codeBits;
 };
 
-typedef std::vector <HarqProcessInfoElement_t> HarqProcessInfoList_t;
+/**
+ * \ingroup lte
+ * \brief The info of the transmissions of a TB, stored inline
+ *
+ * LteHarqPhy keeps the info of at most MAX_SIZE transmissions per HARQ
+ * process, hence the list has a fixed capacity and does not allocate.
+ * It offers the subset of the std::vector interface used by the users
+ * of HarqProcessInfoList_t.
+ */
+class HarqProcessInfoList
+{
+public:
+  /// Largest number of transmissions whose info is kept (MAX HARQ RETX)
+  static const uint8_t MAX_SIZE = 3;
+
+  HarqProcessInfoList ()
+    : m_size (0)
+  {
+  }
+
+  /// \return the number of transmissions
+  uint32_t size () const
+  {
+    return m_size;
+  }
+
+  /// \return true if there is no transmission
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param i the index of a transmission
+   * \return the info of the transmission
+   */
+  const HarqProcessInfoElement_t& at (uint32_t i) const
+  {
+    NS_ASSERT_MSG (i < m_size, "invalid HARQ transmission " << i);
+    return m_elements[i];
+  }
+
+  /**
+   * \param i the index of a transmission
+   * \return the info of the transmission
+   */
+  const HarqProcessInfoElement_t& operator[] (uint32_t i) const
+  {
+    return at (i);
+  }
+
+  /**
+   * \param el the info of a new transmission
+   */
+  void push_back (const HarqProcessInfoElement_t& el)
+  {
+    NS_ASSERT (m_size < MAX_SIZE);
+    m_elements[m_size++] = el;
+  }
+
+  /// Forget all the transmissions
+  void clear ()
+  {
+    m_size = 0;
+  }
+
+private:
+  HarqProcessInfoElement_t m_elements[MAX_SIZE]; ///< the info of the transmissions
+  uint8_t m_size; ///< the number of transmissions
+};
+
+typedef HarqProcessInfoList HarqProcessInfoList_t;
 
 /**
  * \ingroup lte
@@ -74,9 +145,10 @@ public:
   * for DL (asynchronous)
   * \param harqProcId the HARQ proc id
   * \param layer layer no. (for MIMO spatail multiplexing)
-  * \return the vector of the info related to HARQ proc Id
+  * \return the vector of the info related to HARQ proc Id, valid until
+  * the next update of the HARQ processes
   */
-  HarqProcessInfoList_t GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer);
+  const HarqProcessInfoList_t& GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer);
 
   /**
   * \brief Return the cumulated MI of the HARQ procId in case of retranmissions
@@ -90,9 +162,10 @@ public:
   * for UL (asynchronous)
   * \param rnti the RNTI of the transmitter
   * \param harqProcId the HARQ proc id
-  * \return the vector of the info related to HARQ proc Id
+  * \return the vector of the info related to HARQ proc Id, valid until
+  * the next update of the HARQ processes
   */
-  HarqProcessInfoList_t GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
+  const HarqProcessInfoList_t& GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
 
   /**
   * \brief Update the Info associated to the decodification of an HARQ process
@@ -135,8 +208,36 @@ public:
 
 private:
 
-  std::vector <std::vector <HarqProcessInfoList_t> > m_miDlHarqProcessesInfoMap;
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> > m_miUlHarqProcessesInfoMap;
+  /// Number of HARQ processes
+  static const uint8_t HARQ_PROC_NUM = 8;
+
+  /// Number of layers of the DL HARQ processes
+  static const uint8_t HARQ_DL_LAYER_NUM = 2;
+
+  /// The UL HARQ processes of a transmitter
+  struct UlHarqProcesses
+  {
+    /// the processes, the oldest being at m_ulHarqHead
+    HarqProcessInfoList_t m_processes[HARQ_PROC_NUM];
+  };
+
+  /**
+   * \param rnti the RNTI of a transmitter
+   * \return the UL HARQ processes of the transmitter, created if needed
+   */
+  UlHarqProcesses& GetUlHarqProcesses (uint16_t rnti);
+
+  /**
+   * \param id the index of an UL HARQ process, 0 being the oldest one
+   * \return the index of the process in UlHarqProcesses::m_processes
+   */
+  uint8_t GetUlHarqSlot (uint8_t id) const;
+
+  HarqProcessInfoList_t m_miDlHarqProcessesInfo[HARQ_DL_LAYER_NUM][HARQ_PROC_NUM]; ///< the DL HARQ processes, by layer and id
+
+  std::map <uint16_t, uint32_t> m_ulHarqIndexByRnti; ///< index in m_miUlHarqProcessesInfo of each RNTI
+  std::vector <UlHarqProcesses> m_miUlHarqProcessesInfo; ///< the UL HARQ processes of the transmitters
+  uint8_t m_ulHarqHead; ///< slot of the oldest UL HARQ process, shared by all the transmitters
   
 
 };
@@ -24,6 +24,8 @@
 
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <ns3/boolean.h>
+#include <ns3/spectrum-phy.h>
 
 
 namespace ns3 {
@@ -33,7 +35,8 @@ NS_LOG_COMPONENT_DEFINE ("LteInterference");
 LteInterference::LteInterference ()
   : m_receiving (false),
     m_lastSignalId (0),
-    m_lastSignalIdBeforeReset (0)
+    m_lastSignalIdBeforeReset (0),
+    m_cacheContributions (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -53,6 +56,8 @@ LteInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_contributions.clear ();
+  m_expiredTxPhys.clear ();
   Object::DoDispose ();
 } 
 
@@ -63,6 +68,14 @@ LteInterference::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::LteInterference")
     .SetParent<Object> ()
     .SetGroupName("Lte")
+    .AddAttribute ("CacheContributions",
+                   "If true, the contribution of each transmitter to the total "
+                   "interference is kept between its signals and updated only "
+                   "when its power spectral density changes; if false, every "
+                   "signal is added and subtracted on its own.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&LteInterference::m_cacheContributions),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -136,6 +149,78 @@ LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
 {
   NS_LOG_FUNCTION (this << *spd << duration);
   DoAddSignal (spd);
+  uint32_t signalId = GetNextSignalId ();
+  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+}
+
+/**
+ * \param a a power spectral density
+ * \param b another power spectral density, of the same spectrum model
+ * \return true if the values of the two are equal
+ */
+static bool
+IsEqual (const SpectrumValue& a, const SpectrumValue& b)
+{
+  Values::const_iterator ita = a.ConstValuesBegin ();
+  Values::const_iterator itb = b.ConstValuesBegin ();
+  for (; ita != a.ConstValuesEnd (); ++ita, ++itb)
+    {
+      if (*ita != *itb)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration, Ptr<SpectrumPhy> txPhy)
+{
+  NS_LOG_FUNCTION (this << *spd << duration << txPhy);
+  if (!m_cacheContributions || txPhy == 0)
+    {
+      AddSignal (spd, duration);
+      return;
+    }
+  // before the lookup, since it may remove expired contributions
+  ConditionallyEvaluateChunk ();
+  std::map<Ptr<SpectrumPhy>, Contribution>::iterator it = m_contributions.find (txPhy);
+  if (it != m_contributions.end () && !it->second.expired)
+    {
+      // the previous signal of the transmitter is still on the air
+      AddSignal (spd, duration);
+      return;
+    }
+
+  if (it == m_contributions.end ())
+    {
+      NS_LOG_LOGIC ("new contribution");
+      Contribution contribution;
+      contribution.psd = spd;
+      contribution.listed = false;
+      it = m_contributions.insert (std::make_pair (txPhy, contribution)).first;
+      (*m_allSignals) += (*spd);
+    }
+  else if (!IsEqual (*it->second.psd, *spd))
+    {
+      NS_LOG_LOGIC ("updated contribution");
+      (*m_allSignals) -= (*it->second.psd);
+      (*m_allSignals) += (*spd);
+      it->second.psd = spd;
+    }
+  else
+    {
+      NS_LOG_LOGIC ("unchanged contribution");
+    }
+  it->second.signalId = GetNextSignalId ();
+  it->second.end = Now () + duration;
+  it->second.expired = false;
+  Simulator::Schedule (duration, &LteInterference::DoExpireContribution, this, txPhy, it->second.signalId);
+}
+
+uint32_t
+LteInterference::GetNextSignalId ()
+{
   uint32_t signalId = ++m_lastSignalId;
   if (signalId == m_lastSignalIdBeforeReset)
     {
@@ -146,7 +231,7 @@ LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
       // boundary further.
       m_lastSignalIdBeforeReset += 0x10000000;
     }
-  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+  return signalId;
 }
 
 
@@ -175,6 +260,56 @@ LteInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signa
 }
 
 
+void
+LteInterference::DoExpireContribution (Ptr<SpectrumPhy> txPhy, uint32_t signalId)
+{
+  NS_LOG_FUNCTION (this << txPhy << signalId);
+  std::map<Ptr<SpectrumPhy>, Contribution>::iterator it = m_contributions.find (txPhy);
+  if (it == m_contributions.end () || it->second.signalId != signalId)
+    {
+      NS_LOG_INFO ("ignoring contribution cached before last reset");
+      return;
+    }
+  // close the chunk at the end of the signal, as if it were subtracted;
+  // the contribution itself stays in m_allSignals until the next chunk
+  // is evaluated, so that a new equal signal of the transmitter costs
+  // nothing
+  ConditionallyEvaluateChunk ();
+  it->second.expired = true;
+  if (!it->second.listed)
+    {
+      it->second.listed = true;
+      m_expiredTxPhys.push_back (txPhy);
+    }
+}
+
+void
+LteInterference::RemoveExpiredContributions (Time time)
+{
+  NS_LOG_FUNCTION (this << time);
+  std::vector<Ptr<SpectrumPhy> >::iterator keep = m_expiredTxPhys.begin ();
+  for (std::vector<Ptr<SpectrumPhy> >::iterator it = m_expiredTxPhys.begin ();
+       it != m_expiredTxPhys.end (); ++it)
+    {
+      std::map<Ptr<SpectrumPhy>, Contribution>::iterator cit = m_contributions.find (*it);
+      if (!cit->second.expired)
+        {
+          // renewed by a new signal
+          cit->second.listed = false;
+        }
+      else if (cit->second.end <= time)
+        {
+          (*m_allSignals) -= (*cit->second.psd);
+          m_contributions.erase (cit);
+        }
+      else
+        {
+          *keep++ = *it;
+        }
+    }
+  m_expiredTxPhys.erase (keep, m_expiredTxPhys.end ());
+}
+
 void
 LteInterference::ConditionallyEvaluateChunk ()
 {
@@ -186,6 +321,10 @@ LteInterference::ConditionallyEvaluateChunk ()
   NS_LOG_DEBUG (this << " now "  << Now () << " last " << m_lastChangeTime);
   if (m_receiving && (Now () > m_lastChangeTime))
     {
+      if (!m_expiredTxPhys.empty ())
+        {
+          RemoveExpiredContributions (m_lastChangeTime);
+        }
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
       SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
@@ -225,6 +364,8 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // record the last SignalId so that we can ignore all signals that
   // were scheduled for subtraction before m_allSignal 
   m_lastSignalIdBeforeReset = m_lastSignalId;
+  m_contributions.clear ();
+  m_expiredTxPhys.clear ();
 }
 
 void
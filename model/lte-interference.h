@@ -28,6 +28,8 @@
 #include <ns3/spectrum-value.h>
 
 #include <list>
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -35,6 +37,7 @@ namespace ns3 {
 
 
 class LteChunkProcessor;
+class SpectrumPhy;
 
 
 
@@ -42,6 +45,13 @@ class LteChunkProcessor;
  * This class implements a gaussian interference model, i.e., all
  * incoming signals are added to the total interference.
  *
+ * The signals whose transmitter is known are cached as the contribution
+ * of the transmitter to the total: when a transmitter sends a new
+ * signal after the end of its previous one, only the difference between
+ * the two power spectral densities is applied to the total, and nothing
+ * at all if they are equal. The contribution of a transmitter which
+ * stops transmitting is removed before the next interference chunk is
+ * evaluated.
  */
 class LteInterference : public Object
 {
@@ -106,6 +116,16 @@ public:
    */
   void AddSignal (Ptr<const SpectrumValue> spd, const Time duration);
 
+  /**
+   * notify that a new signal of a known transmitter is being perceived
+   * in the medium.
+   *
+   * @param spd the power spectral density of the new signal
+   * @param duration the duration of the new signal
+   * @param txPhy the transmitter of the signal
+   */
+  void AddSignal (Ptr<const SpectrumValue> spd, const Time duration, Ptr<SpectrumPhy> txPhy);
+
 
   /**
    *
@@ -119,6 +139,38 @@ private:
   void DoAddSignal  (Ptr<const SpectrumValue> spd);
   void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
 
+  /**
+   * \return the identifier of a new signal
+   */
+  uint32_t GetNextSignalId ();
+
+  /**
+   * Mark the contribution of a transmitter as expired, if its last signal
+   * is the given one
+   *
+   * \param txPhy the transmitter
+   * \param signalId the identifier of the signal which ends
+   */
+  void DoExpireContribution (Ptr<SpectrumPhy> txPhy, uint32_t signalId);
+
+  /**
+   * Remove from m_allSignals the contributions which expired at or before
+   * the given time
+   *
+   * \param time the start time of the chunk to be evaluated
+   */
+  void RemoveExpiredContributions (Time time);
+
+  /// Contribution of a transmitter to m_allSignals
+  struct Contribution
+  {
+    Ptr<const SpectrumValue> psd; ///< the PSD of the last signal of the transmitter
+    uint32_t signalId; ///< the identifier of the last signal of the transmitter
+    Time end; ///< the end time of the last signal
+    bool expired; ///< true if the last signal ended and was not followed by a new one
+    bool listed; ///< true if the transmitter is in m_expiredTxPhys
+  };
+
 
 
   bool m_receiving;
@@ -141,6 +193,10 @@ private:
   uint32_t m_lastSignalId;
   uint32_t m_lastSignalIdBeforeReset;
 
+  bool m_cacheContributions; ///< whether the signals of known transmitters are cached
+  std::map<Ptr<SpectrumPhy>, Contribution> m_contributions; ///< the cached contributions, by transmitter
+  std::vector<Ptr<SpectrumPhy> > m_expiredTxPhys; ///< the transmitters whose contribution expired
+
   /** all the processor instances that need to be notified whenever
   a new interference chunk is calculated */
   std::list<Ptr<LteChunkProcessor> > m_rsPowerChunkProcessorList;
@@ -19,6 +19,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 
 #include "ns3/lte-pdcp-header.h"
 
@@ -117,4 +118,22 @@ uint32_t LtePdcpHeader::Deserialize (Buffer::Iterator start)
   return GetSerializedSize ();
 }
 
+LtePdcpHeader::View::View (Ptr<const Packet> p)
+{
+  NS_ASSERT (p->GetSize () >= SIZE);
+  p->CopyData (m_bytes, SIZE);
+}
+
+uint8_t
+LtePdcpHeader::View::GetDcBit () const
+{
+  return (m_bytes[0] & 0x80) >> 7;
+}
+
+uint16_t
+LtePdcpHeader::View::GetSequenceNumber () const
+{
+  return ((m_bytes[0] & 0x0F) << 8) | m_bytes[1];
+}
+
 }; // namespace ns3
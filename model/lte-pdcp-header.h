@@ -22,11 +22,14 @@
 #define LTE_PDCP_HEADER_H
 
 #include "ns3/header.h"
+#include "ns3/ptr.h"
 
 #include <list>
 
 namespace ns3 {
 
+class Packet;
+
 /**
  * \ingroup lte
  * \brief The packet header for the Packet Data Convergence Protocol (PDCP) packets
@@ -65,6 +68,31 @@ public:
   virtual void Serialize (Buffer::Iterator start) const;
   virtual uint32_t Deserialize (Buffer::Iterator start);
 
+  /**
+   * \brief In-place view of the header at the start of a PDCP data PDU
+   *
+   * The header of a PDCP data PDU has a fixed 2-byte layout, so its
+   * fields are read directly from the first bytes of the packet, with
+   * no Header deserialization.
+   */
+  class View
+  {
+  public:
+    /**
+     * \param p the PDCP data PDU, starting with its header
+     */
+    View (Ptr<const Packet> p);
+
+    uint8_t GetDcBit () const;
+    uint16_t GetSequenceNumber () const;
+
+    /// size of the header in bytes
+    static const uint32_t SIZE = 2;
+
+  private:
+    uint8_t m_bytes[SIZE]; ///< the header bytes
+  };
+
 private:
   uint8_t m_dcBit;
   uint16_t m_sequenceNumber;
@@ -94,6 +94,10 @@ LtePdcp::GetTypeId (void)
                      "PDU received.",
                      MakeTraceSourceAccessor (&LtePdcp::m_rxPdu),
                      "ns3::LtePdcp::PduRxTracedCallback")
+    .AddTraceSource ("RxPDUPacket",
+                     "PDU received, before the removal of the PDCP header.",
+                     MakeTraceSourceAccessor (&LtePdcp::m_rxPduPacket),
+                     "ns3::LtePdcp::PduRxPacketTracedCallback")
     ;
   return tid;
 }
@@ -212,10 +216,15 @@ LtePdcp::DoReceivePdu (Ptr<Packet> p)
       delay = Simulator::Now() - pdcpTag.GetSenderTimestamp ();
     }
   m_rxPdu(m_rnti, m_lcid, p->GetSize (), delay.GetNanoSeconds ());
-
-  LtePdcpHeader pdcpHeader;
-  p->RemoveHeader (pdcpHeader);
-  NS_LOG_LOGIC ("PDCP header: " << pdcpHeader);
+  m_rxPduPacket (m_rnti, m_lcid, p);
+
+  // The PDCP data PDU header has a fixed layout: read it in place and
+  // strip its bytes, rather than deserializing a LtePdcpHeader
+  LtePdcpHeader::View pdcpHeader (p);
+  NS_LOG_LOGIC ("PDCP header: D/C=" << (uint16_t) pdcpHeader.GetDcBit ()
+                << " SN=" << pdcpHeader.GetSequenceNumber ());
+  NS_ASSERT (pdcpHeader.GetDcBit () == LtePdcpHeader::DATA_PDU);
+  p->RemoveAtStart (LtePdcpHeader::View::SIZE);
 
   m_rxSequenceNumber = pdcpHeader.GetSequenceNumber () + 1;
   if (m_rxSequenceNumber > m_maxPdcpSn)
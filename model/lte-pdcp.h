@@ -135,6 +135,18 @@ public:
     (const uint16_t rnti, const uint8_t lcid,
      const uint32_t size, const uint64_t delay);
 
+  /**
+   * TracedCallback signature for PDU receive event, with the packet.
+   *
+   * \param [in] rnti The C-RNTI identifying the UE.
+   * \param [in] lcid The logical channel id corresponding to
+   *             the sending RLC instance.
+   * \param [in] packet The PDU, still carrying the PDCP header and
+   *             the timestamp tags of the lower layers.
+   */
+  typedef void (* PduRxPacketTracedCallback)
+    (const uint16_t rnti, const uint8_t lcid, Ptr<const Packet> packet);
+
 protected:
   // Interface provided to upper RRC entity
   virtual void DoTransmitPdcpSdu (Ptr<Packet> p);
@@ -161,6 +173,12 @@ protected:
    * The parameters are RNTI, LCID, bytes delivered and delivery delay in nanoseconds. 
    */
   TracedCallback<uint16_t, uint8_t, uint32_t, uint64_t> m_rxPdu;
+  /**
+   * Used to inform of a PDU reception from the RLC SAP user, with the
+   * packet, so that the timestamps it carries can be inspected.
+   * The parameters are RNTI, LCID and the PDU.
+   */
+  TracedCallback<uint16_t, uint8_t, Ptr<const Packet> > m_rxPduPacket;
 
 private:
   /**
@@ -19,6 +19,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 
 #include "ns3/lte-rlc-am-header.h"
 
@@ -643,4 +644,46 @@ uint32_t LteRlcAmHeader::Deserialize (Buffer::Iterator start)
   return GetSerializedSize ();
 }
 
+LteRlcAmHeader::View::View (Ptr<const Packet> p)
+{
+  NS_ASSERT (p->GetSize () >= SIZE);
+  p->CopyData (m_bytes, SIZE);
+}
+
+bool
+LteRlcAmHeader::View::IsDataPdu (void) const
+{
+  return ((m_bytes[0] & 0x80) >> 7) == DATA_PDU;
+}
+
+bool
+LteRlcAmHeader::View::IsControlPdu (void) const
+{
+  return ((m_bytes[0] & 0x80) >> 7) == CONTROL_PDU;
+}
+
+uint8_t
+LteRlcAmHeader::View::GetResegmentationFlag () const
+{
+  return (m_bytes[0] & 0x40) >> 6;
+}
+
+uint8_t
+LteRlcAmHeader::View::GetPollingBit () const
+{
+  return (m_bytes[0] & 0x20) >> 5;
+}
+
+uint8_t
+LteRlcAmHeader::View::GetFramingInfo () const
+{
+  return (m_bytes[0] & 0x18) >> 3;
+}
+
+SequenceNumber10
+LteRlcAmHeader::View::GetSequenceNumber () const
+{
+  return SequenceNumber10 (((m_bytes[0] & 0x03) << 8) | m_bytes[1]);
+}
+
 }; // namespace ns3
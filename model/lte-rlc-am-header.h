@@ -22,12 +22,15 @@
 #define LTE_RLC_AM_HEADER_H
 
 #include "ns3/header.h"
+#include "ns3/ptr.h"
 #include "ns3/lte-rlc-sequence-number.h"
 
 #include <list>
 
 namespace ns3 {
 
+class Packet;
+
 /**
  * \ingroup lte
  * \brief The packet header for the AM Radio Link Control (RLC) protocol packets
@@ -170,6 +173,36 @@ public:
    */
   int PopNack (void);
 
+  /**
+   * \brief In-place view of the first bytes of the header of an AMD PDU
+   *
+   * The D/C, RF, P, FI, E and SN fields of a data PDU have a fixed
+   * 2-byte layout, so they are read directly from the first bytes of
+   * the packet, without deserializing the whole header. The D/C field
+   * tells whether the PDU is a STATUS PDU, which needs to be
+   * deserialized to read its ACK and NACK fields.
+   */
+  class View
+  {
+  public:
+    /**
+     * \param p the AMD PDU or STATUS PDU, starting with its header
+     */
+    View (Ptr<const Packet> p);
+
+    bool IsDataPdu (void) const;
+    bool IsControlPdu (void) const;
+    uint8_t GetResegmentationFlag () const;
+    uint8_t GetPollingBit () const;
+    uint8_t GetFramingInfo () const;
+    SequenceNumber10 GetSequenceNumber () const;
+
+    /// number of header bytes read by the view
+    static const uint32_t SIZE = 2;
+
+  private:
+    uint8_t m_bytes[SIZE]; ///< the first bytes of the header
+  };
 
 private:
   uint16_t m_headerLength;
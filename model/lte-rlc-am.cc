@@ -34,23 +34,131 @@ NS_LOG_COMPONENT_DEFINE ("LteRlcAm");
 
 NS_OBJECT_ENSURE_REGISTERED (LteRlcAm);
 
+/**
+ * \param word a non-zero word
+ * \return the index of the least significant bit set in the word
+ */
+static uint16_t
+FindLowestBitSet (uint64_t word)
+{
+  // de Bruijn sequence based lookup
+  static const uint8_t index[64] = {
+    0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+    62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+    63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+    46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+  };
+  NS_ASSERT (word != 0);
+  return index[((word & (~word + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+LteRlcAm::SnBitmap::SnBitmap ()
+{
+  ClearAll ();
+}
+
+void
+LteRlcAm::SnBitmap::Set (uint16_t sn)
+{
+  NS_ASSERT (sn < 1024);
+  m_words[sn / 64] |= (uint64_t) 1 << (sn % 64);
+}
+
+void
+LteRlcAm::SnBitmap::Clear (uint16_t sn)
+{
+  NS_ASSERT (sn < 1024);
+  m_words[sn / 64] &= ~((uint64_t) 1 << (sn % 64));
+}
+
+bool
+LteRlcAm::SnBitmap::IsSet (uint16_t sn) const
+{
+  NS_ASSERT (sn < 1024);
+  return (m_words[sn / 64] >> (sn % 64)) & 1;
+}
+
+void
+LteRlcAm::SnBitmap::ClearAll ()
+{
+  for (uint16_t i = 0; i < 1024 / 64; ++i)
+    {
+      m_words[i] = 0;
+    }
+}
+
+void
+LteRlcAm::SnBitmap::SetAll (const SnBitmap& other)
+{
+  for (uint16_t i = 0; i < 1024 / 64; ++i)
+    {
+      m_words[i] |= other.m_words[i];
+    }
+}
+
+uint16_t
+LteRlcAm::SnBitmap::FindFirstSet (uint16_t first, uint16_t count) const
+{
+  return Find (first, count, false);
+}
+
+uint16_t
+LteRlcAm::SnBitmap::FindFirstClear (uint16_t first, uint16_t count) const
+{
+  return Find (first, count, true);
+}
+
+uint16_t
+LteRlcAm::SnBitmap::Find (uint16_t first, uint16_t count, bool invert) const
+{
+  NS_ASSERT (first < 1024 && count <= 1024);
+  uint16_t offset = 0;
+  while (offset < count)
+    {
+      uint16_t sn = (first + offset) % 1024;
+      uint16_t bit = sn % 64;
+      uint64_t word = m_words[sn / 64];
+      if (invert)
+        {
+          word = ~word;
+        }
+      word >>= bit;
+      // number of bits of this word belonging to the range
+      uint16_t numBits = std::min<uint16_t> (64 - bit, count - offset);
+      if (numBits < 64)
+        {
+          word &= ((uint64_t) 1 << numBits) - 1;
+        }
+      if (word != 0)
+        {
+          return offset + FindLowestBitSet (word);
+        }
+      offset += numBits;
+    }
+  return count;
+}
+
+
 
 LteRlcAm::LteRlcAm ()
 {
   NS_LOG_FUNCTION (this);
 
-  // Buffers
+  m_windowSize = 512;
+
+  // Buffers: at most m_windowSize SNs can be in the transmitting
+  // (receiving) window, hence there is no need to allocate room for
+  // the whole SN space
   m_txonBufferSize = 0;
-  m_retxBuffer.resize (1024);
+  m_txWindow.resize (m_windowSize);
   m_retxBufferSize = 0;
-  m_txedBuffer.resize (1024);
   m_txedBufferSize = 0;
+  m_rxonBuffer.resize (m_windowSize);
 
   m_statusPduRequested = false;
   m_statusPduBufferSize = 0;
 
   // State variables: transmitting side
-  m_windowSize = 512;
   m_vtA  = 0;
   m_vtMs = m_vtA + m_windowSize;
   m_vtS  = 0;
@@ -135,11 +243,13 @@ LteRlcAm::DoDispose ()
 
   m_txonBuffer.clear ();
   m_txonBufferSize = 0;
-  m_txedBuffer.clear ();
+  m_txWindow.clear ();
+  m_txedBitmap.ClearAll ();
   m_txedBufferSize = 0;
-  m_retxBuffer.clear ();
+  m_retxBitmap.ClearAll ();
   m_retxBufferSize = 0;
   m_rxonBuffer.clear ();
+  m_rxonBitmap.ClearAll ();
   m_sdusBuffer.clear ();
   m_keepS0 = 0;
   m_controlPduBuffer = 0;
@@ -157,19 +267,9 @@ LteRlcAm::DoTransmitPdcpPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
 
-  /** Store arrival time */
-  Time now = Simulator::Now ();
-  RlcTag timeTag (now);
-  p->AddPacketTag (timeTag);
-
-  /** Store PDCP PDU */
-
-  LteRlcSduStatusTag tag;
-  tag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-  p->AddPacketTag (tag);
-
+  /** Store PDCP PDU and its arrival time */
   NS_LOG_LOGIC ("Txon Buffer: New packet added");
-  m_txonBuffer.push_back (p);
+  m_txonBuffer.push_back (TxSdu (p, Simulator::Now (), LteRlcSduStatusTag::FULL_SDU));
   m_txonBufferSize += p->GetSize ();
   NS_LOG_LOGIC ("NumOfBuffers = " << m_txonBuffer.size() );
   NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
@@ -753,38 +853,30 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       rlcAmHeader.SetControlPdu (LteRlcAmHeader::STATUS_PDU);
      
       NS_LOG_LOGIC ("Check for SNs to NACK from " << m_vrR.GetValue() << " to " << m_vrMs.GetValue());
-      SequenceNumber10 sn;
-      sn.SetModulusBase (m_vrR);
-      std::map<uint16_t, PduBuffer>::iterator pduIt;
-      for (sn = m_vrR; sn < m_vrMs; sn++) 
+      // jump from one missing SN to the next one
+      uint16_t offset = 0;
+      uint16_t count = (m_vrMs.GetValue () + 1024 - m_vrR.GetValue ()) % 1024;
+      while (offset < count)
         {
-          NS_LOG_LOGIC ("SN = " << sn);          
+          offset += m_rxonBitmap.FindFirstClear ((m_vrR.GetValue () + offset) % 1024, count - offset);
+          if (offset == count)
+            {
+              break;
+            }
           if (!rlcAmHeader.OneMoreNackWouldFitIn (bytes))
             {
+              // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN: the SN of the
+              // next not received RLC Data PDU which is not reported as
+              // missing in the STATUS PDU
               NS_LOG_LOGIC ("Can't fit more NACKs in STATUS PDU");
               break;
-            }          
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
-          if (pduIt == m_rxonBuffer.end () || (!(pduIt->second.m_pduComplete)))
-            {
-              NS_LOG_LOGIC ("adding NACK_SN " << sn.GetValue ());
-              rlcAmHeader.PushNack (sn.GetValue ());              
-            }          
-        }
-      NS_LOG_LOGIC ("SN at end of NACK loop = " << sn);
-      // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN
-      // find the  SN of the next not received RLC Data PDU 
-      // which is not reported as missing in the STATUS PDU. 
-      pduIt = m_rxonBuffer.find (sn.GetValue ());
-      while ((sn < m_vrMs) && (pduIt != m_rxonBuffer.end ()) && (pduIt->second.m_pduComplete))            
-        {
-          NS_LOG_LOGIC ("SN = " << sn << " < " << m_vrMs << " = " << (sn < m_vrMs));
-          sn++;
-          NS_LOG_LOGIC ("SN = " << sn);
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
+            }
+          NS_LOG_LOGIC ("adding NACK_SN " << (m_vrR.GetValue () + offset) % 1024);
+          rlcAmHeader.PushNack ((m_vrR.GetValue () + offset) % 1024);
+          ++offset;
         }
-      
-      NS_ASSERT_MSG (sn <= m_vrMs, "first SN not reported as missing = " << sn << ", VR(MS) = " << m_vrMs);      
+      SequenceNumber10 sn = m_vrR + offset;
+      NS_LOG_LOGIC ("ACK_SN = " << sn);
       rlcAmHeader.SetAckSn (sn); 
 
 
@@ -813,106 +905,96 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);      
       NS_LOG_LOGIC ("Sending data from Retransmission Buffer");
       NS_ASSERT (m_vtA < m_vtS);
-      SequenceNumber10 sn;
-      sn.SetModulusBase (m_vtA);
-      bool found = false;
-      for (sn = m_vtA; sn < m_vtS; sn++) 
+      uint16_t count = (m_vtS.GetValue () + 1024 - m_vtA.GetValue ()) % 1024;
+      uint16_t offset = m_retxBitmap.FindFirstSet (m_vtA.GetValue (), count);
+      NS_ASSERT_MSG (offset < count, "m_retxBufferSize > 0, but no PDU considered for retx found");
+      uint16_t seqNumberValue = (m_vtA.GetValue () + offset) % 1024;
+      RetxPdu& retxPdu = m_txWindow.at (seqNumberValue % m_windowSize);
+      NS_LOG_LOGIC ("SN = " << seqNumberValue << " m_pdu " << retxPdu.m_pdu);
+
+      Ptr<Packet> packet = retxPdu.m_pdu->Copy ();
+      
+      if (( packet->GetSize () <= bytes )
+          || m_txOpportunityForRetxAlwaysBigEnough)
         {
-          uint16_t seqNumberValue = sn.GetValue ();
-          NS_LOG_LOGIC ("SN = " << seqNumberValue << " m_pdu " << m_retxBuffer.at (seqNumberValue).m_pdu);
+          // According to 5.2.1, the data field is left as is, but we rebuild the header
+          LteRlcAmHeader rlcAmHeader;
+          packet->RemoveHeader (rlcAmHeader);
+          NS_LOG_LOGIC ("old AM RLC header: " << rlcAmHeader);
+
+          // Calculate the Polling Bit (5.2.2.1)
+          rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_NOT_REQUESTED);
+
+          NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.empty () 
+                        << " retxBufferSize="  << m_retxBufferSize
+                        << " packet->GetSize ()=" << packet->GetSize ());
+          if (((m_txonBuffer.empty ()) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ())) 
+              || (m_vtS >= m_vtMs)
+              || m_pollRetransmitTimerJustExpired)
+            {
+              m_pollRetransmitTimerJustExpired = false;
+              rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_IS_REQUESTED);
+              m_pduWithoutPoll = 0;
+              m_byteWithoutPoll = 0;
 
-          if (m_retxBuffer.at (seqNumberValue).m_pdu != 0)
-            {            
+              m_pollSn = m_vtS - 1;
+              NS_LOG_LOGIC ("New POLL_SN = " << m_pollSn);
 
-              Ptr<Packet> packet = m_retxBuffer.at (seqNumberValue).m_pdu->Copy ();
-              
-              if (( packet->GetSize () <= bytes )
-                  || m_txOpportunityForRetxAlwaysBigEnough)
+              if (! m_pollRetransmitTimer.IsRunning () )
                 {
-                  found = true;
-                  // According to 5.2.1, the data field is left as is, but we rebuild the header
-                  LteRlcAmHeader rlcAmHeader;
-                  packet->RemoveHeader (rlcAmHeader);
-                  NS_LOG_LOGIC ("old AM RLC header: " << rlcAmHeader);
-
-                  // Calculate the Polling Bit (5.2.2.1)
-                  rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_NOT_REQUESTED);
-
-                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.empty () 
-                                << " retxBufferSize="  << m_retxBufferSize
-                                << " packet->GetSize ()=" << packet->GetSize ());
-                  if (((m_txonBuffer.empty ()) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ())) 
-                      || (m_vtS >= m_vtMs)
-                      || m_pollRetransmitTimerJustExpired)
-                    {
-                      m_pollRetransmitTimerJustExpired = false;
-                      rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_IS_REQUESTED);
-                      m_pduWithoutPoll = 0;
-                      m_byteWithoutPoll = 0;
-
-                      m_pollSn = m_vtS - 1;
-                      NS_LOG_LOGIC ("New POLL_SN = " << m_pollSn);
-
-                      if (! m_pollRetransmitTimer.IsRunning () )
-                        {
-                          NS_LOG_LOGIC ("Start PollRetransmit timer");
-
-                          m_pollRetransmitTimer = Simulator::Schedule (m_pollRetransmitTimerValue,
-                                                                       &LteRlcAm::ExpirePollRetransmitTimer, this);
-                        }
-                      else
-                        {
-                          NS_LOG_LOGIC ("Restart PollRetransmit timer");
-
-                          m_pollRetransmitTimer.Cancel ();
-                          m_pollRetransmitTimer = Simulator::Schedule (m_pollRetransmitTimerValue,
-                                                                       &LteRlcAm::ExpirePollRetransmitTimer, this);
-                        }
-                    }
+                  NS_LOG_LOGIC ("Start PollRetransmit timer");
 
-                  packet->AddHeader (rlcAmHeader);
-                  NS_LOG_LOGIC ("new AM RLC header: " << rlcAmHeader);
-                  
-                  // Send RLC PDU to MAC layer
-                  LteMacSapProvider::TransmitPduParameters params;
-                  params.pdu = packet;
-                  params.rnti = m_rnti;
-                  params.lcid = m_lcid;
-                  params.layer = layer;
-                  params.harqProcessId = harqId;
-                  params.componentCarrierId = componentCarrierId;
-                  
-                  m_macSapProvider->TransmitPdu (params);
-
-                  m_retxBuffer.at (seqNumberValue).m_retxCount++;
-                  NS_LOG_INFO ("Incr RETX_COUNT for SN = " << seqNumberValue);
-                  if (m_retxBuffer.at (seqNumberValue).m_retxCount >= m_maxRetxThreshold)
-                    {
-                      NS_LOG_INFO ("Max RETX_COUNT for SN = " << seqNumberValue);
-                    }
-
-                  NS_LOG_INFO ("Move SN = " << seqNumberValue << " back to txedBuffer");
-                  m_txedBuffer.at (seqNumberValue).m_pdu = m_retxBuffer.at (seqNumberValue).m_pdu->Copy ();
-                  m_txedBuffer.at (seqNumberValue).m_retxCount = m_retxBuffer.at (seqNumberValue).m_retxCount;
-                  m_txedBufferSize += m_txedBuffer.at (seqNumberValue).m_pdu->GetSize ();
-
-                  m_retxBufferSize -= m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
-                  m_retxBuffer.at (seqNumberValue).m_pdu = 0;
-                  m_retxBuffer.at (seqNumberValue).m_retxCount = 0;
-                  
-                  NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
-
-                  return;
+                  m_pollRetransmitTimer = Simulator::Schedule (m_pollRetransmitTimerValue,
+                                                               &LteRlcAm::ExpirePollRetransmitTimer, this);
                 }
               else
                 {
-                  NS_LOG_LOGIC ("TxOpportunity (size = " << bytes << ") too small for retransmission of the packet (size = " << packet->GetSize () << ")");
-                  NS_LOG_LOGIC ("Waiting for bigger TxOpportunity");
-                  return;
+                  NS_LOG_LOGIC ("Restart PollRetransmit timer");
+
+                  m_pollRetransmitTimer.Cancel ();
+                  m_pollRetransmitTimer = Simulator::Schedule (m_pollRetransmitTimerValue,
+                                                               &LteRlcAm::ExpirePollRetransmitTimer, this);
                 }
             }
+
+          packet->AddHeader (rlcAmHeader);
+          NS_LOG_LOGIC ("new AM RLC header: " << rlcAmHeader);
+          
+          // Send RLC PDU to MAC layer
+          LteMacSapProvider::TransmitPduParameters params;
+          params.pdu = packet;
+          params.rnti = m_rnti;
+          params.lcid = m_lcid;
+          params.layer = layer;
+          params.harqProcessId = harqId;
+          params.componentCarrierId = componentCarrierId;
+          
+          m_macSapProvider->TransmitPdu (params);
+
+          retxPdu.m_retxCount++;
+          retxPdu.m_waitingSince = Simulator::Now ();
+          NS_LOG_INFO ("Incr RETX_COUNT for SN = " << seqNumberValue);
+          if (retxPdu.m_retxCount >= m_maxRetxThreshold)
+            {
+              NS_LOG_INFO ("Max RETX_COUNT for SN = " << seqNumberValue);
+            }
+
+          NS_LOG_INFO ("Move SN = " << seqNumberValue << " back to txedBuffer");
+          m_retxBitmap.Clear (seqNumberValue);
+          m_txedBitmap.Set (seqNumberValue);
+          m_txedBufferSize += retxPdu.m_pdu->GetSize ();
+          m_retxBufferSize -= retxPdu.m_pdu->GetSize ();
+          
+          NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
+
+          return;
+        }
+      else
+        {
+          NS_LOG_LOGIC ("TxOpportunity (size = " << bytes << ") too small for retransmission of the packet (size = " << packet->GetSize () << ")");
+          NS_LOG_LOGIC ("Waiting for bigger TxOpportunity");
+          return;
         }
-      NS_ASSERT_MSG (found, "m_retxBufferSize > 0, but no PDU considered for retx found");
     }
   else if ( m_txonBufferSize > 0 )
     {
@@ -955,7 +1037,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   uint32_t nextSegmentId = 1;
   uint32_t dataFieldTotalSize = 0;
   uint32_t dataFieldAddedSize = 0;
-  std::vector < Ptr<Packet> > dataField;
+  std::vector < TxSdu > dataField;
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
@@ -966,12 +1048,16 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     }
 
   NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << *(m_txonBuffer.begin()));
-  NS_LOG_LOGIC ("First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+  NS_LOG_LOGIC ("First SDU buffer  = " << m_txonBuffer.begin ()->m_sdu);
+  NS_LOG_LOGIC ("First SDU size    = " << m_txonBuffer.begin ()->m_sdu->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
-  m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
+  // The SDUs in the buffer are never modified: segmentation creates
+  // fragments, so the SDU does not need to be copied
+  Ptr<Packet> firstSegment = m_txonBuffer.begin ()->m_sdu;
+  Time firstSegmentWaitingSince = m_txonBuffer.begin ()->m_waitingSince;
+  uint8_t firstSegmentStatus = m_txonBuffer.begin ()->m_status;
+  m_txonBufferSize -= firstSegment->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
   m_txonBuffer.erase (m_txonBuffer.begin ());
 
@@ -997,61 +1083,56 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
           NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
 
-          // Status tag of the new and remaining segments
+          // Status of the new and remaining segments
           // Note: This is the only place where a PDU is segmented and
           // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
-          firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
-          if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
+          uint8_t oldStatus = firstSegmentStatus;
+          uint8_t newStatus = firstSegmentStatus;
+          if (oldStatus == LteRlcSduStatusTag::FULL_SDU)
             {
-              newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
-              oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+              newStatus = LteRlcSduStatusTag::FIRST_SEGMENT;
+              oldStatus = LteRlcSduStatusTag::LAST_SEGMENT;
             }
-          else if (oldTag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT)
+          else if (oldStatus == LteRlcSduStatusTag::LAST_SEGMENT)
             {
-              newTag.SetStatus (LteRlcSduStatusTag::MIDDLE_SEGMENT);
-              //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+              newStatus = LteRlcSduStatusTag::MIDDLE_SEGMENT;
+              //oldStatus = LteRlcSduStatusTag::LAST_SEGMENT;
             }
 
           // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
+          uint32_t remainingSegmentSize = firstSegment->GetSize () - currSegmentSize;
+          NS_LOG_LOGIC ("    remaining segment size = " << remainingSegmentSize);
+          if (remainingSegmentSize > 0)
             {
-              firstSegment->AddPacketTag (oldTag);
-
-              m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-              m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
+              Ptr<Packet> remainingSegment = firstSegment->CreateFragment (currSegmentSize, remainingSegmentSize);
+              m_txonBuffer.insert (m_txonBuffer.begin (), TxSdu (remainingSegment, firstSegmentWaitingSince, oldStatus));
+              m_txonBufferSize += remainingSegmentSize;
 
               NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
               NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.begin ()->m_sdu->GetSize ());
               NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize );
             }
           else
             {
-              // Whole segment was taken, so adjust tag
-              if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
+              // Whole segment was taken, so adjust status
+              if (newStatus == LteRlcSduStatusTag::FIRST_SEGMENT)
                 {
-                  newTag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
+                  newStatus = LteRlcSduStatusTag::FULL_SDU;
                 }
-              else if (newTag.GetStatus () == LteRlcSduStatusTag::MIDDLE_SEGMENT)
+              else if (newStatus == LteRlcSduStatusTag::MIDDLE_SEGMENT)
                 {
-                  newTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+                  newStatus = LteRlcSduStatusTag::LAST_SEGMENT;
                 }
             }
           // Segment is completely taken or
           // the remaining segment is given back to the transmission buffer
           firstSegment = 0;
 
-          // Put status tag once it has been adjusted
-          newSegment->AddPacketTag (newTag);
-
-          // Add Segment to Data field
+          // Add Segment to Data field, with its adjusted status
           dataFieldAddedSize = newSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (newSegment);
+          dataField.push_back (TxSdu (newSegment, firstSegmentWaitingSince, newStatus));
           newSegment = 0;
 
           // ExtensionBit (Next_Segment - 1) = 0
@@ -1074,7 +1155,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // Add txBuffer.FirstBuffer to DataField
           dataFieldAddedSize = firstSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
+          dataField.push_back (TxSdu (firstSegment, firstSegmentWaitingSince, firstSegmentStatus));
           firstSegment = 0;
 
           // ExtensionBit (Next_Segment - 1) = 0
@@ -1088,8 +1169,8 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
           if (m_txonBuffer.size () > 0)
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txonBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_sdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_sdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -1104,7 +1185,7 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // Add txBuffer.FirstBuffer to DataField
           dataFieldAddedSize = firstSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
+          dataField.push_back (TxSdu (firstSegment, firstSegmentWaitingSince, firstSegmentStatus));
 
           // ExtensionBit (Next_Segment - 1) = 1
           rlcAmHeader.PushExtensionBit (LteRlcAmHeader::E_LI_FIELDS_FOLLOWS);
@@ -1118,15 +1199,17 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
           if (m_txonBuffer.size () > 0)
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txonBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_sdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_sdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
-          m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
+          firstSegment = m_txonBuffer.begin ()->m_sdu;
+          firstSegmentWaitingSince = m_txonBuffer.begin ()->m_waitingSince;
+          firstSegmentStatus = m_txonBuffer.begin ()->m_status;
+          m_txonBufferSize -= firstSegment->GetSize ();
           m_txonBuffer.erase (m_txonBuffer.begin ());
           NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
         }
@@ -1147,14 +1230,12 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
 
   // Calculate FramingInfo flag according the status of the SDUs in the DataField
   uint8_t framingInfo = 0;
-  std::vector< Ptr<Packet> >::iterator it;
+  std::vector< TxSdu >::iterator it;
   it = dataField.begin ();
 
   // FIRST SEGMENT
-  LteRlcSduStatusTag tag;
-  (*it)->RemovePacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-       (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
+  if ( (it->m_status == LteRlcSduStatusTag::FULL_SDU) ||
+       (it->m_status == LteRlcSduStatusTag::FIRST_SEGMENT)
      )
     {
       framingInfo |= LteRlcAmHeader::FIRST_BYTE;
@@ -1163,22 +1244,20 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     {
       framingInfo |= LteRlcAmHeader::NO_FIRST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
 
   // Add all SDUs (in DataField) to the Packet
   while (it < dataField.end ())
     {
-      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << it->m_sdu->GetSize ());
 
-      packet->AddAtEnd (*it);
+      packet->AddAtEnd (it->m_sdu);
       it++;
     }
 
   // LAST SEGMENT (Note: There could be only one and be the first one)
   it--;
-  (*it)->RemovePacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
+  if ( (it->m_status == LteRlcSduStatusTag::FULL_SDU) ||
+        (it->m_status == LteRlcSduStatusTag::LAST_SEGMENT) )
     {
       framingInfo |= LteRlcAmHeader::LAST_BYTE;
     }
@@ -1186,7 +1265,6 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     {
       framingInfo |= LteRlcAmHeader::NO_LAST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
 
   // Set the FramingInfo flag after the calculation
   rlcAmHeader.SetFramingInfo (framingInfo);
@@ -1239,8 +1317,11 @@ LteRlcAm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   // Store new PDU into the Transmitted PDU Buffer
   NS_LOG_LOGIC ("Put transmitted PDU in the txedBuffer");
   m_txedBufferSize += packet->GetSize ();
-  m_txedBuffer.at ( rlcAmHeader.GetSequenceNumber ().GetValue () ).m_pdu = packet->Copy ();
-  m_txedBuffer.at ( rlcAmHeader.GetSequenceNumber ().GetValue () ).m_retxCount = 0;
+  uint16_t seqNumberValue = rlcAmHeader.GetSequenceNumber ().GetValue ();
+  m_txWindow.at (seqNumberValue % m_windowSize).m_pdu = packet->Copy ();
+  m_txWindow.at (seqNumberValue % m_windowSize).m_retxCount = 0;
+  m_txWindow.at (seqNumberValue % m_windowSize).m_waitingSince = Simulator::Now ();
+  m_txedBitmap.Set (seqNumberValue);
 
   // Sender timestamp
   RlcTag rlcTag (Simulator::Now ());
@@ -1265,6 +1346,29 @@ LteRlcAm::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+LteRlcAm::TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus)
+{
+  NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << m_txonBuffer.size ());
+  std::vector<TxSdu>::iterator kept = m_txonBuffer.begin ();
+  for (std::vector<TxSdu>::iterator it = m_txonBuffer.begin (); it != m_txonBuffer.end (); ++it)
+    {
+      if (it->m_status == LteRlcSduStatusTag::FULL_SDU)
+        {
+          m_txonBufferSize -= it->m_sdu->GetSize ();
+          sdus.push_back (it->m_sdu);
+        }
+      else
+        {
+          *kept++ = *it;
+        }
+    }
+  m_txonBuffer.erase (kept, m_txonBuffer.end ());
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+
+  DoReportBufferStatus ();
+}
+
 
 void
 LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
@@ -1280,12 +1384,11 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
     }
   m_rxPdu (m_rnti, m_lcid, p->GetSize (), delay.GetNanoSeconds ());
 
-  // Get RLC header parameters
-  LteRlcAmHeader rlcAmHeader;
-  p->PeekHeader (rlcAmHeader);
-  NS_LOG_LOGIC ("RLC header: " << rlcAmHeader);
+  // Get RLC header parameters, reading the fixed part in place: the
+  // whole header is deserialized only for STATUS PDUs
+  LteRlcAmHeader::View rlcAmHeaderView (p);
 
-  if ( rlcAmHeader.IsDataPdu () )
+  if ( rlcAmHeaderView.IsDataPdu () )
     {
 
       // 5.1.3.1   Transmit operations
@@ -1338,14 +1441,14 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
       // - update state variables and start t-Reordering as needed (see sub clause 5.1.3.2.4).
 
 
-      SequenceNumber10 seqNumber = rlcAmHeader.GetSequenceNumber ();
+      SequenceNumber10 seqNumber = rlcAmHeaderView.GetSequenceNumber ();
       seqNumber.SetModulusBase (m_vrR);
 
-      if ( rlcAmHeader.GetResegmentationFlag () == LteRlcAmHeader::SEGMENT )
+      if ( rlcAmHeaderView.GetResegmentationFlag () == LteRlcAmHeader::SEGMENT )
         {
           NS_LOG_LOGIC ("PDU segment received ( SN = " << seqNumber << " )");
         }
-      else if ( rlcAmHeader.GetResegmentationFlag () == LteRlcAmHeader::PDU )
+      else if ( rlcAmHeaderView.GetResegmentationFlag () == LteRlcAmHeader::PDU )
         {
           NS_LOG_LOGIC ("PDU received ( SN = " << seqNumber << " )");
         }
@@ -1356,7 +1459,7 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
         }
 
       // STATUS PDU is requested
-      if ( rlcAmHeader.GetPollingBit () == LteRlcAmHeader::STATUS_REPORT_IS_REQUESTED )
+      if ( rlcAmHeaderView.GetPollingBit () == LteRlcAmHeader::STATUS_REPORT_IS_REQUESTED )
         {
           m_statusPduRequested = true;
           m_statusPduBufferSize = 4;
@@ -1398,18 +1501,15 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
           //         - discard the duplicate byte segments.
           // note: re-segmentation of AMD PDU is currently not supported, 
           // so we just check that the segment was not received before
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if (it != m_rxonBuffer.end () )
+          if (m_rxonBitmap.IsSet (seqNumber.GetValue ()))
             {
-              NS_ASSERT (it->second.m_byteSegments.size () > 0);
-              NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1, "re-segmentation not supported");
               NS_LOG_LOGIC ("PDU segment already received, discarded");
             }
           else
             {
               NS_LOG_LOGIC ("Place PDU in the reception buffer ( SN = " << seqNumber << " )");
-              m_rxonBuffer[ seqNumber.GetValue () ].m_byteSegments.push_back (p);
-              m_rxonBuffer[ seqNumber.GetValue () ].m_pduComplete = true;
+              m_rxonBuffer.at (seqNumber.GetValue () % m_windowSize) = p;
+              m_rxonBitmap.Set (seqNumber.GetValue ());
             }
 
 
@@ -1432,20 +1532,13 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
       //     - update VR(MS) to the SN of the first AMD PDU with SN > current VR(MS) for
       //       which not all byte segments have been received;
 
-      std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-      if ( it != m_rxonBuffer.end () &&
-           it->second.m_pduComplete )
+      if (m_rxonBitmap.IsSet (m_vrMs.GetValue ()))
         {
-          int firstVrMs = m_vrMs.GetValue ();
-          while ( it != m_rxonBuffer.end () &&
-                  it->second.m_pduComplete )
-            {
-              m_vrMs++;
-              it = m_rxonBuffer.find (m_vrMs.GetValue ());
-              NS_LOG_LOGIC ("Incr VR(MS) = " << m_vrMs);
-
-              NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in RxonBuffer");
-            }
+          // no more than m_windowSize PDUs can be in the reception
+          // buffer, hence a missing SN is always found
+          uint16_t offset = m_rxonBitmap.FindFirstClear (m_vrMs.GetValue (), 1024);
+          NS_ASSERT_MSG (offset < 1024, "Infinite loop in RxonBuffer");
+          m_vrMs = m_vrMs + offset;
           NS_LOG_LOGIC ("New VR(MS) = " << m_vrMs);
         }
 
@@ -1457,27 +1550,22 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
 
       if ( seqNumber == m_vrR )
         {
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if ( it != m_rxonBuffer.end () &&
-               it->second.m_pduComplete )
+          if (m_rxonBitmap.IsSet (seqNumber.GetValue ()))
             {
-              it = m_rxonBuffer.find (m_vrR.GetValue ());
               int firstVrR = m_vrR.GetValue ();
-              while ( it != m_rxonBuffer.end () &&
-                      it->second.m_pduComplete )
+              while (m_rxonBitmap.IsSet (m_vrR.GetValue ()))
                 {
                   NS_LOG_LOGIC ("Reassemble and Deliver ( SN = " << m_vrR << " )");
-                  NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1,
-                                "Too many segments. PDU Reassembly process didn't work");
-                  ReassembleAndDeliver (it->second.m_byteSegments.front ());
-                  m_rxonBuffer.erase (m_vrR.GetValue ());
+                  Ptr<Packet> pdu = m_rxonBuffer.at (m_vrR.GetValue () % m_windowSize);
+                  m_rxonBuffer.at (m_vrR.GetValue () % m_windowSize) = 0;
+                  m_rxonBitmap.Clear (m_vrR.GetValue ());
+                  ReassembleAndDeliver (pdu);
 
                   m_vrR++;
                   m_vrR.SetModulusBase (m_vrR);
                   m_vrX.SetModulusBase (m_vrR);
                   m_vrMs.SetModulusBase (m_vrR);
                   m_vrH.SetModulusBase (m_vrR);
-                  it = m_rxonBuffer.find (m_vrR.GetValue ());
 
                   NS_ASSERT_MSG (firstVrR != m_vrR.GetValue (), "Infinite loop in RxonBuffer");
                 }
@@ -1525,10 +1613,14 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
             }
         }
     }
-  else if ( rlcAmHeader.IsControlPdu () )
+  else if ( rlcAmHeaderView.IsControlPdu () )
     {
       NS_LOG_INFO ("Control AM RLC PDU");
 
+      LteRlcAmHeader rlcAmHeader;
+      p->PeekHeader (rlcAmHeader);
+      NS_LOG_LOGIC ("RLC header: " << rlcAmHeader);
+
       SequenceNumber10 ackSn = rlcAmHeader.GetAckSn ();
       SequenceNumber10 sn;
 
@@ -1564,41 +1656,40 @@ LteRlcAm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
 
               incrementVtA = false;
 
-              if (m_txedBuffer.at (seqNumberValue).m_pdu != 0)
+              if (m_txedBitmap.IsSet (seqNumberValue))
                 {
                   NS_LOG_INFO ("Move SN = " << seqNumberValue << " to retxBuffer");
-                  m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu->Copy ();
-                  m_retxBuffer.at (seqNumberValue).m_retxCount = m_txedBuffer.at (seqNumberValue).m_retxCount;
-                  m_retxBufferSize += m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
-
-                  m_txedBufferSize -= m_txedBuffer.at (seqNumberValue).m_pdu->GetSize ();
-                  m_txedBuffer.at (seqNumberValue).m_pdu = 0;
-                  m_txedBuffer.at (seqNumberValue).m_retxCount = 0;
+                  uint32_t size = m_txWindow.at (seqNumberValue % m_windowSize).m_pdu->GetSize ();
+                  m_txedBitmap.Clear (seqNumberValue);
+                  m_retxBitmap.Set (seqNumberValue);
+                  m_retxBufferSize += size;
+                  m_txedBufferSize -= size;
                 }
 
-              NS_ASSERT (m_retxBuffer.at (seqNumberValue).m_pdu != 0);
+              NS_ASSERT (m_retxBitmap.IsSet (seqNumberValue));
               
             }
           else
             {
               NS_LOG_LOGIC ("sn " << sn << " is ACKed");
 
-              if (m_txedBuffer.at (seqNumberValue).m_pdu)
+              RetxPdu& ackedPdu = m_txWindow.at (seqNumberValue % m_windowSize);
+              if (m_txedBitmap.IsSet (seqNumberValue))
                 {
                   NS_LOG_INFO ("ACKed SN = " << seqNumberValue << " from txedBuffer");
-                  //               NS_LOG_INFO ("m_txedBuffer( " << m_vtA << " )->GetSize = " << m_txedBuffer.at (m_vtA.GetValue ())->GetSize ());
-                  m_txedBufferSize -= m_txedBuffer.at (seqNumberValue).m_pdu->GetSize ();
-                  m_txedBuffer.at (seqNumberValue).m_pdu = 0;
-                  NS_ASSERT (m_retxBuffer.at (seqNumberValue).m_pdu == 0);
+                  m_txedBufferSize -= ackedPdu.m_pdu->GetSize ();
+                  m_txedBitmap.Clear (seqNumberValue);
+                  NS_ASSERT (!m_retxBitmap.IsSet (seqNumberValue));
                 }
 
-              if (m_retxBuffer.at (seqNumberValue).m_pdu)
+              if (m_retxBitmap.IsSet (seqNumberValue))
                 {
                   NS_LOG_INFO ("ACKed SN = " << seqNumberValue << " from retxBuffer");
-                  m_retxBufferSize -= m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
-                  m_retxBuffer.at (seqNumberValue).m_pdu = 0;
-                  m_retxBuffer.at (seqNumberValue).m_retxCount = 0;
+                  m_retxBufferSize -= ackedPdu.m_pdu->GetSize ();
+                  m_retxBitmap.Clear (seqNumberValue);
                 }
+              ackedPdu.m_pdu = 0;
+              ackedPdu.m_retxCount = 0;
 
             }
 
@@ -2090,25 +2181,14 @@ LteRlcAm::DoReportBufferStatus (void)
   Time txonQueueHolDelay (0);
   if ( m_txonBufferSize > 0 )
     {
-      RlcTag txonQueueHolTimeTag;
-      m_txonBuffer.front ()->PeekPacketTag (txonQueueHolTimeTag);
-      txonQueueHolDelay = now - txonQueueHolTimeTag.GetSenderTimestamp ();
+      txonQueueHolDelay = now - m_txonBuffer.front ().m_waitingSince;
     }
 
   // Retransmission Queue HOL time
   Time retxQueueHolDelay;
-  RlcTag retxQueueHolTimeTag;
   if ( m_retxBufferSize > 0 )
     {
-      if (m_retxBuffer.at (m_vtA.GetValue ()).m_pdu != 0)
-        {
-          m_retxBuffer.at (m_vtA.GetValue ()).m_pdu->PeekPacketTag (retxQueueHolTimeTag);
-        }
-      else
-        {
-          m_txedBuffer.at (m_vtA.GetValue ()).m_pdu->PeekPacketTag (retxQueueHolTimeTag);
-        }      
-      retxQueueHolDelay = now - retxQueueHolTimeTag.GetSenderTimestamp ();
+      retxQueueHolDelay = now - m_txWindow.at (m_vtA.GetValue () % m_windowSize).m_waitingSince;
     }
   else 
     {      
@@ -2160,17 +2240,9 @@ LteRlcAm::ExpireReorderingTimer (void)
   //    - start t-Reordering;
   //    - set VR(X) to VR(H).
 
-  m_vrMs = m_vrX;
-  int firstVrMs = m_vrMs.GetValue ();
-  std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-  while ( it != m_rxonBuffer.end () &&
-          it->second.m_pduComplete )
-    {
-      m_vrMs++;
-      it = m_rxonBuffer.find (m_vrMs.GetValue ());
-
-      NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in ExpireReorderingTimer");
-    }
+  uint16_t offset = m_rxonBitmap.FindFirstClear (m_vrX.GetValue (), 1024);
+  NS_ASSERT_MSG (offset < 1024, "Infinite loop in ExpireReorderingTimer");
+  m_vrMs = m_vrX + offset;
   NS_LOG_LOGIC ("New VR(MS) = " << m_vrMs);
 
   if ( m_vrH > m_vrMs )
@@ -2207,24 +2279,12 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
   if ((m_txonBufferSize == 0 && m_retxBufferSize == 0)
       || (m_vtS == m_vtMs))
     {
+      // all the PDUs waiting for an ACK are within VT(A) <= SN < VT(S)
       NS_LOG_INFO ("txonBuffer and retxBuffer empty. Move PDUs up to = " << m_vtS.GetValue () - 1 << " to retxBuffer");
-      uint16_t sn = 0;
-      for ( sn = m_vtA.GetValue(); sn < m_vtS.GetValue (); sn++ )
-        {
-          bool pduAvailable = m_txedBuffer.at (sn).m_pdu != 0;
-
-           if ( pduAvailable )
-             {
-               NS_LOG_INFO ("Move PDU " << sn << " from txedBuffer to retxBuffer");
-               m_retxBuffer.at (sn).m_pdu = m_txedBuffer.at (sn).m_pdu->Copy ();
-               m_retxBuffer.at (sn).m_retxCount = m_txedBuffer.at (sn).m_retxCount;
-               m_retxBufferSize += m_retxBuffer.at (sn).m_pdu->GetSize ();
-
-               m_txedBufferSize -= m_txedBuffer.at (sn).m_pdu->GetSize ();
-               m_txedBuffer.at (sn).m_pdu = 0;
-               m_txedBuffer.at (sn).m_retxCount = 0;
-             }
-        }
+      m_retxBitmap.SetAll (m_txedBitmap);
+      m_txedBitmap.ClearAll ();
+      m_retxBufferSize += m_txedBufferSize;
+      m_txedBufferSize = 0;
     }
 
   DoReportBufferStatus ();  
@@ -54,6 +54,9 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid);
 
+  // inherited from LteRlc
+  virtual void TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus);
+
 private:
   /**
    * This method will schedule a timeout at WaitReplyTimeout interval
@@ -80,18 +83,78 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer;       // Transmission buffer
+  /**
+   * Bitmap over the whole 10 bit SN space, with word-level scanning of
+   * SN ranges. Ranges are given as a first SN and a number of SNs, and
+   * wrap around the SN space.
+   */
+  class SnBitmap
+  {
+  public:
+    SnBitmap ();
+
+    /// \param sn the SN to be set
+    void Set (uint16_t sn);
+    /// \param sn the SN to be cleared
+    void Clear (uint16_t sn);
+    /**
+     * \param sn the SN
+     * \return true if the bit of the SN is set
+     */
+    bool IsSet (uint16_t sn) const;
+    /// clear all the bits
+    void ClearAll ();
+    /**
+     * set all the bits set in another bitmap
+     * \param other the other bitmap
+     */
+    void SetAll (const SnBitmap& other);
+    /**
+     * \param first the first SN of the range
+     * \param count the number of SNs in the range
+     * \return the offset from first of the first SN of the range whose
+     * bit is set, or count if none is set
+     */
+    uint16_t FindFirstSet (uint16_t first, uint16_t count) const;
+    /**
+     * \param first the first SN of the range
+     * \param count the number of SNs in the range
+     * \return the offset from first of the first SN of the range whose
+     * bit is not set, or count if all are set
+     */
+    uint16_t FindFirstClear (uint16_t first, uint16_t count) const;
+
+  private:
+    /**
+     * \param first the first SN of the range
+     * \param count the number of SNs in the range
+     * \param invert whether to look for clear bits rather than set bits
+     * \return the offset of the first matching SN, or count
+     */
+    uint16_t Find (uint16_t first, uint16_t count, bool invert) const;
+
+    uint64_t m_words[1024 / 64]; ///< the bits, SN n is bit n % 64 of word n / 64
+  };
+
+    std::vector < TxSdu > m_txonBuffer;       // Transmission buffer
 
     struct RetxPdu
     {
       Ptr<Packet> m_pdu;
       uint16_t    m_retxCount;
+      Time        m_waitingSince; ///< time of the last (re)transmission of the PDU
     };
 
-  std::vector <RetxPdu> m_txedBuffer;  ///< Buffer for transmitted and retransmitted PDUs 
-                                       ///< that have not been acked but are not considered 
-                                       ///< for retransmission 
-  std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission
+  /**
+   * Transmitted PDUs that have not been acked yet, indexed by SN modulo
+   * the window size. Whether a PDU is waiting for an ACK or is
+   * considered for retransmission is told by m_txedBitmap and
+   * m_retxBitmap.
+   */
+  std::vector <RetxPdu> m_txWindow;
+  SnBitmap m_txedBitmap;  ///< PDUs transmitted or retransmitted that have not been acked
+                          ///< but are not considered for retransmission
+  SnBitmap m_retxBitmap;  ///< PDUs considered for retransmission
 
     uint32_t m_txonBufferSize;
     uint32_t m_retxBufferSize;
@@ -100,15 +163,13 @@ private:
     bool     m_statusPduRequested;
     uint32_t m_statusPduBufferSize;
 
-    struct PduBuffer
-    {
-      SequenceNumber10  m_seqNumber;
-      std::list < Ptr<Packet> >  m_byteSegments;
-
-      bool      m_pduComplete;
-    };
-
-    std::map <uint16_t, PduBuffer > m_rxonBuffer; // Reception buffer
+  /**
+   * Reception buffer, indexed by SN modulo the window size; as
+   * re-segmentation is not supported, a PDU placed in the buffer is
+   * always complete. m_rxonBitmap tells which SNs have been received.
+   */
+  std::vector < Ptr<Packet> > m_rxonBuffer;
+  SnBitmap m_rxonBitmap;  ///< PDUs in the reception buffer
 
     Ptr<Packet> m_controlPduBuffer;               // Control PDU buffer (just one PDU)
 
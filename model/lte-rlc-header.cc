@@ -19,6 +19,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 
 #include "ns3/lte-rlc-header.h"
 
@@ -268,4 +269,22 @@ uint32_t LteRlcHeader::Deserialize (Buffer::Iterator start)
   return GetSerializedSize ();
 }
 
+LteRlcHeader::View::View (Ptr<const Packet> p)
+{
+  NS_ASSERT (p->GetSize () >= SIZE);
+  p->CopyData (m_bytes, SIZE);
+}
+
+uint8_t
+LteRlcHeader::View::GetFramingInfo () const
+{
+  return (m_bytes[0] & 0x18) >> 3;
+}
+
+SequenceNumber10
+LteRlcHeader::View::GetSequenceNumber () const
+{
+  return SequenceNumber10 (((m_bytes[0] & 0x03) << 8) | m_bytes[1]);
+}
+
 }; // namespace ns3
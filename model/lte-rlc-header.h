@@ -22,12 +22,15 @@
 #define LTE_RLC_HEADER_H
 
 #include "ns3/header.h"
+#include "ns3/ptr.h"
 #include "ns3/lte-rlc-sequence-number.h"
 
 #include <list>
 
 namespace ns3 {
 
+class Packet;
+
 /**
  * \ingroup lte
  * \brief The packet header for the Radio Link Control (RLC) protocol packets
@@ -83,6 +86,31 @@ public:
   virtual void Serialize (Buffer::Iterator start) const;
   virtual uint32_t Deserialize (Buffer::Iterator start);
 
+  /**
+   * \brief In-place view of the fixed part of the header of an UMD PDU
+   *
+   * The fixed part (FI, E and SN fields) has a 2-byte layout, so it is
+   * read directly from the first bytes of the packet, without
+   * deserializing the E/LI fields that may follow.
+   */
+  class View
+  {
+  public:
+    /**
+     * \param p the UMD PDU, starting with its header
+     */
+    View (Ptr<const Packet> p);
+
+    uint8_t GetFramingInfo () const;
+    SequenceNumber10 GetSequenceNumber () const;
+
+    /// size of the fixed part of the header in bytes
+    static const uint32_t SIZE = 2;
+
+  private:
+    uint8_t m_bytes[SIZE]; ///< the bytes of the fixed part
+  };
+
 private:
   uint16_t m_headerLength;
   uint8_t  m_framingInfo;      //  2 bits
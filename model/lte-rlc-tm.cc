@@ -24,6 +24,7 @@
 
 #include "ns3/lte-rlc-tm.h"
 #include "ns3/lte-rlc-tag.h"
+#include "ns3/lte-rlc-sdu-status-tag.h"
 
 namespace ns3 {
 
@@ -81,12 +82,9 @@ LteRlcTm::DoTransmitPdcpPdu (Ptr<Packet> p)
 
   if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
     {
-      /** Store arrival time */
-      RlcTag timeTag (Simulator::Now ());
-      p->AddPacketTag (timeTag);
-
+      /** Store PDCP PDU and its arrival time */
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
-      m_txBuffer.push_back (p);
+      m_txBuffer.push_back (TxSdu (p, Simulator::Now (), LteRlcSduStatusTag::FULL_SDU));
       m_txBufferSize += p->GetSize ();
       NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size() );
       NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
@@ -177,7 +175,7 @@ LteRlcTm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       return;
     }
 
-  Ptr<Packet> packet = (*(m_txBuffer.begin ()))->Copy ();
+  Ptr<Packet> packet = m_txBuffer.begin ()->m_sdu->Copy ();
 
   if (bytes < packet->GetSize ())
     {
@@ -185,7 +183,7 @@ LteRlcTm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
       return;
     }
 
-  m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
+  m_txBufferSize -= m_txBuffer.begin ()->m_sdu->GetSize ();
   m_txBuffer.erase (m_txBuffer.begin ());
  
   // Sender timestamp
@@ -248,9 +246,7 @@ LteRlcTm::DoReportBufferStatus (void)
 
   if (! m_txBuffer.empty ())
     {
-      RlcTag holTimeTag;
-      m_txBuffer.front ()->PeekPacketTag (holTimeTag);
-      holDelay = Simulator::Now () - holTimeTag.GetSenderTimestamp ();
+      holDelay = Simulator::Now () - m_txBuffer.front ().m_waitingSince;
 
       queueSize = m_txBufferSize; // just data in tx queue (no header overhead for RLC TM)
     }
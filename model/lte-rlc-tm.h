@@ -60,7 +60,7 @@ private:
 private:
   uint32_t m_maxTxBufferSize;
   uint32_t m_txBufferSize;
-  std::vector < Ptr<Packet> > m_txBuffer;       // Transmission buffer
+  std::vector < TxSdu > m_txBuffer;       // Transmission buffer
 
   EventId m_rbsTimer;
 
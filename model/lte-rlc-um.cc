@@ -88,18 +88,9 @@ LteRlcUm::DoTransmitPdcpPdu (Ptr<Packet> p)
 
   if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
     {
-      /** Store arrival time */
-      RlcTag timeTag (Simulator::Now ());
-      p->AddPacketTag (timeTag);
-
-      /** Store PDCP PDU */
-
-      LteRlcSduStatusTag tag;
-      tag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
-      p->AddPacketTag (tag);
-
+      /** Store PDCP PDU and its arrival time */
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
-      m_txBuffer.push_back (p);
+      m_txBuffer.push_back (TxSdu (p, Simulator::Now (), LteRlcSduStatusTag::FULL_SDU));
       m_txBufferSize += p->GetSize ();
       NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size() );
       NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
@@ -413,7 +404,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   uint32_t nextSegmentId = 1;
   uint32_t dataFieldTotalSize = 0;
   uint32_t dataFieldAddedSize = 0;
-  std::vector < Ptr<Packet> > dataField;
+  std::vector < TxSdu > dataField;
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
@@ -424,12 +415,16 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     }
 
   NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << *(m_txBuffer.begin()));
-  NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+  NS_LOG_LOGIC ("First SDU buffer  = " << m_txBuffer.begin ()->m_sdu);
+  NS_LOG_LOGIC ("First SDU size    = " << m_txBuffer.begin ()->m_sdu->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-  m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
+  // The SDUs in the buffer are never modified: segmentation creates
+  // fragments, so the SDU does not need to be copied
+  Ptr<Packet> firstSegment = m_txBuffer.begin ()->m_sdu;
+  Time firstSegmentWaitingSince = m_txBuffer.begin ()->m_waitingSince;
+  uint8_t firstSegmentStatus = m_txBuffer.begin ()->m_status;
+  m_txBufferSize -= firstSegment->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
   m_txBuffer.erase (m_txBuffer.begin ());
 
@@ -455,61 +450,56 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
           NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
 
-          // Status tag of the new and remaining segments
+          // Status of the new and remaining segments
           // Note: This is the only place where a PDU is segmented and
           // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
-          firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
-          if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
+          uint8_t oldStatus = firstSegmentStatus;
+          uint8_t newStatus = firstSegmentStatus;
+          if (oldStatus == LteRlcSduStatusTag::FULL_SDU)
             {
-              newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
-              oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+              newStatus = LteRlcSduStatusTag::FIRST_SEGMENT;
+              oldStatus = LteRlcSduStatusTag::LAST_SEGMENT;
             }
-          else if (oldTag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT)
+          else if (oldStatus == LteRlcSduStatusTag::LAST_SEGMENT)
             {
-              newTag.SetStatus (LteRlcSduStatusTag::MIDDLE_SEGMENT);
-              //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+              newStatus = LteRlcSduStatusTag::MIDDLE_SEGMENT;
+              //oldStatus = LteRlcSduStatusTag::LAST_SEGMENT;
             }
 
           // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
+          uint32_t remainingSegmentSize = firstSegment->GetSize () - currSegmentSize;
+          NS_LOG_LOGIC ("    remaining segment size = " << remainingSegmentSize);
+          if (remainingSegmentSize > 0)
             {
-              firstSegment->AddPacketTag (oldTag);
-
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
-              m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
+              Ptr<Packet> remainingSegment = firstSegment->CreateFragment (currSegmentSize, remainingSegmentSize);
+              m_txBuffer.insert (m_txBuffer.begin (), TxSdu (remainingSegment, firstSegmentWaitingSince, oldStatus));
+              m_txBufferSize += remainingSegmentSize;
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
               NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.begin ()->m_sdu->GetSize ());
               NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
             }
           else
             {
-              // Whole segment was taken, so adjust tag
-              if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
+              // Whole segment was taken, so adjust status
+              if (newStatus == LteRlcSduStatusTag::FIRST_SEGMENT)
                 {
-                  newTag.SetStatus (LteRlcSduStatusTag::FULL_SDU);
+                  newStatus = LteRlcSduStatusTag::FULL_SDU;
                 }
-              else if (newTag.GetStatus () == LteRlcSduStatusTag::MIDDLE_SEGMENT)
+              else if (newStatus == LteRlcSduStatusTag::MIDDLE_SEGMENT)
                 {
-                  newTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
+                  newStatus = LteRlcSduStatusTag::LAST_SEGMENT;
                 }
             }
           // Segment is completely taken or
           // the remaining segment is given back to the transmission buffer
           firstSegment = 0;
 
-          // Put status tag once it has been adjusted
-          newSegment->AddPacketTag (newTag);
-
-          // Add Segment to Data field
+          // Add Segment to Data field, with its adjusted status
           dataFieldAddedSize = newSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (newSegment);
+          dataField.push_back (TxSdu (newSegment, firstSegmentWaitingSince, newStatus));
           newSegment = 0;
 
           // ExtensionBit (Next_Segment - 1) = 0
@@ -531,7 +521,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // Add txBuffer.FirstBuffer to DataField
           dataFieldAddedSize = firstSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
+          dataField.push_back (TxSdu (firstSegment, firstSegmentWaitingSince, firstSegmentStatus));
           firstSegment = 0;
 
           // ExtensionBit (Next_Segment - 1) = 0
@@ -545,8 +535,8 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
           if (m_txBuffer.size () > 0)
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin ()->m_sdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin ()->m_sdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -561,7 +551,7 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           // Add txBuffer.FirstBuffer to DataField
           dataFieldAddedSize = firstSegment->GetSize ();
           dataFieldTotalSize += dataFieldAddedSize;
-          dataField.push_back (firstSegment);
+          dataField.push_back (TxSdu (firstSegment, firstSegmentWaitingSince, firstSegmentStatus));
 
           // ExtensionBit (Next_Segment - 1) = 1
           rlcHeader.PushExtensionBit (LteRlcHeader::E_LI_FIELDS_FOLLOWS);
@@ -575,15 +565,17 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
           NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
           if (m_txBuffer.size () > 0)
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << *(m_txBuffer.begin()));
-              NS_LOG_LOGIC ("        First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin ()->m_sdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin ()->m_sdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-          m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
+          firstSegment = m_txBuffer.begin ()->m_sdu;
+          firstSegmentWaitingSince = m_txBuffer.begin ()->m_waitingSince;
+          firstSegmentStatus = m_txBuffer.begin ()->m_status;
+          m_txBufferSize -= firstSegment->GetSize ();
           m_txBuffer.erase (m_txBuffer.begin ());
           NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
@@ -594,16 +586,14 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
   rlcHeader.SetSequenceNumber (m_sequenceNumber++);
 
   // Build RLC PDU with DataField and Header
-  std::vector< Ptr<Packet> >::iterator it;
+  std::vector< TxSdu >::iterator it;
   it = dataField.begin ();
 
   uint8_t framingInfo = 0;
 
   // FIRST SEGMENT
-  LteRlcSduStatusTag tag;
-  (*it)->RemovePacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT) )
+  if ( (it->m_status == LteRlcSduStatusTag::FULL_SDU) ||
+        (it->m_status == LteRlcSduStatusTag::FIRST_SEGMENT) )
     {
       framingInfo |= LteRlcHeader::FIRST_BYTE;
     }
@@ -611,21 +601,19 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     {
       framingInfo |= LteRlcHeader::NO_FIRST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
 
   while (it < dataField.end ())
     {
-      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << (*it)->GetSize ());
+      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << it->m_sdu->GetSize ());
 
-      packet->AddAtEnd (*it);
+      packet->AddAtEnd (it->m_sdu);
       it++;
     }
 
   // LAST SEGMENT (Note: There could be only one and be the first one)
   it--;
-  (*it)->RemovePacketTag (tag);
-  if ( (tag.GetStatus () == LteRlcSduStatusTag::FULL_SDU) ||
-        (tag.GetStatus () == LteRlcSduStatusTag::LAST_SEGMENT) )
+  if ( (it->m_status == LteRlcSduStatusTag::FULL_SDU) ||
+        (it->m_status == LteRlcSduStatusTag::LAST_SEGMENT) )
     {
       framingInfo |= LteRlcHeader::LAST_BYTE;
     }
@@ -633,7 +621,6 @@ LteRlcUm::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId,
     {
       framingInfo |= LteRlcHeader::NO_LAST_BYTE;
     }
-  (*it)->AddPacketTag (tag);
 
   rlcHeader.SetFramingInfo (framingInfo);
 
@@ -669,6 +656,29 @@ LteRlcUm::DoNotifyHarqDeliveryFailure ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+LteRlcUm::TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus)
+{
+  NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << m_txBuffer.size ());
+  std::vector<TxSdu>::iterator kept = m_txBuffer.begin ();
+  for (std::vector<TxSdu>::iterator it = m_txBuffer.begin (); it != m_txBuffer.end (); ++it)
+    {
+      if (it->m_status == LteRlcSduStatusTag::FULL_SDU)
+        {
+          m_txBufferSize -= it->m_sdu->GetSize ();
+          sdus.push_back (it->m_sdu);
+        }
+      else
+        {
+          *kept++ = *it;
+        }
+    }
+  m_txBuffer.erase (kept, m_txBuffer.end ());
+  NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
+
+  DoReportBufferStatus ();
+}
+
 void
 LteRlcUm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
 {
@@ -685,11 +695,10 @@ LteRlcUm::DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid)
 
   // 5.1.2.2 Receive operations
 
-  // Get RLC header parameters
-  LteRlcHeader rlcHeader;
-  p->PeekHeader (rlcHeader);
-  NS_LOG_LOGIC ("RLC header: " << rlcHeader);
-  SequenceNumber10 seqNumber = rlcHeader.GetSequenceNumber ();
+  // Get RLC header parameters, reading the fixed part in place: the
+  // whole header is deserialized at reassembly
+  LteRlcHeader::View rlcHeaderView (p);
+  SequenceNumber10 seqNumber = rlcHeaderView.GetSequenceNumber ();
 
   // 5.1.2.2.1 General
   // The receiving UM RLC entity shall maintain a reordering window according to state variable VR(UH) as follows:
@@ -1387,9 +1396,7 @@ LteRlcUm::DoReportBufferStatus (void)
 
   if (! m_txBuffer.empty ())
     {
-      RlcTag holTimeTag;
-      m_txBuffer.front ()->PeekPacketTag (holTimeTag);
-      holDelay = Simulator::Now () - holTimeTag.GetSenderTimestamp ();
+      holDelay = Simulator::Now () - m_txBuffer.front ().m_waitingSince;
 
       queueSize = m_txBufferSize + 2 * m_txBuffer.size (); // Data in tx queue + estimated headers size
     }
@@ -53,6 +53,9 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (Ptr<Packet> p, uint16_t rnti, uint8_t lcid);
 
+  // inherited from LteRlc
+  virtual void TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus);
+
 private:
   void ExpireReorderingTimer (void);
   void ExpireRbsTimer (void);
@@ -69,7 +72,7 @@ private:
 private:
   uint32_t m_maxTxBufferSize;
   uint32_t m_txBufferSize;
-  std::vector < Ptr<Packet> > m_txBuffer;       // Transmission buffer
+  std::vector < TxSdu > m_txBuffer;       // Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; // Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     // Reassembling buffer
 
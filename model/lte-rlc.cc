@@ -107,6 +107,18 @@ LteRlc::~LteRlc ()
   NS_LOG_FUNCTION (this);
 }
 
+LteRlc::TxSdu::TxSdu ()
+  : m_status (0)
+{
+}
+
+LteRlc::TxSdu::TxSdu (Ptr<Packet> sdu, Time waitingSince, uint8_t status)
+  : m_sdu (sdu),
+    m_waitingSince (waitingSince),
+    m_status (status)
+{
+}
+
 TypeId LteRlc::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::LteRlc")
@@ -174,6 +186,13 @@ LteRlc::GetLteMacSapUser ()
   return m_macSapUser;
 }
 
+void
+LteRlc::TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus)
+{
+  NS_LOG_FUNCTION (this);
+  // no transmission buffer to take from
+}
+
 
 
 ////////////////////////////////////////
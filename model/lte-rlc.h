@@ -33,6 +33,8 @@
 #include "ns3/lte-rlc-sap.h"
 #include "ns3/lte-mac-sap.h"
 
+#include <vector>
+
 namespace ns3 {
 
 
@@ -99,6 +101,16 @@ public:
    */
   LteMacSapUser* GetLteMacSapUser ();
 
+  /**
+   * Remove the SDUs whose transmission has not started from the
+   * transmission buffer, e.g., to forward them to the target eNB of a
+   * handover. The SDUs already segmented are kept.
+   *
+   * \param sdus the removed SDUs (i.e., PDCP PDUs) are appended here,
+   *        in order of arrival
+   */
+  virtual void TakeUntransmittedSdus (std::vector<Ptr<Packet> >& sdus);
+
 
   /**
    * TracedCallback signature for NotifyTxOpportunity events.
@@ -146,6 +158,27 @@ protected:
   uint16_t m_rnti;
   uint8_t m_lcid;
 
+  /**
+   * RLC SDU, or segment of an RLC SDU, waiting in a transmission buffer
+   * together with the per-SDU information needed by the transmitting
+   * entity. This information is kept here rather than in packet tags,
+   * so that buffering and segmenting an SDU does not touch its tag list.
+   */
+  struct TxSdu
+  {
+    TxSdu ();
+    /**
+     * \param sdu the SDU or SDU segment
+     * \param waitingSince the arrival time of the SDU at the RLC
+     * \param status the LteRlcSduStatusTag::SduStatus_t of the segment
+     */
+    TxSdu (Ptr<Packet> sdu, Time waitingSince, uint8_t status);
+
+    Ptr<Packet> m_sdu;    ///< the SDU or SDU segment
+    Time m_waitingSince;  ///< the arrival time of the SDU at the RLC
+    uint8_t m_status;     ///< the LteRlcSduStatusTag::SduStatus_t of the segment
+  };
+
   /**
    * Used to inform of a PDU delivery to the MAC SAP provider
    */
@@ -2662,7 +2662,7 @@ namespace ns3 {
     NS_LOG_FUNCTION (this);
     std::bitset<1> RadioResourceConfigDedicatedSCell_r10;
     bIterator = DeserializeSequence (&RadioResourceConfigDedicatedSCell_r10,false,bIterator);
-    DeserializePhysicalConfigDedicatedSCell (&rrcdsc->physicalConfigDedicatedSCell, bIterator);
+    bIterator = DeserializePhysicalConfigDedicatedSCell (&rrcdsc->physicalConfigDedicatedSCell, bIterator);
 
     return bIterator;
   }
@@ -4502,7 +4502,7 @@ namespace ns3 {
   void
   RrcConnectionRequestHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     SerializeUlCcchMessage (1);
 
@@ -4631,7 +4631,7 @@ namespace ns3 {
   void
   RrcConnectionSetupHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     SerializeDlCcchMessage (3);
 
@@ -4802,7 +4802,7 @@ namespace ns3 {
   void
   RrcConnectionSetupCompleteHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize DCCH message
     SerializeUlDcchMessage (4);
@@ -4908,7 +4908,7 @@ namespace ns3 {
   void
   RrcConnectionReconfigurationCompleteHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize DCCH message
     SerializeUlDcchMessage (2);
@@ -4999,7 +4999,7 @@ namespace ns3 {
   void
   RrcConnectionReconfigurationHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     SerializeDlDcchMessage (4);
 
@@ -5721,7 +5721,7 @@ namespace ns3 {
   void
   HandoverPreparationInfoHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize HandoverPreparationInformation sequence:
     // no default or optional fields. Extension marker not present.
@@ -5957,7 +5957,7 @@ namespace ns3 {
   void
   RrcConnectionReestablishmentRequestHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     SerializeUlCcchMessage (0);
 
@@ -6123,7 +6123,7 @@ namespace ns3 {
   void
   RrcConnectionReestablishmentHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     SerializeDlCcchMessage (0);
 
@@ -6251,7 +6251,7 @@ namespace ns3 {
   void
   RrcConnectionReestablishmentCompleteHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize DCCH message
     SerializeUlDcchMessage (3);
@@ -6353,7 +6353,7 @@ namespace ns3 {
   void
   RrcConnectionReestablishmentRejectHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize CCCH message
     SerializeDlCcchMessage (1);
@@ -6438,7 +6438,7 @@ namespace ns3 {
   void
   RrcConnectionReleaseHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize DCCH message
     SerializeDlDcchMessage (5);
@@ -6563,7 +6563,7 @@ namespace ns3 {
   void
   RrcConnectionRejectHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize CCCH message
     SerializeDlCcchMessage (2);
@@ -6671,7 +6671,7 @@ namespace ns3 {
   void
   MeasurementReportHeader::PreSerialize () const
   {
-    m_serializationResult = Buffer ();
+    StartSerialization ();
 
     // Serialize DCCH message
     SerializeUlDcchMessage (1);
@@ -6834,7 +6834,9 @@ namespace ns3 {
   void
   RrcUlDcchMessage::PreSerialize () const
   {
+    StartSerialization ();
     SerializeUlDcchMessage (m_messageType);
+    FinalizeSerialization ();
   }
 
   Buffer::Iterator
@@ -6895,7 +6897,9 @@ namespace ns3 {
   void
   RrcDlDcchMessage::PreSerialize () const
   {
+    StartSerialization ();
     SerializeDlDcchMessage (m_messageType);
+    FinalizeSerialization ();
   }
 
   Buffer::Iterator
@@ -6956,7 +6960,9 @@ namespace ns3 {
   void
   RrcUlCcchMessage::PreSerialize () const
   {
+    StartSerialization ();
     SerializeUlCcchMessage (m_messageType);
+    FinalizeSerialization ();
   }
 
   Buffer::Iterator
@@ -7017,7 +7023,9 @@ namespace ns3 {
   void
   RrcDlCcchMessage::PreSerialize () const
   {
+    StartSerialization ();
     SerializeDlCcchMessage (m_messageType);
+    FinalizeSerialization ();
   }
 
   Buffer::Iterator
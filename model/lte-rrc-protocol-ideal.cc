@@ -37,6 +37,12 @@ NS_LOG_COMPONENT_DEFINE ("LteRrcProtocolIdeal");
 
 static const Time RRC_IDEAL_MSG_DELAY = MilliSeconds (0);
 
+/*
+ * Protocol of each eNB by cell ID, so that the UEs find the eNB they
+ * connect to without walking the node list.
+ */
+static std::map<uint16_t, LteEnbRrcProtocolIdeal*> g_enbRrcProtocolIdealMap;
+
 NS_OBJECT_ENSURE_REGISTERED (LteUeRrcProtocolIdeal);
 
 LteUeRrcProtocolIdeal::LteUeRrcProtocolIdeal ()
@@ -56,6 +62,7 @@ LteUeRrcProtocolIdeal::DoDispose ()
   NS_LOG_FUNCTION (this);
   delete m_ueRrcSapUser;
   m_rrc = 0;
+  m_enbRrcProtocol = 0;
 }
 
 TypeId
@@ -102,21 +109,19 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionRequest (LteRrcSap::RrcConnectionReque
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
     
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-                       &LteEnbRrcSapProvider::RecvRrcConnectionRequest,
-                       m_enbRrcSapProvider,
-                       m_rnti, 
-                       msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvRrcConnectionRequest,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
 LteUeRrcProtocolIdeal::DoSendRrcConnectionSetupCompleted (LteRrcSap::RrcConnectionSetupCompleted msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
-                       m_enbRrcSapProvider,
-		       m_rnti, 
-		       msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvRrcConnectionSetupCompleted,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
@@ -127,41 +132,37 @@ LteUeRrcProtocolIdeal::DoSendRrcConnectionReconfigurationCompleted (LteRrcSap::R
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
     
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-                        &LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
-                        m_enbRrcSapProvider,
-                        m_rnti, 
-                        msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvRrcConnectionReconfigurationCompleted,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentRequest (LteRrcSap::RrcConnectionReestablishmentRequest msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
-                       m_enbRrcSapProvider,
-		       m_rnti, 
-                        msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentRequest,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
 LteUeRrcProtocolIdeal::DoSendRrcConnectionReestablishmentComplete (LteRrcSap::RrcConnectionReestablishmentComplete msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
-                       m_enbRrcSapProvider,
-		       m_rnti, 
-msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvRrcConnectionReestablishmentComplete,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
 LteUeRrcProtocolIdeal::DoSendMeasurementReport (LteRrcSap::MeasurementReport msg)
 {
-   Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-                        &LteEnbRrcSapProvider::RecvMeasurementReport,
-                        m_enbRrcSapProvider,
-                        m_rnti, 
-                        msg);
+  m_enbRrcProtocol->SendMessage (MakeEvent (&LteEnbRrcSapProvider::RecvMeasurementReport,
+                                             m_enbRrcSapProvider,
+                                             m_rnti,
+                                             msg));
 }
 
 void 
@@ -169,46 +170,18 @@ LteUeRrcProtocolIdeal::SetEnbRrcSapProvider ()
 {
   uint16_t cellId = m_rrc->GetCellId ();  
 
-  // walk list of all nodes to get the peer eNB
-  Ptr<LteEnbNetDevice> enbDev;
-  NodeList::Iterator listEnd = NodeList::End ();
-  bool found = false;
-  for (NodeList::Iterator i = NodeList::Begin (); 
-       (i != listEnd) && (!found); 
-       ++i)
-    {
-      Ptr<Node> node = *i;
-      int nDevs = node->GetNDevices ();
-      for (int j = 0; 
-           (j < nDevs) && (!found);
-           j++)
-        {
-          enbDev = node->GetDevice (j)->GetObject <LteEnbNetDevice> ();
-          if (enbDev == 0)
-            {
-              continue;
-            }
-          else
-            {
-              if (enbDev->GetCellId () == cellId)
-                {
-                  found = true;          
-                  break;
-                }
-            }
-        }
-    }
-  NS_ASSERT_MSG (found, " Unable to find eNB with CellId =" << cellId);
-  m_enbRrcSapProvider = enbDev->GetRrc ()->GetLteEnbRrcSapProvider ();  
-  Ptr<LteEnbRrcProtocolIdeal> enbRrcProtocolIdeal = enbDev->GetRrc ()->GetObject<LteEnbRrcProtocolIdeal> ();
-  enbRrcProtocolIdeal->SetUeRrcSapProvider (m_rnti, m_ueRrcSapProvider);
+  m_enbRrcProtocol = LteEnbRrcProtocolIdeal::GetProtocolOfCell (cellId);
+  NS_ASSERT_MSG (m_enbRrcProtocol != 0, " Unable to find eNB with CellId =" << cellId);
+  m_enbRrcSapProvider = m_enbRrcProtocol->GetLteEnbRrcSapProvider ();
+  m_enbRrcProtocol->SetUeRrcSapProvider (m_rnti, m_ueRrcSapProvider);
 }
 
 
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrcProtocolIdeal);
 
 LteEnbRrcProtocolIdeal::LteEnbRrcProtocolIdeal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_cellId (0),
+     m_enbRrcSapProvider (0)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<LteEnbRrcProtocolIdeal> (this);
@@ -224,6 +197,17 @@ LteEnbRrcProtocolIdeal::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   delete m_enbRrcSapUser;  
+  for (std::list<MessageBatch>::iterator it = m_messageBatches.begin ();
+       it != m_messageBatches.end (); ++it)
+    {
+      it->event.Cancel ();
+    }
+  m_messageBatches.clear ();
+  std::map<uint16_t, LteEnbRrcProtocolIdeal*>::iterator it = g_enbRrcProtocolIdealMap.find (m_cellId);
+  if (it != g_enbRrcProtocolIdealMap.end () && it->second == this)
+    {
+      g_enbRrcProtocolIdealMap.erase (it);
+    }
 }
 
 TypeId
@@ -253,6 +237,57 @@ void
 LteEnbRrcProtocolIdeal::SetCellId (uint16_t cellId)
 {
   m_cellId = cellId;
+  // the first eNB with the cell ID is kept, as when walking the node list
+  g_enbRrcProtocolIdealMap.insert (std::pair<uint16_t, LteEnbRrcProtocolIdeal*> (cellId, this));
+}
+
+Ptr<LteEnbRrcProtocolIdeal>
+LteEnbRrcProtocolIdeal::GetProtocolOfCell (uint16_t cellId)
+{
+  std::map<uint16_t, LteEnbRrcProtocolIdeal*>::const_iterator it = g_enbRrcProtocolIdealMap.find (cellId);
+  if (it == g_enbRrcProtocolIdealMap.end ())
+    {
+      return 0;
+    }
+  return it->second;
+}
+
+LteEnbRrcSapProvider*
+LteEnbRrcProtocolIdeal::GetLteEnbRrcSapProvider ()
+{
+  return m_enbRrcSapProvider;
+}
+
+void
+LteEnbRrcProtocolIdeal::SendMessage (EventImpl* message)
+{
+  Time deliveryTime = Simulator::Now () + RRC_IDEAL_MSG_DELAY;
+  if (m_messageBatches.empty () || m_messageBatches.back ().deliveryTime != deliveryTime)
+    {
+      NS_LOG_LOGIC (this << " new batch of messages delivered at " << deliveryTime);
+      m_messageBatches.push_back (MessageBatch ());
+      m_messageBatches.back ().deliveryTime = deliveryTime;
+      m_messageBatches.back ().event = Simulator::Schedule (RRC_IDEAL_MSG_DELAY,
+                                                            &LteEnbRrcProtocolIdeal::DeliverMessageBatch,
+                                                            this);
+    }
+  m_messageBatches.back ().messages.push_back (Ptr<EventImpl> (message, false));
+}
+
+void
+LteEnbRrcProtocolIdeal::DeliverMessageBatch ()
+{
+  NS_ASSERT (!m_messageBatches.empty ());
+  // taken out first, since the receptions send new messages
+  std::vector<Ptr<EventImpl> > messages;
+  messages.swap (m_messageBatches.front ().messages);
+  m_messageBatches.pop_front ();
+  NS_LOG_FUNCTION (this << m_cellId << messages.size ());
+  for (std::vector<Ptr<EventImpl> >::const_iterator it = messages.begin ();
+       it != messages.end (); ++it)
+    {
+      (*it)->Invoke ();
+    }
 }
 
 LteUeRrcSapProvider* 
@@ -327,7 +362,7 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation (LteRrcSap::SystemInformation ms
 {
   NS_LOG_FUNCTION (this << m_cellId);
   // walk list of all nodes to get UEs with this cellId
-  Ptr<LteUeRrc> ueRrc;
+  std::vector<LteUeRrcSapProvider*> ueRrcSapProviders;
   for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
     {
       Ptr<Node> node = *i;
@@ -343,68 +378,79 @@ LteEnbRrcProtocolIdeal::DoSendSystemInformation (LteRrcSap::SystemInformation ms
                 {       
                   NS_LOG_LOGIC ("sending SI to IMSI " << ueDev->GetImsi ());
                   ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-                                       &LteUeRrcSapProvider::RecvSystemInformation,
-                                       ueRrc->GetLteUeRrcSapProvider (), 
-                                       msg);          
+                  ueRrcSapProviders.push_back (ueRrc->GetLteUeRrcSapProvider ());
                 }             
             }
         }
     } 
+  if (!ueRrcSapProviders.empty ())
+    {
+      // one copy of the message for all the UEs
+      SendMessage (MakeEvent (&LteEnbRrcProtocolIdeal::DeliverSystemInformation,
+                              this,
+                              ueRrcSapProviders,
+                              msg));
+    }
+}
+
+void
+LteEnbRrcProtocolIdeal::DeliverSystemInformation (std::vector<LteUeRrcSapProvider*> ueRrcSapProviders,
+                                                  LteRrcSap::SystemInformation msg)
+{
+  NS_LOG_FUNCTION (this << m_cellId << ueRrcSapProviders.size ());
+  for (std::vector<LteUeRrcSapProvider*>::const_iterator it = ueRrcSapProviders.begin ();
+       it != ueRrcSapProviders.end (); ++it)
+    {
+      (*it)->RecvSystemInformation (msg);
+    }
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionSetup (uint16_t rnti, LteRrcSap::RrcConnectionSetup msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionSetup,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionSetup,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReconfiguration (uint16_t rnti, LteRrcSap::RrcConnectionReconfiguration msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionReconfiguration,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishment (uint16_t rnti, LteRrcSap::RrcConnectionReestablishment msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionReestablishment,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReestablishmentReject (uint16_t rnti, LteRrcSap::RrcConnectionReestablishmentReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionReestablishmentReject,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionRelease (uint16_t rnti, LteRrcSap::RrcConnectionRelease msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionRelease,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionRelease,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 void 
 LteEnbRrcProtocolIdeal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcConnectionReject msg)
 {
-  Simulator::Schedule (RRC_IDEAL_MSG_DELAY, 
-		       &LteUeRrcSapProvider::RecvRrcConnectionReject,
-		       GetUeRrcSapProvider (rnti), 
-		       msg);
+  SendMessage (MakeEvent (&LteUeRrcSapProvider::RecvRrcConnectionReject,
+                          GetUeRrcSapProvider (rnti),
+                          msg));
 }
 
 /*
@@ -24,9 +24,14 @@
 
 #include <stdint.h>
 #include <map>
+#include <list>
+#include <vector>
 
 #include <ns3/ptr.h>
 #include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/event-impl.h>
 #include <ns3/lte-rrc-sap.h>
 
 namespace ns3 {
@@ -35,6 +40,7 @@ class LteUeRrcSapProvider;
 class LteUeRrcSapUser;
 class LteEnbRrcSapProvider;
 class LteUeRrc;
+class LteEnbRrcProtocolIdeal;
 
 
 /**
@@ -80,6 +86,8 @@ private:
   LteUeRrcSapProvider* m_ueRrcSapProvider;
   LteUeRrcSapUser* m_ueRrcSapUser;
   LteEnbRrcSapProvider* m_enbRrcSapProvider;
+  /// protocol of the eNB, delivering the messages sent to it
+  Ptr<LteEnbRrcProtocolIdeal> m_enbRrcProtocol;
   
 };
 
@@ -111,6 +119,25 @@ public:
   LteUeRrcSapProvider* GetUeRrcSapProvider (uint16_t rnti);
   void SetUeRrcSapProvider (uint16_t rnti, LteUeRrcSapProvider* p);
 
+  /**
+   * \param cellId the cell ID
+   * \return the protocol of the eNB with the cell ID, 0 if none
+   */
+  static Ptr<LteEnbRrcProtocolIdeal> GetProtocolOfCell (uint16_t cellId);
+
+  /// \return the SAP provider of the eNB RRC
+  LteEnbRrcSapProvider* GetLteEnbRrcSapProvider ();
+
+  /**
+   * Send a message from or to this eNB. The messages sent at the same
+   * time are delivered in order by a single event, after the ideal
+   * message delay.
+   *
+   * \param message the reception of the message, as made by MakeEvent,
+   *        whose reference is taken over
+   */
+  void SendMessage (EventImpl* message);
+
 private:
 
   // methods forwarded from LteEnbRrcSapUser
@@ -135,6 +162,30 @@ private:
   LteEnbRrcSapProvider* m_enbRrcSapProvider;
   LteEnbRrcSapUser* m_enbRrcSapUser;
   std::map<uint16_t, LteUeRrcSapProvider*> m_enbRrcSapProviderMap;
+
+  /**
+   * Deliver the system information to the UEs camped on or attached to
+   * the cell, sharing a single copy of the message
+   *
+   * \param ueRrcSapProviders the SAP providers of the UE RRCs
+   * \param msg the system information
+   */
+  void DeliverSystemInformation (std::vector<LteUeRrcSapProvider*> ueRrcSapProviders,
+                                 LteRrcSap::SystemInformation msg);
+
+  /// Deliver the oldest batch of messages
+  void DeliverMessageBatch ();
+
+  /// Messages delivered by a single event
+  struct MessageBatch
+  {
+    Time deliveryTime; ///< delivery time of the messages
+    EventId event; ///< delivery event
+    std::vector<Ptr<EventImpl> > messages; ///< messages, in order of sending
+  };
+
+  /// batches of messages waiting for their delivery, oldest first
+  std::list<MessageBatch> m_messageBatches;
   
 };
 
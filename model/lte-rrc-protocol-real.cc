@@ -38,6 +38,13 @@ NS_LOG_COMPONENT_DEFINE ("LteRrcProtocolReal");
 
 const Time RRC_REAL_MSG_DELAY = MilliSeconds (0); 
 
+/**
+ * Incremented whenever a UE RRC is bound to or released by its
+ * LteUeRrcProtocolReal, so that the eNBs know when to collect again the
+ * receivers of the system information.
+ */
+static uint32_t g_ueRrcProtocolRealGeneration = 0;
+
 NS_OBJECT_ENSURE_REGISTERED (LteUeRrcProtocolReal);
 
 LteUeRrcProtocolReal::LteUeRrcProtocolReal ()
@@ -61,6 +68,7 @@ LteUeRrcProtocolReal::DoDispose ()
   delete m_completeSetupParameters.srb0SapUser;
   delete m_completeSetupParameters.srb1SapUser;
   m_rrc = 0;
+  ++g_ueRrcProtocolRealGeneration;
 }
 
 TypeId
@@ -90,6 +98,7 @@ void
 LteUeRrcProtocolReal::SetUeRrc (Ptr<LteUeRrc> rrc)
 {
   m_rrc = rrc;
+  ++g_ueRrcProtocolRealGeneration;
 }
 
 void 
@@ -353,7 +362,10 @@ LteUeRrcProtocolReal::DoReceivePdcpSdu (LtePdcpSapUser::ReceivePdcpSduParameters
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrcProtocolReal);
 
 LteEnbRrcProtocolReal::LteEnbRrcProtocolReal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_enbRrcSapProvider (0),
+    m_systemInformationTargetsValid (false),
+    m_systemInformationTargetsGeneration (0),
+    m_systemInformationTargetsNumNodes (0)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<LteEnbRrcProtocolReal> (this);
@@ -378,6 +390,8 @@ LteEnbRrcProtocolReal::DoDispose ()
       delete it->second.srb1SapUser;
     }
   m_completeSetupUeParametersMap.clear ();
+  m_systemInformationTargets.clear ();
+  m_systemInformationTargetsValid = false;
 }
 
 TypeId
@@ -387,6 +401,12 @@ LteEnbRrcProtocolReal::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteEnbRrcProtocolReal> ()
+    .AddTraceSource ("SystemInformationCache",
+                     "Fired upon every system information broadcast, telling "
+                     "whether the cached list of UE RRC instances was used "
+                     "instead of walking the node list.",
+                     MakeTraceSourceAccessor (&LteEnbRrcProtocolReal::m_systemInformationCacheTrace),
+                     "ns3::LteEnbRrcProtocolReal::SystemInformationCacheTracedCallback")
   ;
   return tid;
 }
@@ -504,11 +524,11 @@ LteEnbRrcProtocolReal::DoRemoveUe (uint16_t rnti)
 }
 
 void 
-LteEnbRrcProtocolReal::DoSendSystemInformation (LteRrcSap::SystemInformation msg)
+LteEnbRrcProtocolReal::UpdateSystemInformationTargets ()
 {
   NS_LOG_FUNCTION (this << m_cellId);
-  // walk list of all nodes to get UEs with this cellId
-  Ptr<LteUeRrc> ueRrc;
+  m_systemInformationTargets.clear ();
+  // walk list of all nodes to get the UEs
   for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
     {
       Ptr<Node> node = *i;
@@ -518,20 +538,48 @@ LteEnbRrcProtocolReal::DoSendSystemInformation (LteRrcSap::SystemInformation msg
           Ptr<LteUeNetDevice> ueDev = node->GetDevice (j)->GetObject <LteUeNetDevice> ();
           if (ueDev != 0)
             {
-              Ptr<LteUeRrc> ueRrc = ueDev->GetRrc ();
-              NS_LOG_LOGIC ("considering UE IMSI " << ueDev->GetImsi () << " that has cellId " << ueRrc->GetCellId ());
-              if (ueRrc->GetCellId () == m_cellId)
-                {
-                  NS_LOG_LOGIC ("sending SI to IMSI " << ueDev->GetImsi ());
-                  ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
-                  Simulator::Schedule (RRC_REAL_MSG_DELAY, 
-                                       &LteUeRrcSapProvider::RecvSystemInformation,
-                                       ueRrc->GetLteUeRrcSapProvider (), 
-                                       msg);
-                }
+              m_systemInformationTargets.push_back (ueDev->GetRrc ());
             }
         }
-    } 
+    }
+  m_systemInformationTargetsValid = true;
+  m_systemInformationTargetsGeneration = g_ueRrcProtocolRealGeneration;
+  m_systemInformationTargetsNumNodes = NodeList::GetNNodes ();
+}
+
+void 
+LteEnbRrcProtocolReal::DoSendSystemInformation (LteRrcSap::SystemInformation msg)
+{
+  NS_LOG_FUNCTION (this << m_cellId);
+  // the UE devices only change when nodes are created or when a UE RRC
+  // is bound to its protocol, so the node list walk is done only then
+  bool hit = m_systemInformationTargetsValid
+    && m_systemInformationTargetsGeneration == g_ueRrcProtocolRealGeneration
+    && m_systemInformationTargetsNumNodes == NodeList::GetNNodes ();
+  if (!hit)
+    {
+      UpdateSystemInformationTargets ();
+    }
+
+  uint32_t numUes = 0;
+  for (std::vector<Ptr<LteUeRrc> >::const_iterator it = m_systemInformationTargets.begin ();
+       it != m_systemInformationTargets.end ();
+       ++it)
+    {
+      Ptr<LteUeRrc> ueRrc = *it;
+      NS_LOG_LOGIC ("considering UE IMSI " << ueRrc->GetImsi () << " that has cellId " << ueRrc->GetCellId ());
+      if (ueRrc->GetCellId () == m_cellId)
+        {
+          NS_LOG_LOGIC ("sending SI to IMSI " << ueRrc->GetImsi ());
+          ueRrc->GetLteUeRrcSapProvider ()->RecvSystemInformation (msg);
+          Simulator::Schedule (RRC_REAL_MSG_DELAY, 
+                               &LteUeRrcSapProvider::RecvSystemInformation,
+                               ueRrc->GetLteUeRrcSapProvider (), 
+                               msg);
+          ++numUes;
+        }
+    }
+  m_systemInformationCacheTrace (m_cellId, hit, numUes);
 }
 
 void 
@@ -25,9 +25,11 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include <ns3/ptr.h>
 #include <ns3/object.h>
+#include <ns3/traced-callback.h>
 #include <ns3/lte-rrc-sap.h>
 #include <ns3/lte-pdcp-sap.h>
 #include <ns3/lte-rlc-sap.h>
@@ -124,6 +126,16 @@ public:
   LteUeRrcSapProvider* GetUeRrcSapProvider (uint16_t rnti);
   void SetUeRrcSapProvider (uint16_t rnti, LteUeRrcSapProvider* p);
 
+  /**
+   * TracedCallback signature for the broadcast of system information.
+   *
+   * \param [in] cellId
+   * \param [in] hit whether the cached list of UE RRC instances was used
+   * \param [in] numUes number of UEs camped on or attached to the cell
+   */
+  typedef void (*SystemInformationCacheTracedCallback)
+    (const uint16_t cellId, const bool hit, const uint32_t numUes);
+
 private:
   // methods forwarded from LteEnbRrcSapUser
   void DoSetupUe (uint16_t rnti, LteEnbRrcSapUser::SetupUeParameters params);
@@ -152,6 +164,27 @@ private:
   std::map<uint16_t, LteEnbRrcSapUser::SetupUeParameters> m_setupUeParametersMap;
   std::map<uint16_t, LteEnbRrcSapProvider::CompleteSetupUeParameters> m_completeSetupUeParametersMap;
 
+  /**
+   * Collect the RRC of all the UE devices of the simulation, which are
+   * the candidate receivers of the system information of this cell
+   */
+  void UpdateSystemInformationTargets ();
+
+  /// RRC of all the UE devices, cached across system information broadcasts
+  std::vector<Ptr<LteUeRrc> > m_systemInformationTargets;
+  /// whether m_systemInformationTargets has been collected
+  bool m_systemInformationTargetsValid;
+  /// UE RRC protocol generation at which m_systemInformationTargets was collected
+  uint32_t m_systemInformationTargetsGeneration;
+  /// number of nodes when m_systemInformationTargets was collected
+  uint32_t m_systemInformationTargetsNumNodes;
+
+  /**
+   * The `SystemInformationCache` trace source. Fired upon every system
+   * information broadcast. Exporting cell ID, cache hit and number of UEs.
+   */
+  TracedCallback<uint16_t, bool, uint32_t> m_systemInformationCacheTrace;
+
 };
 
 ///////////////////////////////////////
@@ -150,7 +150,7 @@ void LteSpectrumPhy::DoDispose ()
   m_interferenceCtrl = 0;
   m_ltePhyRxDataEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyRxDataEndOkCallback    = MakeNullCallback< void, Ptr<Packet> >  ();
-  m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, std::list<Ptr<LteControlMessage> > > ();
+  m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, Ptr<const LteControlMessageList> > ();
   m_ltePhyRxCtrlEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyDlHarqFeedbackCallback = MakeNullCallback< void, DlInfoListElement_s > ();
   m_ltePhyUlHarqFeedbackCallback = MakeNullCallback< void, UlInfoListElement_s > ();
@@ -223,6 +223,13 @@ LteSpectrumPhy::GetTypeId (void)
                     BooleanValue (true),
                     MakeBooleanAccessor (&LteSpectrumPhy::m_ctrlErrorModelEnabled),
                     MakeBooleanChecker ())
+    .AddAttribute ("InterferenceCullingThreshold",
+                   "Signals of other cells whose received PSD is more than this "
+                   "number of dB under the noise PSD on every RB are not accounted "
+                   "for as interference. A negative value disables the culling.",
+                   DoubleValue (-1.0),
+                   MakeDoubleAccessor (&LteSpectrumPhy::m_interferenceCullingThreshold),
+                   MakeDoubleChecker<double> ())
     .AddTraceSource ("DlPhyReception",
                      "DL reception PHY layer statistics.",
                      MakeTraceSourceAccessor (&LteSpectrumPhy::m_dlPhyReception),
@@ -304,6 +311,7 @@ LteSpectrumPhy::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd)
   NS_LOG_FUNCTION (this << noisePsd);
   NS_ASSERT (noisePsd);
   m_rxSpectrumModel = noisePsd->GetSpectrumModel ();
+  m_noisePsd = noisePsd;
   m_interferenceData->SetNoisePowerSpectralDensity (noisePsd);
   m_interferenceCtrl->SetNoisePowerSpectralDensity (noisePsd);
 }
@@ -321,7 +329,7 @@ LteSpectrumPhy::Reset ()
   m_endRxDataEvent.Cancel ();
   m_endRxDlCtrlEvent.Cancel ();
   m_endRxUlSrsEvent.Cancel ();
-  m_rxControlMessageList.clear ();
+  m_rxControlMessageLists.clear ();
   m_expectedTbs.clear ();
   m_txControlMessageList.clear ();
   m_rxPacketBurstList.clear ();
@@ -463,7 +471,11 @@ LteSpectrumPhy::StartTxDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<LteControlM
       txParams->txAntenna = m_antenna;
       txParams->psd = m_txPsd;
       txParams->packetBurst = pb;
-      txParams->ctrlMsgList = ctrlMsgList;
+      if (!ctrlMsgList.empty ())
+        {
+          // built once, then shared by the signal of every receiver
+          txParams->ctrlMsgList = Ptr<LteControlMessageList> (new LteControlMessageList (ctrlMsgList), false);
+        }
       txParams->cellId = m_cellId;
       m_channel->StartTx (txParams);
       m_endTxEvent = Simulator::Schedule (duration, &LteSpectrumPhy::EndTxData, this);
@@ -521,7 +533,10 @@ LteSpectrumPhy::StartTxDlCtrlFrame (std::list<Ptr<LteControlMessage> > ctrlMsgLi
       txParams->psd = m_txPsd;
       txParams->cellId = m_cellId;
       txParams->pss = pss;
-      txParams->ctrlMsgList = ctrlMsgList;
+      if (!ctrlMsgList.empty ())
+        {
+          txParams->ctrlMsgList = Ptr<LteControlMessageList> (new LteControlMessageList (ctrlMsgList), false);
+        }
       m_channel->StartTx (txParams);
       m_endTxEvent = Simulator::Schedule (DL_CTRL_DURATION, &LteSpectrumPhy::EndTxDlCtrl, this);
     }
@@ -646,17 +661,27 @@ LteSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
   Ptr<LteSpectrumSignalParametersUlSrsFrame> lteUlSrsRxParams = DynamicCast<LteSpectrumSignalParametersUlSrsFrame> (spectrumRxParams);
   if (lteDataRxParams != 0)
     {
-      m_interferenceData->AddSignal (rxPsd, duration);
+      if (!IsCulledInterferer (rxPsd, lteDataRxParams->cellId))
+        {
+          m_interferenceData->AddSignal (rxPsd, duration, spectrumRxParams->txPhy);
+        }
       StartRxData (lteDataRxParams);
     }
   else if (lteDlCtrlRxParams!=0)
     {
-      m_interferenceCtrl->AddSignal (rxPsd, duration);
+      // the PSS of culled cells are still measured
+      if (!IsCulledInterferer (rxPsd, lteDlCtrlRxParams->cellId))
+        {
+          m_interferenceCtrl->AddSignal (rxPsd, duration, spectrumRxParams->txPhy);
+        }
       StartRxDlCtrl (lteDlCtrlRxParams);
     }
   else if (lteUlSrsRxParams!=0)
     {
-      m_interferenceCtrl->AddSignal (rxPsd, duration);
+      if (!IsCulledInterferer (rxPsd, lteUlSrsRxParams->cellId))
+        {
+          m_interferenceCtrl->AddSignal (rxPsd, duration, spectrumRxParams->txPhy);
+        }
       StartRxUlSrs (lteUlSrsRxParams);
     }
   else
@@ -667,6 +692,29 @@ LteSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
     }    
 }
 
+bool
+LteSpectrumPhy::IsCulledInterferer (Ptr<const SpectrumValue> rxPsd, uint16_t cellId) const
+{
+  if (m_interferenceCullingThreshold < 0 || cellId == m_cellId || m_noisePsd == 0)
+    {
+      return false;
+    }
+  // the signal is culled when it is below the threshold on every RB
+  double threshold = std::pow (10.0, -m_interferenceCullingThreshold / 10.0);
+  Values::const_iterator itNoise = m_noisePsd->ConstValuesBegin ();
+  for (Values::const_iterator it = rxPsd->ConstValuesBegin ();
+       it != rxPsd->ConstValuesEnd ();
+       ++it, ++itNoise)
+    {
+      if (*it >= threshold * (*itNoise))
+        {
+          return false;
+        }
+    }
+  NS_LOG_LOGIC (this << " culled interferer of cell " << cellId);
+  return true;
+}
+
 void
 LteSpectrumPhy::StartRxData (Ptr<LteSpectrumSignalParametersDataFrame> params)
 {
@@ -693,7 +741,7 @@ LteSpectrumPhy::StartRxData (Ptr<LteSpectrumSignalParametersDataFrame> params)
           if (params->cellId  == m_cellId)
             {
               NS_LOG_LOGIC (this << " synchronized with this signal (cellId=" << params->cellId << ")");
-              if ((m_rxPacketBurstList.empty ())&&(m_rxControlMessageList.empty ()))
+              if ((m_rxPacketBurstList.empty ())&&(m_rxControlMessageLists.empty ()))
                 {
                   NS_ASSERT (m_state == IDLE);
                   // first transmission, i.e., we're IDLE and we
@@ -722,8 +770,11 @@ LteSpectrumPhy::StartRxData (Ptr<LteSpectrumSignalParametersDataFrame> params)
                   
                   m_phyRxStartTrace (params->packetBurst);
                 }
-                NS_LOG_DEBUG (this << " insert msgs " << params->ctrlMsgList.size ());
-              m_rxControlMessageList.insert (m_rxControlMessageList.end (), params->ctrlMsgList.begin (), params->ctrlMsgList.end ());
+              if (params->ctrlMsgList)
+                {
+                  NS_LOG_DEBUG (this << " insert msgs " << params->ctrlMsgList->GetN ());
+                  m_rxControlMessageLists.push_back (params->ctrlMsgList);
+                }
               
               NS_LOG_LOGIC (this << " numSimultaneousRxEvents = " << m_rxPacketBurstList.size ());
             }
@@ -794,13 +845,16 @@ LteSpectrumPhy::StartRxDlCtrl (Ptr<LteSpectrumSignalParametersDlCtrlFrame> lteDl
             {
               NS_LOG_LOGIC (this << " synchronized with this signal (cellId=" << cellId << ")");
               
-              NS_ASSERT (m_rxControlMessageList.empty ());
+              NS_ASSERT (m_rxControlMessageLists.empty ());
               m_firstRxStart = Simulator::Now ();
               m_firstRxDuration = lteDlCtrlRxParams->duration;
               NS_LOG_LOGIC (this << " scheduling EndRx with delay " << lteDlCtrlRxParams->duration);
               
               // store the DCIs
-              m_rxControlMessageList = lteDlCtrlRxParams->ctrlMsgList;
+              if (lteDlCtrlRxParams->ctrlMsgList)
+                {
+                  m_rxControlMessageLists.push_back (lteDlCtrlRxParams->ctrlMsgList);
+                }
               m_endRxDlCtrlEvent = Simulator::Schedule (lteDlCtrlRxParams->duration, &LteSpectrumPhy::EndRxDlCtrl, this);
               ChangeState (RX_DL_CTRL);
               m_interferenceCtrl->StartRx (lteDlCtrlRxParams->psd);            
@@ -864,7 +918,7 @@ LteSpectrumPhy::StartRxUlSrs (Ptr<LteSpectrumSignalParametersUlSrsFrame> lteUlSr
               {
                 // first transmission, i.e., we're IDLE and we
                 // start RX
-                NS_ASSERT (m_rxControlMessageList.empty ());
+                NS_ASSERT (m_rxControlMessageLists.empty ());
                 m_firstRxStart = Simulator::Now ();
                 m_firstRxDuration = lteUlSrsRxParams->duration;
                 NS_LOG_LOGIC (this << " scheduling EndRx with delay " << lteUlSrsRxParams->duration);
@@ -1111,17 +1165,18 @@ LteSpectrumPhy::EndRxData ()
           m_ltePhyDlHarqFeedbackCallback ((*itHarq).second);
         }
     }
-  // forward control messages of this frame to LtePhy
-  if (!m_rxControlMessageList.empty ())
+  // forward control messages of this frame to LtePhy, in order of reception
+  if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
     {
-      if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
+      for (std::vector<Ptr<const LteControlMessageList> >::const_iterator it = m_rxControlMessageLists.begin ();
+           it != m_rxControlMessageLists.end (); ++it)
         {
-          m_ltePhyRxCtrlEndOkCallback (m_rxControlMessageList);
+          m_ltePhyRxCtrlEndOkCallback (*it);
         }
     }
   ChangeState (IDLE);
   m_rxPacketBurstList.clear ();
-  m_rxControlMessageList.clear ();
+  m_rxControlMessageLists.clear ();
   m_expectedTbs.clear ();
 }
 
@@ -1160,7 +1215,11 @@ LteSpectrumPhy::EndRxDlCtrl ()
       if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
         {
           NS_LOG_DEBUG (this << " PCFICH-PDCCH Rxed OK");
-          m_ltePhyRxCtrlEndOkCallback (m_rxControlMessageList);
+          for (std::vector<Ptr<const LteControlMessageList> >::const_iterator it = m_rxControlMessageLists.begin ();
+               it != m_rxControlMessageLists.end (); ++it)
+            {
+              m_ltePhyRxCtrlEndOkCallback (*it);
+            }
         }
     }
   else
@@ -1172,7 +1231,7 @@ LteSpectrumPhy::EndRxDlCtrl ()
         }
     }
   ChangeState (IDLE);
-  m_rxControlMessageList.clear ();
+  m_rxControlMessageLists.clear ();
 }
 
 void
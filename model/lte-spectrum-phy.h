@@ -41,6 +41,7 @@
 #include <ns3/ff-mac-common.h>
 #include <ns3/lte-harq-phy.h>
 #include <ns3/lte-common.h>
+#include <ns3/lte-control-message-list.h>
 
 namespace ns3 {
 
@@ -110,9 +111,9 @@ typedef Callback< void, Ptr<Packet> > LtePhyRxDataEndOkCallback;
 * previously started RX of a control frame attempt has been 
 * successfully completed.
 *
-* @param packet the received Packet
+* @param msgList the received control messages
 */
-typedef Callback< void, std::list<Ptr<LteControlMessage> > > LtePhyRxCtrlEndOkCallback;
+typedef Callback< void, Ptr<const LteControlMessageList> > LtePhyRxCtrlEndOkCallback;
 
 /**
 * This method is used by the LteSpectrumPhy to notify the PHY that a
@@ -429,6 +430,14 @@ private:
   void EndRxUlSrs ();
   
   void SetTxModeGain (uint8_t txMode, double gain);
+
+  /**
+   * \param rxPsd the PSD of a received signal
+   * \param cellId the cell the signal was sent to or from
+   * \return whether the signal is an interferer weak enough to be left
+   *         out of the interference, as per InterferenceCullingThreshold
+   */
+  bool IsCulledInterferer (Ptr<const SpectrumValue> rxPsd, uint16_t cellId) const;
   
 
   Ptr<MobilityModel> m_mobility;
@@ -443,7 +452,8 @@ private:
   std::list<Ptr<PacketBurst> > m_rxPacketBurstList;
   
   std::list<Ptr<LteControlMessage> > m_txControlMessageList;
-  std::list<Ptr<LteControlMessage> > m_rxControlMessageList;
+  /// the control messages received in the current frame, one list per transmitter
+  std::vector<Ptr<const LteControlMessageList> > m_rxControlMessageLists;
   
   
   State m_state;
@@ -465,6 +475,13 @@ private:
 
   Ptr<LteInterference> m_interferenceData;
   Ptr<LteInterference> m_interferenceCtrl;
+  Ptr<const SpectrumValue> m_noisePsd;
+  /**
+   * The `InterferenceCullingThreshold` attribute. Margin below the noise
+   * floor, in dB, under which the signals of other cells are ignored;
+   * negative to account for all the signals.
+   */
+  double m_interferenceCullingThreshold;
 
   uint16_t m_cellId;
   
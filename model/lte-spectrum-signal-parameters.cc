@@ -23,7 +23,7 @@
 #include <ns3/packet-burst.h>
 #include <ns3/ptr.h>
 #include <ns3/lte-spectrum-signal-parameters.h>
-#include <ns3/lte-control-messages.h>
+#include <ns3/lte-control-message-list.h>
 
 
 namespace ns3 {
@@ -24,11 +24,11 @@
 
 
 #include <ns3/spectrum-signal-parameters.h>
+#include <ns3/lte-control-message-list.h>
 
 namespace ns3 {
 
 class PacketBurst;
-class LteControlMessage;
 
 
 /**
@@ -87,7 +87,11 @@ struct LteSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
   */
   Ptr<PacketBurst> packetBurst;
   
-  std::list<Ptr<LteControlMessage> > ctrlMsgList;
+  /**
+  * The control messages sent with this signal, shared by all the
+  * receivers; null if none
+  */
+  Ptr<const LteControlMessageList> ctrlMsgList;
   
   uint16_t cellId;
 };
@@ -115,7 +119,11 @@ struct LteSpectrumSignalParametersDlCtrlFrame : public SpectrumSignalParameters
   LteSpectrumSignalParametersDlCtrlFrame (const LteSpectrumSignalParametersDlCtrlFrame& p);
 
 
-  std::list<Ptr<LteControlMessage> > ctrlMsgList;
+  /**
+  * The control messages sent with this signal, shared by all the
+  * receivers; null if none
+  */
+  Ptr<const LteControlMessageList> ctrlMsgList;
   
   uint16_t cellId;
   bool pss; // primary synchronization signal
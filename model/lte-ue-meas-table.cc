@@ -0,0 +1,214 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-ue-meas-table.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteUeMeasTable");
+
+/**
+ * \param a a value
+ * \param b another value
+ * \return whether a comes before b in decreasing order, the invalid
+ *         (NaN) values being the smallest
+ */
+static inline bool
+IsBefore (double a, double b)
+{
+  return a > b || (std::isnan (b) && !std::isnan (a));
+}
+
+LteUeMeasTable::LteUeMeasTable ()
+{
+  for (uint32_t q = 0; q < NUM_QUANTITIES; ++q)
+    {
+      m_isSorted[q] = true;
+    }
+}
+
+uint32_t
+LteUeMeasTable::AddRow (uint16_t cellId)
+{
+  uint32_t row = m_cellId.size ();
+  if (cellId >= m_rowOfCell.size ())
+    {
+      m_rowOfCell.resize (cellId + 1, -1);
+    }
+  m_rowOfCell[cellId] = row;
+  m_cellId.push_back (cellId);
+  for (uint32_t q = 0; q < NUM_QUANTITIES; ++q)
+    {
+      m_value[q].push_back (0.0);
+      m_sample[q].push_back (0.0);
+    }
+  m_hasSample.push_back (0);
+  return row;
+}
+
+void
+LteUeMeasTable::Update (const std::vector<LteUeCphySapUser::UeMeasurementsElement>& measurements,
+                        bool useLayer3Filtering, double aRsrp, double aRsrq)
+{
+  NS_LOG_FUNCTION (this << measurements.size () << useLayer3Filtering << aRsrp << aRsrq);
+
+  bool haveSamples = false;
+  for (std::vector<LteUeCphySapUser::UeMeasurementsElement>::const_iterator it = measurements.begin ();
+       it != measurements.end (); ++it)
+    {
+      NS_LOG_DEBUG ("cell " << it->m_cellId << " new RSRP " << it->m_rsrp
+                            << " new RSRQ " << it->m_rsrq);
+      int32_t row = FindRow (it->m_cellId);
+      if (row < 0)
+        {
+          // first value is always unfiltered
+          uint32_t newRow = AddRow (it->m_cellId);
+          m_value[RSRP][newRow] = it->m_rsrp;
+          m_value[RSRQ][newRow] = it->m_rsrq;
+          continue;
+        }
+      NS_ASSERT_MSG (m_hasSample[row] == 0, "cell " << it->m_cellId << " measured twice in the same batch");
+      m_sample[RSRP][row] = it->m_rsrp;
+      m_sample[RSRQ][row] = it->m_rsrq;
+      m_hasSample[row] = 1;
+      haveSamples = true;
+    }
+
+  if (haveSamples)
+    {
+      const uint32_t n = m_cellId.size ();
+      double* rsrp = &m_value[RSRP][0];
+      double* rsrq = &m_value[RSRQ][0];
+      const double* sampleRsrp = &m_sample[RSRP][0];
+      const double* sampleRsrq = &m_sample[RSRQ][0];
+      const uint8_t* hasSample = &m_hasSample[0];
+
+      if (useLayer3Filtering)
+        {
+          const double bRsrp = 1 - aRsrp;
+          const double bRsrq = 1 - aRsrq;
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              // F_n = (1-a) F_{n-1} + a M_n
+              double filteredRsrp = bRsrp * rsrp[i] + aRsrp * sampleRsrp[i];
+              // an invalid previous RSRQ is replaced with the unfiltered value
+              double filteredRsrq = std::isnan (rsrq[i]) ? sampleRsrq[i]
+                : bRsrq * rsrq[i] + aRsrq * sampleRsrq[i];
+              rsrp[i] = hasSample[i] ? filteredRsrp : rsrp[i];
+              rsrq[i] = hasSample[i] ? filteredRsrq : rsrq[i];
+            }
+        }
+      else
+        {
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              rsrp[i] = hasSample[i] ? sampleRsrp[i] : rsrp[i];
+              rsrq[i] = hasSample[i] ? sampleRsrq[i] : rsrq[i];
+            }
+        }
+      std::fill (m_hasSample.begin (), m_hasSample.end (), 0);
+    }
+
+  for (uint32_t q = 0; q < NUM_QUANTITIES; ++q)
+    {
+      m_isSorted[q] = false;
+    }
+}
+
+uint32_t
+LteUeMeasTable::GetNRows () const
+{
+  return m_cellId.size ();
+}
+
+int32_t
+LteUeMeasTable::FindRow (uint16_t cellId) const
+{
+  return cellId < m_rowOfCell.size () ? m_rowOfCell[cellId] : -1;
+}
+
+uint16_t
+LteUeMeasTable::GetCellId (uint32_t row) const
+{
+  NS_ASSERT (row < m_cellId.size ());
+  return m_cellId[row];
+}
+
+double
+LteUeMeasTable::GetValue (uint32_t row, Quantity quantity) const
+{
+  NS_ASSERT (row < m_cellId.size ());
+  NS_ASSERT (quantity < NUM_QUANTITIES);
+  return m_value[quantity][row];
+}
+
+const std::vector<uint32_t>&
+LteUeMeasTable::GetSortedRows (Quantity quantity)
+{
+  NS_ASSERT (quantity < NUM_QUANTITIES);
+  std::vector<uint32_t>& sorted = m_sortedRows[quantity];
+  if (!m_isSorted[quantity])
+    {
+      const std::vector<double>& value = m_value[quantity];
+      for (uint32_t row = sorted.size (); row < m_cellId.size (); ++row)
+        {
+          sorted.push_back (row);
+        }
+      // insertion sort from the order of the previous batch
+      for (uint32_t i = 1; i < sorted.size (); ++i)
+        {
+          uint32_t row = sorted[i];
+          double v = value[row];
+          uint32_t j = i;
+          while (j > 0 && IsBefore (v, value[sorted[j - 1]]))
+            {
+              sorted[j] = sorted[j - 1];
+              --j;
+            }
+          sorted[j] = row;
+        }
+      m_isSorted[quantity] = true;
+    }
+  return sorted;
+}
+
+uint32_t
+LteUeMeasTable::CountAbove (Quantity quantity, double threshold)
+{
+  const std::vector<uint32_t>& sorted = GetSortedRows (quantity);
+  const std::vector<double>& value = m_value[quantity];
+  uint32_t low = 0;
+  uint32_t high = sorted.size ();
+  while (low < high)
+    {
+      uint32_t mid = (low + high) / 2;
+      if (value[sorted[mid]] > threshold)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+  return low;
+}
+
+} // namespace ns3
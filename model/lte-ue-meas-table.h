@@ -0,0 +1,138 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_UE_MEAS_TABLE_H
+#define LTE_UE_MEAS_TABLE_H
+
+#include <ns3/lte-ue-cphy-sap.h>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Latest measurement results of all the cells detected by a UE, as used
+ * by the UE RRC.
+ *
+ * The table has one row per cell, in the order the cells were first
+ * detected, and keeps the RSRP and RSRQ of all the rows in contiguous
+ * arrays, so that the layer 3 filtering of a whole batch of
+ * measurements is a single loop over the arrays. Rows are never
+ * removed, hence a row index stays valid for the lifetime of the table.
+ *
+ * For each quantity, the table also keeps the rows sorted by decreasing
+ * value. The order is refreshed lazily after each batch, with an
+ * insertion sort starting from the previous order, which is linear
+ * when the relative order of the cells changes little between two
+ * batches. Conditions of the form "value > threshold" then hold for a
+ * leading range of the sorted rows, found by binary search.
+ */
+class LteUeMeasTable
+{
+public:
+  /// Measured quantities
+  enum Quantity
+  {
+    RSRP = 0,
+    RSRQ,
+    NUM_QUANTITIES
+  };
+
+  LteUeMeasTable ();
+
+  /**
+   * \brief Save a batch of measurement results.
+   * \param measurements the measurements, at most one per cell
+   * \param useLayer3Filtering whether the layer 3 filter is applied to the
+   *                           cells already in the table
+   * \param aRsrp the RSRP filter coefficient
+   * \param aRsrq the RSRQ filter coefficient
+   *
+   * The filter is F_n = (1-a) F_{n-1} + a M_n. The first value of a cell,
+   * and the RSRQ of a cell whose previous RSRQ was invalid (NaN), are
+   * saved unfiltered.
+   */
+  void Update (const std::vector<LteUeCphySapUser::UeMeasurementsElement>& measurements,
+               bool useLayer3Filtering, double aRsrp, double aRsrq);
+
+  /// \return the number of rows, i.e., of cells ever measured
+  uint32_t GetNRows () const;
+
+  /**
+   * \param cellId the cell ID
+   * \return the row of the cell, or -1 if the cell was never measured
+   */
+  int32_t FindRow (uint16_t cellId) const;
+
+  /**
+   * \param row the row
+   * \return the cell ID of the row
+   */
+  uint16_t GetCellId (uint32_t row) const;
+
+  /**
+   * \param row the row
+   * \param quantity the quantity
+   * \return the latest (filtered) value of the quantity, in dBm for RSRP
+   *         and in dB for RSRQ
+   */
+  double GetValue (uint32_t row, Quantity quantity) const;
+
+  /**
+   * \param quantity the quantity
+   * \return the rows sorted by decreasing value of the quantity; the rows
+   *         with an invalid (NaN) value are at the end
+   */
+  const std::vector<uint32_t>& GetSortedRows (Quantity quantity);
+
+  /**
+   * \param quantity the quantity
+   * \param threshold the threshold
+   * \return the number of leading rows of GetSortedRows (quantity) whose
+   *         value is greater than the threshold
+   */
+  uint32_t CountAbove (Quantity quantity, double threshold);
+
+private:
+  /**
+   * Append a row for a newly detected cell
+   *
+   * \param cellId the cell ID
+   * \return the new row
+   */
+  uint32_t AddRow (uint16_t cellId);
+
+  /// cell ID of each row
+  std::vector<uint16_t> m_cellId;
+  /// latest value of each quantity, indexed by row
+  std::vector<double> m_value[NUM_QUANTITIES];
+  /// sample of the batch being saved, indexed by row
+  std::vector<double> m_sample[NUM_QUANTITIES];
+  /// whether the row has a sample in the batch being saved
+  std::vector<uint8_t> m_hasSample;
+  /// row of each cell ID, -1 for the cells never measured
+  std::vector<int32_t> m_rowOfCell;
+  /// rows sorted by decreasing value of each quantity
+  std::vector<uint32_t> m_sortedRows[NUM_QUANTITIES];
+  /// whether m_sortedRows is up to date with the values
+  bool m_isSorted[NUM_QUANTITIES];
+};
+
+} // namespace ns3
+
+#endif // LTE_UE_MEAS_TABLE_H
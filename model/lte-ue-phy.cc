@@ -24,9 +24,11 @@
 #include <ns3/log.h>
 #include <ns3/node.h>
 #include <cfloat>
+#include <algorithm>
 #include <cmath>
 #include <ns3/simulator.h>
 #include <ns3/double.h>
+#include <ns3/uinteger.h>
 #include "lte-ue-phy.h"
 #include "lte-enb-phy.h"
 #include "lte-net-device.h"
@@ -153,6 +155,7 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_pssReceived (false),
     m_ueMeasurementsFilterPeriod (MilliSeconds (200)),
     m_ueMeasurementsFilterLast (MilliSeconds (0)),
+    m_nSelectedCells (0),
     m_rsrpSinrSampleCounter (0)
 {
   NS_LOG_UNCOND ("LteUePhy::LteUePhy=" << this);
@@ -283,6 +286,19 @@ LteUePhy::GetTypeId (void)
                    TimeValue (MilliSeconds (200)),
                    MakeTimeAccessor (&LteUePhy::m_ueMeasurementsFilterPeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxMeasuredCells",
+                   "Maximum number of cells whose RSRQ is measured and which are "
+                   "reported to the RRC, the strongest ones in RSRP; "
+                   "0 means all the detected cells.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LteUePhy::m_maxMeasuredCells),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MeasuredCellsHysteresis",
+                   "RSRP margin [dB] by which a cell must exceed a measured cell "
+                   "to replace it, when MaxMeasuredCells is set.",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&LteUePhy::m_measuredCellsHysteresis),
+                   MakeDoubleChecker<double> (0.0))
     .AddTraceSource ("ReportUeMeasurements",
                      "Report UE measurements RSRP (dBm) and RSRQ (dB).",
                      MakeTraceSourceAccessor (&LteUePhy::m_reportUeMeasurements),
@@ -551,39 +567,44 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
       // measure instantaneous RSRQ now
       NS_ASSERT_MSG (m_rsInterferencePowerUpdated, " RS interference power info obsolete");
 
-      std::list <PssElement>::iterator itPss = m_pssList.begin ();
-      while (itPss != m_pssList.end ())
+      // the RSSI is the same for all the cells
+      uint16_t rbNum = 0;
+      double rssiSum = 0.0;
+      Values::const_iterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
+      Values::const_iterator itPj;
+      for (itPj = m_rsReceivedPower.ConstValuesBegin ();
+           itPj != m_rsReceivedPower.ConstValuesEnd ();
+           itIntN++, itPj++)
         {
-          uint16_t rbNum = 0;
-          double rssiSum = 0.0;
-
-          Values::const_iterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
-          Values::const_iterator itPj = m_rsReceivedPower.ConstValuesBegin ();
-          for (itPj = m_rsReceivedPower.ConstValuesBegin ();
-               itPj != m_rsReceivedPower.ConstValuesEnd ();
-               itIntN++, itPj++)
+          rbNum++;
+          // convert PSD [W/Hz] to linear power [W] for the single RE
+          double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
+          double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
+          rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+        }
+
+      for (std::vector <PssElement>::const_iterator itPss = m_pssList.begin ();
+           itPss != m_pssList.end ();
+           ++itPss)
+        {
+          UeMeasurementsElement& meas = m_ueMeasurements[itPss->cellIndex];
+          if (!meas.selected)
             {
-              rbNum++;
-              // convert PSD [W/Hz] to linear power [W] for the single RE
-              double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
-              double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
-              rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+              continue;
             }
 
-          NS_ASSERT (rbNum == (*itPss).nRB);
-          double rsrq_dB = 10 * log10 ((*itPss).pssPsdSum / rssiSum);
+          NS_ASSERT (rbNum == itPss->nRB);
+          double rsrq_dB = 10 * log10 (itPss->pssPsdSum / rssiSum);
 
           if (rsrq_dB > m_pssReceptionThreshold)
             {
               NS_LOG_INFO (this << " PSS RNTI " << m_rnti << " cellId " << m_cellId
                                 << " has RSRQ " << rsrq_dB << " and RBnum " << rbNum);
               // store measurements
-              std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap;
-              itMeasMap = m_ueMeasurementsMap.find ((*itPss).cellId);
-              if (itMeasMap != m_ueMeasurementsMap.end ())
+              if (meas.rsrpNum > 0)
                 {
-                  (*itMeasMap).second.rsrqSum += rsrq_dB;
-                  (*itMeasMap).second.rsrqNum++;
+                  meas.rsrqSum += rsrq_dB;
+                  meas.rsrqNum++;
                 }
               else
                 {
@@ -591,9 +612,7 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
                 }
             }
 
-          itPss++;
-
-        } // end of while (itPss != m_pssList.end ())
+        } // end of for (itPss = m_pssList.begin (); ...)
 
       m_pssList.clear ();
 
@@ -815,36 +834,65 @@ LteUePhy::ReportUeMeasurements ()
 
   LteUeCphySapUser::UeMeasurementsParameters ret;
 
-  std::map <uint16_t, UeMeasurementsElement>::iterator it;
-  for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end (); it++)
+  // report the cells in increasing cell ID order
+  std::vector <std::pair <uint16_t, uint32_t> > measuredCells;
+  measuredCells.reserve (m_ueMeasuredCells.size ());
+  for (std::vector <uint32_t>::const_iterator it = m_ueMeasuredCells.begin ();
+       it != m_ueMeasuredCells.end (); ++it)
+    {
+      measuredCells.push_back (std::make_pair (m_ueMeasurements[*it].cellId, *it));
+    }
+  std::sort (measuredCells.begin (), measuredCells.end ());
+
+  for (std::vector <std::pair <uint16_t, uint32_t> >::const_iterator it = measuredCells.begin ();
+       it != measuredCells.end (); ++it)
     {
-      double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
-      double avg_rsrq = (*it).second.rsrqSum / (double)(*it).second.rsrqNum;
+      const UeMeasurementsElement& meas = m_ueMeasurements[it->second];
+      if (!meas.selected)
+        {
+          continue;
+        }
+      double avg_rsrp = meas.rsrpSum / (double) meas.rsrpNum;
+      double avg_rsrq = meas.rsrqSum / (double) meas.rsrqNum;
       /*
        * In CELL_SEARCH state, this may result in avg_rsrq = 0/0 = -nan.
        * UE RRC must take this into account when receiving measurement reports.
        * TODO remove this shortcoming by calculating RSRQ during CELL_SEARCH
        */
-      NS_LOG_DEBUG (this << " CellId " << (*it).first
+      NS_LOG_DEBUG (this << " CellId " << meas.cellId
                          << " RSRP " << avg_rsrp
-                         << " (nSamples " << (uint16_t)(*it).second.rsrpNum << ")"
+                         << " (nSamples " << (uint16_t) meas.rsrpNum << ")"
                          << " RSRQ " << avg_rsrq
-                         << " (nSamples " << (uint16_t)(*it).second.rsrqNum << ")");
+                         << " (nSamples " << (uint16_t) meas.rsrqNum << ")");
 
       LteUeCphySapUser::UeMeasurementsElement newEl;
-      newEl.m_cellId = (*it).first;
+      newEl.m_cellId = meas.cellId;
       newEl.m_rsrp = avg_rsrp;
       newEl.m_rsrq = avg_rsrq;
       ret.m_ueMeasurementsList.push_back (newEl);
 
       // report to UE measurements trace
-      m_reportUeMeasurements (m_rnti, (*it).first, avg_rsrp, avg_rsrq, ((*it).first == m_cellId ? 1 : 0));
+      m_reportUeMeasurements (m_rnti, meas.cellId, avg_rsrp, avg_rsrq, (meas.cellId == m_cellId ? 1 : 0));
     }
 
   // report to RRC
   m_ueCphySapUser->ReportUeMeasurements (ret);
 
-  m_ueMeasurementsMap.clear ();
+  if (m_maxMeasuredCells > 0)
+    {
+      SelectMeasuredCells ();
+    }
+
+  for (std::vector <uint32_t>::const_iterator it = m_ueMeasuredCells.begin ();
+       it != m_ueMeasuredCells.end (); ++it)
+    {
+      UeMeasurementsElement& meas = m_ueMeasurements[*it];
+      meas.rsrpSum = 0;
+      meas.rsrpNum = 0;
+      meas.rsrqSum = 0;
+      meas.rsrqNum = 0;
+    }
+  m_ueMeasuredCells.clear ();
   Simulator::Schedule (m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
@@ -871,27 +919,39 @@ LteUePhy::DoSendRachPreamble (uint32_t raPreambleId, uint32_t raRnti)
 
 
 void
-LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgList)
+LteUePhy::ReceiveLteControlMessageList (Ptr<const LteControlMessageList> msgList)
 {
   NS_LOG_FUNCTION (this);
 
-  std::list<Ptr<LteControlMessage> >::iterator it;
-  NS_LOG_DEBUG (this << " I am rnti = " << m_rnti << " and I received msgs " << (uint16_t) msgList.size ());
-  for (it = msgList.begin (); it != msgList.end (); it++)
-    {
-      Ptr<LteControlMessage> msg = (*it);
+  NS_LOG_DEBUG (this << " I am rnti = " << m_rnti << " and I received msgs " << msgList->GetN ());
 
-      if (msg->GetMessageType () == LteControlMessage::DL_DCI)
+  // look up the messages of this UE and the ones bound to no UE in
+  // particular (MIB, SIB1, RAR), merged back in order of transmission
+  std::pair<LteControlMessageList::Iterator, LteControlMessageList::Iterator> own = msgList->Find (m_rnti);
+  std::pair<LteControlMessageList::Iterator, LteControlMessageList::Iterator> common = msgList->Find (0);
+  if (m_rnti == 0)
+    {
+      own.second = own.first;
+    }
+  while (own.first != own.second || common.first != common.second)
+    {
+      uint32_t msgIndex;
+      if (common.first == common.second
+          || (own.first != own.second && *own.first < *common.first))
         {
-          Ptr<DlDciLteControlMessage> msg2 = DynamicCast<DlDciLteControlMessage> (msg);
+          msgIndex = *own.first++;
+        }
+      else
+        {
+          msgIndex = *common.first++;
+        }
+      LteControlMessage::MessageType msgType = msgList->GetType (msgIndex);
 
+      if (msgType == LteControlMessage::DL_DCI)
+        {
+          NS_ASSERT (msgList->GetRnti (msgIndex) == m_rnti);
+          Ptr<DlDciLteControlMessage> msg2 = DynamicCast<DlDciLteControlMessage> (msgList->Get (msgIndex));
           DlDciListElement_s dci = msg2->GetDci ();
-          NS_LOG_DEBUG (this << " I am rnti = " << m_rnti << " and I received dci for rnti " << dci.m_rnti);
-          if (dci.m_rnti != m_rnti)
-            {
-              // DCI not for me
-              continue;
-            }
 
           if (dci.m_resAlloc != 0)
             {
@@ -931,16 +991,13 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
 
 
         }
-      else if (msg->GetMessageType () == LteControlMessage::UL_DCI)
+      else if (msgType == LteControlMessage::UL_DCI)
         {
+          NS_ASSERT (msgList->GetRnti (msgIndex) == m_rnti);
           // set the uplink bandwidth according to the UL-CQI
+          Ptr<LteControlMessage> msg = msgList->Get (msgIndex);
           Ptr<UlDciLteControlMessage> msg2 = DynamicCast<UlDciLteControlMessage> (msg);
           UlDciListElement_s dci = msg2->GetDci ();
-          if (dci.m_rnti != m_rnti)
-            {
-              // DCI not for me
-              continue;
-            }
           NS_LOG_INFO (this << " UL DCI");
           std::vector <int> ulRb;
           for (int i = 0; i < dci.m_rbLen; i++)
@@ -950,7 +1007,7 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
             }
           QueueSubChannelsForTransmission (ulRb);
           // fire trace of UL Tx PHY stats
-          HarqProcessInfoList_t harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl (m_rnti, 0);
+          const HarqProcessInfoList_t& harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl (m_rnti, 0);
           PhyTransmissionStatParameters params;
           params.m_cellId = m_cellId;
           params.m_imsi = 0; // it will be set by DlPhyTransmissionCallback in LteHelper
@@ -966,8 +1023,9 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
           // pass the info to the MAC
           m_uePhySapUser->ReceiveLteControlMessage (msg);
         }
-      else if (msg->GetMessageType () == LteControlMessage::RAR)
+      else if (msgType == LteControlMessage::RAR)
         {
+          Ptr<LteControlMessage> msg = msgList->Get (msgIndex);
           Ptr<RarLteControlMessage> rarMsg = DynamicCast<RarLteControlMessage> (msg);
           if (rarMsg->GetRaRnti () == m_raRnti)
             {
@@ -998,24 +1056,24 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
                 }
             }
         }
-      else if (msg->GetMessageType () == LteControlMessage::MIB)
+      else if (msgType == LteControlMessage::MIB)
         {
           NS_LOG_INFO ("received MIB");
           NS_ASSERT (m_cellId > 0);
-          Ptr<MibLteControlMessage> msg2 = DynamicCast<MibLteControlMessage> (msg);
+          Ptr<MibLteControlMessage> msg2 = DynamicCast<MibLteControlMessage> (msgList->Get (msgIndex));
           m_ueCphySapUser->RecvMasterInformationBlock (m_cellId, msg2->GetMib ());
         }
-      else if (msg->GetMessageType () == LteControlMessage::SIB1)
+      else if (msgType == LteControlMessage::SIB1)
         {
           NS_LOG_INFO ("received SIB1");
           NS_ASSERT (m_cellId > 0);
-          Ptr<Sib1LteControlMessage> msg2 = DynamicCast<Sib1LteControlMessage> (msg);
+          Ptr<Sib1LteControlMessage> msg2 = DynamicCast<Sib1LteControlMessage> (msgList->Get (msgIndex));
           m_ueCphySapUser->RecvSystemInformationBlockType1 (m_cellId, msg2->GetSib1 ());
         }
       else
         {
           // pass the message to UE-MAC
-          m_uePhySapUser->ReceiveLteControlMessage (msg);
+          m_uePhySapUser->ReceiveLteControlMessage (msgList->Get (msgIndex));
         }
 
     }
@@ -1024,6 +1082,73 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
 }
 
 
+uint32_t
+LteUePhy::GetUeMeasurementsIndex (uint16_t cellId)
+{
+  if (cellId >= m_ueMeasurementsIndex.size ())
+    {
+      m_ueMeasurementsIndex.resize (cellId + 1, -1);
+    }
+  if (m_ueMeasurementsIndex[cellId] < 0)
+    {
+      UeMeasurementsElement newEl;
+      newEl.cellId = cellId;
+      newEl.rsrpSum = 0;
+      newEl.rsrpNum = 0;
+      newEl.rsrqSum = 0;
+      newEl.rsrqNum = 0;
+      // a new cell is measured while there is room for it
+      newEl.selected = (m_maxMeasuredCells == 0 || m_nSelectedCells < m_maxMeasuredCells);
+      if (newEl.selected)
+        {
+          ++m_nSelectedCells;
+        }
+      m_ueMeasurementsIndex[cellId] = m_ueMeasurements.size ();
+      m_ueMeasurements.push_back (newEl);
+    }
+  return m_ueMeasurementsIndex[cellId];
+}
+
+void
+LteUePhy::SelectMeasuredCells ()
+{
+  NS_LOG_FUNCTION (this);
+
+  // rank the cells detected in the period just ended
+  std::vector <std::pair <double, uint32_t> > ranking;
+  ranking.reserve (m_ueMeasuredCells.size ());
+  for (std::vector <uint32_t>::const_iterator it = m_ueMeasuredCells.begin ();
+       it != m_ueMeasuredCells.end (); ++it)
+    {
+      const UeMeasurementsElement& meas = m_ueMeasurements[*it];
+      double score = meas.rsrpSum / (double) meas.rsrpNum;
+      if (meas.cellId == m_cellId)
+        {
+          score = DBL_MAX;
+        }
+      else if (meas.selected)
+        {
+          score += m_measuredCellsHysteresis;
+        }
+      // negated, so that the strongest cells come first
+      ranking.push_back (std::make_pair (-score, *it));
+    }
+  uint32_t nSelected = std::min (m_maxMeasuredCells, (uint32_t) ranking.size ());
+  std::partial_sort (ranking.begin (), ranking.begin () + nSelected, ranking.end ());
+
+  for (std::vector <UeMeasurementsElement>::iterator it = m_ueMeasurements.begin ();
+       it != m_ueMeasurements.end (); ++it)
+    {
+      it->selected = false;
+    }
+  for (uint32_t i = 0; i < nSelected; ++i)
+    {
+      m_ueMeasurements[ranking[i].second].selected = true;
+      NS_LOG_LOGIC (this << " measuring cell " << m_ueMeasurements[ranking[i].second].cellId);
+    }
+  m_nSelectedCells = nSelected;
+}
+
 void
 LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 {
@@ -1047,22 +1172,14 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
   // note that m_pssReceptionThreshold does not apply here
 
   // store measurements
-  std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap = m_ueMeasurementsMap.find (cellId);
-  if (itMeasMap == m_ueMeasurementsMap.end ())
-    {
-      // insert new entry
-      UeMeasurementsElement newEl;
-      newEl.rsrpSum = rsrp_dBm;
-      newEl.rsrpNum = 1;
-      newEl.rsrqSum = 0;
-      newEl.rsrqNum = 0;
-      m_ueMeasurementsMap.insert (std::pair <uint16_t, UeMeasurementsElement> (cellId, newEl));
-    }
-  else
+  uint32_t cellIndex = GetUeMeasurementsIndex (cellId);
+  UeMeasurementsElement& meas = m_ueMeasurements[cellIndex];
+  if (meas.rsrpNum == 0)
     {
-      (*itMeasMap).second.rsrpSum += rsrp_dBm;
-      (*itMeasMap).second.rsrpNum++;
+      m_ueMeasuredCells.push_back (cellIndex);
     }
+  meas.rsrpSum += rsrp_dBm;
+  meas.rsrpNum++;
 
   /*
    * Collect the PSS for later processing in GenerateCtrlCqiReport()
@@ -1070,7 +1187,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
    */
   m_pssReceived = true;
   PssElement el;
-  el.cellId = cellId;
+  el.cellIndex = cellIndex;
   el.pssPsdSum = sum;
   el.nRB = nRB;
   m_pssList.push_back (el);
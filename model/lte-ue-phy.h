@@ -27,12 +27,14 @@
 #include <ns3/ff-mac-common.h>
 
 #include <ns3/lte-control-messages.h>
+#include <ns3/lte-control-message-list.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ue-phy-sap.h>
 #include <ns3/lte-ue-cphy-sap.h>
 #include <ns3/ptr.h>
 #include <ns3/lte-amc.h>
 #include <set>
+#include <vector>
 #include <ns3/lte-ue-power-control.h>
 
 
@@ -196,7 +198,7 @@ public:
   virtual void ReportRsReceivedPower (const SpectrumValue& power);
 
   // callbacks for LteSpectrumPhy
-  virtual void ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> >);
+  virtual void ReceiveLteControlMessageList (Ptr<const LteControlMessageList> msgList);
   virtual void ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p);
 
 
@@ -304,6 +306,23 @@ private:
    */
   void ReportUeMeasurements ();
 
+  /**
+   * \param cellId the cell ID
+   * \return the index of the cell in m_ueMeasurements, a new entry being
+   *         appended the first time the cell is detected
+   */
+  uint32_t GetUeMeasurementsIndex (uint16_t cellId);
+
+  /**
+   * \brief Select the cells measured during the next layer-1 filtering
+   *        period, when MaxMeasuredCells is set.
+   *
+   * The serving cell is always selected. The other cells are ranked by
+   * their average RSRP in the period just ended, the cells already
+   * selected getting a bonus of MeasuredCellsHysteresis.
+   */
+  void SelectMeasuredCells ();
+
   /**
    * Switch the UE PHY to the given state.
    * \param s the destination state
@@ -400,13 +419,15 @@ private:
   SpectrumValue m_dataInterferencePower;
 
   bool m_pssReceived;
+  /// PSS received in the current subframe
   struct PssElement
   {
-    uint16_t cellId;
-    double pssPsdSum;
-    uint16_t nRB;
+    uint32_t cellIndex; ///< index of the cell in m_ueMeasurements
+    double pssPsdSum; ///< sum of the PSS power over the RBs, in W
+    uint16_t nRB; ///< number of RBs
   };
-  std::list <PssElement> m_pssList;
+  /// PSS received in the current subframe, reused across subframes
+  std::vector <PssElement> m_pssList;
 
   /**
    * The `RsrqUeMeasThreshold` attribute. Receive threshold for PSS on RSRQ
@@ -417,17 +438,37 @@ private:
   /// Summary results of measuring a specific cell. Used for layer-1 filtering.
   struct UeMeasurementsElement
   {
+    uint16_t cellId;  ///< Cell ID of the measured cell.
     double rsrpSum;   ///< Sum of RSRP sample values in linear unit.
     uint8_t rsrpNum;  ///< Number of RSRP samples.
     double rsrqSum;   ///< Sum of RSRQ sample values in linear unit.
     uint8_t rsrqNum;  ///< Number of RSRQ samples.
+    bool selected;    ///< Whether the cell is measured and reported.
   };
 
   /**
    * Store measurement results during the last layer-1 filtering period.
-   * Indexed by the cell ID where the measurements come from.
+   * Indexed by a dense index, given to each cell when it is first
+   * detected; the entries are kept across the filtering periods.
+   */
+  std::vector <UeMeasurementsElement> m_ueMeasurements;
+  /// Index in m_ueMeasurements of each cell ID, -1 for undetected cells.
+  std::vector <int32_t> m_ueMeasurementsIndex;
+  /// Indexes of the cells with RSRP samples in the current filtering period.
+  std::vector <uint32_t> m_ueMeasuredCells;
+  /**
+   * The `MaxMeasuredCells` attribute. Maximum number of cells whose RSRQ
+   * is measured and which are reported to the RRC, 0 for all the
+   * detected cells.
+   */
+  uint32_t m_maxMeasuredCells;
+  /**
+   * The `MeasuredCellsHysteresis` attribute. RSRP margin, in dB, by which
+   * a cell must exceed a measured cell to replace it.
    */
-  std::map <uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+  double m_measuredCellsHysteresis;
+  /// Number of cells currently selected for measurement.
+  uint32_t m_nSelectedCells;
   /**
    * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
    * measurements, i.e., the length of layer-1 filtering (default 200 ms).
@@ -32,6 +32,34 @@ NS_LOG_COMPONENT_DEFINE ("LteUePowerControl");
 
 NS_OBJECT_ENSURE_REGISTERED (LteUePowerControl);
 
+/// TPC command to accumulated delta [dB], see TS 36.213 Table 5.1.1.1-2
+static const int8_t ACCUMULATED_TPC_DELTA[4] = { -1, 0, 1, 3 };
+
+/// TPC command to absolute delta [dB], see TS 36.213 Table 5.1.1.1-2
+static const int8_t ABSOLUTE_TPC_DELTA[4] = { -4, -1, 1, 4 };
+
+/// Largest number of RBs whose power offset is tabulated
+static const uint16_t MAX_TABULATED_RB_NUM = 110;
+
+/**
+ * \param rbNum a number of resource blocks
+ * \return 10 log10 (rbNum), tabulated for the bandwidths of LTE
+ */
+static double
+RbNumToDb (uint16_t rbNum)
+{
+  static std::vector<double> table;
+  if (table.empty ())
+    {
+      table.resize (MAX_TABULATED_RB_NUM + 1);
+      for (uint16_t n = 0; n <= MAX_TABULATED_RB_NUM; ++n)
+        {
+          table[n] = 10 * log10 (1.0 * n);
+        }
+    }
+  return rbNum <= MAX_TABULATED_RB_NUM ? table[rbNum] : 10 * log10 (1.0 * rbNum);
+}
+
 LteUePowerControl::LteUePowerControl ()
 {
   NS_LOG_FUNCTION (this);
@@ -48,6 +76,9 @@ LteUePowerControl::LteUePowerControl ()
 
   m_M_Pusch = 0;
   m_rsrpSet = false;
+
+  m_deltaPuschHead = 0;
+  m_deltaPuschSize = 0;
 }
 
 LteUePowerControl::~LteUePowerControl ()
@@ -270,66 +301,30 @@ LteUePowerControl::ReportTpc (uint8_t tpc)
 {
   NS_LOG_FUNCTION (this);
 
-  int delta = 0;
-  if (m_accumulationEnabled)
+  if (tpc > 3)
     {
-      switch (tpc)
-        {
-        case 0:
-          delta = -1;
-          break;
-        case 1:
-          delta = 0;
-          break;
-        case 2:
-          delta = 1;
-          break;
-        case 3:
-          delta = 3;
-          break;
-        default:
-          NS_FATAL_ERROR ("Unexpected TPC value");
-        }
+      NS_FATAL_ERROR ("Unexpected TPC value");
     }
-  else
-    {
-      switch (tpc)
-        {
-        case 0:
-          delta = -4;
-          break;
-        case 1:
-          delta = -1;
-          break;
-        case 2:
-          delta = 1;
-          break;
-        case 3:
-          delta = 4;
-          break;
-        default:
-          NS_FATAL_ERROR ("Unexpected TPC value");
-        }
-    }
-
-  m_deltaPusch.push_back (delta);
+  int delta = m_accumulationEnabled ? ACCUMULATED_TPC_DELTA[tpc] : ABSOLUTE_TPC_DELTA[tpc];
 
   if (m_closedLoop)
     {
       if (m_accumulationEnabled)
         {
-          if (m_deltaPusch.size () == 4)
+          // the deltas are accumulated four TPCs later
+          m_deltaPusch[(m_deltaPuschHead + m_deltaPuschSize) % 4] = delta;
+          m_deltaPuschSize++;
+          if (m_deltaPuschSize == 4)
             {
-              if ((m_curPuschTxPower <= m_Pcmin && m_deltaPusch.at (0) < 0)
-                  || (m_curPuschTxPower >= m_Pcmax && m_deltaPusch.at (0) > 0))
-                {
-                  //TPC commands for serving cell shall not be accumulated
-                  m_deltaPusch.erase (m_deltaPusch.begin ());
-                }
-              else
+              int8_t oldest = m_deltaPusch[m_deltaPuschHead];
+              m_deltaPuschHead = (m_deltaPuschHead + 1) % 4;
+              m_deltaPuschSize--;
+              //TPC commands for serving cell shall not be accumulated
+              //beyond the power limits
+              if (!((m_curPuschTxPower <= m_Pcmin && oldest < 0)
+                    || (m_curPuschTxPower >= m_Pcmax && oldest > 0)))
                 {
-                  m_fc = m_fc + m_deltaPusch.at (0);
-                  m_deltaPusch.erase (m_deltaPusch.begin ());
+                  m_fc = m_fc + oldest;
                 }
             }
           else
@@ -339,8 +334,7 @@ LteUePowerControl::ReportTpc (uint8_t tpc)
         }
       else
         {
-          m_fc = m_deltaPusch.at (0);
-          m_deltaPusch.erase (m_deltaPusch.begin ());
+          m_fc = delta;
         }
     }
   else
@@ -352,7 +346,7 @@ LteUePowerControl::ReportTpc (uint8_t tpc)
 }
 
 void
-LteUePowerControl::SetSubChannelMask (std::vector <int> mask)
+LteUePowerControl::SetSubChannelMask (const std::vector <int>& mask)
 {
   NS_LOG_FUNCTION (this);
   m_M_Pusch = mask.size ();
@@ -371,7 +365,7 @@ LteUePowerControl::CalculatePuschTxPower ()
 
   if ( m_M_Pusch > 0 )
     {
-      m_curPuschTxPower = 10 * log10 (1.0 * m_M_Pusch) + PoPusch + m_alpha[j] * m_pathLoss + m_deltaTF + m_fc;
+      m_curPuschTxPower = RbNumToDb (m_M_Pusch) + PoPusch + m_alpha[j] * m_pathLoss + m_deltaTF + m_fc;
       m_M_Pusch = 0;
     }
   else
@@ -408,7 +402,7 @@ LteUePowerControl::CalculateSrsTxPower ()
 
   double pSrsOffsetValue = -10.5 + m_PsrsOffset * 1.5;
 
-  m_curSrsTxPower = pSrsOffsetValue + 10 * log10 (m_srsBandwidth) + PoPusch + m_alpha[j] * m_pathLoss + m_fc;
+  m_curSrsTxPower = pSrsOffsetValue + RbNumToDb (m_srsBandwidth) + PoPusch + m_alpha[j] * m_pathLoss + m_fc;
 
   NS_LOG_INFO ("CalcPower: " << m_curSrsTxPower << " MinPower: " << m_Pcmin << " MaxPower:" << m_Pcmax);
 
@@ -419,7 +413,7 @@ LteUePowerControl::CalculateSrsTxPower ()
 
 
 double
-LteUePowerControl::GetPuschTxPower (std::vector <int> dlRb)
+LteUePowerControl::GetPuschTxPower (const std::vector <int>& dlRb)
 {
   NS_LOG_FUNCTION (this);
 
@@ -432,7 +426,7 @@ LteUePowerControl::GetPuschTxPower (std::vector <int> dlRb)
 }
 
 double
-LteUePowerControl::GetPucchTxPower (std::vector <int> dlRb)
+LteUePowerControl::GetPucchTxPower (const std::vector <int>& dlRb)
 {
   NS_LOG_FUNCTION (this);
 
@@ -444,7 +438,7 @@ LteUePowerControl::GetPucchTxPower (std::vector <int> dlRb)
 }
 
 double
-LteUePowerControl::GetSrsTxPower (std::vector <int> dlRb)
+LteUePowerControl::GetSrsTxPower (const std::vector <int>& dlRb)
 {
   NS_LOG_FUNCTION (this);
 
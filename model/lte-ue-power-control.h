@@ -83,9 +83,9 @@ public:
   void CalculatePucchTxPower ();
   void CalculateSrsTxPower ();
 
-  double GetPuschTxPower (std::vector <int> rb);
-  double GetPucchTxPower (std::vector <int> rb);
-  double GetSrsTxPower (std::vector <int> rb);
+  double GetPuschTxPower (const std::vector <int>& rb);
+  double GetPucchTxPower (const std::vector <int>& rb);
+  double GetSrsTxPower (const std::vector <int>& rb);
 
   /**
    * TracedCallback signature for uplink transmit power.
@@ -98,7 +98,7 @@ public:
     (const uint16_t cellId, const uint16_t rnti, const double power);
 
 private:
-  void SetSubChannelMask (std::vector <int> mask);
+  void SetSubChannelMask (const std::vector <int>& mask);
 
   double m_txPower;
   double m_Pcmax;
@@ -122,7 +122,10 @@ private:
   double m_pathLoss;
   double m_deltaTF;
 
-  std::vector<int8_t> m_deltaPusch;
+  /// TPC deltas received but not accumulated yet, as a ring buffer
+  int8_t m_deltaPusch[4];
+  uint8_t m_deltaPuschHead; ///< index in m_deltaPusch of the oldest delta
+  uint8_t m_deltaPuschSize; ///< number of deltas in m_deltaPusch
   double m_fc;
 
   uint16_t m_srsBandwidth;
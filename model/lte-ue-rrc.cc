@@ -35,6 +35,7 @@
 #include <ns3/lte-radio-bearer-info.h>
 
 #include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -113,6 +114,28 @@ static const std::string & ToString (LteUeRrc::State s)
   return g_ueRrcStateName[s];
 }
 
+/// Maximum number of measurement identities, see 3GPP TS 36.331 maxMeasId
+static const uint8_t MAX_MEAS_ID = 32;
+
+/**
+ * \param reportConfigEutra the reporting configuration
+ * \return the quantity of the measurement table used as trigger quantity
+ */
+static LteUeMeasTable::Quantity
+GetTriggerQuantity (const LteRrcSap::ReportConfigEutra& reportConfigEutra)
+{
+  switch (reportConfigEutra.triggerQuantity)
+    {
+    case LteRrcSap::ReportConfigEutra::RSRP:
+      return LteUeMeasTable::RSRP;
+    case LteRrcSap::ReportConfigEutra::RSRQ:
+      return LteUeMeasTable::RSRQ;
+    default:
+      NS_FATAL_ERROR ("unsupported triggerQuantity");
+      return LteUeMeasTable::RSRP;
+    }
+}
+
 
 /////////////////////////////
 // ue RRC methods
@@ -158,6 +181,8 @@ LteUeRrc::LteUeRrc ()
       m_cphySapUser[i] = new MemberLteUeCphySapUser<LteUeRrc> (this);
       m_cmacSapUser[i] = new UeMemberLteUeCmacSapUser (this);
     }
+  m_enteringTriggerQueue.resize (MAX_MEAS_ID + 1);
+  m_leavingTriggerQueue.resize (MAX_MEAS_ID + 1);
 }
 
 
@@ -859,13 +884,7 @@ LteUeRrc::DoReportUeMeasurements (LteUeCphySapUser::UeMeasurementsParameters par
   // layer 3 filtering does not apply in IDLE mode
   bool useLayer3Filtering = (m_state == CONNECTED_NORMALLY);
 
-  std::vector <LteUeCphySapUser::UeMeasurementsElement>::iterator newMeasIt;
-  for (newMeasIt = params.m_ueMeasurementsList.begin ();
-       newMeasIt != params.m_ueMeasurementsList.end (); ++newMeasIt)
-    {
-      SaveUeMeasurements (newMeasIt->m_cellId, newMeasIt->m_rsrp,
-                          newMeasIt->m_rsrq, useLayer3Filtering);
-    }
+  SaveUeMeasurements (params.m_ueMeasurementsList, useLayer3Filtering);
 
   if (m_state == IDLE_CELL_SEARCH)
     {
@@ -1125,21 +1144,22 @@ LteUeRrc::SynchronizeToStrongestCell ()
   uint16_t maxRsrpCellId = 0;
   double maxRsrp = -std::numeric_limits<double>::infinity ();
 
-  std::map<uint16_t, MeasValues>::iterator it;
-  for (it = m_storedMeasValues.begin (); it != m_storedMeasValues.end (); it++)
+  for (uint32_t row = 0; row < m_measTable.GetNRows (); ++row)
     {
       /*
        * This block attempts to find a cell with strongest RSRP and has not
        * yet been identified as "acceptable cell".
        */
-      if (maxRsrp < it->second.rsrp)
+      double rsrp = m_measTable.GetValue (row, LteUeMeasTable::RSRP);
+      if (maxRsrp < rsrp)
         {
+          uint16_t cellId = m_measTable.GetCellId (row);
           std::set<uint16_t>::const_iterator itCell;
-          itCell = m_acceptableCell.find (it->first);
+          itCell = m_acceptableCell.find (cellId);
           if (itCell == m_acceptableCell.end ())
             {
-              maxRsrpCellId = it->first;
-              maxRsrp = it->second.rsrp;
+              maxRsrpCellId = cellId;
+              maxRsrp = rsrp;
             }
         }
     }
@@ -1172,8 +1192,9 @@ LteUeRrc::EvaluateCellForSelection ()
 
   bool isSuitableCell = false;
   bool isAcceptableCell = false;
-  std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.find (cellId);
-  double qRxLevMeas = storedMeasIt->second.rsrp;
+  int32_t measRow = m_measTable.FindRow (cellId);
+  NS_ASSERT (measRow >= 0);
+  double qRxLevMeas = m_measTable.GetValue (measRow, LteUeMeasTable::RSRP);
   double qRxLevMin = EutranMeasurementMapping::IeValue2ActualQRxLevMin (m_lastSib1.cellSelectionInfo.qRxLevMin);
   NS_LOG_LOGIC (this << " cell selection to cellId=" << cellId
                      << " qrxlevmeas=" << qRxLevMeas << " dBm"
@@ -1610,9 +1631,10 @@ LteUeRrc::ApplyMeasConfig (LteRrcSap::MeasConfig mc)
       m_varMeasConfig.measIdList.erase (measId);
       VarMeasReportListClear (measId);
 
-      // removing time-to-trigger queues
-      m_enteringTriggerQueue.erase (measId);
-      m_leavingTriggerQueue.erase (measId);
+      // emptying time-to-trigger queues
+      NS_ASSERT (measId <= MAX_MEAS_ID);
+      m_enteringTriggerQueue[measId].Clear ();
+      m_leavingTriggerQueue[measId].Clear ();
     }
 
   // 3GPP TS 36.331 section 5.5.2.3 Measurement identity addition/ modification
@@ -1639,9 +1661,10 @@ LteUeRrc::ApplyMeasConfig (LteRrcSap::MeasConfig mc)
                  ->second.reportConfigEutra.triggerType != LteRrcSap::ReportConfigEutra::PERIODICAL);
 
       // new empty queues for time-to-trigger
-      std::list<PendingTrigger_t> s;
-      m_enteringTriggerQueue[it->measId] = s;
-      m_leavingTriggerQueue[it->measId] = s;
+      NS_ASSERT_MSG (it->measId >= 1 && it->measId <= MAX_MEAS_ID,
+                     "invalid measId " << (uint32_t) it->measId);
+      m_enteringTriggerQueue[it->measId].Clear ();
+      m_leavingTriggerQueue[it->measId].Clear ();
     }
 
   if (mc.haveMeasGapConfig)
@@ -1661,56 +1684,17 @@ LteUeRrc::ApplyMeasConfig (LteRrcSap::MeasConfig mc)
 }
 
 void
-LteUeRrc::SaveUeMeasurements (uint16_t cellId, double rsrp, double rsrq,
+LteUeRrc::SaveUeMeasurements (const std::vector<LteUeCphySapUser::UeMeasurementsElement>& measurements,
                               bool useLayer3Filtering)
 {
-  NS_LOG_FUNCTION (this << cellId << rsrp << rsrq << useLayer3Filtering);
-
-  std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.find (cellId);
+  NS_LOG_FUNCTION (this << measurements.size () << useLayer3Filtering);
 
-  if (storedMeasIt != m_storedMeasValues.end ())
-    {
-      if (useLayer3Filtering)
-        {
-          // F_n = (1-a) F_{n-1} + a M_n
-          storedMeasIt->second.rsrp = (1 - m_varMeasConfig.aRsrp) * storedMeasIt->second.rsrp
-            + m_varMeasConfig.aRsrp * rsrp;
-
-          if (std::isnan (storedMeasIt->second.rsrq))
-            {
-              // the previous RSRQ measurements provided UE PHY are invalid
-              storedMeasIt->second.rsrq = rsrq;   // replace it with unfiltered value
-            }
-          else
-            {
-              storedMeasIt->second.rsrq = (1 - m_varMeasConfig.aRsrq) * storedMeasIt->second.rsrq
-                + m_varMeasConfig.aRsrq * rsrq;
-            }
-        }
-      else
-        {
-          storedMeasIt->second.rsrp = rsrp;
-          storedMeasIt->second.rsrq = rsrq;
-        }
-    }
-  else
-    {
-      // first value is always unfiltered
-      MeasValues v;
-      v.rsrp = rsrp;
-      v.rsrq = rsrq;
-      std::pair<uint16_t, MeasValues> val (cellId, v);
-      std::pair<std::map<uint16_t, MeasValues>::iterator, bool>
-      ret = m_storedMeasValues.insert (val);
-      NS_ASSERT_MSG (ret.second == true, "element already existed");
-      storedMeasIt = ret.first;
-    }
+  m_measTable.Update (measurements, useLayer3Filtering,
+                      m_varMeasConfig.aRsrp, m_varMeasConfig.aRsrq);
 
   NS_LOG_DEBUG (this << " IMSI " << m_imsi << " state " << ToString (m_state)
                      << ", measured cell " << m_cellId
-                     << ", new RSRP " << rsrp << " stored " << storedMeasIt->second.rsrp
-                     << ", new RSRQ " << rsrq << " stored " << storedMeasIt->second.rsrq);
-  storedMeasIt->second.timestamp = Simulator::Now ();
+                     << ", saved " << measurements.size () << " measurements");
 
 }   // end of void SaveUeMeasurements
 
@@ -1768,13 +1752,13 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
         switch (reportConfigEutra.triggerQuantity)
           {
           case LteRrcSap::ReportConfigEutra::RSRP:
-            ms = m_storedMeasValues[m_cellId].rsrp;
+            ms = GetServingCellMeasValue (LteUeMeasTable::RSRP);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRP);
             thresh = EutranMeasurementMapping::RsrpRange2Dbm (reportConfigEutra.threshold1.range);
             break;
           case LteRrcSap::ReportConfigEutra::RSRQ:
-            ms = m_storedMeasValues[m_cellId].rsrq;
+            ms = GetServingCellMeasValue (LteUeMeasTable::RSRQ);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ);
             thresh = EutranMeasurementMapping::RsrqRange2Db (reportConfigEutra.threshold1.range);
@@ -1855,13 +1839,13 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
         switch (reportConfigEutra.triggerQuantity)
           {
           case LteRrcSap::ReportConfigEutra::RSRP:
-            ms = m_storedMeasValues[m_cellId].rsrp;
+            ms = GetServingCellMeasValue (LteUeMeasTable::RSRP);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRP);
             thresh = EutranMeasurementMapping::RsrpRange2Dbm (reportConfigEutra.threshold1.range);
             break;
           case LteRrcSap::ReportConfigEutra::RSRQ:
-            ms = m_storedMeasValues[m_cellId].rsrq;
+            ms = GetServingCellMeasValue (LteUeMeasTable::RSRQ);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ);
             thresh = EutranMeasurementMapping::RsrqRange2Db (reportConfigEutra.threshold1.range);
@@ -1934,7 +1918,6 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
          * Please refer to 3GPP TS 36.331 Section 5.5.4.4
          */
 
-        double mn;   // Mn, the measurement result of the neighbouring cell
         double ofn = measObjectEutra.offsetFreq;   // Ofn, the frequency specific offset of the frequency of the
         double ocn = 0.0;   // Ocn, the cell specific offset of the neighbour cell
         double mp;   // Mp, the measurement result of the PCell
@@ -1948,12 +1931,12 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
         switch (reportConfigEutra.triggerQuantity)
           {
           case LteRrcSap::ReportConfigEutra::RSRP:
-            mp = m_storedMeasValues[m_cellId].rsrp;
+            mp = GetServingCellMeasValue (LteUeMeasTable::RSRP);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRP);
             break;
           case LteRrcSap::ReportConfigEutra::RSRQ:
-            mp = m_storedMeasValues[m_cellId].rsrq;
+            mp = GetServingCellMeasValue (LteUeMeasTable::RSRQ);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ);
             break;
@@ -1962,71 +1945,21 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
             break;
           }
 
-        for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-             storedMeasIt != m_storedMeasValues.end ();
-             ++storedMeasIt)
-          {
-            uint16_t cellId = storedMeasIt->first;
-            if (cellId == m_cellId)
-              {
-                continue;
-              }
-
-            switch (reportConfigEutra.triggerQuantity)
-              {
-              case LteRrcSap::ReportConfigEutra::RSRP:
-                mn = storedMeasIt->second.rsrp;
-                break;
-              case LteRrcSap::ReportConfigEutra::RSRQ:
-                mn = storedMeasIt->second.rsrq;
-                break;
-              default:
-                NS_FATAL_ERROR ("unsupported triggerQuantity");
-                break;
-              }
-
-            bool hasTriggered = isMeasIdInReportList
-              && (measReportIt->second.cellsTriggeredList.find (cellId)
-                  != measReportIt->second.cellsTriggeredList.end ());
+        NS_LOG_LOGIC (this << " event A3: mp=" << mp << " offset=" << off);
 
-            // Inequality A3-1 (Entering condition): Mn + Ofn + Ocn - Hys > Mp + Ofp + Ocp + Off
-            bool entryCond = mn + ofn + ocn - hys > mp + ofp + ocp + off;
-
-            if (entryCond)
-              {
-                if (!hasTriggered)
-                  {
-                    concernedCellsEntry.push_back (cellId);
-                    eventEntryCondApplicable = true;
-                  }
-              }
-            else if (reportConfigEutra.timeToTrigger > 0)
-              {
-                CancelEnteringTrigger (measId, cellId);
-              }
+        // Inequality A3-1 (Entering condition): Mn + Ofn + Ocn - Hys > Mp + Ofp + Ocp + Off
+        FindEnteringNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                    mp + ofp + ocp + off - ofn - ocn + hys,
+                                    reportConfigEutra.timeToTrigger > 0,
+                                    concernedCellsEntry);
+        eventEntryCondApplicable = !concernedCellsEntry.empty ();
 
-            // Inequality A3-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Mp + Ofp + Ocp + Off
-            bool leavingCond = mn + ofn + ocn + hys < mp + ofp + ocp + off;
-
-            if (leavingCond)
-              {
-                if (hasTriggered)
-                  {
-                    concernedCellsLeaving.push_back (cellId);
-                    eventLeavingCondApplicable = true;
-                  }
-              }
-            else if (reportConfigEutra.timeToTrigger > 0)
-              {
-                CancelLeavingTrigger (measId, cellId);
-              }
-
-            NS_LOG_LOGIC (this << " event A3: neighbor cell " << cellId
-                               << " mn=" << mn << " mp=" << mp << " offset=" << off
-                               << " entryCond=" << entryCond
-                               << " leavingCond=" << leavingCond);
-
-          }   // end of for (storedMeasIt)
+        // Inequality A3-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Mp + Ofp + Ocp + Off
+        FindLeavingNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                   mp + ofp + ocp + off - ofn - ocn - hys,
+                                   reportConfigEutra.timeToTrigger > 0,
+                                   concernedCellsLeaving);
+        eventLeavingCondApplicable = !concernedCellsLeaving.empty ();
 
       }   // end of case LteRrcSap::ReportConfigEutra::EVENT_A3
 
@@ -2039,7 +1972,6 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
          * Please refer to 3GPP TS 36.331 Section 5.5.4.5
          */
 
-        double mn;   // Mn, the measurement result of the neighbouring cell
         double ofn = measObjectEutra.offsetFreq;   // Ofn, the frequency specific offset of the frequency of the
         double ocn = 0.0;   // Ocn, the cell specific offset of the neighbour cell
         double thresh;   // Thresh, the threshold parameter for this event
@@ -2063,71 +1995,21 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
             break;
           }
 
-        for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-             storedMeasIt != m_storedMeasValues.end ();
-             ++storedMeasIt)
-          {
-            uint16_t cellId = storedMeasIt->first;
-            if (cellId == m_cellId)
-              {
-                continue;
-              }
-
-            switch (reportConfigEutra.triggerQuantity)
-              {
-              case LteRrcSap::ReportConfigEutra::RSRP:
-                mn = storedMeasIt->second.rsrp;
-                break;
-              case LteRrcSap::ReportConfigEutra::RSRQ:
-                mn = storedMeasIt->second.rsrq;
-                break;
-              default:
-                NS_FATAL_ERROR ("unsupported triggerQuantity");
-                break;
-              }
-
-            bool hasTriggered = isMeasIdInReportList
-              && (measReportIt->second.cellsTriggeredList.find (cellId)
-                  != measReportIt->second.cellsTriggeredList.end ());
+        NS_LOG_LOGIC (this << " event A4: thresh=" << thresh);
 
-            // Inequality A4-1 (Entering condition): Mn + Ofn + Ocn - Hys > Thresh
-            bool entryCond = mn + ofn + ocn - hys > thresh;
-
-            if (entryCond)
-              {
-                if (!hasTriggered)
-                  {
-                    concernedCellsEntry.push_back (cellId);
-                    eventEntryCondApplicable = true;
-                  }
-              }
-            else if (reportConfigEutra.timeToTrigger > 0)
-              {
-                CancelEnteringTrigger (measId, cellId);
-              }
+        // Inequality A4-1 (Entering condition): Mn + Ofn + Ocn - Hys > Thresh
+        FindEnteringNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                    thresh - ofn - ocn + hys,
+                                    reportConfigEutra.timeToTrigger > 0,
+                                    concernedCellsEntry);
+        eventEntryCondApplicable = !concernedCellsEntry.empty ();
 
-            // Inequality A4-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Thresh
-            bool leavingCond = mn + ofn + ocn + hys < thresh;
-
-            if (leavingCond)
-              {
-                if (hasTriggered)
-                  {
-                    concernedCellsLeaving.push_back (cellId);
-                    eventLeavingCondApplicable = true;
-                  }
-              }
-            else if (reportConfigEutra.timeToTrigger > 0)
-              {
-                CancelLeavingTrigger (measId, cellId);
-              }
-
-            NS_LOG_LOGIC (this << " event A4: neighbor cell " << cellId
-                               << " mn=" << mn << " thresh=" << thresh
-                               << " entryCond=" << entryCond
-                               << " leavingCond=" << leavingCond);
-
-          }   // end of for (storedMeasIt)
+        // Inequality A4-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Thresh
+        FindLeavingNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                   thresh - ofn - ocn - hys,
+                                   reportConfigEutra.timeToTrigger > 0,
+                                   concernedCellsLeaving);
+        eventLeavingCondApplicable = !concernedCellsLeaving.empty ();
 
       }   // end of case LteRrcSap::ReportConfigEutra::EVENT_A4
 
@@ -2153,7 +2035,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
         switch (reportConfigEutra.triggerQuantity)
           {
           case LteRrcSap::ReportConfigEutra::RSRP:
-            mp = m_storedMeasValues[m_cellId].rsrp;
+            mp = GetServingCellMeasValue (LteUeMeasTable::RSRP);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRP);
             NS_ASSERT (reportConfigEutra.threshold2.choice
@@ -2162,7 +2044,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
             thresh2 = EutranMeasurementMapping::RsrpRange2Dbm (reportConfigEutra.threshold2.range);
             break;
           case LteRrcSap::ReportConfigEutra::RSRQ:
-            mp = m_storedMeasValues[m_cellId].rsrq;
+            mp = GetServingCellMeasValue (LteUeMeasTable::RSRQ);
             NS_ASSERT (reportConfigEutra.threshold1.choice
                        == LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ);
             NS_ASSERT (reportConfigEutra.threshold2.choice
@@ -2180,57 +2062,12 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
 
         if (entryCond)
           {
-            for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-                 storedMeasIt != m_storedMeasValues.end ();
-                 ++storedMeasIt)
-              {
-                uint16_t cellId = storedMeasIt->first;
-                if (cellId == m_cellId)
-                  {
-                    continue;
-                  }
-
-                switch (reportConfigEutra.triggerQuantity)
-                  {
-                  case LteRrcSap::ReportConfigEutra::RSRP:
-                    mn = storedMeasIt->second.rsrp;
-                    break;
-                  case LteRrcSap::ReportConfigEutra::RSRQ:
-                    mn = storedMeasIt->second.rsrq;
-                    break;
-                  default:
-                    NS_FATAL_ERROR ("unsupported triggerQuantity");
-                    break;
-                  }
-
-                bool hasTriggered = isMeasIdInReportList
-                  && (measReportIt->second.cellsTriggeredList.find (cellId)
-                      != measReportIt->second.cellsTriggeredList.end ());
-
-                // Inequality A5-2 (Entering condition 2): Mn + Ofn + Ocn - Hys > Thresh2
-
-                entryCond = mn + ofn + ocn - hys > thresh2;
-
-                if (entryCond)
-                  {
-                    if (!hasTriggered)
-                      {
-                        concernedCellsEntry.push_back (cellId);
-                        eventEntryCondApplicable = true;
-                      }
-                  }
-                else if (reportConfigEutra.timeToTrigger > 0)
-                  {
-                    CancelEnteringTrigger (measId, cellId);
-                  }
-
-                NS_LOG_LOGIC (this << " event A5: neighbor cell " << cellId
-                                   << " mn=" << mn << " mp=" << mp
-                                   << " thresh2=" << thresh2
-                                   << " thresh1=" << thresh1
-                                   << " entryCond=" << entryCond);
-
-              }   // end of for (storedMeasIt)
+            // Inequality A5-2 (Entering condition 2): Mn + Ofn + Ocn - Hys > Thresh2
+            FindEnteringNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                        thresh2 - ofn - ocn + hys,
+                                        reportConfigEutra.timeToTrigger > 0,
+                                        concernedCellsEntry);
+            eventEntryCondApplicable = !concernedCellsEntry.empty ();
 
           }   // end of if (entryCond)
         else
@@ -2252,87 +2089,45 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
 
             if (leavingCond)
               {
-                if (reportConfigEutra.timeToTrigger == 0)
+                /*
+                 * All the triggered cells are "in". When time-to-trigger is
+                 * enabled, leaving condition #2 is still checked to cancel
+                 * the time-to-trigger of the cells not fulfilling it.
+                 */
+                const std::set<uint16_t>& cellsTriggeredList = measReportIt->second.cellsTriggeredList;
+                for (std::set<uint16_t>::const_iterator cellIt = cellsTriggeredList.begin ();
+                     cellIt != cellsTriggeredList.end ();
+                     ++cellIt)
                   {
-                    // leaving condition #2 does not have to be checked
-
-                    for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-                         storedMeasIt != m_storedMeasValues.end ();
-                         ++storedMeasIt)
+                    uint16_t cellId = *cellIt;
+                    int32_t row = m_measTable.FindRow (cellId);
+                    if (cellId == m_cellId || row < 0)
                       {
-                        uint16_t cellId = storedMeasIt->first;
-                        if (cellId == m_cellId)
-                          {
-                            continue;
-                          }
-
-                        if (measReportIt->second.cellsTriggeredList.find (cellId)
-                            != measReportIt->second.cellsTriggeredList.end ())
-                          {
-                            concernedCellsLeaving.push_back (cellId);
-                            eventLeavingCondApplicable = true;
-                          }
+                        continue;
                       }
-                  }   // end of if (reportConfigEutra.timeToTrigger == 0)
-                else
-                  {
-                    // leaving condition #2 has to be checked to cancel time-to-trigger
 
-                    for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-                         storedMeasIt != m_storedMeasValues.end ();
-                         ++storedMeasIt)
+                    if (reportConfigEutra.timeToTrigger > 0)
                       {
-                        uint16_t cellId = storedMeasIt->first;
-                        if (cellId == m_cellId)
+                        mn = m_measTable.GetValue (row, GetTriggerQuantity (reportConfigEutra));
+
+                        // Inequality A5-4 (Leaving condition 2): Mn + Ofn + Ocn + Hys < Thresh2
+                        bool leavingCond2 = mn + ofn + ocn + hys < thresh2;
+
+                        if (!leavingCond2)
                           {
-                            continue;
+                            CancelLeavingTrigger (measId, cellId);
                           }
 
-                        if (measReportIt->second.cellsTriggeredList.find (cellId)
-                            != measReportIt->second.cellsTriggeredList.end ())
-                          {
-                            switch (reportConfigEutra.triggerQuantity)
-                              {
-                              case LteRrcSap::ReportConfigEutra::RSRP:
-                                mn = storedMeasIt->second.rsrp;
-                                break;
-                              case LteRrcSap::ReportConfigEutra::RSRQ:
-                                mn = storedMeasIt->second.rsrq;
-                                break;
-                              default:
-                                NS_FATAL_ERROR ("unsupported triggerQuantity");
-                                break;
-                              }
-
-                            // Inequality A5-4 (Leaving condition 2): Mn + Ofn + Ocn + Hys < Thresh2
-
-                            leavingCond = mn + ofn + ocn + hys < thresh2;
-
-                            if (!leavingCond)
-                              {
-                                CancelLeavingTrigger (measId, cellId);
-                              }
-
-                            /*
-                             * Whatever the result of leaving condition #2, this
-                             * cell is still "in", because leaving condition #1
-                             * is already true.
-                             */
-                            concernedCellsLeaving.push_back (cellId);
-                            eventLeavingCondApplicable = true;
-
-                            NS_LOG_LOGIC (this << " event A5: neighbor cell " << cellId
-                                               << " mn=" << mn << " mp=" << mp
-                                               << " thresh2=" << thresh2
-                                               << " thresh1=" << thresh1
-                                               << " leavingCond=" << leavingCond);
-
-                          }   // end of if (measReportIt->second.cellsTriggeredList.find (cellId)
-                        //            != measReportIt->second.cellsTriggeredList.end ())
-
-                      }   // end of for (storedMeasIt)
-
-                  }   // end of else of if (reportConfigEutra.timeToTrigger == 0)
+                        NS_LOG_LOGIC (this << " event A5: neighbor cell " << cellId
+                                           << " mn=" << mn << " mp=" << mp
+                                           << " thresh2=" << thresh2
+                                           << " thresh1=" << thresh1
+                                           << " leavingCond=" << leavingCond2);
+                      }
+
+                    concernedCellsLeaving.push_back (cellId);
+                    eventLeavingCondApplicable = true;
+                  }
 
                 NS_LOG_LOGIC (this << " event A5: serving cell " << m_cellId
                                    << " mp=" << mp << " thresh1=" << thresh1
@@ -2346,53 +2141,12 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                     CancelLeavingTrigger (measId);
                   }
 
-                // check leaving condition #2
-
-                for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
-                     storedMeasIt != m_storedMeasValues.end ();
-                     ++storedMeasIt)
-                  {
-                    uint16_t cellId = storedMeasIt->first;
-                    if (cellId == m_cellId)
-                      {
-                        continue;
-                      }
-
-                    if (measReportIt->second.cellsTriggeredList.find (cellId)
-                        != measReportIt->second.cellsTriggeredList.end ())
-                      {
-                        switch (reportConfigEutra.triggerQuantity)
-                          {
-                          case LteRrcSap::ReportConfigEutra::RSRP:
-                            mn = storedMeasIt->second.rsrp;
-                            break;
-                          case LteRrcSap::ReportConfigEutra::RSRQ:
-                            mn = storedMeasIt->second.rsrq;
-                            break;
-                          default:
-                            NS_FATAL_ERROR ("unsupported triggerQuantity");
-                            break;
-                          }
-
-                        // Inequality A5-4 (Leaving condition 2): Mn + Ofn + Ocn + Hys < Thresh2
-                        leavingCond = mn + ofn + ocn + hys < thresh2;
-
-                        if (leavingCond)
-                          {
-                            concernedCellsLeaving.push_back (cellId);
-                            eventLeavingCondApplicable = true;
-                          }
-
-                        NS_LOG_LOGIC (this << " event A5: neighbor cell " << cellId
-                                           << " mn=" << mn << " mp=" << mp
-                                           << " thresh2=" << thresh2
-                                           << " thresh1=" << thresh1
-                                           << " leavingCond=" << leavingCond);
-
-                      }   // end of if (measReportIt->second.cellsTriggeredList.find (cellId)
-                    //            != measReportIt->second.cellsTriggeredList.end ())
-
-                  }   // end of for (storedMeasIt)
+                // Inequality A5-4 (Leaving condition 2): Mn + Ofn + Ocn + Hys < Thresh2
+                FindLeavingNeighbourCells (measId, GetTriggerQuantity (reportConfigEutra),
+                                           thresh2 - ofn - ocn - hys,
+                                           reportConfigEutra.timeToTrigger > 0,
+                                           concernedCellsLeaving);
+                eventLeavingCondApplicable = !concernedCellsLeaving.empty ();
 
               }   // end of else of if (leavingCond)
 
@@ -2425,10 +2179,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
           t.timer = Simulator::Schedule (MilliSeconds (reportConfigEutra.timeToTrigger),
                                          &LteUeRrc::VarMeasReportListAdd, this,
                                          measId, concernedCellsEntry);
-          std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-            enteringTriggerIt = m_enteringTriggerQueue.find (measId);
-          NS_ASSERT (enteringTriggerIt != m_enteringTriggerQueue.end ());
-          enteringTriggerIt->second.push_back (t);
+          m_enteringTriggerQueue[measId].PushBack (t);
         }
     }
 
@@ -2450,73 +2201,162 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
           t.timer = Simulator::Schedule (MilliSeconds (reportConfigEutra.timeToTrigger),
                                          &LteUeRrc::VarMeasReportListErase, this,
                                          measId, concernedCellsLeaving, reportOnLeave);
-          std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-            leavingTriggerIt = m_leavingTriggerQueue.find (measId);
-          NS_ASSERT (leavingTriggerIt != m_leavingTriggerQueue.end ());
-          leavingTriggerIt->second.push_back (t);
+          m_leavingTriggerQueue[measId].PushBack (t);
         }
     }
 
 }   // end of void LteUeRrc::MeasurementReportTriggering (uint8_t measId)
 
+double
+LteUeRrc::GetServingCellMeasValue (LteUeMeasTable::Quantity quantity) const
+{
+  int32_t row = m_measTable.FindRow (m_cellId);
+  return row >= 0 ? m_measTable.GetValue (row, quantity) : 0.0;
+}
+
 void
-LteUeRrc::CancelEnteringTrigger (uint8_t measId)
+LteUeRrc::FindEnteringNeighbourCells (uint8_t measId, LteUeMeasTable::Quantity quantity,
+                                      double thresh, bool useTimeToTrigger,
+                                      ConcernedCells_t& enteringCells)
 {
-  NS_LOG_FUNCTION (this << (uint16_t) measId);
+  NS_LOG_FUNCTION (this << (uint16_t) measId << quantity << thresh << useTimeToTrigger);
 
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    it1 = m_enteringTriggerQueue.find (measId);
-  NS_ASSERT (it1 != m_enteringTriggerQueue.end ());
+  std::map<uint8_t, VarMeasReport>::iterator
+    measReportIt = m_varMeasReportList.find (measId);
+  bool isMeasIdInReportList = (measReportIt != m_varMeasReportList.end ());
 
-  if (!it1->second.empty ())
+  // the condition holds for the leading cells sorted by decreasing Mn
+  const std::vector<uint32_t>& sortedRows = m_measTable.GetSortedRows (quantity);
+  uint32_t numEntering = m_measTable.CountAbove (quantity, thresh);
+  for (uint32_t i = 0; i < numEntering; ++i)
     {
-      std::list<PendingTrigger_t>::iterator it2;
-      for (it2 = it1->second.begin (); it2 != it1->second.end (); ++it2)
+      uint16_t cellId = m_measTable.GetCellId (sortedRows[i]);
+      if (cellId == m_cellId)
         {
-          NS_ASSERT (it2->measId == measId);
-          NS_LOG_LOGIC (this << " canceling entering time-to-trigger event at "
-                             << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
-          Simulator::Cancel (it2->timer);
+          continue;
+        }
+
+      bool hasTriggered = isMeasIdInReportList
+        && (measReportIt->second.cellsTriggeredList.find (cellId)
+            != measReportIt->second.cellsTriggeredList.end ());
+      if (!hasTriggered)
+        {
+          enteringCells.push_back (cellId);
         }
 
-      it1->second.clear ();
+      NS_LOG_LOGIC (this << " neighbor cell " << cellId
+                         << " mn=" << m_measTable.GetValue (sortedRows[i], quantity)
+                         << " fulfills the entering condition");
+    }
+
+  if (useTimeToTrigger && !m_enteringTriggerQueue[measId].IsEmpty ())
+    {
+      for (uint32_t i = numEntering; i < sortedRows.size (); ++i)
+        {
+          uint16_t cellId = m_measTable.GetCellId (sortedRows[i]);
+          if (cellId != m_cellId)
+            {
+              CancelEnteringTrigger (measId, cellId);
+            }
+        }
     }
 }
 
 void
-LteUeRrc::CancelEnteringTrigger (uint8_t measId, uint16_t cellId)
+LteUeRrc::FindLeavingNeighbourCells (uint8_t measId, LteUeMeasTable::Quantity quantity,
+                                     double thresh, bool useTimeToTrigger,
+                                     ConcernedCells_t& leavingCells)
 {
-  NS_LOG_FUNCTION (this << (uint16_t) measId << cellId);
-
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    it1 = m_enteringTriggerQueue.find (measId);
-  NS_ASSERT (it1 != m_enteringTriggerQueue.end ());
+  NS_LOG_FUNCTION (this << (uint16_t) measId << quantity << thresh << useTimeToTrigger);
 
-  std::list<PendingTrigger_t>::iterator it2 = it1->second.begin ();
-  while (it2 != it1->second.end ())
+  // only the cells which have triggered can leave
+  std::map<uint8_t, VarMeasReport>::iterator
+    measReportIt = m_varMeasReportList.find (measId);
+  if (measReportIt != m_varMeasReportList.end ())
     {
-      NS_ASSERT (it2->measId == measId);
+      const std::set<uint16_t>& cellsTriggeredList = measReportIt->second.cellsTriggeredList;
+      for (std::set<uint16_t>::const_iterator cellIt = cellsTriggeredList.begin ();
+           cellIt != cellsTriggeredList.end ();
+           ++cellIt)
+        {
+          int32_t row = m_measTable.FindRow (*cellIt);
+          if (*cellIt == m_cellId || row < 0)
+            {
+              continue;
+            }
+
+          double mn = m_measTable.GetValue (row, quantity);
+          if (mn < thresh)
+            {
+              leavingCells.push_back (*cellIt);
+            }
+
+          NS_LOG_LOGIC (this << " neighbor cell " << *cellIt << " mn=" << mn
+                             << " leavingCond=" << (mn < thresh));
+        }
+    }
 
-      ConcernedCells_t::iterator it3;
-      for (it3 = it2->concernedCells.begin ();
-           it3 != it2->concernedCells.end (); ++it3)
+  if (useTimeToTrigger && !m_leavingTriggerQueue[measId].IsEmpty ())
+    {
+      for (uint32_t row = 0; row < m_measTable.GetNRows (); ++row)
         {
-          if (*it3 == cellId)
+          uint16_t cellId = m_measTable.GetCellId (row);
+          if (cellId != m_cellId && !(m_measTable.GetValue (row, quantity) < thresh))
             {
-              it3 = it2->concernedCells.erase (it3);
+              CancelLeavingTrigger (measId, cellId);
             }
         }
+    }
+}
+
+void
+LteUeRrc::CancelEnteringTrigger (uint8_t measId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) measId);
+
+  NS_ASSERT (measId < m_enteringTriggerQueue.size ());
+  PendingTriggerQueue& queue = m_enteringTriggerQueue[measId];
+
+  for (uint32_t i = 0; i < queue.GetSize (); ++i)
+    {
+      NS_ASSERT (queue.Get (i).measId == measId);
+      NS_LOG_LOGIC (this << " canceling entering time-to-trigger event at "
+                         << Simulator::GetDelayLeft (queue.Get (i).timer).GetSeconds ());
+      Simulator::Cancel (queue.Get (i).timer);
+    }
+
+  queue.Clear ();
+}
+
+void
+LteUeRrc::CancelEnteringTrigger (uint8_t measId, uint16_t cellId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) measId << cellId);
+
+  NS_ASSERT (measId < m_enteringTriggerQueue.size ());
+  PendingTriggerQueue& queue = m_enteringTriggerQueue[measId];
+
+  uint32_t i = 0;
+  while (i < queue.GetSize ())
+    {
+      PendingTrigger_t& t = queue.Get (i);
+      NS_ASSERT (t.measId == measId);
+
+      t.concernedCells.erase (std::remove (t.concernedCells.begin (),
+                                           t.concernedCells.end (),
+                                           cellId),
+                              t.concernedCells.end ());
 
-      if (it2->concernedCells.empty ())
+      if (t.concernedCells.empty ())
         {
           NS_LOG_LOGIC (this << " canceling entering time-to-trigger event at "
-                             << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
-          Simulator::Cancel (it2->timer);
-          it2 = it1->second.erase (it2);
+                             << Simulator::GetDelayLeft (t.timer).GetSeconds ());
+          Simulator::Cancel (t.timer);
+          queue.Erase (i);
         }
       else
         {
-          it2++;
+          ++i;
         }
     }
 }
@@ -2526,23 +2366,18 @@ LteUeRrc::CancelLeavingTrigger (uint8_t measId)
 {
   NS_LOG_FUNCTION (this << (uint16_t) measId);
 
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    it1 = m_leavingTriggerQueue.find (measId);
-  NS_ASSERT (it1 != m_leavingTriggerQueue.end ());
+  NS_ASSERT (measId < m_leavingTriggerQueue.size ());
+  PendingTriggerQueue& queue = m_leavingTriggerQueue[measId];
 
-  if (!it1->second.empty ())
+  for (uint32_t i = 0; i < queue.GetSize (); ++i)
     {
-      std::list<PendingTrigger_t>::iterator it2;
-      for (it2 = it1->second.begin (); it2 != it1->second.end (); ++it2)
-        {
-          NS_ASSERT (it2->measId == measId);
-          NS_LOG_LOGIC (this << " canceling leaving time-to-trigger event at "
-                             << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
-          Simulator::Cancel (it2->timer);
-        }
-
-      it1->second.clear ();
+      NS_ASSERT (queue.Get (i).measId == measId);
+      NS_LOG_LOGIC (this << " canceling leaving time-to-trigger event at "
+                         << Simulator::GetDelayLeft (queue.Get (i).timer).GetSeconds ());
+      Simulator::Cancel (queue.Get (i).timer);
     }
+
+  queue.Clear ();
 }
 
 void
@@ -2550,35 +2385,30 @@ LteUeRrc::CancelLeavingTrigger (uint8_t measId, uint16_t cellId)
 {
   NS_LOG_FUNCTION (this << (uint16_t) measId << cellId);
 
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    it1 = m_leavingTriggerQueue.find (measId);
-  NS_ASSERT (it1 != m_leavingTriggerQueue.end ());
+  NS_ASSERT (measId < m_leavingTriggerQueue.size ());
+  PendingTriggerQueue& queue = m_leavingTriggerQueue[measId];
 
-  std::list<PendingTrigger_t>::iterator it2 = it1->second.begin ();
-  while (it2 != it1->second.end ())
+  uint32_t i = 0;
+  while (i < queue.GetSize ())
     {
-      NS_ASSERT (it2->measId == measId);
+      PendingTrigger_t& t = queue.Get (i);
+      NS_ASSERT (t.measId == measId);
 
-      ConcernedCells_t::iterator it3;
-      for (it3 = it2->concernedCells.begin ();
-           it3 != it2->concernedCells.end (); ++it3)
-        {
-          if (*it3 == cellId)
-            {
-              it3 = it2->concernedCells.erase (it3);
-            }
-        }
+      t.concernedCells.erase (std::remove (t.concernedCells.begin (),
+                                           t.concernedCells.end (),
+                                           cellId),
+                              t.concernedCells.end ());
 
-      if (it2->concernedCells.empty ())
+      if (t.concernedCells.empty ())
         {
           NS_LOG_LOGIC (this << " canceling leaving time-to-trigger event at "
-                             << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
-          Simulator::Cancel (it2->timer);
-          it2 = it1->second.erase (it2);
+                             << Simulator::GetDelayLeft (t.timer).GetSeconds ());
+          Simulator::Cancel (t.timer);
+          queue.Erase (i);
         }
       else
         {
-          it2++;
+          ++i;
         }
     }
 }
@@ -2619,10 +2449,9 @@ LteUeRrc::VarMeasReportListAdd (uint8_t measId, ConcernedCells_t enteringCells)
                            &LteUeRrc::SendMeasurementReport,
                            this, measId);
 
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    enteringTriggerIt = m_enteringTriggerQueue.find (measId);
-  NS_ASSERT (enteringTriggerIt != m_enteringTriggerQueue.end ());
-  if (!enteringTriggerIt->second.empty ())
+  NS_ASSERT (measId < m_enteringTriggerQueue.size ());
+  PendingTriggerQueue& enteringTriggerQueue = m_enteringTriggerQueue[measId];
+  if (!enteringTriggerQueue.IsEmpty ())
     {
       /*
        * Assumptions at this point:
@@ -2630,9 +2459,9 @@ LteUeRrc::VarMeasReportListAdd (uint8_t measId, ConcernedCells_t enteringCells)
        *  - the time-to-trigger delay is fixed (not adaptive/dynamic); and
        *  - the first element in the list is associated with this function call.
        */
-      enteringTriggerIt->second.pop_front ();
+      enteringTriggerQueue.PopFront ();
 
-      if (!enteringTriggerIt->second.empty ())
+      if (!enteringTriggerQueue.IsEmpty ())
         {
           /*
            * To prevent the same set of cells triggering again in the future,
@@ -2646,7 +2475,7 @@ LteUeRrc::VarMeasReportListAdd (uint8_t measId, ConcernedCells_t enteringCells)
             }
         }
 
-    }   // end of if (!enteringTriggerIt->second.empty ())
+    }   // end of if (!enteringTriggerQueue.IsEmpty ())
 
 }   // end of LteUeRrc::VarMeasReportListAdd
 
@@ -2680,10 +2509,9 @@ LteUeRrc::VarMeasReportListErase (uint8_t measId, ConcernedCells_t leavingCells,
       m_varMeasReportList.erase (measReportIt);
     }
 
-  std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
-    leavingTriggerIt = m_leavingTriggerQueue.find (measId);
-  NS_ASSERT (leavingTriggerIt != m_leavingTriggerQueue.end ());
-  if (!leavingTriggerIt->second.empty ())
+  NS_ASSERT (measId < m_leavingTriggerQueue.size ());
+  PendingTriggerQueue& leavingTriggerQueue = m_leavingTriggerQueue[measId];
+  if (!leavingTriggerQueue.IsEmpty ())
     {
       /*
        * Assumptions at this point:
@@ -2691,9 +2519,9 @@ LteUeRrc::VarMeasReportListErase (uint8_t measId, ConcernedCells_t leavingCells,
        *  - the time-to-trigger delay is fixed (not adaptive/dynamic); and
        *  - the first element in the list is associated with this function call.
        */
-      leavingTriggerIt->second.pop_front ();
+      leavingTriggerQueue.PopFront ();
 
-      if (!leavingTriggerIt->second.empty ())
+      if (!leavingTriggerQueue.IsEmpty ())
         {
           /*
            * To prevent the same set of cells triggering again in the future,
@@ -2707,7 +2535,7 @@ LteUeRrc::VarMeasReportListErase (uint8_t measId, ConcernedCells_t leavingCells,
             }
         }
 
-    }   // end of if (!leavingTriggerIt->second.empty ())
+    }   // end of if (!leavingTriggerQueue.IsEmpty ())
 
 }   // end of LteUeRrc::VarMeasReportListErase
 
@@ -2749,13 +2577,15 @@ LteUeRrc::SendMeasurementReport (uint8_t measId)
   LteRrcSap::MeasResults& measResults = measurementReport.measResults;
   measResults.measId = measId;
 
-  std::map<uint16_t, MeasValues>::iterator servingMeasIt = m_storedMeasValues.find (m_cellId);
-  NS_ASSERT (servingMeasIt != m_storedMeasValues.end ());
-  measResults.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (servingMeasIt->second.rsrp);
-  measResults.rsrqResult = EutranMeasurementMapping::Db2RsrqRange (servingMeasIt->second.rsrq);
+  int32_t servingRow = m_measTable.FindRow (m_cellId);
+  NS_ASSERT (servingRow >= 0);
+  double servingRsrp = m_measTable.GetValue (servingRow, LteUeMeasTable::RSRP);
+  double servingRsrq = m_measTable.GetValue (servingRow, LteUeMeasTable::RSRQ);
+  measResults.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (servingRsrp);
+  measResults.rsrqResult = EutranMeasurementMapping::Db2RsrqRange (servingRsrq);
   NS_LOG_INFO (this << " reporting serving cell "
-               "RSRP " << (uint32_t) measResults.rsrpResult << " (" << servingMeasIt->second.rsrp << " dBm) "
-               "RSRQ " << (uint32_t) measResults.rsrqResult << " (" << servingMeasIt->second.rsrq << " dB)");
+               "RSRP " << (uint32_t) measResults.rsrpResult << " (" << servingRsrp << " dBm) "
+               "RSRQ " << (uint32_t) measResults.rsrqResult << " (" << servingRsrq << " dB)");
   measResults.haveMeasResultNeighCells = false;
   std::map<uint8_t, VarMeasReport>::iterator measReportIt = m_varMeasReportList.find (measId);
   if (measReportIt == m_varMeasReportList.end ())
@@ -2774,20 +2604,9 @@ LteUeRrc::SendMeasurementReport (uint8_t measId)
               uint16_t cellId = *cellsTriggeredIt;
               if (cellId != m_cellId)
                 {
-                  std::map<uint16_t, MeasValues>::iterator neighborMeasIt = m_storedMeasValues.find (cellId);
-                  double triggerValue;
-                  switch (reportConfigEutra.triggerQuantity)
-                    {
-                    case LteRrcSap::ReportConfigEutra::RSRP:
-                      triggerValue = neighborMeasIt->second.rsrp;
-                      break;
-                    case LteRrcSap::ReportConfigEutra::RSRQ:
-                      triggerValue = neighborMeasIt->second.rsrq;
-                      break;
-                    default:
-                      NS_FATAL_ERROR ("unsupported triggerQuantity");
-                      break;
-                    }
+                  int32_t neighborRow = m_measTable.FindRow (cellId);
+                  NS_ASSERT (neighborRow >= 0);
+                  double triggerValue = m_measTable.GetValue (neighborRow, GetTriggerQuantity (reportConfigEutra));
                   sortedNeighCells.insert (std::pair<double, uint16_t> (triggerValue, cellId));
                 }
             }
@@ -2799,20 +2618,22 @@ LteUeRrc::SendMeasurementReport (uint8_t measId)
                ++sortedNeighCellsIt, ++count)
             {
               uint16_t cellId = sortedNeighCellsIt->second;
-              std::map<uint16_t, MeasValues>::iterator neighborMeasIt = m_storedMeasValues.find (cellId);
-              NS_ASSERT (neighborMeasIt != m_storedMeasValues.end ());
+              int32_t neighborRow = m_measTable.FindRow (cellId);
+              NS_ASSERT (neighborRow >= 0);
+              double neighborRsrp = m_measTable.GetValue (neighborRow, LteUeMeasTable::RSRP);
+              double neighborRsrq = m_measTable.GetValue (neighborRow, LteUeMeasTable::RSRQ);
               LteRrcSap::MeasResultEutra measResultEutra;
               measResultEutra.physCellId = cellId;
               measResultEutra.haveCgiInfo = false;
               measResultEutra.haveRsrpResult = true;
-              measResultEutra.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (neighborMeasIt->second.rsrp);
+              measResultEutra.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (neighborRsrp);
               measResultEutra.haveRsrqResult = true;
-              measResultEutra.rsrqResult = EutranMeasurementMapping::Db2RsrqRange (neighborMeasIt->second.rsrq);
+              measResultEutra.rsrqResult = EutranMeasurementMapping::Db2RsrqRange (neighborRsrq);
               NS_LOG_INFO (this << " reporting neighbor cell " << (uint32_t) measResultEutra.physCellId
                                 << " RSRP " << (uint32_t) measResultEutra.rsrpResult
-                                << " (" << neighborMeasIt->second.rsrp << " dBm)"
+                                << " (" << neighborRsrp << " dBm)"
                                 << " RSRQ " << (uint32_t) measResultEutra.rsrqResult
-                                << " (" << neighborMeasIt->second.rsrq << " dB)");
+                                << " (" << neighborRsrq << " dB)");
               measResults.measResultListEutra.push_back (measResultEutra);
               measResults.haveMeasResultNeighCells = true;
             }
@@ -2888,6 +2709,81 @@ LteUeRrc::SendMeasurementReport (uint8_t measId)
     }
 }
 
+LteUeRrc::PendingTriggerQueue::PendingTriggerQueue ()
+  : m_ring (8),
+    m_head (0),
+    m_size (0)
+{
+}
+
+bool
+LteUeRrc::PendingTriggerQueue::IsEmpty () const
+{
+  return m_size == 0;
+}
+
+uint32_t
+LteUeRrc::PendingTriggerQueue::GetSize () const
+{
+  return m_size;
+}
+
+LteUeRrc::PendingTrigger_t&
+LteUeRrc::PendingTriggerQueue::Get (uint32_t i)
+{
+  NS_ASSERT (i < m_size);
+  return m_ring[(m_head + i) % m_ring.size ()];
+}
+
+void
+LteUeRrc::PendingTriggerQueue::PushBack (const PendingTrigger_t& t)
+{
+  if (m_size == m_ring.size ())
+    {
+      // unroll the ring into a twice larger one
+      std::vector<PendingTrigger_t> ring (2 * m_ring.size ());
+      for (uint32_t i = 0; i < m_size; ++i)
+        {
+          ring[i] = Get (i);
+        }
+      m_ring.swap (ring);
+      m_head = 0;
+    }
+  m_ring[(m_head + m_size) % m_ring.size ()] = t;
+  ++m_size;
+}
+
+void
+LteUeRrc::PendingTriggerQueue::PopFront ()
+{
+  NS_ASSERT (m_size > 0);
+  m_ring[m_head].concernedCells.clear ();
+  m_head = (m_head + 1) % m_ring.size ();
+  --m_size;
+}
+
+void
+LteUeRrc::PendingTriggerQueue::Erase (uint32_t i)
+{
+  NS_ASSERT (i < m_size);
+  for (uint32_t j = i; j + 1 < m_size; ++j)
+    {
+      Get (j) = Get (j + 1);
+    }
+  Get (m_size - 1).concernedCells.clear ();
+  --m_size;
+}
+
+void
+LteUeRrc::PendingTriggerQueue::Clear ()
+{
+  while (m_size > 0)
+    {
+      PopFront ();
+    }
+  m_head = 0;
+}
+
 void
 LteUeRrc::StartConnection ()
 {
@@ -32,6 +32,7 @@
 #include <ns3/traced-callback.h>
 #include "ns3/component-carrier-ue.h"
 #include <ns3/lte-ue-ccm-rrc-sap.h>
+#include <ns3/lte-ue-meas-table.h>
 #include <vector>
 
 #include <map>
@@ -468,17 +469,16 @@ private:
   void ApplyMeasConfig (LteRrcSap::MeasConfig mc);
 
   /**
-   * \brief Keep the given measurement result as the latest measurement figures,
+   * \brief Keep the given measurement results as the latest measurement figures,
    *        to be utilised by UE RRC functions.
-   * \param cellId the cell ID of the measured cell
-   * \param rsrp measured RSRP value to be saved (in dBm)
-   * \param rsrq measured RSRQ value to be saved (in dB)
+   * \param measurements the measured cells, with their RSRP (in dBm) and
+   *                     RSRQ (in dB)
    * \param useLayer3Filtering
    * \todo Remove the useLayer3Filtering argument
    *
    * Implements Section 5.5.3.2 "Layer 3 filtering" of 3GPP TS 36.331. *Layer-3
    * filtering* is applied to the given measurement results before saved to
-   * #m_storedMeasValues. The filtering is however disabled when the UE is in
+   * #m_measTable. The filtering is however disabled when the UE is in
    * IDLE mode, i.e., saving unfiltered values.
    *
    * Layer-3 filtering is influenced by a filter coefficient, which determines
@@ -487,9 +487,9 @@ private:
    * LteUeRrc::ApplyMeasConfig. Details on how the coefficient works and how to
    * modify it can be found in LTE module's Design Documentation.
    *
-   * \sa LteUeRrc::m_storedMeasValues
+   * \sa LteUeRrc::m_measTable
    */
-  void SaveUeMeasurements (uint16_t cellId, double rsrp, double rsrq,
+  void SaveUeMeasurements (const std::vector<LteUeCphySapUser::UeMeasurementsElement>& measurements,
                            bool useLayer3Filtering);
 
   /**
@@ -786,7 +786,7 @@ private:
   /**
    * \brief List of cell IDs which are responsible for a certain trigger.
    */
-  typedef std::list<uint16_t> ConcernedCells_t;
+  typedef std::vector<uint16_t> ConcernedCells_t;
 
   /**
    * \brief Compose a new reporting entry of the given measurement identity,
@@ -841,20 +841,9 @@ private:
    */
   void VarMeasReportListClear (uint8_t measId);
 
-  /**
-   * \brief Represents a measurement result from a certain cell.
-   */
-  struct MeasValues
-  {
-    double rsrp; ///< Measured RSRP in dBm.
-    double rsrq; ///< Measured RSRQ in dB.
-    Time timestamp; ///< Not used. \todo Should be removed.
-  };
-
   /**
    * \brief Internal storage of the latest measurement results from all detected
-   *        detected cells, indexed by the cell ID where the measurement was
-   *        taken from.
+   *        detected cells, with one row per cell.
    *
    * Each *measurement result* comprises of RSRP (in dBm) and RSRQ (in dB).
    *
@@ -862,9 +851,17 @@ private:
    * selection* procedure. While in CONNECTED mode, *layer-3 filtering* is
    * applied to the measurement results and they are used by *UE measurements*
    * function (LteUeRrc::MeasurementReportTriggering and
-   * LteUeRrc::SendMeasurementReport).
+   * LteUeRrc::SendMeasurementReport), which look up the neighbour cells
+   * fulfilling a condition in the cells sorted by the trigger quantity.
    */
-  std::map<uint16_t, MeasValues> m_storedMeasValues;
+  LteUeMeasTable m_measTable;
+
+  /**
+   * \param quantity the quantity
+   * \return the latest measurement result of the serving cell, or zero if
+   *         the serving cell was never measured
+   */
+  double GetServingCellMeasValue (LteUeMeasTable::Quantity quantity) const;
 
   /**
    * \brief Represents a single triggered event from a measurement identity
@@ -878,28 +875,70 @@ private:
     EventId timer; ///< The pending reporting event, scheduled at the end of the time-to-trigger.
   };
 
+  /**
+   * \brief Ring buffer of the triggers of a measurement identity which are
+   *        waiting for the end of their time-to-trigger, oldest first.
+   *
+   * The storage is allocated once and only grows (doubling its capacity)
+   * when more triggers are pending than the time-to-trigger and the
+   * measurement period allow for in the default configuration.
+   */
+  class PendingTriggerQueue
+  {
+  public:
+    PendingTriggerQueue ();
+
+    /// \return whether no trigger is pending
+    bool IsEmpty () const;
+    /// \return the number of pending triggers
+    uint32_t GetSize () const;
+    /**
+     * \param i the position, 0 being the oldest trigger
+     * \return the trigger at the given position
+     */
+    PendingTrigger_t& Get (uint32_t i);
+    /**
+     * \param t the trigger to be appended
+     */
+    void PushBack (const PendingTrigger_t& t);
+    /// remove the oldest trigger
+    void PopFront ();
+    /**
+     * \param i the position of the trigger to be removed, keeping the order
+     *          of the others
+     */
+    void Erase (uint32_t i);
+    /// remove all the triggers, without canceling their events
+    void Clear ();
+
+  private:
+    std::vector<PendingTrigger_t> m_ring; ///< the storage
+    uint32_t m_head; ///< position of the oldest trigger in m_ring
+    uint32_t m_size; ///< number of pending triggers
+  };
+
   /**
    * \brief List of triggers that were raised because entering condition have
    *        been true, but are still delayed from reporting it by
    *        time-to-trigger.
    *
-   * The list is indexed by the measurement identity where the trigger
+   * The queues are indexed by the measurement identity where the trigger
    * originates from. The enclosed event will run at the end of the
    * time-to-trigger and insert a *reporting entry* to #m_varMeasReportList.
    */
-  std::map<uint8_t, std::list<PendingTrigger_t> > m_enteringTriggerQueue;
+  std::vector<PendingTriggerQueue> m_enteringTriggerQueue;
 
   /**
    * \brief List of triggers that were raised because leaving condition have
    *        been true, but are still delayed from stopping the reporting by
    *        time-to-trigger.
    *
-   * The list is indexed by the measurement identity where the trigger
+   * The queues are indexed by the measurement identity where the trigger
    * originates from. The enclosed event will run at the end of the
    * time-to-trigger and remove the associated *reporting entry* from
    * #m_varMeasReportList.
    */
-  std::map<uint8_t, std::list<PendingTrigger_t> > m_leavingTriggerQueue;
+  std::vector<PendingTriggerQueue> m_leavingTriggerQueue;
 
   /**
    * \brief Clear all the waiting triggers in #m_enteringTriggerQueue which are
@@ -920,6 +959,45 @@ private:
    */
   void CancelEnteringTrigger (uint8_t measId);
 
+  /**
+   * \brief Find the neighbour cells fulfilling the entering condition of an
+   *        event which compares the neighbour cells against a threshold.
+   * \param measId the measurement identity being evaluated
+   * \param quantity the trigger quantity
+   * \param thresh the entering condition is Mn > thresh, with the offsets
+   *               and hysteresis of the event folded into thresh
+   * \param useTimeToTrigger whether time-to-trigger is enabled
+   * \param enteringCells the cells fulfilling the condition which are not
+   *                      yet in the reporting entry are appended here
+   *
+   * The cells fulfilling the condition are a leading range of the cells
+   * sorted by decreasing Mn, so that only they are visited. The others are
+   * only visited to be removed from #m_enteringTriggerQueue when
+   * time-to-trigger is enabled and some triggers are pending.
+   */
+  void FindEnteringNeighbourCells (uint8_t measId, LteUeMeasTable::Quantity quantity,
+                                   double thresh, bool useTimeToTrigger,
+                                   ConcernedCells_t& enteringCells);
+
+  /**
+   * \brief Find the neighbour cells fulfilling the leaving condition of an
+   *        event which compares the neighbour cells against a threshold.
+   * \param measId the measurement identity being evaluated
+   * \param quantity the trigger quantity
+   * \param thresh the leaving condition is Mn < thresh, with the offsets
+   *               and hysteresis of the event folded into thresh
+   * \param useTimeToTrigger whether time-to-trigger is enabled
+   * \param leavingCells the cells of the reporting entry fulfilling the
+   *                     condition are appended here
+   *
+   * Only the cells of the reporting entry are visited. The others are only
+   * visited to be removed from #m_leavingTriggerQueue when time-to-trigger
+   * is enabled and some triggers are pending.
+   */
+  void FindLeavingNeighbourCells (uint8_t measId, LteUeMeasTable::Quantity quantity,
+                                  double thresh, bool useTimeToTrigger,
+                                  ConcernedCells_t& leavingCells);
+
   /**
    * \brief Remove a specific cell from the waiting triggers in
    *        #m_enteringTriggerQueue which belong to the given measurement